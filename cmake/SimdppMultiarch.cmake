@@ -111,6 +111,43 @@ set(SIMDPP_X86_SSE4_1_TEST_CODE
     }"
 )
 
+list(APPEND SIMDPP_ARCHS_PRI "X86_SSE4_2")
+if(NOT MSVC)
+    set(SIMDPP_X86_SSE4_2_CXX_FLAGS "-msse4.2 -DSIMDPP_ARCH_X86_SSE4_2")
+else()
+    set(SIMDPP_X86_SSE4_2_CXX_FLAGS "/arch:SSE2 -DSIMDPP_ARCH_X86_SSE4_2")
+endif()
+set(SIMDPP_X86_SSE4_2_SUFFIX "-x86_sse4_2")
+set(SIMDPP_X86_SSE4_2_TEST_CODE
+    "#include <nmmintrin.h>
+    int main()
+    {
+        volatile unsigned a = 0;
+        a = _mm_crc32_u32(a, a);
+    }"
+)
+
+list(APPEND SIMDPP_ARCHS_PRI "X86_PCLMUL")
+if(NOT MSVC)
+    set(SIMDPP_X86_PCLMUL_CXX_FLAGS "-mpclmul -DSIMDPP_ARCH_X86_PCLMUL")
+else()
+    set(SIMDPP_X86_PCLMUL_CXX_FLAGS "/arch:SSE2 -DSIMDPP_ARCH_X86_PCLMUL")
+endif()
+set(SIMDPP_X86_PCLMUL_SUFFIX "-x86_pclmul")
+set(SIMDPP_X86_PCLMUL_TEST_CODE
+    "#include <wmmintrin.h>
+    int main()
+    {
+        union {
+            volatile char a[16];
+            __m128i align;
+        };
+        __m128i one = _mm_load_si128((__m128i*)(a));
+        one = _mm_clmulepi64_si128(one, one, 0);
+        _mm_store_si128((__m128i*)(a), one);
+    }"
+)
+
 list(APPEND SIMDPP_ARCHS_PRI "X86_AVX")
 if(NOT MSVC)
     set(SIMDPP_X86_AVX_CXX_FLAGS "-mavx -DSIMDPP_ARCH_X86_AVX")
@@ -215,7 +252,7 @@ set(SIMDPP_X86_XOP_TEST_CODE
 
 list(APPEND SIMDPP_ARCHS_PRI "X86_AVX512F")
 if(NOT MSVC)
-    set(SIMDPP_X86_AVX512F_CXX_FLAGS "-mavx512f -DSIMDPP_ARCH_X86_AVX512F")
+    set(SIMDPP_X86_AVX512F_CXX_FLAGS "-mavx512f -mfma -DSIMDPP_ARCH_X86_AVX512F")
 else()
     set(SIMDPP_X86_AVX512F_CXX_FLAGS "/arch:AVX -DSIMDPP_ARCH_X86_AVX512F") #unsupported
 endif()
@@ -343,8 +380,9 @@ endfunction()
 #   identifiers is supplied.
 #
 #   The following identifiers are currently supported:
-#   X86_SSE2, X86_SSE3, X86_SSSE3, X86_SSE4_1, X86_AVX, X86_AVX2, X86_FMA3,
-#   X86_FMA4, X86_XOP, ARM_NEON, ARM_NEON_FLT_SP, ARM64_NEON
+#   X86_SSE2, X86_SSE3, X86_SSSE3, X86_SSE4_1, X86_SSE4_2, X86_PCLMUL, X86_AVX,
+#   X86_AVX2, X86_FMA3, X86_FMA4, X86_XOP, ARM_NEON, ARM_NEON_FLT_SP,
+#   ARM64_NEON
 #
 function(simdpp_multiarch FILE_LIST_VAR SRC_FILE)
     if(NOT EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/${SRC_FILE}")
@@ -404,6 +442,12 @@ function(simdpp_get_arch_perm ALL_ARCHS_VAR)
     if(DEFINED ARCH_SUPPORTED_X86_SSE4_1)
         list(APPEND ALL_ARCHS "X86_SSE4_1")
     endif()
+    if(DEFINED ARCH_SUPPORTED_X86_SSE4_2)
+        list(APPEND ALL_ARCHS "X86_SSE4_2")
+        if(DEFINED ARCH_SUPPORTED_X86_PCLMUL)
+            list(APPEND ALL_ARCHS "X86_SSE4_2,X86_PCLMUL")
+        endif()
+    endif()
     if(DEFINED ARCH_SUPPORTED_X86_AVX)
         list(APPEND ALL_ARCHS "X86_AVX")
     endif()
@@ -0,0 +1,293 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_ALPHA_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_ALPHA_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_le.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_div.h>
+#include <simdpp/core/f_min.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_add_sat.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_float32.h>
+#include <simdpp/core/to_int32.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The pixels are RGBA with 8-bit channels, alpha is the fourth byte of each
+    pixel. The products of two channels are divided by 255 with exact
+    rounding using
+
+        round(x / 255) = ((x + 128) * 257) >> 16
+
+    which holds for all x within [0, 255*255]. The vector code computes the
+    products in 16-bit elements: the even and the odd bytes of each vector
+    are widened to separate vectors, multiplied with mul_lo and divided
+    with mul_hi. The alpha of each pixel is broadcast to both 16-bit halves
+    of its 32-bit element with shifts, which is cheaper than a byte shuffle
+    on SSE2 and not slower elsewhere. The shift amounts depend on the byte
+    order: the alpha is the most significant byte of the 32-bit element on
+    little-endian architectures and the least significant one on big-endian
+    ALTIVEC.
+
+    Unpremultiplication divides by a different alpha for each pixel and is
+    computed in float32. The quotient 255*c/a is rounded correctly, thus the
+    results are exact. Float division is only approximate on NEON32 and
+    ALTIVEC, there the rounded quotient is corrected by comparing it against
+    the exact products, which are small integers.
+
+    All functions produce the same results on all architectures. The source
+    and the destination may be the same array.
+*/
+
+namespace detail {
+
+using alpha_vector = typename fast_vector<uint8_t>::type;
+using alpha_vector16 = uint16<alpha_vector::length / 2>;
+using alpha_vector32 = uint32<alpha_vector::length / 4>;
+
+// The shift of the byte at offset B of a pixel within its 32-bit element
+template<unsigned B>
+struct alpha_byte {
+#if SIMDPP_USE_ALTIVEC
+    static const unsigned shift = 8 * (3 - B);
+#else
+    static const unsigned shift = 8 * B;
+#endif
+};
+
+// Returns the byte at offset B of each pixel
+template<unsigned B, unsigned N> SIMDPP_INL
+uint32<N> alpha_channel(const uint32<N>& x)
+{
+    uint32<N> r = shift_r<alpha_byte<B>::shift>(x);
+    if (alpha_byte<B>::shift != 24) {
+        r = bit_and(r, (uint32<N>) make_uint(0xff));
+    }
+    return r;
+}
+
+SIMDPP_INL uint8_t alpha_div255(unsigned x)
+{
+    return uint8_t(((x + 128) * 257) >> 16);
+}
+
+SIMDPP_INL alpha_vector16 alpha_div255(const alpha_vector16& x)
+{
+    alpha_vector16 t = add(x, (alpha_vector16) make_uint(128));
+    return mul_hi(t, (alpha_vector16) make_uint(257));
+}
+
+// Returns the alpha of each pixel in both 16-bit halves of the pixel
+SIMDPP_INL alpha_vector16 alpha_broadcast(const alpha_vector& x)
+{
+    alpha_vector32 a = alpha_channel<3>(alpha_vector32(x));
+    return alpha_vector16(bit_or(a, shift_l<16>(a)));
+}
+
+// Multiplies each channel by the corresponding element of m and divides by 255
+SIMDPP_INL void alpha_scale(const alpha_vector& x, const alpha_vector16& m,
+                            alpha_vector16& e, alpha_vector16& o)
+{
+    alpha_vector16 w = alpha_vector16(x);
+    e = bit_and(w, (alpha_vector16) make_uint(0xff));
+    o = shift_r<8>(w);
+    e = alpha_div255(alpha_vector16(mul_lo(e, m)));
+    o = alpha_div255(alpha_vector16(mul_lo(o, m)));
+}
+
+SIMDPP_INL alpha_vector alpha_join(const alpha_vector16& e, const alpha_vector16& o)
+{
+    return alpha_vector(bit_or(e, shift_l<8>(o)));
+}
+
+SIMDPP_INL uint8_t alpha_unpremultiply(unsigned c, unsigned a)
+{
+    if (a == 0) {
+        return 0;
+    }
+    float q = float(c * 255) / float(a) + 0.5f;
+    return q >= 255.0f ? 255 : uint8_t(q);
+}
+
+// Returns min(round(c * 255 / a), 255) for integral c and nonzero a
+template<unsigned N> SIMDPP_INL
+float32<N> alpha_unpremultiply(const float32<N>& c, const float32<N>& a)
+{
+    using F = float32<N>;
+    F c255 = make_float(255.0f);
+    F q = add(div(mul(c, c255), a), (F) make_float(0.5f));
+#if SIMDPP_USE_NEON32 || SIMDPP_USE_ALTIVEC
+    // The truncated q is off by at most one. round(n/a) == q holds iff
+    // (2q - 1)*a <= 2n < (2q + 1)*a, all terms are exact in float
+    F one = make_float(1.0f);
+    F n2 = mul(c, (F) make_float(510.0f));
+    q = to_float32(to_int32(q));
+    F q2 = add(q, q);
+    F hi = mul(add(q2, one), a);
+    F lo = mul(sub(q2, one), a);
+    q = add(q, bit_and(one, cmp_le(hi, n2)));
+    q = sub(q, bit_and(one, cmp_lt(n2, lo)));
+#endif
+    return min(q, c255);
+}
+
+} // namespace detail
+
+/** Multiplies the color channels of @a n RGBA pixels by their alpha:
+
+    @code
+    dst.rgb = round(src.rgb * src.a / 255)
+    dst.a = src.a
+    @endcode
+*/
+inline void premultiply_rgba(const uint8_t* src, std::size_t n, uint8_t* dst)
+{
+    using V = detail::alpha_vector;
+    using V16 = detail::alpha_vector16;
+    using V32 = detail::alpha_vector32;
+    const unsigned L = V32::length;
+    V32 amask = make_uint(0xffu << detail::alpha_byte<3>::shift);
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V x = load_u(src + 4*i);
+        V16 e, o;
+        detail::alpha_scale(x, detail::alpha_broadcast(x), e, o);
+        V r = detail::alpha_join(e, o);
+        // The alpha byte is multiplied too, restore it
+        V32 p = bit_or(bit_andnot(V32(r), amask), bit_and(V32(x), amask));
+        store_u(dst + 4*i, p);
+    }
+    for (; i < n; ++i) {
+        const uint8_t* s = src + 4*i;
+        uint8_t* d = dst + 4*i;
+        unsigned a = s[3];
+        d[0] = detail::alpha_div255(s[0] * a);
+        d[1] = detail::alpha_div255(s[1] * a);
+        d[2] = detail::alpha_div255(s[2] * a);
+        d[3] = uint8_t(a);
+    }
+}
+
+/** Divides the color channels of @a n premultiplied RGBA pixels by their
+    alpha. The color of pixels with zero alpha is set to zero.
+
+    @code
+    dst.rgb = min(round(src.rgb * 255 / src.a), 255)
+    dst.a = src.a
+    @endcode
+*/
+inline void unpremultiply_rgba(const uint8_t* src, std::size_t n, uint8_t* dst)
+{
+    using F = typename detail::fast_vector<float>::type;
+    const unsigned L = F::length;
+    using U = uint32<L>;
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        U x = load_u(src + 4*i);
+        U a = detail::alpha_channel<3>(x);
+        F fa = to_float32(int32<L>(a));
+        F r = to_float32(int32<L>(detail::alpha_channel<0>(x)));
+        F g = to_float32(int32<L>(detail::alpha_channel<1>(x)));
+        F b = to_float32(int32<L>(detail::alpha_channel<2>(x)));
+        r = detail::alpha_unpremultiply(r, fa);
+        g = detail::alpha_unpremultiply(g, fa);
+        b = detail::alpha_unpremultiply(b, fa);
+        U p = shift_l<detail::alpha_byte<0>::shift>(U(to_int32(r)));
+        p = bit_or(p, shift_l<detail::alpha_byte<1>::shift>(U(to_int32(g))));
+        p = bit_or(p, shift_l<detail::alpha_byte<2>::shift>(U(to_int32(b))));
+        // The quotients of zero alpha are not finite
+        p = bit_andnot(p, cmp_eq(a, (U) U::zero()));
+        p = bit_or(p, shift_l<detail::alpha_byte<3>::shift>(a));
+        store_u(dst + 4*i, p);
+    }
+    for (; i < n; ++i) {
+        const uint8_t* s = src + 4*i;
+        uint8_t* d = dst + 4*i;
+        unsigned a = s[3];
+        d[0] = detail::alpha_unpremultiply(s[0], a);
+        d[1] = detail::alpha_unpremultiply(s[1], a);
+        d[2] = detail::alpha_unpremultiply(s[2], a);
+        d[3] = uint8_t(a);
+    }
+}
+
+/** Composites @a n premultiplied RGBA pixels @a src over the premultiplied
+    RGBA pixels @a bg (Porter-Duff over operator). All four channels are
+    computed as
+
+    @code
+    dst = min(src + round(bg * (255 - src.a) / 255), 255)
+    @endcode
+
+    The result does not exceed 255 unless the color of a source pixel exceeds
+    its alpha. @a dst may be the same array as @a src or @a bg.
+*/
+inline void blend_over_rgba(const uint8_t* src, const uint8_t* bg, std::size_t n,
+                            uint8_t* dst)
+{
+    using V = detail::alpha_vector;
+    using V16 = detail::alpha_vector16;
+    using V32 = detail::alpha_vector32;
+    const unsigned L = V32::length;
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V s = load_u(src + 4*i);
+        V b = load_u(bg + 4*i);
+        V16 ia = sub((V16) make_uint(255), detail::alpha_broadcast(s));
+        V16 e, o;
+        detail::alpha_scale(b, ia, e, o);
+        store_u(dst + 4*i, add_sat(s, detail::alpha_join(e, o)));
+    }
+    for (; i < n; ++i) {
+        const uint8_t* s = src + 4*i;
+        const uint8_t* b = bg + 4*i;
+        uint8_t* d = dst + 4*i;
+        unsigned ia = 255 - s[3];
+        for (unsigned j = 0; j < 4; ++j) {
+            unsigned r = s[j] + detail::alpha_div255(b[j] * ia);
+            d[j] = uint8_t(r > 255 ? 255 : r);
+        }
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,143 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_AOS_SOA_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_AOS_SOA_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/load_packed.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/store_packed.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+namespace detail {
+
+template<unsigned K, class T>
+void v_aos_to_soa(const T* src, std::size_t n, T* const* dst)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V v[K];
+        load_packed_u(v, src + i*K);
+        for (unsigned j = 0; j < K; ++j) {
+            store_u(dst[j] + i, v[j]);
+        }
+    }
+    for (; i < n; ++i) {
+        for (unsigned j = 0; j < K; ++j) {
+            dst[j][i] = src[i*K + j];
+        }
+    }
+}
+
+template<unsigned K, class T>
+void v_soa_to_aos(const T* const* src, std::size_t n, T* dst)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V v[K];
+        for (unsigned j = 0; j < K; ++j) {
+            v[j] = load_u(src[j] + i);
+        }
+        store_packed_u(dst + i*K, v);
+    }
+    for (; i < n; ++i) {
+        for (unsigned j = 0; j < K; ++j) {
+            dst[i*K + j] = src[j][i];
+        }
+    }
+}
+
+} // namespace detail
+
+/** Converts an array of @a n structures with @a k fields of type T each to
+    @a k arrays of @a n elements (array of structures to structure of
+    arrays).
+
+    @code
+    dst[j][i] = src[i*k + j]    for i in [0, n) and j in [0, k)
+    @endcode
+
+    The pointers need to be aligned only to the size of T. Structures with 2
+    to 8 fields are converted with load_packed, wider structures are
+    converted one element at a time. T must be an arithmetic type supported
+    by the library.
+*/
+template<class T>
+void aos_to_soa(const T* src, std::size_t n, unsigned k, T* const* dst)
+{
+    switch (k) {
+    case 0: return;
+    case 1: std::memcpy(dst[0], src, n * sizeof(T)); return;
+    case 2: detail::v_aos_to_soa<2>(src, n, dst); return;
+    case 3: detail::v_aos_to_soa<3>(src, n, dst); return;
+    case 4: detail::v_aos_to_soa<4>(src, n, dst); return;
+    case 5: detail::v_aos_to_soa<5>(src, n, dst); return;
+    case 6: detail::v_aos_to_soa<6>(src, n, dst); return;
+    case 7: detail::v_aos_to_soa<7>(src, n, dst); return;
+    case 8: detail::v_aos_to_soa<8>(src, n, dst); return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (unsigned j = 0; j < k; ++j) {
+            dst[j][i] = src[i*k + j];
+        }
+    }
+}
+
+/** Converts @a k arrays of @a n elements of type T to an array of @a n
+    structures with @a k fields each (structure of arrays to array of
+    structures). This is the inverse of aos_to_soa.
+
+    @code
+    dst[i*k + j] = src[j][i]    for i in [0, n) and j in [0, k)
+    @endcode
+*/
+template<class T>
+void soa_to_aos(const T* const* src, std::size_t n, unsigned k, T* dst)
+{
+    switch (k) {
+    case 0: return;
+    case 1: std::memcpy(dst, src[0], n * sizeof(T)); return;
+    case 2: detail::v_soa_to_aos<2>(src, n, dst); return;
+    case 3: detail::v_soa_to_aos<3>(src, n, dst); return;
+    case 4: detail::v_soa_to_aos<4>(src, n, dst); return;
+    case 5: detail::v_soa_to_aos<5>(src, n, dst); return;
+    case 6: detail::v_soa_to_aos<6>(src, n, dst); return;
+    case 7: detail::v_soa_to_aos<7>(src, n, dst); return;
+    case 8: detail::v_soa_to_aos<8>(src, n, dst); return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (unsigned j = 0; j < k; ++j) {
+            dst[i*k + j] = src[j][i];
+        }
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
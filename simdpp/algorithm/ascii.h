@@ -0,0 +1,314 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_ASCII_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_ASCII_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/algorithm/find.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The functions in this file treat the text as a span of bytes, bytes
+    outside the ASCII range are left unchanged and never match. The letters
+    and the whitespace characters are those of the C locale.
+*/
+
+namespace detail {
+
+using ascii_vector = typename fast_vector<uint8_t>::type;
+
+SIMDPP_INL bool ascii_is_space(uint8_t c)
+{
+    return c == ' ' || uint8_t(c - '\t') < 5;
+}
+
+SIMDPP_INL uint8_t ascii_lower(uint8_t c)
+{
+    return uint8_t(c - 'A') < 26 ? c + 0x20 : c;
+}
+
+/*  Returns the mask of the elements within [lo, lo+n). The range is moved to
+    the bottom of the signed range so that a single signed comparison is
+    needed.
+*/
+template<class V> SIMDPP_INL
+typename V::mask_vector_type ascii_in_range(const V& c, uint8_t lo, uint8_t n)
+{
+    using I = int8<V::length>;
+    V bias = make_uint(uint8_t(0x80 - lo));
+    V limit = make_uint(uint8_t(0x80 + n));
+    I t = I(add(c, bias));
+    return cmp_lt(t, I(limit));
+}
+
+// Switches the case of the letters within [lo, lo+26)
+template<class V> SIMDPP_INL
+V ascii_flip_case(const V& c, uint8_t lo)
+{
+    V k = make_uint(0x20);
+    V m = V(ascii_in_range(c, lo, 26));
+    return bit_xor(c, bit_and(m, k));
+}
+
+template<class V> SIMDPP_INL
+typename V::mask_vector_type ascii_space_mask(const V& c)
+{
+    V space = make_uint(' ');
+    return bit_or(ascii_in_range(c, '\t', 5), cmp_eq(c, space));
+}
+
+// Finds the first byte that is not whitespace
+template<class V>
+struct ascii_nonspace_op {
+    const uint8_t* p;
+
+    ascii_nonspace_op(const uint8_t* ptr) : p(ptr) {}
+
+    template<bool A> SIMDPP_INL
+    typename V::mask_vector_type mask(std::size_t i) const
+    {
+        V x = find_load<A>::template run<V>(p + i);
+        return cmp_eq(V(ascii_space_mask(x)), V::zero());
+    }
+
+    SIMDPP_INL bool test(std::size_t i) const { return !ascii_is_space(p[i]); }
+    SIMDPP_INL std::size_t aligned_offset() const { return find_aligned_offset<V>(p); }
+};
+
+// Finds the first position at which the lowercase bytes differ
+template<class V>
+struct ascii_casecmp_op {
+    const uint8_t* a;
+    const uint8_t* b;
+
+    ascii_casecmp_op(const uint8_t* pa, const uint8_t* pb) : a(pa), b(pb) {}
+
+    template<bool A> SIMDPP_INL
+    typename V::mask_vector_type mask(std::size_t i) const
+    {
+        // the bytes are equal ignoring case if they are equal or differ in
+        // bit 5 only and are letters
+        V x = find_load<A>::template run<V>(a + i);
+        V y = load_u(b + i);
+        V k = make_uint(0x20);
+        V d = bit_xor(x, y);
+        V letter = V(ascii_in_range(V(bit_or(x, k)), 'a', 26));
+        V same = bit_or(V(cmp_eq(d, V::zero())), bit_and(V(cmp_eq(d, k)), letter));
+        return cmp_eq(same, V::zero());
+    }
+
+    SIMDPP_INL bool test(std::size_t i) const
+    {
+        return ascii_lower(a[i]) != ascii_lower(b[i]);
+    }
+
+    SIMDPP_INL std::size_t aligned_offset() const { return find_aligned_offset<V>(a); }
+};
+
+/*  Applies ascii_flip_case to each byte. The last partial vector is handled
+    by an unaligned vector that ends at the end of the buffer. The bytes it
+    rechecks are already converted when the conversion is done in place,
+    which does not matter because the conversion is idempotent. Buffers
+    shorter than one vector can't hold such a vector and are converted one
+    byte at a time.
+*/
+inline void ascii_convert(const char* src, std::size_t n, char* dst, uint8_t lo)
+{
+    using V = ascii_vector;
+    const unsigned L = V::length;
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* d = reinterpret_cast<uint8_t*>(dst);
+
+    if (n < L) {
+        for (std::size_t i = 0; i < n; ++i) {
+            d[i] = uint8_t(s[i] - lo) < 26 ? s[i] ^ 0x20 : s[i];
+        }
+        return;
+    }
+
+    std::size_t i = 0;
+    for (; i + 4*L <= n; i += 4*L) {
+        V x0 = load_u(s + i);
+        V x1 = load_u(s + i + L);
+        V x2 = load_u(s + i + 2*L);
+        V x3 = load_u(s + i + 3*L);
+        store_u(d + i, ascii_flip_case(x0, lo));
+        store_u(d + i + L, ascii_flip_case(x1, lo));
+        store_u(d + i + 2*L, ascii_flip_case(x2, lo));
+        store_u(d + i + 3*L, ascii_flip_case(x3, lo));
+    }
+    for (; i + L <= n; i += L) {
+        V x = load_u(s + i);
+        store_u(d + i, ascii_flip_case(x, lo));
+    }
+    if (i < n) {
+        V x = load_u(s + n - L);
+        store_u(d + n - L, ascii_flip_case(x, lo));
+    }
+}
+
+} // namespace detail
+
+/** Converts the uppercase ASCII letters of [src, src+n) to lowercase and
+    stores the result to [dst, dst+n). The buffers must either be the same or
+    not overlap.
+*/
+inline void ascii_to_lower(const char* src, std::size_t n, char* dst)
+{
+    detail::ascii_convert(src, n, dst, 'A');
+}
+
+/** Converts the lowercase ASCII letters of [src, src+n) to uppercase and
+    stores the result to [dst, dst+n). The buffers must either be the same or
+    not overlap.
+*/
+inline void ascii_to_upper(const char* src, std::size_t n, char* dst)
+{
+    detail::ascii_convert(src, n, dst, 'a');
+}
+
+/** Returns the number of leading whitespace characters (space, \\t, \\n,
+    \\v, \\f and \\r) of [p, p+n). Memory outside the buffer is never
+    accessed.
+*/
+inline std::size_t ascii_trim_left(const char* p, std::size_t n)
+{
+    using V = detail::ascii_vector;
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+    return detail::v_find_first<V>(n, detail::ascii_nonspace_op<V>(b));
+}
+
+/** Returns the length of [p, p+n) without the trailing whitespace
+    characters. See ascii_trim_left for the whitespace characters. The buffer
+    is scanned backwards one vector at a time, the remaining bytes at the
+    start of the buffer, fewer than one vector, are checked one at a time.
+    Memory outside the buffer is never accessed.
+*/
+inline std::size_t ascii_trim_right(const char* p, std::size_t n)
+{
+    using V = detail::ascii_vector;
+    const unsigned L = V::length;
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+
+    for (; n >= L; n -= L) {
+        V x = load_u(b + n - L);
+        uint64_t m = detail::mask_bits(cmp_eq(V(detail::ascii_space_mask(x)), V::zero()));
+        if (m != 0) {
+            return n - L + detail::msb64(m) + 1;
+        }
+    }
+    while (n > 0 && detail::ascii_is_space(b[n - 1])) {
+        n--;
+    }
+    return n;
+}
+
+/** Returns the length of the null-terminated string @a s.
+
+    The string is read with aligned vector loads, which may read up to one
+    vector before the start and after the terminator of the string. An
+    aligned vector never crosses a page boundary, thus this can't fault, but
+    it is reported by memory checkers such as AddressSanitizer.
+*/
+inline std::size_t ascii_strlen(const char* s)
+{
+    using V = detail::ascii_vector;
+    const unsigned L = V::length;
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(s);
+    const unsigned off = addr % L;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(addr - off);
+
+    V x = load(p);
+    uint64_t m = detail::mask_bits(cmp_eq(x, V::zero())) >> off;
+    if (m != 0) {
+        return detail::ctz64(m);
+    }
+    p += L;
+
+    // continue one vector at a time up to a boundary of four vectors, which
+    // also never crosses a page boundary
+    while (reinterpret_cast<uintptr_t>(p) % (4*L) != 0) {
+        x = load(p);
+        m = detail::mask_bits(cmp_eq(x, V::zero()));
+        if (m != 0) {
+            return p - reinterpret_cast<const uint8_t*>(s) + detail::ctz64(m);
+        }
+        p += L;
+    }
+    for (;; p += 4*L) {
+        V x0 = load(p);
+        V x1 = load(p + L);
+        V x2 = load(p + 2*L);
+        V x3 = load(p + 3*L);
+        V z = V::zero();
+        typename V::mask_vector_type m0, m1, m2, m3;
+        m0 = cmp_eq(x0, z);
+        m1 = cmp_eq(x1, z);
+        m2 = cmp_eq(x2, z);
+        m3 = cmp_eq(x3, z);
+        if (detail::mask_bits(bit_or(bit_or(m0, m1), bit_or(m2, m3))) != 0) {
+            std::size_t i = p - reinterpret_cast<const uint8_t*>(s);
+            m = detail::mask_bits(m0);
+            if (m != 0) return i + detail::ctz64(m);
+            m = detail::mask_bits(m1);
+            if (m != 0) return i + L + detail::ctz64(m);
+            m = detail::mask_bits(m2);
+            if (m != 0) return i + 2*L + detail::ctz64(m);
+            m = detail::mask_bits(m3);
+            return i + 3*L + detail::ctz64(m);
+        }
+    }
+}
+
+/** Compares [a, a+na) and [b, b+nb) lexicographically, ignoring the case of
+    ASCII letters. Returns a negative value, zero or a positive value if the
+    first span is less than, equal to or greater than the second. The bytes
+    are compared as unsigned values after converting them to lowercase, as
+    strncasecmp does, but null bytes don't end the comparison. Memory outside
+    the buffers is never accessed.
+*/
+inline int ascii_casecmp(const char* a, std::size_t na, const char* b, std::size_t nb)
+{
+    using V = detail::ascii_vector;
+    const uint8_t* pa = reinterpret_cast<const uint8_t*>(a);
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(b);
+    std::size_t n = na < nb ? na : nb;
+    std::size_t i = detail::v_find_first<V>(n, detail::ascii_casecmp_op<V>(pa, pb));
+    if (i < n) {
+        return int(detail::ascii_lower(pa[i])) - int(detail::ascii_lower(pb[i]));
+    }
+    return na < nb ? -1 : (na > nb ? 1 : 0);
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,527 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_AUDIO_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_AUDIO_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/transpose.h>
+#include <simdpp/detail/madd.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  All filters process float32 samples and keep their state between the
+    calls of process(), thus a stream may be split into blocks of any size.
+    The buffers are allocated by the constructors, process() never allocates.
+    The input and the output of the filters may be the same array.
+
+    The results depend on the architecture within the rounding error, because
+    fmadd is used only where it is supported.
+*/
+
+namespace detail {
+
+using audio_vector = typename fast_vector<float>::type;
+using audio_buffer = std::vector<float, aligned_allocator<float, sizeof(audio_vector)>>;
+
+// The number of input samples that the filters copy to their buffers at once
+static const std::size_t audio_chunk = 1024;
+
+// Sums the elements of a down to four elements
+SIMDPP_INL float32<4> audio_fold4(const float32<4>& a)
+{
+    return a;
+}
+
+template<unsigned N> SIMDPP_INL
+float32<4> audio_fold4(const float32<N>& a)
+{
+    float32<N/2> l, h;
+    split(a, l, h);
+    return audio_fold4(float32<N/2>(add(l, h)));
+}
+
+// Returns the sums of the elements of a0, a1, a2 and a3
+SIMDPP_INL float32<4> audio_sum4(float32<4> a0, float32<4> a1,
+                                 float32<4> a2, float32<4> a3)
+{
+    transpose4(a0, a1, a2, a3);
+    return add(add(a0, a1), add(a2, a3));
+}
+
+SIMDPP_INL float audio_sum(const float32<4>& a)
+{
+    SIMDPP_ALIGN(16) float t[4];
+    store(t, a);
+    return (t[0] + t[1]) + (t[2] + t[3]);
+}
+
+// The modified Bessel function of the first kind of order zero
+inline double audio_bessel_i0(double x)
+{
+    double s = 1, t = 1;
+    for (unsigned k = 1; k < 64; ++k) {
+        t *= (x / (2*k)) * (x / (2*k));
+        s += t;
+        if (t < s * 1e-17) {
+            break;
+        }
+    }
+    return s;
+}
+
+inline unsigned audio_gcd(unsigned a, unsigned b)
+{
+    while (b != 0) {
+        unsigned t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+} // namespace detail
+
+/** A finite impulse response filter:
+
+    @code
+    y[i] = taps[0] * x[i] + taps[1] * x[i-1] + ... + taps[n-1] * x[i-n+1]
+    @endcode
+
+    The samples before the first one are zero. The filter is vectorized
+    across the outputs. Each tap is stored broadcast to a whole vector, so
+    that the inner loop over the taps needs a single aligned load of the
+    coefficient for each four vectors of outputs.
+*/
+class fir_filter {
+public:
+    /// Creates a filter with @a n taps. @a n must be at least one.
+    fir_filter(const float* taps, std::size_t n) :
+        ntaps_(n),
+        coefs_(n * L),
+        buf_(n - 1 + detail::audio_chunk)
+    {
+        // The taps are reversed so that tap j applies to the sample at i + j
+        for (std::size_t j = 0; j < n; ++j) {
+            for (unsigned l = 0; l < L; ++l) {
+                coefs_[j*L + l] = taps[n - 1 - j];
+            }
+        }
+    }
+
+    std::size_t size() const { return ntaps_; }
+
+    /// Sets the past samples to zero
+    void reset()
+    {
+        std::memset(buf_.data(), 0, (ntaps_ - 1) * sizeof(float));
+    }
+
+    /// Filters the next @a n samples of the stream
+    void process(const float* in, std::size_t n, float* out)
+    {
+        std::size_t h = ntaps_ - 1;
+        while (n > 0) {
+            std::size_t m = n < detail::audio_chunk ? n : detail::audio_chunk;
+            std::memcpy(buf_.data() + h, in, m * sizeof(float));
+            filter(out, m);
+            std::memmove(buf_.data(), buf_.data() + m, h * sizeof(float));
+            in += m;
+            out += m;
+            n -= m;
+        }
+    }
+
+private:
+    using V = detail::audio_vector;
+    static const unsigned L = V::length;
+
+    void filter(float* d, std::size_t m) const
+    {
+        using detail::madd;
+        const float* b = buf_.data();
+        const float* k = coefs_.data();
+        std::size_t t = ntaps_;
+
+        std::size_t i = 0;
+        for (; i + 4*L <= m; i += 4*L) {
+            V a0 = V::zero(), a1 = V::zero(), a2 = V::zero(), a3 = V::zero();
+            for (std::size_t j = 0; j < t; ++j) {
+                V kv = load(k + j*L);
+                const float* s = b + i + j;
+                a0 = madd(V(load_u(s)), kv, a0);
+                a1 = madd(V(load_u(s + L)), kv, a1);
+                a2 = madd(V(load_u(s + 2*L)), kv, a2);
+                a3 = madd(V(load_u(s + 3*L)), kv, a3);
+            }
+            store_u(d + i, a0);
+            store_u(d + i + L, a1);
+            store_u(d + i + 2*L, a2);
+            store_u(d + i + 3*L, a3);
+        }
+        for (; i + L <= m; i += L) {
+            V a = V::zero();
+            for (std::size_t j = 0; j < t; ++j) {
+                a = madd(V(load_u(b + i + j)), V(load(k + j*L)), a);
+            }
+            store_u(d + i, a);
+        }
+        for (; i < m; ++i) {
+            float s = 0;
+            for (std::size_t j = 0; j < t; ++j) {
+                s += k[j*L] * b[i + j];
+            }
+            d[i] = s;
+        }
+    }
+
+    std::size_t ntaps_;
+    detail::audio_buffer coefs_;
+    // The last ntaps_ - 1 samples followed by the current chunk
+    detail::audio_buffer buf_;
+};
+
+/// The coefficients of a biquad section, a0 is normalized to one
+struct biquad_coefs {
+    float b0, b1, b2, a1, a2;
+};
+
+/** A cascade of biquad sections applied to each channel of an interleaved
+    multichannel stream:
+
+    @code
+    y[i] = b0 * x[i] + b1 * x[i-1] + b2 * x[i-2] - a1 * y[i-1] - a2 * y[i-2]
+    @endcode
+
+    The sections are computed in the transposed direct form II. The filter
+    is vectorized across the channels, each channel may have its own
+    coefficients. The sections are initially pass-through.
+*/
+class biquad_cascade {
+public:
+    biquad_cascade(unsigned channels, unsigned sections) :
+        channels_(channels),
+        sections_(sections),
+        groups_((channels + L - 1) / L),
+        coefs_(std::size_t(groups_) * sections * 5 * L),
+        state_(std::size_t(groups_) * sections * 2 * L)
+    {
+        biquad_coefs pass = { 1, 0, 0, 0, 0 };
+        for (unsigned s = 0; s < sections; ++s) {
+            set_section(s, pass);
+        }
+    }
+
+    unsigned channels() const { return channels_; }
+    unsigned sections() const { return sections_; }
+
+    /// Sets the coefficients of the section @a s of all channels
+    void set_section(unsigned s, const biquad_coefs& c)
+    {
+        for (unsigned ch = 0; ch < channels_; ++ch) {
+            set_section(s, ch, c);
+        }
+    }
+
+    /// Sets the coefficients of the section @a s of the channel @a ch
+    void set_section(unsigned s, unsigned ch, const biquad_coefs& c)
+    {
+        float* p = coefs_.data() + (std::size_t(ch / L) * sections_ + s) * 5 * L + ch % L;
+        // The feedback coefficients are stored negated so that all terms are added
+        p[0] = c.b0;
+        p[L] = c.b1;
+        p[2*L] = c.b2;
+        p[3*L] = -c.a1;
+        p[4*L] = -c.a2;
+    }
+
+    /// Sets the state of all sections to zero
+    void reset()
+    {
+        std::memset(state_.data(), 0, state_.size() * sizeof(float));
+    }
+
+    /** Filters the next @a frames frames of the stream. Each frame consists
+        of channels() samples.
+    */
+    void process(const float* in, std::size_t frames, float* out)
+    {
+        if (sections_ == 0) {
+            if (in != out) {
+                std::memcpy(out, in, frames * channels_ * sizeof(float));
+            }
+            return;
+        }
+        for (unsigned g = 0; g < groups_; ++g) {
+            // The sections are applied in passes of up to 4 so that the
+            // state of each pass stays in registers
+            const float* src = in;
+            for (unsigned s = 0; s < sections_; s += 4) {
+                unsigned n = sections_ - s < 4 ? sections_ - s : 4;
+                switch (n) {
+                case 1: run<1>(g, s, src, frames, out); break;
+                case 2: run<2>(g, s, src, frames, out); break;
+                case 3: run<3>(g, s, src, frames, out); break;
+                default: run<4>(g, s, src, frames, out); break;
+                }
+                src = out;
+            }
+        }
+    }
+
+private:
+    using V = detail::audio_vector;
+    static const unsigned L = V::length;
+
+    // Applies the sections [s0, s0 + S) to the channel group g
+    template<unsigned S>
+    void run(unsigned g, unsigned s0, const float* in, std::size_t frames, float* out)
+    {
+        using detail::madd;
+        const float* c = coefs_.data() + (std::size_t(g) * sections_ + s0) * 5 * L;
+        float* st = state_.data() + (std::size_t(g) * sections_ + s0) * 2 * L;
+        std::size_t ch = std::size_t(g) * L;
+        unsigned w = channels_ - ch < L ? unsigned(channels_ - ch) : L;
+
+        V z1[S], z2[S];
+        for (unsigned s = 0; s < S; ++s) {
+            z1[s] = load(st + 2*s*L);
+            z2[s] = load(st + (2*s + 1)*L);
+        }
+        SIMDPP_ALIGN(64) float t[L] = {};
+
+        for (std::size_t f = 0; f < frames; ++f) {
+            const float* p = in + f * channels_ + ch;
+            float* q = out + f * channels_ + ch;
+            V x;
+            if (w == L) {
+                x = load_u(p);
+            } else {
+                // The last group of channels is partial
+                std::memcpy(t, p, w * sizeof(float));
+                x = load(t);
+            }
+            for (unsigned s = 0; s < S; ++s) {
+                const float* k = c + 5*s*L;
+                V y = madd(V(load(k)), x, z1[s]);
+                z1[s] = madd(V(load(k + 3*L)), y, V(madd(V(load(k + L)), x, z2[s])));
+                z2[s] = madd(V(load(k + 4*L)), y, V(mul(V(load(k + 2*L)), x)));
+                x = y;
+            }
+            if (w == L) {
+                store_u(q, x);
+            } else {
+                store(t, x);
+                std::memcpy(q, t, w * sizeof(float));
+            }
+        }
+
+        for (unsigned s = 0; s < S; ++s) {
+            store(st + 2*s*L, z1[s]);
+            store(st + (2*s + 1)*L, z2[s]);
+        }
+    }
+
+    unsigned channels_;
+    unsigned sections_;
+    unsigned groups_;
+    // For each group of L channels and each section: b0, b1, b2, -a1, -a2
+    detail::audio_buffer coefs_;
+    // For each group of L channels and each section: z1, z2
+    detail::audio_buffer state_;
+};
+
+/** A polyphase resampler that changes the sample rate by the rational factor
+    @a up / @a down, e.g. 160 / 147 from 44.1 kHz to 48 kHz.
+
+    The prototype lowpass filter is a Kaiser-windowed sinc with
+    @a taps_per_phase taps per output sample and the cutoff at 90% of the
+    Nyquist frequency of the lower of the two rates. Its gain is normalized
+    so that the gain at zero frequency is one. The output is delayed by
+    delay() input samples.
+
+    Each output is the dot product of the coefficients of its phase and the
+    input samples. The dot products are vectorized across the taps, four
+    outputs are reduced at once with a transpose.
+*/
+class resampler {
+public:
+    resampler(unsigned up, unsigned down, unsigned taps_per_phase = 32) :
+        up_(up / detail::audio_gcd(up, down)),
+        down_(down / detail::audio_gcd(up, down)),
+        taps_((taps_per_phase + L - 1) / L * L),
+        coefs_(std::size_t(up_) * taps_),
+        buf_(taps_ - 1 + detail::audio_chunk),
+        delay_(0)
+    {
+        design(taps_per_phase);
+        reset();
+    }
+
+    unsigned up() const { return up_; }
+    unsigned down() const { return down_; }
+
+    /// Returns the delay of the output relative to the input, in input samples
+    double delay() const { return delay_; }
+
+    /// Sets the past samples to zero and restarts the phase
+    void reset()
+    {
+        std::memset(buf_.data(), 0, (taps_ - 1) * sizeof(float));
+        pos_ = taps_ - 1;
+        phase_ = 0;
+    }
+
+    /// Returns the number of samples that process() will output for @a n inputs
+    std::size_t output_size(std::size_t n) const
+    {
+        std::size_t len = taps_ - 1 + n;
+        if (pos_ >= len) {
+            return 0;
+        }
+        return ((len - pos_) * up_ - phase_ + down_ - 1) / down_;
+    }
+
+    /** Resamples the next @a n samples of the stream. Returns the number of
+        output samples, which is output_size(n). @a out must not overlap
+        @a in.
+    */
+    std::size_t process(const float* in, std::size_t n, float* out)
+    {
+        std::size_t h = taps_ - 1;
+        float* out0 = out;
+        while (n > 0) {
+            std::size_t m = n < detail::audio_chunk ? n : detail::audio_chunk;
+            std::memcpy(buf_.data() + h, in, m * sizeof(float));
+            out = filter(out, h + m);
+            std::memmove(buf_.data(), buf_.data() + m, h * sizeof(float));
+            pos_ -= m;
+            in += m;
+            n -= m;
+        }
+        return out - out0;
+    }
+
+private:
+    using V = detail::audio_vector;
+    static const unsigned L = V::length;
+
+    void design(unsigned k0)
+    {
+        const double pi = 3.14159265358979323846;
+        const double beta = 8.0;
+        std::size_t m = std::size_t(up_) * k0;
+        unsigned r = up_ > down_ ? up_ : down_;
+        double fc = 0.9 * 0.5 / r;
+        double c = (m - 1) / 2.0;
+        double i0 = detail::audio_bessel_i0(beta);
+        std::vector<double> h(m);
+        double sum = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+            double x = i - c;
+            double sinc = x == 0 ? 2 * fc : std::sin(2 * pi * fc * x) / (pi * x);
+            double u = x / (c + 1);
+            double w = detail::audio_bessel_i0(beta * std::sqrt(1 - u * u)) / i0;
+            h[i] = sinc * w;
+            sum += h[i];
+        }
+        // Tap j of a phase applies to the sample at pos - taps_ + 1 + j
+        for (unsigned p = 0; p < up_; ++p) {
+            for (unsigned j = 0; j < taps_; ++j) {
+                unsigned k = taps_ - 1 - j;
+                coefs_[p * taps_ + j] = k < k0 ? float(h[p + k * up_] * up_ / sum) : 0.0f;
+            }
+        }
+        delay_ = c / up_;
+    }
+
+    SIMDPP_INL float32<4> dot(std::size_t pos, unsigned phase) const
+    {
+        using detail::madd;
+        const float* b = buf_.data() + pos - (taps_ - 1);
+        const float* k = coefs_.data() + std::size_t(phase) * taps_;
+        V a = V::zero();
+        for (unsigned j = 0; j < taps_; j += L) {
+            a = madd(V(load_u(b + j)), V(load(k + j)), a);
+        }
+        return detail::audio_fold4(a);
+    }
+
+    // Computes the outputs for the samples in buf_[0, len)
+    float* filter(float* out, std::size_t len)
+    {
+        std::size_t pos[4];
+        unsigned phase[4];
+        for (;;) {
+            pos[0] = pos_;
+            phase[0] = phase_;
+            for (unsigned i = 1; i < 4; ++i) {
+                unsigned p = phase[i-1] + down_;
+                pos[i] = pos[i-1] + p / up_;
+                phase[i] = p % up_;
+            }
+            if (pos[3] >= len) {
+                break;
+            }
+            store_u(out, detail::audio_sum4(dot(pos[0], phase[0]), dot(pos[1], phase[1]),
+                                            dot(pos[2], phase[2]), dot(pos[3], phase[3])));
+            out += 4;
+            unsigned p = phase[3] + down_;
+            pos_ = pos[3] + p / up_;
+            phase_ = p % up_;
+        }
+        while (pos_ < len) {
+            *out++ = detail::audio_sum(dot(pos_, phase_));
+            unsigned p = phase_ + down_;
+            pos_ += p / up_;
+            phase_ = p % up_;
+        }
+        return out;
+    }
+
+    unsigned up_;
+    unsigned down_;
+    // The number of taps per phase, a multiple of the vector length
+    unsigned taps_;
+    // The coefficients of each phase
+    detail::audio_buffer coefs_;
+    // The last taps_ - 1 samples followed by the current chunk
+    detail::audio_buffer buf_;
+    double delay_;
+    // The position of the next output in buf_ and its phase
+    std::size_t pos_;
+    unsigned phase_;
+};
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
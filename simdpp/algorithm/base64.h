@@ -0,0 +1,579 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_BASE64_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_BASE64_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_gt.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_packed2.h>
+#include <simdpp/core/load_packed3.h>
+#include <simdpp/core/load_packed4.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_packed2.h>
+#include <simdpp/core/store_packed3.h>
+#include <simdpp/core/store_packed4.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The alphabets of base64 encoding as defined in RFC 4648
+enum class base64_alphabet {
+    /// A-Z, a-z, 0-9, '+' and '/'
+    standard,
+    /// A-Z, a-z, 0-9, '-' and '_'. Safe for URLs and file names.
+    url
+};
+
+/*  The 3 to 4 byte reshuffle of base64 is done either with permute_bytes16 on
+    groups of 12 bytes and 16 characters in each 128-bit lane, or with
+    load_packed3 and store_packed4 on whole blocks. The former relies on the
+    little-endian layout of 32-bit elements and is much faster where byte
+    permutation is supported natively, thus SSE2 and ALTIVEC use the latter.
+*/
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON
+#define SIMDPP_BASE64_USE_PERMUTE 1
+#else
+#define SIMDPP_BASE64_USE_PERMUTE 0
+#endif
+
+namespace detail {
+
+/*  Encoding alphabets and decoding tables of the scalar code. The decoding
+    tables map the characters outside the alphabet to 0xff.
+*/
+struct base64_tables {
+    char encode[2][64];
+    uint8_t decode[2][256];
+
+    base64_tables()
+    {
+        static const char std_chars[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (unsigned a = 0; a < 2; ++a) {
+            std::memcpy(encode[a], std_chars, 64);
+            std::memset(decode[a], 0xff, 256);
+        }
+        encode[1][62] = '-';
+        encode[1][63] = '_';
+        for (unsigned a = 0; a < 2; ++a) {
+            for (unsigned i = 0; i < 64; ++i) {
+                decode[a][uint8_t(encode[a][i])] = i;
+            }
+        }
+    }
+};
+
+inline const base64_tables& get_base64_tables()
+{
+    static const base64_tables t;
+    return t;
+}
+
+/*  The vector code works on the native byte vectors. load_packed* and
+    store_packed* require aligned memory, thus the blocks they process are
+    copied through aligned buffers.
+*/
+using base64_vector = typename fast_vector<uint8_t>::type;
+
+#if SIMDPP_BASE64_USE_PERMUTE
+/*  Loads 12 bytes into each 128-bit lane: [p, p+12) into the first lane,
+    [p+12, p+24) into the second and so on. 4 bytes past the last group are
+    read.
+*/
+SIMDPP_INL void base64_load_groups(uint8<16>& r, const uint8_t* p)
+{
+    r = load_u(p);
+}
+
+SIMDPP_INL void base64_load_groups(uint8<32>& r, const uint8_t* p)
+{
+    uint8<16> r0, r1;
+    r0 = load_u(p);
+    r1 = load_u(p + 12);
+    r = combine(r0, r1);
+}
+
+/*  Stores the first 12 bytes of each 128-bit lane contiguously. 4 bytes past
+    the last group are overwritten.
+*/
+SIMDPP_INL void base64_store_groups(uint8_t* p, const uint8<16>& a)
+{
+    store_u(p, a);
+}
+
+SIMDPP_INL void base64_store_groups(uint8_t* p, const uint8<32>& a)
+{
+    uint8<16> a0, a1;
+    split(a, a0, a1);
+    store_u(p, a0);
+    store_u(p + 12, a1);
+}
+
+/*  Byte permutations of a 128-bit lane. The encoding one moves each group of
+    3 bytes into a 32-bit element as b0 << 16 | b1 << 8 | b2, the decoding one
+    moves the lower 3 bytes of each 32-bit element to the group of 3 bytes in
+    the reverse order.
+*/
+SIMDPP_ALIGN(32) static const uint8_t base64_encode_permute[32] = {
+    2, 1, 0, 0, 5, 4, 3, 0, 8, 7, 6, 0, 11, 10, 9, 0,
+    2, 1, 0, 0, 5, 4, 3, 0, 8, 7, 6, 0, 11, 10, 9, 0
+};
+SIMDPP_ALIGN(32) static const uint8_t base64_decode_permute[32] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0, 0, 0, 0,
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0, 0, 0, 0
+};
+#endif
+
+// Returns a byte vector with all elements set to @a x
+template<class V> SIMDPP_INL
+V base64_splat(uint8_t x)
+{
+    return (V) make_uint(x);
+}
+
+/*  Selects @a x for the elements set in the mask @a m and zero otherwise. The
+    argument is usually an offset to be added to another vector.
+*/
+template<class V, class M> SIMDPP_INL
+V base64_select(const M& m, uint8_t x)
+{
+    return bit_and(V(m), base64_splat<V>(x));
+}
+
+/*  Returns the mask of the elements within [lo, lo+n). The range is moved to
+    the bottom of the signed range so that a single signed comparison is
+    needed.
+*/
+template<class V> SIMDPP_INL
+typename V::mask_vector_type base64_in_range(const V& c, uint8_t lo, uint8_t n)
+{
+    using I = int8<V::length>;
+    I t = I(add(c, base64_splat<V>(uint8_t(0x80 - lo))));
+    return cmp_lt(t, I(base64_splat<V>(uint8_t(0x80 + n))));
+}
+
+/*  Converts 6-bit values to characters. The offset that maps each value to
+    its character is built from the comparisons with the range boundaries of
+    the alphabet. The values are less than 64, thus signed comparisons are
+    used.
+*/
+template<bool Url, class V> SIMDPP_INL
+V base64_encode_chars(const V& s)
+{
+    using I = int8<V::length>;
+    I si = I(s);
+    V off = base64_splat<V>('A');
+    off = add(off, base64_select<V>(cmp_gt(si, I(base64_splat<V>(25))), 'a' - 'A' - 26));
+    off = sub(off, base64_select<V>(cmp_gt(si, I(base64_splat<V>(51))), 'a' - '0' + 26));
+    off = add(off, base64_select<V>(cmp_eq(s, base64_splat<V>(62)),
+                                    uint8_t((Url ? '-' : '+') - '0' - 10)));
+    off = add(off, base64_select<V>(cmp_eq(s, base64_splat<V>(63)),
+                                    uint8_t((Url ? '_' : '/') - '0' - 11)));
+    return add(s, off);
+}
+
+/*  Converts characters to 6-bit values. Returns false if any character is not
+    in the alphabet.
+*/
+template<bool Url, class V> SIMDPP_INL
+bool base64_decode_chars(V& c)
+{
+    using M = typename V::mask_vector_type;
+    M m_upper = base64_in_range(c, 'A', 26);
+    M m_lower = base64_in_range(c, 'a', 26);
+    M m_digit = base64_in_range(c, '0', 10);
+    M m_62 = cmp_eq(c, base64_splat<V>(Url ? '-' : '+'));
+    M m_63 = cmp_eq(c, base64_splat<V>(Url ? '_' : '/'));
+
+    V valid = bit_or(bit_or(bit_or(V(m_upper), V(m_lower)),
+                            bit_or(V(m_digit), V(m_62))), V(m_63));
+    if (~byte_mask_bits(valid) & ((uint64_t(1) << (V::length - 1) << 1) - 1)) {
+        return false;
+    }
+
+    V off = base64_select<V>(m_upper, uint8_t(-'A'));
+    off = bit_or(off, base64_select<V>(m_lower, uint8_t(26 - 'a')));
+    off = bit_or(off, base64_select<V>(m_digit, uint8_t(52 - '0')));
+    off = bit_or(off, base64_select<V>(m_62, uint8_t(62 - (Url ? '-' : '+'))));
+    off = bit_or(off, base64_select<V>(m_63, uint8_t(63 - (Url ? '_' : '/'))));
+    c = add(c, off);
+    return true;
+}
+
+// Converts 4-bit values to hex digits
+template<class V> SIMDPP_INL
+V hex_encode_chars(const V& n, const V& letter_off)
+{
+    using I = int8<V::length>;
+    V off = base64_splat<V>('0');
+    off = add(off, bit_and(V(cmp_gt(I(n), I(base64_splat<V>(9)))), letter_off));
+    return add(n, off);
+}
+
+/*  Converts hex digits of either case to 4-bit values. Returns false if any
+    character is not a hex digit.
+*/
+template<class V> SIMDPP_INL
+bool hex_decode_chars(V& c)
+{
+    using M = typename V::mask_vector_type;
+    V l = bit_or(c, base64_splat<V>(0x20));
+    M m_digit = base64_in_range(c, '0', 10);
+    M m_letter = base64_in_range(l, 'a', 6);
+    V valid = bit_or(V(m_digit), V(m_letter));
+    if (~byte_mask_bits(valid) & ((uint64_t(1) << (V::length - 1) << 1) - 1)) {
+        return false;
+    }
+    c = bit_or(bit_and(V(m_digit), sub(c, base64_splat<V>('0'))),
+               bit_and(V(m_letter), sub(l, base64_splat<V>('a' - 10))));
+    return true;
+}
+
+/*  Encodes the leading blocks of [p, p+len) and advances @a out past the
+    written characters. Returns the number of the encoded bytes.
+*/
+template<bool Url> SIMDPP_INL
+std::size_t base64_encode_vector(const uint8_t* p, std::size_t len, char*& out)
+{
+    using V = base64_vector;
+    const unsigned L = V::length;
+    std::size_t i = 0;
+#if SIMDPP_BASE64_USE_PERMUTE
+    using U = uint32<L/4>;
+    V perm = load(base64_encode_permute);
+    U mask0 = make_uint(0x3f), mask1 = make_uint(0x3f00);
+    U mask2 = make_uint(0x3f0000), mask3 = make_uint(0x3f000000);
+
+    // each step encodes 3*L/4 bytes into L characters
+    for (; i + 3*L/4 + 4 <= len; i += 3*L/4) {
+        V b;
+        base64_load_groups(b, p + i);
+        U x = U(permute_bytes16(b, perm));
+        U s = bit_or(bit_or(bit_and(shift_r<18>(x), mask0),
+                            bit_and(shift_r<4>(x), mask1)),
+                     bit_or(bit_and(shift_l<10>(x), mask2),
+                            bit_and(shift_l<24>(x), mask3)));
+        store_u(out, base64_encode_chars<Url>(V(s)));
+        out += L;
+    }
+#else
+    SIMDPP_ALIGN(64) uint8_t in_buf[3*L];
+    SIMDPP_ALIGN(64) uint8_t out_buf[4*L];
+    V mask6 = base64_splat<V>(0x3f);
+
+    for (; i + 3*L <= len; i += 3*L) {
+        V a, b, c;
+        std::memcpy(in_buf, p + i, 3*L);
+        load_packed3(a, b, c, in_buf);
+
+        V s0 = shift_r<2>(a);
+        V s1 = bit_and(bit_or(shift_l<4>(a), shift_r<4>(b)), mask6);
+        V s2 = bit_and(bit_or(shift_l<2>(b), shift_r<6>(c)), mask6);
+        V s3 = bit_and(c, mask6);
+
+        store_packed4(out_buf, base64_encode_chars<Url>(s0),
+                      base64_encode_chars<Url>(s1),
+                      base64_encode_chars<Url>(s2),
+                      base64_encode_chars<Url>(s3));
+        std::memcpy(out, out_buf, 4*L);
+        out += 4*L;
+    }
+#endif
+    return i;
+}
+
+/*  Decodes the leading blocks of [p, p+len) and advances @a out past the
+    written bytes. Blocks containing padding or invalid characters are left
+    to the scalar code. Returns the number of the decoded characters.
+*/
+template<bool Url> SIMDPP_INL
+std::size_t base64_decode_vector(const uint8_t* p, std::size_t len, uint8_t*& out)
+{
+    using V = base64_vector;
+    const unsigned L = V::length;
+    std::size_t i = 0;
+#if SIMDPP_BASE64_USE_PERMUTE
+    using U = uint32<L/4>;
+    V perm = load(base64_decode_permute);
+    U mask0 = make_uint(0x3f), mask1 = make_uint(0x3f00);
+    U mask2 = make_uint(0xfc0);
+
+    // each step decodes L characters into 3*L/4 bytes. The stores overwrite
+    // 4 bytes past the decoded ones, thus the last 8 characters, which are
+    // decoded to at least 4 bytes, are left to the scalar code.
+    for (; i + L + 8 <= len; i += L) {
+        V c = load_u(p + i);
+        if (!base64_decode_chars<Url>(c)) {
+            break;
+        }
+        U x = U(c);
+        U x0 = bit_and(x, mask0), x1 = bit_and(x, mask1);
+        U v = bit_or(bit_or(shift_l<18>(x0), shift_l<4>(x1)),
+                     bit_or(bit_and(shift_r<10>(x), mask2), shift_r<24>(x)));
+        base64_store_groups(out, permute_bytes16(V(v), perm));
+        out += 3*L/4;
+    }
+#else
+    SIMDPP_ALIGN(64) uint8_t in_buf[4*L];
+    SIMDPP_ALIGN(64) uint8_t out_buf[3*L];
+
+    for (; i + 4*L <= len; i += 4*L) {
+        V s0, s1, s2, s3;
+        std::memcpy(in_buf, p + i, 4*L);
+        load_packed4(s0, s1, s2, s3, in_buf);
+        if (!base64_decode_chars<Url>(s0) || !base64_decode_chars<Url>(s1) ||
+            !base64_decode_chars<Url>(s2) || !base64_decode_chars<Url>(s3)) {
+            break;
+        }
+        store_packed3(out_buf, bit_or(shift_l<2>(s0), shift_r<4>(s1)),
+                      bit_or(shift_l<4>(s1), shift_r<2>(s2)),
+                      bit_or(shift_l<6>(s2), s3));
+        std::memcpy(out, out_buf, 3*L);
+        out += 3*L;
+    }
+#endif
+    return i;
+}
+
+} // namespace detail
+
+/** Returns the number of characters base64_encode writes when encoding
+    @a len bytes.
+*/
+inline std::size_t base64_encoded_size(std::size_t len, bool pad = true)
+{
+    return pad ? (len + 2) / 3 * 4 : len / 3 * 4 + (len % 3 * 4 + 2) / 3;
+}
+
+/** Returns the maximum number of bytes base64_decode may write when decoding
+    @a len characters.
+*/
+inline std::size_t base64_decoded_max_size(std::size_t len)
+{
+    return len / 4 * 3 + len % 4 * 3 / 4;
+}
+
+/** Encodes the buffer [src, src+len) in base64 as defined in RFC 4648. Each
+    group of three bytes is encoded as four characters. If @a pad is true, the
+    last group is padded with '=' to four characters, otherwise the padding is
+    omitted.
+
+    The output buffer must be at least base64_encoded_size(len, pad)
+    characters long. No null terminator is written. Returns the pointer past
+    the last written character.
+*/
+inline char* base64_encode(const void* src, std::size_t len, char* out,
+                           base64_alphabet alphabet = base64_alphabet::standard,
+                           bool pad = true)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(src);
+    bool url = alphabet == base64_alphabet::url;
+    std::size_t i = url ? detail::base64_encode_vector<true>(p, len, out)
+                        : detail::base64_encode_vector<false>(p, len, out);
+
+    const char* e = detail::get_base64_tables().encode[url];
+    for (; i + 3 <= len; i += 3) {
+        uint32_t x = uint32_t(p[i]) << 16 | uint32_t(p[i+1]) << 8 | p[i+2];
+        *out++ = e[x >> 18];
+        *out++ = e[(x >> 12) & 0x3f];
+        *out++ = e[(x >> 6) & 0x3f];
+        *out++ = e[x & 0x3f];
+    }
+    if (i < len) {
+        uint32_t x = uint32_t(p[i]) << 16;
+        if (i + 1 < len) {
+            x |= uint32_t(p[i+1]) << 8;
+        }
+        *out++ = e[x >> 18];
+        *out++ = e[(x >> 12) & 0x3f];
+        if (i + 1 < len) {
+            *out++ = e[(x >> 6) & 0x3f];
+        } else if (pad) {
+            *out++ = '=';
+        }
+        if (pad) {
+            *out++ = '=';
+        }
+    }
+    return out;
+}
+
+/** Decodes base64 characters [in, in+len) as defined in RFC 4648. The input
+    may be either padded to a multiple of four characters with '=' or not
+    padded at all. The decoding is strict: characters outside the alphabet,
+    including whitespace, misplaced padding and nonzero unused bits in the
+    last group are rejected.
+
+    The output buffer must be at least base64_decoded_max_size(len) bytes
+    long. Returns the pointer past the last written byte, or nullptr if the
+    input is malformed.
+*/
+inline uint8_t* base64_decode(const char* in, std::size_t len, uint8_t* out,
+                              base64_alphabet alphabet = base64_alphabet::standard)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    bool url = alphabet == base64_alphabet::url;
+    std::size_t i = url ? detail::base64_decode_vector<true>(p, len, out)
+                        : detail::base64_decode_vector<false>(p, len, out);
+
+    const uint8_t* d = detail::get_base64_tables().decode[url];
+    // invalid characters decode to 0xff, which the valid 6-bit values never
+    // have in the high bit
+    for (; i + 4 < len; i += 4) {
+        uint8_t c0 = d[p[i]], c1 = d[p[i+1]], c2 = d[p[i+2]], c3 = d[p[i+3]];
+        if ((c0 | c1 | c2 | c3) & 0x80) {
+            return nullptr;
+        }
+        uint32_t x = uint32_t(c0) << 18 | uint32_t(c1) << 12 |
+                     uint32_t(c2) << 6 | c3;
+        *out++ = uint8_t(x >> 16);
+        *out++ = uint8_t(x >> 8);
+        *out++ = uint8_t(x);
+    }
+
+    // the last group of 1 to 4 characters, possibly padded
+    std::size_t rem = len - i;
+    if (rem == 4 && p[i+3] == '=') {
+        rem = p[i+2] == '=' ? 2 : 3;
+    }
+    if (rem == 1) {
+        return nullptr;
+    }
+    uint32_t x = 0;
+    for (std::size_t k = 0; k < rem; ++k) {
+        uint8_t c = d[p[i+k]];
+        if (c & 0x80) {
+            return nullptr;
+        }
+        x |= uint32_t(c) << (18 - 6*k);
+    }
+    // unused bits of the last character must be zero
+    if ((rem == 2 && (x & 0xffff)) || (rem == 3 && (x & 0xff))) {
+        return nullptr;
+    }
+    for (std::size_t k = 1; k < rem; ++k) {
+        *out++ = uint8_t(x >> (24 - 8*k));
+    }
+    return out;
+}
+
+/** Encodes the buffer [src, src+len) as hex digits (base16), two characters
+    per byte, the most significant half first. If @a upper is true, the
+    uppercase letters are used.
+
+    The output buffer must be at least 2*len characters long. No null
+    terminator is written. Returns the pointer past the last written
+    character.
+*/
+inline char* hex_encode(const void* src, std::size_t len, char* out,
+                        bool upper = false)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(src);
+    std::size_t i = 0;
+
+    using V = detail::base64_vector;
+    const unsigned L = V::length;
+    SIMDPP_ALIGN(64) uint8_t out_buf[2*L];
+    V mask4 = detail::base64_splat<V>(0x0f);
+    V letter_off = detail::base64_splat<V>((upper ? 'A' : 'a') - '0' - 10);
+
+    for (; i + L <= len; i += L) {
+        V b = load_u(p + i);
+        V hi = detail::hex_encode_chars(V(shift_r<4>(b)), letter_off);
+        V lo = detail::hex_encode_chars(V(bit_and(b, mask4)), letter_off);
+        store_packed2(out_buf, hi, lo);
+        std::memcpy(out, out_buf, 2*L);
+        out += 2*L;
+    }
+
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    for (; i < len; ++i) {
+        *out++ = digits[p[i] >> 4];
+        *out++ = digits[p[i] & 0xf];
+    }
+    return out;
+}
+
+/** Decodes hex digits [in, in+len) of either case (base16). Returns the
+    pointer past the last written byte, or nullptr if @a len is odd or any
+    character is not a hex digit. The output buffer must be at least len/2
+    bytes long.
+*/
+inline uint8_t* hex_decode(const char* in, std::size_t len, uint8_t* out)
+{
+    if (len % 2 != 0) {
+        return nullptr;
+    }
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    std::size_t i = 0;
+
+    using V = detail::base64_vector;
+    const unsigned L = V::length;
+    SIMDPP_ALIGN(64) uint8_t in_buf[2*L];
+
+    for (; i + 2*L <= len; i += 2*L) {
+        V hi, lo;
+        std::memcpy(in_buf, p + i, 2*L);
+        load_packed2(hi, lo, in_buf);
+        if (!detail::hex_decode_chars(hi) || !detail::hex_decode_chars(lo)) {
+            return nullptr;
+        }
+        store_u(out, bit_or(shift_l<4>(hi), lo));
+        out += L;
+    }
+
+    for (; i < len; i += 2) {
+        unsigned v[2];
+        for (unsigned k = 0; k < 2; ++k) {
+            unsigned c = p[i+k];
+            if (c - '0' < 10) {
+                v[k] = c - '0';
+            } else if ((c | 0x20) - 'a' < 6) {
+                v[k] = (c | 0x20) - 'a' + 10;
+            } else {
+                return nullptr;
+            }
+        }
+        *out++ = uint8_t(v[0] << 4 | v[1]);
+    }
+    return out;
+}
+
+#undef SIMDPP_BASE64_USE_PERMUTE
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,467 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_CHECKSUM_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_CHECKSUM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_mull.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/to_int16.h>
+#include <simdpp/core/to_int32.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The vectorized Adler-32 and Fletcher-32 paths read the input as
+    little-endian words, thus ALTIVEC uses the scalar code. Both produce
+    identical results.
+*/
+#if SIMDPP_USE_ALTIVEC
+#define SIMDPP_CHECKSUM_USE_VECTOR 0
+#else
+#define SIMDPP_CHECKSUM_USE_VECTOR 1
+#endif
+
+namespace detail {
+
+// CRC-32C (Castagnoli) polynomial, bit-reflected
+const uint32_t crc32c_poly = 0x82f63b78;
+
+/*  The lengths of the blocks that are processed as three interleaved streams
+    by the CRC32 instruction.
+*/
+const std::size_t crc32c_long_block = 4096;
+const std::size_t crc32c_short_block = 256;
+
+const uint32_t adler32_mod = 65521;
+// The largest n such that 255n(n+1)/2 + (n+1)(mod-1) fits into 32 bits
+const std::size_t adler32_nmax = 5552;
+const uint32_t fletcher32_mod = 65535;
+// The number of words after which the 32-bit scalar sums must be reduced
+const std::size_t fletcher32_nmax = 359;
+// The number of 8-word vector chunks after which the vector sums are reduced
+const std::size_t fletcher32_vector_nmax = 256;
+
+inline uint32_t checksum_read32(const uint8_t* p)
+{
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+           uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+/*  Multiplies two polynomials modulo the CRC-32C polynomial. Both arguments
+    and the result are bit-reflected, i.e. bit 31 corresponds to x^0.
+*/
+inline uint32_t crc32c_multmodp(uint32_t a, uint32_t b)
+{
+    uint32_t m = uint32_t(1) << 31;
+    uint32_t p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ crc32c_poly : b >> 1;
+    }
+    return p;
+}
+
+// Returns x^n modulo the CRC-32C polynomial, bit-reflected
+inline uint32_t crc32c_xpow(uint64_t n)
+{
+    uint32_t r = uint32_t(1) << 31;
+    uint32_t b = uint32_t(1) << 30;
+    while (n) {
+        if (n & 1) {
+            r = crc32c_multmodp(r, b);
+        }
+        b = crc32c_multmodp(b, b);
+        n >>= 1;
+    }
+    return r;
+}
+
+/*  Slicing-by-8 tables. table[0] is the classic byte-wise table, table[k]
+    advances a CRC over k additional zero bytes.
+*/
+struct crc32c_tables {
+    uint32_t table[8][256];
+
+    crc32c_tables()
+    {
+        for (unsigned i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (unsigned k = 0; k < 8; ++k) {
+                c = (c & 1) ? (c >> 1) ^ crc32c_poly : c >> 1;
+            }
+            table[0][i] = c;
+        }
+        for (unsigned k = 1; k < 8; ++k) {
+            for (unsigned i = 0; i < 256; ++i) {
+                uint32_t c = table[k-1][i];
+                table[k][i] = (c >> 8) ^ table[0][c & 0xff];
+            }
+        }
+    }
+};
+
+inline const crc32c_tables& get_crc32c_tables()
+{
+    static const crc32c_tables t;
+    return t;
+}
+
+/*  Computes the CRC of the buffer. @a crc is the raw CRC register, i.e. the
+    pre- and post-inversion is not done.
+*/
+inline uint32_t crc32c_sw(uint32_t crc, const uint8_t* p, std::size_t len)
+{
+    const crc32c_tables& t = get_crc32c_tables();
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t lo = checksum_read32(p) ^ crc;
+        uint32_t hi = checksum_read32(p + 4);
+        crc = t.table[7][lo & 0xff] ^ t.table[6][(lo >> 8) & 0xff] ^
+              t.table[5][(lo >> 16) & 0xff] ^ t.table[4][lo >> 24] ^
+              t.table[3][hi & 0xff] ^ t.table[2][(hi >> 8) & 0xff] ^
+              t.table[1][(hi >> 16) & 0xff] ^ t.table[0][hi >> 24];
+    }
+    for (; len > 0; --len, ++p) {
+        crc = (crc >> 8) ^ t.table[0][(crc ^ *p) & 0xff];
+    }
+    return crc;
+}
+
+#if SIMDPP_USE_SSE4_2
+/*  The constants that shift a CRC over one and two blocks. With PCLMUL they
+    are x^(8*len-33): the carry-less product is one bit short of the register
+    width and the CRC32 instruction that reduces it multiplies by x^32. The
+    scalar code multiplies by x^(8*len) directly.
+*/
+struct crc32c_shift_consts {
+    uint32_t long1, long2, short1, short2;
+
+    crc32c_shift_consts()
+    {
+#if SIMDPP_USE_PCLMUL
+        const unsigned adj = 33;
+#else
+        const unsigned adj = 0;
+#endif
+        long1 = crc32c_xpow(8 * crc32c_long_block - adj);
+        long2 = crc32c_xpow(16 * crc32c_long_block - adj);
+        short1 = crc32c_xpow(8 * crc32c_short_block - adj);
+        short2 = crc32c_xpow(16 * crc32c_short_block - adj);
+    }
+};
+
+inline const crc32c_shift_consts& get_crc32c_shift_consts()
+{
+    static const crc32c_shift_consts t;
+    return t;
+}
+
+SIMDPP_INL uint32_t crc32c_hw_u64(uint32_t crc, uint64_t w)
+{
+#if SIMDPP_64_BITS
+    return uint32_t(_mm_crc32_u64(crc, w));
+#else
+    crc = _mm_crc32_u32(crc, uint32_t(w));
+    return _mm_crc32_u32(crc, uint32_t(w >> 32));
+#endif
+}
+
+SIMDPP_INL uint32_t crc32c_hw_load(uint32_t crc, const uint8_t* p)
+{
+    uint64_t w;
+    std::memcpy(&w, p, 8);
+    return crc32c_hw_u64(crc, w);
+}
+
+inline uint32_t crc32c_hw(uint32_t crc, const uint8_t* p, std::size_t len)
+{
+    for (; len >= 8; len -= 8, p += 8) {
+        crc = crc32c_hw_load(crc, p);
+    }
+    for (; len > 0; --len, ++p) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+
+// Multiplies the CRC by a constant from crc32c_shift_consts
+SIMDPP_INL uint32_t crc32c_shift(uint32_t crc, uint32_t k)
+{
+#if SIMDPP_USE_PCLMUL
+    __m128i r = _mm_clmulepi64_si128(_mm_cvtsi32_si128(crc),
+                                     _mm_cvtsi32_si128(k), 0);
+    uint64_t w;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&w), r);
+    return crc32c_hw_u64(0, w);
+#else
+    return crc32c_multmodp(crc, k);
+#endif
+}
+
+/*  Splits 3*L bytes into three streams which are processed in parallel to
+    hide the latency of the CRC32 instruction. The first stream continues @a
+    crc, the other two start from zero. The partial CRCs are then shifted over
+    the data that follows them and combined.
+*/
+template<std::size_t L> SIMDPP_INL
+uint32_t crc32c_hw_3way(uint32_t crc, const uint8_t* p, uint32_t k1, uint32_t k2)
+{
+    uint32_t c0 = crc, c1 = 0, c2 = 0;
+    for (std::size_t i = 0; i < L; i += 8) {
+        c0 = crc32c_hw_load(c0, p + i);
+        c1 = crc32c_hw_load(c1, p + L + i);
+        c2 = crc32c_hw_load(c2, p + 2*L + i);
+    }
+    return crc32c_shift(c0, k2) ^ crc32c_shift(c1, k1) ^ c2;
+}
+#endif
+
+inline uint32_t adler32_scalar(uint32_t adler, const uint8_t* p, std::size_t len)
+{
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+    while (len > 0) {
+        std::size_t n = len < adler32_nmax ? len : adler32_nmax;
+        len -= n;
+        for (; n > 0; --n) {
+            s1 += *p++;
+            s2 += s1;
+        }
+        s1 %= adler32_mod;
+        s2 %= adler32_mod;
+    }
+    return s2 << 16 | s1;
+}
+
+inline uint32_t fletcher32_scalar(uint32_t sum, const uint8_t* p, std::size_t len)
+{
+    uint32_t s1 = sum & 0xffff;
+    uint32_t s2 = sum >> 16;
+    std::size_t words = len / 2;
+    while (words > 0) {
+        std::size_t n = words < fletcher32_nmax ? words : fletcher32_nmax;
+        words -= n;
+        for (; n > 0; --n, p += 2) {
+            s1 += uint32_t(p[0]) | uint32_t(p[1]) << 8;
+            s2 += s1;
+        }
+        s1 %= fletcher32_mod;
+        s2 %= fletcher32_mod;
+    }
+    if (len & 1) {
+        s1 = (s1 + *p) % fletcher32_mod;
+        s2 = (s2 + s1) % fletcher32_mod;
+    }
+    return s2 << 16 | s1;
+}
+
+#if SIMDPP_CHECKSUM_USE_VECTOR
+template<unsigned N> SIMDPP_INL
+uint64_t checksum_reduce_add(const uint32<N>& a)
+{
+    SIMDPP_ALIGN(64) uint32_t r[N];
+    store(r, a);
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < N; ++i) {
+        sum += r[i];
+    }
+    return sum;
+}
+
+/*  Computes the position-weighted sums of a block of @a chunks chunks of 16
+    bytes. With S1 being the running sum before the chunk, a chunk of bytes
+    b[0..15] updates the sums as follows:
+
+    s2 += 16 * S1 + sum((16 - i) * b[i])
+    s1 += sum(b[i])
+
+    Each lane of ps accumulates the lane sums of all preceding chunks, thus
+    sum(ps) is the sum of S1 - s1_initial over the chunks. The products are
+    computed with mull on 16-bit elements.
+*/
+inline void adler32_vector_block(uint32_t& s1, uint32_t& s2,
+                                 const uint8_t* p, std::size_t chunks)
+{
+    SIMDPP_ALIGN(32) static const uint16_t weights[16] = {
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    };
+    uint16<16> w = load(weights);
+    uint32<16> vs1 = uint32<16>::zero();
+    uint32<16> vps = uint32<16>::zero();
+    uint32<16> vs2 = uint32<16>::zero();
+    for (std::size_t i = 0; i < chunks; ++i, p += 16) {
+        uint8<16> b8 = load_u(p);
+        uint16<16> b = to_int16(b8);
+        vps = add(vps, vs1);
+        vs1 = add(vs1, to_int32(b));
+        vs2 = add(vs2, mull(b, w));
+    }
+    uint64_t t2 = s2 + uint64_t(16) * chunks * s1 +
+                  16 * checksum_reduce_add(vps) + checksum_reduce_add(vs2);
+    uint64_t t1 = s1 + checksum_reduce_add(vs1);
+    s1 = uint32_t(t1 % adler32_mod);
+    s2 = uint32_t(t2 % adler32_mod);
+}
+
+/*  Same as adler32_vector_block, but with 8 16-bit words per chunk. The words
+    are widened with mull by one, since to_int32 sign-extends uint16 values.
+*/
+inline void fletcher32_vector_block(uint32_t& s1, uint32_t& s2,
+                                    const uint8_t* p, std::size_t chunks)
+{
+    uint16<8> w = make_uint(8, 7, 6, 5, 4, 3, 2, 1);
+    uint16<8> one = make_uint(1);
+    uint32<8> vs1 = uint32<8>::zero();
+    uint32<8> vps = uint32<8>::zero();
+    uint32<8> vs2 = uint32<8>::zero();
+    for (std::size_t i = 0; i < chunks; ++i, p += 16) {
+        uint16<8> b = load_u(p);
+        vps = add(vps, vs1);
+        vs1 = add(vs1, mull(b, one));
+        vs2 = add(vs2, mull(b, w));
+    }
+    uint64_t t2 = s2 + uint64_t(8) * chunks * s1 +
+                  8 * checksum_reduce_add(vps) + checksum_reduce_add(vs2);
+    uint64_t t1 = s1 + checksum_reduce_add(vs1);
+    s1 = uint32_t(t1 % fletcher32_mod);
+    s2 = uint32_t(t2 % fletcher32_mod);
+}
+#endif
+
+} // namespace detail
+
+/** Computes the CRC-32C (Castagnoli) checksum of the buffer [data, data+len).
+
+    The polynomial is 0x1edc6f41 (0x82f63b78 bit-reflected). The CRC register
+    is initialized to ~crc and the result is inverted, thus the checksum of a
+    buffer can be computed in pieces by passing the result for the preceding
+    data as @a crc. The checksum of "123456789" is 0xe3069283.
+
+    On SSE4.2 the CRC32 instruction is used. Long buffers are split into three
+    interleaved streams whose partial CRCs are combined by carry-less
+    multiplication on PCLMUL, or by a scalar polynomial multiplication
+    otherwise. Other architectures use slicing-by-8 tables.
+*/
+inline uint32_t crc32c(const void* data, std::size_t len, uint32_t crc = 0)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    crc = ~crc;
+#if SIMDPP_USE_SSE4_2
+    if (len >= 3 * detail::crc32c_short_block) {
+        const detail::crc32c_shift_consts& k = detail::get_crc32c_shift_consts();
+        const std::size_t lb = detail::crc32c_long_block;
+        const std::size_t sb = detail::crc32c_short_block;
+        for (; len >= 3 * lb; len -= 3 * lb, p += 3 * lb) {
+            crc = detail::crc32c_hw_3way<lb>(crc, p, k.long1, k.long2);
+        }
+        for (; len >= 3 * sb; len -= 3 * sb, p += 3 * sb) {
+            crc = detail::crc32c_hw_3way<sb>(crc, p, k.short1, k.short2);
+        }
+    }
+    crc = detail::crc32c_hw(crc, p, len);
+#else
+    crc = detail::crc32c_sw(crc, p, len);
+#endif
+    return ~crc;
+}
+
+/** Computes the Adler-32 checksum of the buffer [data, data+len) as defined in
+    RFC 1950.
+
+    @code
+    s1 = 1 + d[0] + d[1] + ... + d[len-1]   (mod 65521)
+    s2 = sum of the values of s1 after each byte  (mod 65521)
+    result = s2 << 16 | s1
+    @endcode
+
+    The checksum of a buffer can be computed in pieces by passing the result
+    for the preceding data as @a adler. The position-weighted sums are
+    computed on 16-byte chunks with mull.
+*/
+inline uint32_t adler32(const void* data, std::size_t len, uint32_t adler = 1)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+#if SIMDPP_CHECKSUM_USE_VECTOR
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+    while (len >= 16) {
+        std::size_t chunks = len / 16;
+        if (chunks > detail::adler32_nmax / 16) {
+            chunks = detail::adler32_nmax / 16;
+        }
+        detail::adler32_vector_block(s1, s2, p, chunks);
+        p += chunks * 16;
+        len -= chunks * 16;
+    }
+    adler = s2 << 16 | s1;
+#endif
+    return detail::adler32_scalar(adler, p, len);
+}
+
+/** Computes the Fletcher-32 checksum of the buffer [data, data+len).
+
+    The buffer is read as little-endian 16-bit words w[i]. If @a len is odd,
+    the last word is padded with a zero byte.
+
+    @code
+    s1 = w[0] + w[1] + ... + w[n-1]   (mod 65535)
+    s2 = sum of the values of s1 after each word  (mod 65535)
+    result = s2 << 16 | s1
+    @endcode
+
+    Both sums start from zero. The checksum of a buffer can be computed in
+    pieces of even length by passing the result for the preceding data as
+    @a sum. The checksum of "abcde" is 0xf04fc729.
+*/
+inline uint32_t fletcher32(const void* data, std::size_t len, uint32_t sum = 0)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+#if SIMDPP_CHECKSUM_USE_VECTOR
+    uint32_t s1 = sum & 0xffff;
+    uint32_t s2 = sum >> 16;
+    while (len >= 16) {
+        std::size_t chunks = len / 16;
+        if (chunks > detail::fletcher32_vector_nmax) {
+            chunks = detail::fletcher32_vector_nmax;
+        }
+        detail::fletcher32_vector_block(s1, s2, p, chunks);
+        p += chunks * 16;
+        len -= chunks * 16;
+    }
+    sum = s2 << 16 | s1;
+#endif
+    return detail::fletcher32_scalar(sum, p, len);
+}
+
+#undef SIMDPP_CHECKSUM_USE_VECTOR
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,690 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_COLOR_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_COLOR_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_add_sat.h>
+#include <simdpp/core/i_max.h>
+#include <simdpp/core/i_min.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/i_sub_sat.h>
+#include <simdpp/core/load_packed3_u.h>
+#include <simdpp/core/load_packed4_u.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_int.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_packed3_u.h>
+#include <simdpp/core/store_packed4_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_int16.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The layouts of 8-bit interleaved color pixels
+enum class pixel_format {
+    /// 3 bytes per pixel: red, green, blue
+    rgb,
+    /// 3 bytes per pixel: blue, green, red
+    bgr,
+    /// 4 bytes per pixel: red, green, blue, alpha
+    rgba,
+    /// 4 bytes per pixel: blue, green, red, alpha
+    bgra
+};
+
+/// The color matrices of YUV (Y'CbCr) conversions
+enum class yuv_matrix {
+    /// ITU-R BT.601, used by SD video and JPEG
+    bt601,
+    /// ITU-R BT.709, used by HD video
+    bt709
+};
+
+/*  All conversions use 16-bit fixed point arithmetic and produce exactly the
+    same results on all architectures. YUV data is in the limited (video)
+    range: Y within [16, 235], U and V within [16, 240]. RGB and gray data
+    use the full [0, 255] range.
+
+    RGB to gray and RGB to YUV use 8 fractional bits:
+
+        gray = (kr*R + kg*G + kb*B + 128) >> 8
+        Y = ((yr*R + yg*G + yb*B + 128) >> 8) + 16
+        U = ((ur*R + ug*G + ub*B + 128) >> 8) + 128
+        V = ((vr*R + vg*G + vb*B + 128) >> 8) + 128
+
+    U and V are computed from the rounded average (sum + 2) >> 2 of the R, G
+    and B values of each 2x2 block. The result is within 1 of the exactly
+    rounded result.
+
+    YUV to RGB uses 6 fractional bits. The luma term is computed with
+    mul_hi from Y*257 and a 16-bit coefficient, the chroma terms with
+    mul_lo, the terms are summed with signed saturation:
+
+        y = ((Y*257*ky) >> 16) - ko
+        R = clamp(sat(y + cr*(V-128)) >> 6)
+        G = clamp(sat(y - cg*(U-128) - cb*(V-128)) >> 6)
+        B = clamp(sat(y + cu*(U-128)) >> 6)
+
+    Here sat saturates to the int16_t range, ko includes the rounding term
+    and clamp saturates to [0, 255]. The result is within 1 of the exactly
+    rounded result.
+
+    The vector code works on two interleaved halves: the even and the odd
+    bytes of a vector are processed in separate 16-bit vectors and joined
+    back with a shift and a bitwise or. This keeps the element order intact
+    on all architectures, unlike narrowing with unzip16_lo which works
+    within 128-bit lanes.
+*/
+
+namespace detail {
+
+using color_vector = typename fast_vector<uint8_t>::type;
+using color_vector16 = uint16<color_vector::length / 2>;
+using color_ivector16 = int16<color_vector::length / 2>;
+
+struct color_coefs {
+    int16_t kr, kg, kb;         // RGB to gray
+    int16_t yr, yg, yb;         // RGB to Y
+    int16_t ur, ug, ub;         // RGB to U
+    int16_t vr, vg, vb;         // RGB to V
+    uint16_t ky; int16_t ko;    // Y to RGB
+    int16_t cr, cg, cb, cu;     // U and V to RGB
+};
+
+inline const color_coefs& get_color_coefs(yuv_matrix m)
+{
+    static const color_coefs bt601 = {
+        77, 150, 29,
+        66, 129, 25,
+        -38, -74, 112,
+        112, -94, -18,
+        19003, 1160,
+        102, 25, 52, 129
+    };
+    static const color_coefs bt709 = {
+        54, 183, 19,
+        47, 157, 16,
+        -26, -86, 112,
+        112, -102, -10,
+        19003, 1160,
+        115, 14, 34, 135
+    };
+    return m == yuv_matrix::bt709 ? bt709 : bt601;
+}
+
+SIMDPP_INL uint8_t color_clamp(int x)
+{
+    return x < 0 ? 0 : x > 255 ? 255 : uint8_t(x);
+}
+
+SIMDPP_INL int color_sat16(int x)
+{
+    return x < -32768 ? -32768 : x > 32767 ? 32767 : x;
+}
+
+// The arithmetic right shift of a possibly negative value
+SIMDPP_INL int color_asr(int x, unsigned n)
+{
+    return x >= 0 ? x >> n : -((-x - 1) >> n) - 1;
+}
+
+SIMDPP_INL uint8_t color_gray_scalar(const uint8_t* p, unsigned ri, unsigned bi,
+                                     const color_coefs& k)
+{
+    return uint8_t((k.kr*p[ri] + k.kg*p[1] + k.kb*p[bi] + 128) >> 8);
+}
+
+SIMDPP_INL uint8_t color_y_scalar(const uint8_t* p, unsigned ri, unsigned bi,
+                                  const color_coefs& k)
+{
+    return uint8_t(((k.yr*p[ri] + k.yg*p[1] + k.yb*p[bi] + 128) >> 8) + 16);
+}
+
+// Computes U and V from the sums of 4 values of each channel
+SIMDPP_INL void color_uv_scalar(int r4, int g4, int b4, const color_coefs& k,
+                                uint8_t& u, uint8_t& v)
+{
+    int r = (r4 + 2) >> 2;
+    int g = (g4 + 2) >> 2;
+    int b = (b4 + 2) >> 2;
+    u = uint8_t(color_asr(k.ur*r + k.ug*g + k.ub*b + 128, 8) + 128);
+    v = uint8_t(color_asr(k.vr*r + k.vg*g + k.vb*b + 128, 8) + 128);
+}
+
+SIMDPP_INL void color_rgb_scalar(uint8_t* p, unsigned ri, unsigned bi, unsigned c,
+                                 int y, int u, int v, const color_coefs& k)
+{
+    int yt = ((y * 257 * k.ky) >> 16) - k.ko;
+    u -= 128;
+    v -= 128;
+    p[ri] = color_clamp(color_asr(color_sat16(yt + k.cr*v), 6));
+    p[1] = color_clamp(color_asr(color_sat16(yt - k.cg*u - k.cb*v), 6));
+    p[bi] = color_clamp(color_asr(color_sat16(yt + k.cu*u), 6));
+    if (c == 4) {
+        p[3] = 0xff;
+    }
+}
+
+/*  Loads and stores L pixels with C channels each as C vectors. The fourth
+    channel is ignored on loads and set to 0xff on stores.
+*/
+template<unsigned C> struct color_pixels;
+
+template<> struct color_pixels<3> {
+    static SIMDPP_INL void load(color_vector* c, const uint8_t* p)
+    {
+        load_packed3_u(c[0], c[1], c[2], p);
+    }
+    static SIMDPP_INL void store(uint8_t* p, const color_vector* c)
+    {
+        store_packed3_u(p, c[0], c[1], c[2]);
+    }
+};
+
+template<> struct color_pixels<4> {
+    static SIMDPP_INL void load(color_vector* c, const uint8_t* p)
+    {
+        color_vector a;
+        load_packed4_u(c[0], c[1], c[2], a, p);
+    }
+    static SIMDPP_INL void store(uint8_t* p, const color_vector* c)
+    {
+        color_vector a = make_uint(0xff);
+        store_packed4_u(p, c[0], c[1], c[2], a);
+    }
+};
+
+SIMDPP_INL void color_split(const color_vector& x,
+                            color_vector16& e, color_vector16& o)
+{
+    color_vector16 w = color_vector16(x);
+    e = bit_and(w, (color_vector16) make_uint(0xff));
+    o = shift_r<8>(w);
+}
+
+SIMDPP_INL color_vector color_join(const color_vector16& e, const color_vector16& o)
+{
+    return color_vector(bit_or(e, shift_l<8>(o)));
+}
+
+/*  Splits interleaved U and V values. U is the first byte of each pair, which
+    is the low half of the 16-bit element on little-endian architectures, but
+    the high half on big-endian ALTIVEC.
+*/
+SIMDPP_INL void color_split_uv(const color_vector& x,
+                               color_vector16& u, color_vector16& v)
+{
+#if SIMDPP_USE_ALTIVEC
+    color_split(x, v, u);
+#else
+    color_split(x, u, v);
+#endif
+}
+
+// Interleaves U and V values, the inverse of color_split_uv
+SIMDPP_INL color_vector color_join_uv(const color_vector16& u, const color_vector16& v)
+{
+#if SIMDPP_USE_ALTIVEC
+    return color_join(v, u);
+#else
+    return color_join(u, v);
+#endif
+}
+
+// Computes (a*ka + b*kb + c*kc + 128) >> 8 with wrapping 16-bit arithmetic
+SIMDPP_INL color_vector16 color_dot(const color_vector16& a, const color_vector16& b,
+                                    const color_vector16& c, int16_t ka, int16_t kb,
+                                    int16_t kc)
+{
+    color_vector16 r = make_uint(128);
+    r = add(r, mul_lo(a, (color_vector16) make_int(ka)));
+    r = add(r, mul_lo(b, (color_vector16) make_int(kb)));
+    r = add(r, mul_lo(c, (color_vector16) make_int(kc)));
+    return r;
+}
+
+// Computes the weighted sum of the channels of each byte of r, g and b
+SIMDPP_INL color_vector color_weigh(const color_vector& r, const color_vector& g,
+                                    const color_vector& b, int16_t kr, int16_t kg,
+                                    int16_t kb, uint8_t bias)
+{
+    color_vector16 re, ro, ge, go, be, bo;
+    color_split(r, re, ro);
+    color_split(g, ge, go);
+    color_split(b, be, bo);
+    color_vector16 e = shift_r<8>(color_dot(re, ge, be, kr, kg, kb));
+    color_vector16 o = shift_r<8>(color_dot(ro, go, bo, kr, kg, kb));
+    color_vector x = color_join(e, o);
+    return add(x, (color_vector) make_uint(bias));
+}
+
+/*  Computes one of U and V from the sums of 4 values of each channel. The
+    products fit into int16_t because the sum of the coefficients is zero.
+*/
+SIMDPP_INL color_vector16 color_chroma(const color_vector16& r4, const color_vector16& g4,
+                                       const color_vector16& b4, int16_t kr,
+                                       int16_t kg, int16_t kb)
+{
+    color_vector16 two = make_uint(2);
+    color_vector16 r = shift_r<2>(color_vector16(add(r4, two)));
+    color_vector16 g = shift_r<2>(color_vector16(add(g4, two)));
+    color_vector16 b = shift_r<2>(color_vector16(add(b4, two)));
+    color_ivector16 s = color_ivector16(color_dot(r, g, b, kr, kg, kb));
+    s = shift_r<8>(s);
+    return color_vector16(add(s, (color_ivector16) make_int(128)));
+}
+
+// Converts luma values in 16-bit elements using the precomputed chroma terms
+SIMDPP_INL void color_yuv_lanes(const color_vector16& y, const color_ivector16& cr,
+                                const color_ivector16& cg, const color_ivector16& cb,
+                                const color_coefs& k, color_vector16& r,
+                                color_vector16& g, color_vector16& b)
+{
+    color_ivector16 zero = color_ivector16::zero();
+    color_ivector16 c255 = make_int(255);
+    color_vector16 y257 = bit_or(y, shift_l<8>(y));
+    color_ivector16 yt = color_ivector16(mul_hi(y257, (color_vector16) make_uint(k.ky)));
+    yt = color_ivector16(sub(yt, (color_ivector16) make_int(k.ko)));
+
+    color_ivector16 ir = shift_r<6>(color_ivector16(add_sat(yt, cr)));
+    color_ivector16 ig = shift_r<6>(color_ivector16(sub_sat(yt, cg)));
+    color_ivector16 ib = shift_r<6>(color_ivector16(add_sat(yt, cb)));
+    r = color_vector16(min(max(ir, zero), c255));
+    g = color_vector16(min(max(ig, zero), c255));
+    b = color_vector16(min(max(ib, zero), c255));
+}
+
+/*  Converts L pixels. Element i of u and v holds the chroma of the pixels
+    2*i and 2*i+1.
+*/
+template<unsigned C, bool Swap> SIMDPP_INL
+void color_yuv_block(uint8_t* dst, const color_vector& y, const color_vector16& u,
+                     const color_vector16& v, const color_coefs& k)
+{
+    color_ivector16 c128 = make_int(128);
+    color_ivector16 cu = color_ivector16(sub(color_ivector16(u), c128));
+    color_ivector16 cv = color_ivector16(sub(color_ivector16(v), c128));
+    color_ivector16 cr, cg, cb;
+    cr = color_ivector16(mul_lo(cv, (color_ivector16) make_int(k.cr)));
+    cg = color_ivector16(add(mul_lo(cu, (color_ivector16) make_int(k.cg)),
+                             mul_lo(cv, (color_ivector16) make_int(k.cb))));
+    cb = color_ivector16(mul_lo(cu, (color_ivector16) make_int(k.cu)));
+
+    color_vector16 ye, yo, re, ro, ge, go, be, bo;
+    color_split(y, ye, yo);
+    color_yuv_lanes(ye, cr, cg, cb, k, re, ge, be);
+    color_yuv_lanes(yo, cr, cg, cb, k, ro, go, bo);
+
+    color_vector c[3];
+    c[Swap ? 2 : 0] = color_join(re, ro);
+    c[1] = color_join(ge, go);
+    c[Swap ? 0 : 2] = color_join(be, bo);
+    color_pixels<C>::store(dst, c);
+}
+
+template<unsigned C, bool Swap>
+void v_rgb_to_gray_row(const uint8_t* src, std::size_t width, uint8_t* dst,
+                       const color_coefs& k)
+{
+    using V = color_vector;
+    const unsigned L = V::length;
+    const unsigned ri = Swap ? 2 : 0;
+    const unsigned bi = Swap ? 0 : 2;
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        V c[3];
+        color_pixels<C>::load(c, src + i*C);
+        store_u(dst + i, color_weigh(c[ri], c[1], c[bi], k.kr, k.kg, k.kb, 0));
+    }
+    for (; i < width; ++i) {
+        dst[i] = color_gray_scalar(src + i*C, ri, bi, k);
+    }
+}
+
+/*  Converts a row of pixels given the chroma of each pair of pixels either
+    as interleaved U and V (NV12) or as separate U and V rows (I420, v is not
+    null).
+*/
+template<unsigned C, bool Swap>
+void v_yuv420_to_rgb_row(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                         std::size_t width, uint8_t* dst, const color_coefs& k)
+{
+    using V = color_vector;
+    using V16 = color_vector16;
+    const unsigned L = V::length;
+    const unsigned ri = Swap ? 2 : 0;
+    const unsigned bi = Swap ? 0 : 2;
+
+    std::size_t i = 0;
+    if (v == nullptr) {
+        for (; i + L <= width; i += L) {
+            V16 cu, cv;
+            color_split_uv(load_u(u + i), cu, cv);
+            color_yuv_block<C, Swap>(dst + i*C, load_u(y + i), cu, cv, k);
+        }
+        for (; i < width; ++i) {
+            std::size_t j = i / 2 * 2;
+            color_rgb_scalar(dst + i*C, ri, bi, C, y[i], u[j], u[j+1], k);
+        }
+    } else {
+        for (; i + 2*L <= width; i += 2*L) {
+            // to_int16 produces a pair of vectors in the order of elements
+            V cu8 = load_u(u + i/2);
+            V cv8 = load_u(v + i/2);
+            uint16<L> cu = to_int16(cu8);
+            uint16<L> cv = to_int16(cv8);
+            color_yuv_block<C, Swap>(dst + i*C, load_u(y + i), cu.vec(0), cv.vec(0), k);
+            color_yuv_block<C, Swap>(dst + (i+L)*C, load_u(y + i + L),
+                                     cu.vec(1), cv.vec(1), k);
+        }
+        for (; i < width; ++i) {
+            color_rgb_scalar(dst + i*C, ri, bi, C, y[i], u[i/2], v[i/2], k);
+        }
+    }
+}
+
+/*  Converts L pixels of two rows to two rows of Y and returns L/2 pairs of
+    interleaved U and V. The even and the odd halves of each vector hold the
+    horizontally adjacent pixels, thus the sums of the 2x2 blocks are
+    computed without any shuffles.
+*/
+template<unsigned C, bool Swap> SIMDPP_INL
+color_vector color_yuv420_block(const uint8_t* src0, const uint8_t* src1,
+                                uint8_t* y0, uint8_t* y1, const color_coefs& k)
+{
+    using V = color_vector;
+    using V16 = color_vector16;
+    const unsigned ri = Swap ? 2 : 0;
+    const unsigned bi = Swap ? 0 : 2;
+
+    V a[3], b[3];
+    color_pixels<C>::load(a, src0);
+    color_pixels<C>::load(b, src1);
+    store_u(y0, color_weigh(a[ri], a[1], a[bi], k.yr, k.yg, k.yb, 16));
+    store_u(y1, color_weigh(b[ri], b[1], b[bi], k.yr, k.yg, k.yb, 16));
+
+    V16 s[3];
+    for (unsigned j = 0; j < 3; ++j) {
+        V16 e0, o0, e1, o1;
+        color_split(a[j], e0, o0);
+        color_split(b[j], e1, o1);
+        s[j] = add(add(e0, o0), add(e1, o1));
+    }
+    return color_join_uv(color_chroma(s[ri], s[1], s[bi], k.ur, k.ug, k.ub),
+                         color_chroma(s[ri], s[1], s[bi], k.vr, k.vg, k.vb));
+}
+
+/*  Converts two rows of pixels to two rows of Y and one row of chroma
+    stored either as interleaved U and V (NV12) or as separate U and V rows
+    (I420, v is not null). The latter de-interleaves the chroma of 2*L
+    pixels with mem_unpack2.
+*/
+template<unsigned C, bool Swap>
+void v_rgb_to_yuv420_rows(const uint8_t* src0, const uint8_t* src1,
+                          std::size_t width, uint8_t* y0, uint8_t* y1,
+                          uint8_t* u, uint8_t* v, const color_coefs& k)
+{
+    using V = color_vector;
+    const unsigned L = V::length;
+    const unsigned ri = Swap ? 2 : 0;
+    const unsigned bi = Swap ? 0 : 2;
+
+    std::size_t i = 0;
+    if (v == nullptr) {
+        for (; i + L <= width; i += L) {
+            V uv = color_yuv420_block<C, Swap>(src0 + i*C, src1 + i*C,
+                                               y0 + i, y1 + i, k);
+            store_u(u + i, uv);
+        }
+    } else {
+        for (; i + 2*L <= width; i += 2*L) {
+            V cu = color_yuv420_block<C, Swap>(src0 + i*C, src1 + i*C,
+                                               y0 + i, y1 + i, k);
+            V cv = color_yuv420_block<C, Swap>(src0 + (i+L)*C, src1 + (i+L)*C,
+                                               y0 + i + L, y1 + i + L, k);
+            insn::mem_unpack2(cu, cv);
+            store_u(u + i/2, cu);
+            store_u(v + i/2, cv);
+        }
+    }
+    for (; i < width; i += 2) {
+        std::size_t i1 = i + 1 < width ? i + 1 : i;
+        const uint8_t* p[4] = { src0 + i*C, src0 + i1*C, src1 + i*C, src1 + i1*C };
+        y0[i] = color_y_scalar(p[0], ri, bi, k);
+        y1[i] = color_y_scalar(p[2], ri, bi, k);
+        if (i1 != i) {
+            y0[i1] = color_y_scalar(p[1], ri, bi, k);
+            y1[i1] = color_y_scalar(p[3], ri, bi, k);
+        }
+        int s[3] = { 0, 0, 0 };
+        for (unsigned j = 0; j < 4; ++j) {
+            s[0] += p[j][ri];
+            s[1] += p[j][1];
+            s[2] += p[j][bi];
+        }
+        uint8_t cu, cv;
+        color_uv_scalar(s[0], s[1], s[2], k, cu, cv);
+        if (v == nullptr) {
+            u[i] = cu;
+            u[i+1] = cv;
+        } else {
+            u[i/2] = cu;
+            v[i/2] = cv;
+        }
+    }
+}
+
+} // namespace detail
+
+/** Converts a row of @a width pixels to gray:
+
+    @code
+    dst[i] = (kr*R + kg*G + kb*B + 128) >> 8
+    @endcode
+
+    The weights are (77, 150, 29) for BT.601 and (54, 183, 19) for BT.709,
+    their sum is 256. The alpha channel is ignored.
+*/
+inline void rgb_to_gray_row(const uint8_t* src, std::size_t width, uint8_t* dst,
+                            pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    const detail::color_coefs& k = detail::get_color_coefs(m);
+    switch (fmt) {
+    case pixel_format::rgb: detail::v_rgb_to_gray_row<3, false>(src, width, dst, k); return;
+    case pixel_format::bgr: detail::v_rgb_to_gray_row<3, true>(src, width, dst, k); return;
+    case pixel_format::rgba: detail::v_rgb_to_gray_row<4, false>(src, width, dst, k); return;
+    case pixel_format::bgra: detail::v_rgb_to_gray_row<4, true>(src, width, dst, k); return;
+    }
+}
+
+/** Converts a row of @a width pixels from NV12 layout: a row of luma
+    @a y and a row of interleaved chroma @a uv, which holds (width+1)/2
+    U and V pairs. Each pair applies to two adjacent pixels. The alpha
+    channel of the result, if any, is set to 255.
+*/
+inline void nv12_to_rgb_row(const uint8_t* y, const uint8_t* uv, std::size_t width,
+                            uint8_t* dst, pixel_format fmt,
+                            yuv_matrix m = yuv_matrix::bt601)
+{
+    const detail::color_coefs& k = detail::get_color_coefs(m);
+    switch (fmt) {
+    case pixel_format::rgb: detail::v_yuv420_to_rgb_row<3, false>(y, uv, nullptr, width, dst, k); return;
+    case pixel_format::bgr: detail::v_yuv420_to_rgb_row<3, true>(y, uv, nullptr, width, dst, k); return;
+    case pixel_format::rgba: detail::v_yuv420_to_rgb_row<4, false>(y, uv, nullptr, width, dst, k); return;
+    case pixel_format::bgra: detail::v_yuv420_to_rgb_row<4, true>(y, uv, nullptr, width, dst, k); return;
+    }
+}
+
+/** Converts a row of @a width pixels from I420 layout: a row of luma @a y
+    and rows of (width+1)/2 chroma samples @a u and @a v. Each chroma sample
+    applies to two adjacent pixels. The alpha channel of the result, if any,
+    is set to 255.
+*/
+inline void i420_to_rgb_row(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                            std::size_t width, uint8_t* dst, pixel_format fmt,
+                            yuv_matrix m = yuv_matrix::bt601)
+{
+    const detail::color_coefs& k = detail::get_color_coefs(m);
+    switch (fmt) {
+    case pixel_format::rgb: detail::v_yuv420_to_rgb_row<3, false>(y, u, v, width, dst, k); return;
+    case pixel_format::bgr: detail::v_yuv420_to_rgb_row<3, true>(y, u, v, width, dst, k); return;
+    case pixel_format::rgba: detail::v_yuv420_to_rgb_row<4, false>(y, u, v, width, dst, k); return;
+    case pixel_format::bgra: detail::v_yuv420_to_rgb_row<4, true>(y, u, v, width, dst, k); return;
+    }
+}
+
+/** Converts two rows of @a width pixels to NV12 layout: two rows of luma
+    @a y0 and @a y1 and one row of (width+1)/2 interleaved U and V pairs
+    @a uv. The chroma is computed from the average of each 2x2 block. For an
+    odd number of rows pass the same row as @a src0 and @a src1.
+*/
+inline void rgb_to_nv12_rows(const uint8_t* src0, const uint8_t* src1,
+                             std::size_t width, uint8_t* y0, uint8_t* y1,
+                             uint8_t* uv, pixel_format fmt,
+                             yuv_matrix m = yuv_matrix::bt601)
+{
+    const detail::color_coefs& k = detail::get_color_coefs(m);
+    switch (fmt) {
+    case pixel_format::rgb: detail::v_rgb_to_yuv420_rows<3, false>(src0, src1, width, y0, y1, uv, nullptr, k); return;
+    case pixel_format::bgr: detail::v_rgb_to_yuv420_rows<3, true>(src0, src1, width, y0, y1, uv, nullptr, k); return;
+    case pixel_format::rgba: detail::v_rgb_to_yuv420_rows<4, false>(src0, src1, width, y0, y1, uv, nullptr, k); return;
+    case pixel_format::bgra: detail::v_rgb_to_yuv420_rows<4, true>(src0, src1, width, y0, y1, uv, nullptr, k); return;
+    }
+}
+
+/** Converts two rows of @a width pixels to I420 layout: two rows of luma
+    @a y0 and @a y1 and rows of (width+1)/2 chroma samples @a u and @a v.
+    See rgb_to_nv12_rows for the details.
+*/
+inline void rgb_to_i420_rows(const uint8_t* src0, const uint8_t* src1,
+                             std::size_t width, uint8_t* y0, uint8_t* y1,
+                             uint8_t* u, uint8_t* v, pixel_format fmt,
+                             yuv_matrix m = yuv_matrix::bt601)
+{
+    const detail::color_coefs& k = detail::get_color_coefs(m);
+    switch (fmt) {
+    case pixel_format::rgb: detail::v_rgb_to_yuv420_rows<3, false>(src0, src1, width, y0, y1, u, v, k); return;
+    case pixel_format::bgr: detail::v_rgb_to_yuv420_rows<3, true>(src0, src1, width, y0, y1, u, v, k); return;
+    case pixel_format::rgba: detail::v_rgb_to_yuv420_rows<4, false>(src0, src1, width, y0, y1, u, v, k); return;
+    case pixel_format::bgra: detail::v_rgb_to_yuv420_rows<4, true>(src0, src1, width, y0, y1, u, v, k); return;
+    }
+}
+
+/*  The whole image functions below process the rows independently: the
+    image can be split into horizontal bands which are converted by
+    separate threads by offsetting the pointers by the band's first row and
+    passing the band's height. For the YUV 4:2:0 layouts the bands must
+    start at even rows. All strides are in bytes.
+*/
+
+/** Converts an image of @a width x @a height pixels to gray. See
+    rgb_to_gray_row for the details.
+*/
+inline void rgb_to_gray(const uint8_t* src, std::size_t src_stride,
+                        std::size_t width, std::size_t height,
+                        uint8_t* dst, std::size_t dst_stride,
+                        pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    for (std::size_t r = 0; r < height; ++r) {
+        rgb_to_gray_row(src + r*src_stride, width, dst + r*dst_stride, fmt, m);
+    }
+}
+
+/** Converts an image of @a width x @a height pixels from NV12 layout: the
+    luma plane @a y and the interleaved chroma plane @a uv of
+    (height+1)/2 rows. See nv12_to_rgb_row for the details.
+*/
+inline void nv12_to_rgb(const uint8_t* y, std::size_t y_stride,
+                        const uint8_t* uv, std::size_t uv_stride,
+                        std::size_t width, std::size_t height,
+                        uint8_t* dst, std::size_t dst_stride,
+                        pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    for (std::size_t r = 0; r < height; ++r) {
+        nv12_to_rgb_row(y + r*y_stride, uv + r/2*uv_stride, width,
+                        dst + r*dst_stride, fmt, m);
+    }
+}
+
+/** Converts an image of @a width x @a height pixels from I420 layout: the
+    luma plane @a y and the chroma planes @a u and @a v of (height+1)/2
+    rows. See i420_to_rgb_row for the details.
+*/
+inline void i420_to_rgb(const uint8_t* y, std::size_t y_stride,
+                        const uint8_t* u, std::size_t u_stride,
+                        const uint8_t* v, std::size_t v_stride,
+                        std::size_t width, std::size_t height,
+                        uint8_t* dst, std::size_t dst_stride,
+                        pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    for (std::size_t r = 0; r < height; ++r) {
+        i420_to_rgb_row(y + r*y_stride, u + r/2*u_stride, v + r/2*v_stride,
+                        width, dst + r*dst_stride, fmt, m);
+    }
+}
+
+/** Converts an image of @a width x @a height pixels to NV12 layout. See
+    rgb_to_nv12_rows for the details.
+*/
+inline void rgb_to_nv12(const uint8_t* src, std::size_t src_stride,
+                        std::size_t width, std::size_t height,
+                        uint8_t* y, std::size_t y_stride,
+                        uint8_t* uv, std::size_t uv_stride,
+                        pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    for (std::size_t r = 0; r < height; r += 2) {
+        std::size_t r1 = r + 1 < height ? r + 1 : r;
+        rgb_to_nv12_rows(src + r*src_stride, src + r1*src_stride, width,
+                         y + r*y_stride, y + r1*y_stride, uv + r/2*uv_stride,
+                         fmt, m);
+    }
+}
+
+/** Converts an image of @a width x @a height pixels to I420 layout. See
+    rgb_to_nv12_rows for the details.
+*/
+inline void rgb_to_i420(const uint8_t* src, std::size_t src_stride,
+                        std::size_t width, std::size_t height,
+                        uint8_t* y, std::size_t y_stride,
+                        uint8_t* u, std::size_t u_stride,
+                        uint8_t* v, std::size_t v_stride,
+                        pixel_format fmt, yuv_matrix m = yuv_matrix::bt601)
+{
+    for (std::size_t r = 0; r < height; r += 2) {
+        std::size_t r1 = r + 1 < height ? r + 1 : r;
+        rgb_to_i420_rows(src + r*src_stride, src + r1*src_stride, width,
+                         y + r*y_stride, y + r1*y_stride,
+                         u + r/2*u_stride, v + r/2*v_stride, fmt, m);
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,472 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_COMPLEX_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_COMPLEX_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <complex>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/permute2.h>
+#include <simdpp/core/permute4.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/insn/mem_pack.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/detail/madd.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The complex vectors keep the values interleaved in a single vector of
+    twice the length: re0, im0, re1, im1, ... This is the layout of
+    std::complex arrays, thus the interleaved loads and stores are plain
+    loads and stores. The multiplication duplicates the real and the
+    imaginary parts of the first operand and swaps the parts of the second,
+    then combines the two products with addsub (SSE3) or fmaddsub (FMA3,
+    FMA4, AVX-512F). NEON with the ARMv8.3 complex extension uses vcmla
+    instead. The split storage is converted with the mem_pack2 and
+    mem_unpack2 shuffles.
+*/
+
+namespace detail {
+
+/// @{
+/// Returns a*b - c in the even elements and a*b + c in the odd elements
+SIMDPP_INL float32x4 complex_fmaddsub(const float32x4& a, const float32x4& b,
+                                      const float32x4& c)
+{
+#if SIMDPP_USE_FMA3
+    return _mm_fmaddsub_ps(a, b, c);
+#elif SIMDPP_USE_FMA4
+    return _mm_maddsub_ps(a, b, c);
+#elif SIMDPP_USE_SSE3
+    return _mm_addsub_ps(_mm_mul_ps(a, b), c);
+#else
+    float32x4 sign = make_float(-0.0, 0.0);
+    return add(mul(a, b), bit_xor(c, sign));
+#endif
+}
+
+SIMDPP_INL float64x2 complex_fmaddsub(const float64x2& a, const float64x2& b,
+                                      const float64x2& c)
+{
+#if SIMDPP_USE_FMA3
+    return _mm_fmaddsub_pd(a, b, c);
+#elif SIMDPP_USE_FMA4
+    return _mm_maddsub_pd(a, b, c);
+#elif SIMDPP_USE_SSE3
+    return _mm_addsub_pd(_mm_mul_pd(a, b), c);
+#else
+    float64x2 sign = make_float(-0.0, 0.0);
+    return add(mul(a, b), bit_xor(c, sign));
+#endif
+}
+
+#if SIMDPP_USE_AVX
+SIMDPP_INL float32x8 complex_fmaddsub(const float32x8& a, const float32x8& b,
+                                      const float32x8& c)
+{
+#if SIMDPP_USE_FMA3
+    return _mm256_fmaddsub_ps(a, b, c);
+#elif SIMDPP_USE_FMA4
+    return _mm256_maddsub_ps(a, b, c);
+#else
+    return _mm256_addsub_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+SIMDPP_INL float64x4 complex_fmaddsub(const float64x4& a, const float64x4& b,
+                                      const float64x4& c)
+{
+#if SIMDPP_USE_FMA3
+    return _mm256_fmaddsub_pd(a, b, c);
+#elif SIMDPP_USE_FMA4
+    return _mm256_maddsub_pd(a, b, c);
+#else
+    return _mm256_addsub_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL float32<16> complex_fmaddsub(const float32<16>& a, const float32<16>& b,
+                                        const float32<16>& c)
+{
+    return _mm512_fmaddsub_ps(a, b, c);
+}
+
+SIMDPP_INL float64<8> complex_fmaddsub(const float64<8>& a, const float64<8>& b,
+                                       const float64<8>& c)
+{
+    return _mm512_fmaddsub_pd(a, b, c);
+}
+#endif
+
+template<unsigned N> SIMDPP_INL
+float32<N> complex_fmaddsub(const float32<N>& a, const float32<N>& b,
+                            const float32<N>& c)
+{
+    SIMDPP_VEC_ARRAY_IMPL3(float32<N>, complex_fmaddsub, a, b, c);
+}
+
+template<unsigned N> SIMDPP_INL
+float64<N> complex_fmaddsub(const float64<N>& a, const float64<N>& b,
+                            const float64<N>& c)
+{
+    SIMDPP_VEC_ARRAY_IMPL3(float64<N>, complex_fmaddsub, a, b, c);
+}
+/// @}
+
+/// @{
+/// Multiplies interleaved complex values
+template<unsigned N> SIMDPP_INL
+float32<N> complex_mul(const float32<N>& a, const float32<N>& b)
+{
+#if SIMDPP_USE_NEON64 && defined(__ARM_FEATURE_COMPLEX)
+    float32<N> r;
+    for (unsigned i = 0; i < r.vec_length; ++i) {
+        float32x4_t z = vdupq_n_f32(0);
+        r.vec(i) = vcmlaq_rot90_f32(vcmlaq_f32(z, a.vec(i), b.vec(i)),
+                                    a.vec(i), b.vec(i));
+    }
+    return r;
+#else
+    float32<N> ar = permute4<0,0,2,2>(a);
+    float32<N> ai = permute4<1,1,3,3>(a);
+    float32<N> t = mul(ai, permute4<1,0,3,2>(b));
+    return complex_fmaddsub(ar, b, t);
+#endif
+}
+
+template<unsigned N> SIMDPP_INL
+float64<N> complex_mul(const float64<N>& a, const float64<N>& b)
+{
+#if SIMDPP_USE_NEON64 && defined(__ARM_FEATURE_COMPLEX)
+    float64<N> r;
+    for (unsigned i = 0; i < r.vec_length; ++i) {
+        float64x2_t z = vdupq_n_f64(0);
+        r.vec(i) = vcmlaq_rot90_f64(vcmlaq_f64(z, a.vec(i), b.vec(i)),
+                                    a.vec(i), b.vec(i));
+    }
+    return r;
+#else
+    float64<N> ar = permute2<0,0>(a);
+    float64<N> ai = permute2<1,1>(a);
+    float64<N> t = mul(ai, permute2<1,0>(b));
+    return complex_fmaddsub(ar, b, t);
+#endif
+}
+/// @}
+
+/*  Interleaves the elements of @a re and @a im. Each pair of native vectors
+    is interleaved by mem_pack2; the results are placed into the
+    concatenation of two vectors of the input type, which also handles the
+    inputs narrower than a native vector of the result.
+*/
+template<class R, class V> SIMDPP_INL
+R complex_interleave(const V& re, const V& im)
+{
+    const unsigned vl = V::vec_length;
+    V lo, hi;
+    for (unsigned i = 0; i < vl; ++i) {
+        typename V::base_vector_type a = re.vec(i), b = im.vec(i);
+        insn::mem_pack2(a, b);
+        unsigned j = 2*i, k = 2*i + 1;
+        (j < vl ? lo.vec(j) : hi.vec(j - vl)) = a;
+        (k < vl ? lo.vec(k) : hi.vec(k - vl)) = b;
+    }
+    return combine(lo, hi);
+}
+
+/// The inverse of complex_interleave
+template<class V, class H> SIMDPP_INL
+void complex_deinterleave(const V& v, H& re, H& im)
+{
+    const unsigned vl = H::vec_length;
+    H lo, hi;
+    split(v, lo, hi);
+    for (unsigned i = 0; i < vl; ++i) {
+        unsigned j = 2*i, k = 2*i + 1;
+        typename H::base_vector_type a = j < vl ? lo.vec(j) : hi.vec(j - vl);
+        typename H::base_vector_type b = k < vl ? lo.vec(k) : hi.vec(k - vl);
+        insn::mem_unpack2(a, b);
+        re.vec(i) = a;
+        im.vec(i) = b;
+    }
+}
+
+} // namespace detail
+
+/** @a N complex single precision values. @a N must be a multiple of 4.
+
+    The values are held in a float32<N*2> vector as interleaved real and
+    imaginary parts, which is the layout of a std::complex<float> array.
+*/
+template<unsigned N>
+class complex_float32 {
+public:
+    static const unsigned length = N;
+
+    complex_float32() {}
+
+    /// Wraps a vector of interleaved real and imaginary parts
+    explicit complex_float32(const float32<N*2>& v) : v_(v) {}
+
+    /// Interleaves the real parts @a re and the imaginary parts @a im
+    complex_float32(const float32<N>& re, const float32<N>& im)
+        : v_(detail::complex_interleave<float32<N*2>>(re, im)) {}
+
+    /// Returns the interleaved real and imaginary parts
+    const float32<N*2>& interleaved() const { return v_; }
+
+    /// Deinterleaves the real and imaginary parts
+    void get(float32<N>& re, float32<N>& im) const
+    {
+        detail::complex_deinterleave(v_, re, im);
+    }
+
+    float32<N> real() const { float32<N> re, im; get(re, im); return re; }
+    float32<N> imag() const { float32<N> re, im; get(re, im); return im; }
+
+private:
+    float32<N*2> v_;
+};
+
+/** @a N complex double precision values. @a N must be a multiple of 2.
+
+    The values are held in a float64<N*2> vector as interleaved real and
+    imaginary parts, which is the layout of a std::complex<double> array.
+*/
+template<unsigned N>
+class complex_float64 {
+public:
+    static const unsigned length = N;
+
+    complex_float64() {}
+
+    /// Wraps a vector of interleaved real and imaginary parts
+    explicit complex_float64(const float64<N*2>& v) : v_(v) {}
+
+    /// Interleaves the real parts @a re and the imaginary parts @a im
+    complex_float64(const float64<N>& re, const float64<N>& im)
+        : v_(detail::complex_interleave<float64<N*2>>(re, im)) {}
+
+    /// Returns the interleaved real and imaginary parts
+    const float64<N*2>& interleaved() const { return v_; }
+
+    /// Deinterleaves the real and imaginary parts
+    void get(float64<N>& re, float64<N>& im) const
+    {
+        detail::complex_deinterleave(v_, re, im);
+    }
+
+    float64<N> real() const { float64<N> re, im; get(re, im); return re; }
+    float64<N> imag() const { float64<N> re, im; get(re, im); return im; }
+
+private:
+    float64<N*2> v_;
+};
+
+/** Loads @a N complex values from an interleaved array. The pointer does
+    not need to be aligned.
+
+    @code
+    complex_float32<8> a = load_complex_u<8>(p);
+    @endcode
+*/
+template<unsigned N> SIMDPP_INL
+complex_float32<N> load_complex_u(const std::complex<float>* p)
+{
+    return complex_float32<N>(float32<N*2>(load_u(p)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> load_complex_u(const std::complex<double>* p)
+{
+    return complex_float64<N>(float64<N*2>(load_u(p)));
+}
+
+/** Loads @a N complex values from separate arrays of the real and the
+    imaginary parts. The pointers do not need to be aligned.
+*/
+template<unsigned N> SIMDPP_INL
+complex_float32<N> load_complex_u(const float* re, const float* im)
+{
+    return complex_float32<N>(float32<N>(load_u(re)), float32<N>(load_u(im)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> load_complex_u(const double* re, const double* im)
+{
+    return complex_float64<N>(float64<N>(load_u(re)), float64<N>(load_u(im)));
+}
+
+/// Stores complex values to an interleaved array. The pointer does not need
+/// to be aligned.
+template<unsigned N> SIMDPP_INL
+void store_complex_u(std::complex<float>* p, const complex_float32<N>& a)
+{
+    store_u(p, a.interleaved());
+}
+
+template<unsigned N> SIMDPP_INL
+void store_complex_u(std::complex<double>* p, const complex_float64<N>& a)
+{
+    store_u(p, a.interleaved());
+}
+
+/// Stores complex values to separate arrays of the real and the imaginary
+/// parts. The pointers do not need to be aligned.
+template<unsigned N> SIMDPP_INL
+void store_complex_u(float* re, float* im, const complex_float32<N>& a)
+{
+    float32<N> r, i;
+    a.get(r, i);
+    store_u(re, r);
+    store_u(im, i);
+}
+
+template<unsigned N> SIMDPP_INL
+void store_complex_u(double* re, double* im, const complex_float64<N>& a)
+{
+    float64<N> r, i;
+    a.get(r, i);
+    store_u(re, r);
+    store_u(im, i);
+}
+
+/// Adds complex values
+template<unsigned N> SIMDPP_INL
+complex_float32<N> add(const complex_float32<N>& a, const complex_float32<N>& b)
+{
+    return complex_float32<N>(float32<N*2>(add(a.interleaved(), b.interleaved())));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> add(const complex_float64<N>& a, const complex_float64<N>& b)
+{
+    return complex_float64<N>(float64<N*2>(add(a.interleaved(), b.interleaved())));
+}
+
+/// Subtracts complex values
+template<unsigned N> SIMDPP_INL
+complex_float32<N> sub(const complex_float32<N>& a, const complex_float32<N>& b)
+{
+    return complex_float32<N>(float32<N*2>(sub(a.interleaved(), b.interleaved())));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> sub(const complex_float64<N>& a, const complex_float64<N>& b)
+{
+    return complex_float64<N>(float64<N*2>(sub(a.interleaved(), b.interleaved())));
+}
+
+/** Multiplies complex values
+
+    @code
+    r.re = a.re*b.re - a.im*b.im
+    r.im = a.re*b.im + a.im*b.re
+    @endcode
+
+    The rounding of the result depends on whether fused multiply-add is
+    available.
+*/
+template<unsigned N> SIMDPP_INL
+complex_float32<N> mul(const complex_float32<N>& a, const complex_float32<N>& b)
+{
+    return complex_float32<N>(detail::complex_mul(a.interleaved(), b.interleaved()));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> mul(const complex_float64<N>& a, const complex_float64<N>& b)
+{
+    return complex_float64<N>(detail::complex_mul(a.interleaved(), b.interleaved()));
+}
+
+/// Computes the complex conjugates
+template<unsigned N> SIMDPP_INL
+complex_float32<N> conj(const complex_float32<N>& a)
+{
+    float32<N*2> sign = make_float(0.0, -0.0);
+    return complex_float32<N>(float32<N*2>(bit_xor(a.interleaved(), sign)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> conj(const complex_float64<N>& a)
+{
+    float64<N*2> sign = make_float(0.0, -0.0);
+    return complex_float64<N>(float64<N*2>(bit_xor(a.interleaved(), sign)));
+}
+
+/// Computes the squared magnitudes re*re + im*im
+template<unsigned N> SIMDPP_INL
+float32<N> norm(const complex_float32<N>& a)
+{
+    float32<N> re, im;
+    a.get(re, im);
+    return detail::madd(re, re, float32<N>(mul(im, im)));
+}
+
+template<unsigned N> SIMDPP_INL
+float64<N> norm(const complex_float64<N>& a)
+{
+    float64<N> re, im;
+    a.get(re, im);
+    return detail::madd(re, re, float64<N>(mul(im, im)));
+}
+
+/// @{
+/// Multiplies complex values by real factors
+template<unsigned N> SIMDPP_INL
+complex_float32<N> scale(const complex_float32<N>& a, float s)
+{
+    float32<N*2> vs = splat(s);
+    return complex_float32<N>(float32<N*2>(mul(a.interleaved(), vs)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float32<N> scale(const complex_float32<N>& a, const float32<N>& s)
+{
+    float32<N*2> vs = detail::complex_interleave<float32<N*2>>(s, s);
+    return complex_float32<N>(float32<N*2>(mul(a.interleaved(), vs)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> scale(const complex_float64<N>& a, double s)
+{
+    float64<N*2> vs = splat(s);
+    return complex_float64<N>(float64<N*2>(mul(a.interleaved(), vs)));
+}
+
+template<unsigned N> SIMDPP_INL
+complex_float64<N> scale(const complex_float64<N>& a, const float64<N>& s)
+{
+    float64<N*2> vs = detail::complex_interleave<float64<N*2>>(s, s);
+    return complex_float64<N>(float64<N*2>(mul(a.interleaved(), vs)));
+}
+/// @}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
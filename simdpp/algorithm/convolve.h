@@ -0,0 +1,585 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_CONVOLVE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_CONVOLVE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_add_sat.h>
+#include <simdpp/core/i_max.h>
+#include <simdpp/core/i_min.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/make_int.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_int16.h>
+#include <simdpp/detail/madd.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The ways to extend an image beyond its edges
+enum class border_mode {
+    /// The edge pixels are repeated: aaa|abcd|ddd
+    replicate,
+    /// The image is mirrored without repeating the edge pixels: dcb|abcd|cba
+    reflect,
+    /// The pixels outside the image are zero
+    zero
+};
+
+/*  The separable filters apply a vertical pass from the source to the
+    destination image and then a horizontal pass in place. The vertical pass
+    is vectorized across the columns and processes the image in blocks of
+    columns so that the rows of the current block that are read for
+    consecutive output rows stay in the L1 cache. The horizontal pass copies
+    each row together with its border to a temporary buffer and then loads a
+    vector at each tap offset.
+
+    8-bit images use 16-bit arithmetic: the even and the odd bytes are
+    widened to separate int16 vectors, multiplied by the coefficients with
+    mul_lo and accumulated with add_sat. The results are identical on all
+    architectures.
+*/
+
+namespace detail {
+
+// The number of bytes of each column block of the vertical pass
+static const std::size_t conv_block_bytes = 1024;
+
+/*  Maps the row or column index i to [0, n) according to the border mode.
+    Returns -1 if the pixel is zero.
+*/
+inline std::ptrdiff_t conv_border(std::ptrdiff_t i, std::ptrdiff_t n, border_mode b)
+{
+    if (i >= 0 && i < n) {
+        return i;
+    }
+    switch (b) {
+    case border_mode::replicate:
+        return i < 0 ? 0 : n - 1;
+    case border_mode::reflect:
+        if (n == 1) {
+            return 0;
+        } else {
+            std::ptrdiff_t period = 2 * (n - 1);
+            i = (i < 0 ? -i : i) % period;
+            return i < n ? i : period - i;
+        }
+    default:
+        return -1;
+    }
+}
+
+/*  Copies a row of n elements to t so that t[i] holds the element at i-a,
+    the elements outside the row are filled according to the border mode.
+    t must hold n+pad elements.
+*/
+template<class T>
+void conv_pad_row(const T* src, std::size_t n, unsigned a, unsigned pad,
+                  border_mode b, T* t)
+{
+    std::memcpy(t + a, src, n * sizeof(T));
+    for (unsigned i = 0; i < pad; ++i) {
+        std::ptrdiff_t j = i < a ? std::ptrdiff_t(i) - a : std::ptrdiff_t(n) + i - a;
+        std::ptrdiff_t k = conv_border(j, n, b);
+        t[i < a ? i : n + i] = k < 0 ? T(0) : src[k];
+    }
+}
+
+/*  Collects the rows and the coefficients of the taps of the output row y
+    of the vertical pass, skipping the zero rows. Returns the number of
+    taps.
+*/
+template<class T, class K>
+unsigned conv_rows(const T* src, std::size_t stride, std::size_t h, std::size_t y,
+                   const K* k, unsigned n, border_mode b,
+                   const T** rows, K* coefs)
+{
+    unsigned m = 0;
+    for (unsigned j = 0; j < n; ++j) {
+        std::ptrdiff_t r = conv_border(std::ptrdiff_t(y + j) - n/2, h, b);
+        if (r >= 0) {
+            rows[m] = src + r * stride;
+            coefs[m] = k[j];
+            m++;
+        }
+    }
+    return m;
+}
+
+// float32 images
+
+template<class V> SIMDPP_INL
+V conv_f32_taps(const float* const* p, const float* k, unsigned m, std::size_t x)
+{
+    V acc = V::zero();
+    for (unsigned j = 0; j < m; ++j) {
+        acc = madd(V(load_u(p[j] + x)), V(make_float(k[j])), acc);
+    }
+    return acc;
+}
+
+/*  Computes the output elements [x0, x1) as dot products of m taps. The
+    source of the tap j for the output element x is p[j][x + j*step].
+*/
+inline void conv_f32_span(float* d, const float* const* p, const float* k,
+                          unsigned m, std::size_t step, std::size_t x0,
+                          std::size_t x1)
+{
+    using V = typename fast_vector<float>::type;
+    const unsigned L = V::length;
+    const float* q[256];
+    const float* const* pp = p;
+    if (step != 0) {
+        for (unsigned j = 0; j < m; ++j) {
+            q[j] = p[0] + j * step;
+        }
+        pp = q;
+    }
+
+    std::size_t x = x0;
+    for (; x + 4*L <= x1; x += 4*L) {
+        V a0 = V::zero(), a1 = V::zero(), a2 = V::zero(), a3 = V::zero();
+        for (unsigned j = 0; j < m; ++j) {
+            V kv = make_float(k[j]);
+            const float* s = pp[j] + x;
+            a0 = madd(V(load_u(s)), kv, a0);
+            a1 = madd(V(load_u(s + L)), kv, a1);
+            a2 = madd(V(load_u(s + 2*L)), kv, a2);
+            a3 = madd(V(load_u(s + 3*L)), kv, a3);
+        }
+        store_u(d + x, a0);
+        store_u(d + x + L, a1);
+        store_u(d + x + 2*L, a2);
+        store_u(d + x + 3*L, a3);
+    }
+    for (; x + L <= x1; x += L) {
+        store_u(d + x, conv_f32_taps<V>(pp, k, m, x));
+    }
+    for (; x < x1; ++x) {
+        float s = 0;
+        for (unsigned j = 0; j < m; ++j) {
+            s += k[j] * pp[j][x];
+        }
+        d[x] = s;
+    }
+}
+
+// 8-bit images
+
+using conv_vector = typename fast_vector<uint8_t>::type;
+using conv_vector16 = uint16<conv_vector::length / 2>;
+using conv_ivector16 = int16<conv_vector::length / 2>;
+
+SIMDPP_INL int conv_u8_scalar(const uint8_t* const* p, const int16_t* k, unsigned m,
+                              std::size_t x, unsigned shift)
+{
+    int acc = shift ? 1 << (shift - 1) : 0;
+    for (unsigned j = 0; j < m; ++j) {
+        acc += int16_t(k[j] * p[j][x]);
+        acc = acc < -32768 ? -32768 : acc > 32767 ? 32767 : acc;
+    }
+    acc = acc >= 0 ? acc >> shift : -((-acc - 1) >> shift) - 1;
+    return acc < 0 ? 0 : acc > 255 ? 255 : acc;
+}
+
+struct conv_u8_acc {
+    conv_ivector16 e, o;
+
+    SIMDPP_INL void init(const conv_ivector16& round) { e = round; o = round; }
+
+    SIMDPP_INL void tap(const conv_vector& x, const conv_ivector16& k)
+    {
+        conv_vector16 w = conv_vector16(x);
+        conv_ivector16 xe = conv_ivector16(bit_and(w, (conv_vector16) make_uint(0xff)));
+        conv_ivector16 xo = conv_ivector16(shift_r<8>(w));
+        e = add_sat(e, conv_ivector16(mul_lo(xe, k)));
+        o = add_sat(o, conv_ivector16(mul_lo(xo, k)));
+    }
+
+    SIMDPP_INL conv_vector result(unsigned shift) const
+    {
+        conv_ivector16 zero = conv_ivector16::zero();
+        conv_ivector16 c255 = make_int(255);
+        conv_ivector16 re = min(max(shift_r(e, shift), zero), c255);
+        conv_ivector16 ro = min(max(shift_r(o, shift), zero), c255);
+        return conv_vector(bit_or(conv_vector16(re), shift_l<8>(conv_vector16(ro))));
+    }
+};
+
+// The 8-bit counterpart of conv_f32_span
+inline void conv_u8_span(uint8_t* d, const uint8_t* const* p, const int16_t* k,
+                         unsigned m, std::size_t step, unsigned shift,
+                         std::size_t x0, std::size_t x1)
+{
+    using V = conv_vector;
+    const unsigned L = V::length;
+    const uint8_t* q[256];
+    const uint8_t* const* pp = p;
+    if (step != 0) {
+        for (unsigned j = 0; j < m; ++j) {
+            q[j] = p[0] + j * step;
+        }
+        pp = q;
+    }
+    conv_ivector16 round = make_int(shift ? 1 << (shift - 1) : 0);
+
+    std::size_t x = x0;
+    for (; x + 2*L <= x1; x += 2*L) {
+        conv_u8_acc a0, a1;
+        a0.init(round);
+        a1.init(round);
+        for (unsigned j = 0; j < m; ++j) {
+            conv_ivector16 kv = make_int(k[j]);
+            a0.tap(load_u(pp[j] + x), kv);
+            a1.tap(load_u(pp[j] + x + L), kv);
+        }
+        store_u(d + x, a0.result(shift));
+        store_u(d + x + L, a1.result(shift));
+    }
+    for (; x + L <= x1; x += L) {
+        conv_u8_acc a;
+        a.init(round);
+        for (unsigned j = 0; j < m; ++j) {
+            a.tap(load_u(pp[j] + x), (conv_ivector16) make_int(k[j]));
+        }
+        store_u(d + x, a.result(shift));
+    }
+    for (; x < x1; ++x) {
+        d[x] = uint8_t(conv_u8_scalar(pp, k, m, x, shift));
+    }
+}
+
+struct conv_f32_op {
+    using T = float;
+    using K = float;
+    unsigned shift;
+
+    SIMDPP_INL void span(float* d, const float* const* p, const float* k, unsigned m,
+                         std::size_t step, std::size_t x0, std::size_t x1) const
+    {
+        conv_f32_span(d, p, k, m, step, x0, x1);
+    }
+};
+
+struct conv_u8_op {
+    using T = uint8_t;
+    using K = int16_t;
+    unsigned shift;
+
+    SIMDPP_INL void span(uint8_t* d, const uint8_t* const* p, const int16_t* k,
+                         unsigned m, std::size_t step, std::size_t x0,
+                         std::size_t x1) const
+    {
+        conv_u8_span(d, p, k, m, step, shift, x0, x1);
+    }
+};
+
+template<class Op>
+void conv_separable(const typename Op::T* src, std::size_t src_stride,
+                    std::size_t width, std::size_t height,
+                    typename Op::T* dst, std::size_t dst_stride,
+                    const typename Op::K* kx, unsigned nx,
+                    const typename Op::K* ky, unsigned ny,
+                    border_mode border, const Op& op)
+{
+    using T = typename Op::T;
+    using K = typename Op::K;
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    const T* rows[256];
+    K coefs[256];
+    const std::size_t block = conv_block_bytes / sizeof(T);
+    for (std::size_t x0 = 0; x0 < width; x0 += block) {
+        std::size_t x1 = x0 + block < width ? x0 + block : width;
+        for (std::size_t y = 0; y < height; ++y) {
+            unsigned m = conv_rows(src, src_stride, height, y, ky, ny, border,
+                                   rows, coefs);
+            op.span(dst + y * dst_stride, rows, coefs, m, 0, x0, x1);
+        }
+    }
+
+    std::vector<T> t(width + nx - 1);
+    for (std::size_t y = 0; y < height; ++y) {
+        T* d = dst + y * dst_stride;
+        conv_pad_row(d, width, nx / 2, nx - 1, border, t.data());
+        const T* p = t.data();
+        op.span(d, &p, kx, nx, 1, 0, width);
+    }
+}
+
+// Builds a normalized Gaussian kernel of 2*ceil(3*sigma)+1 taps
+inline std::vector<float> conv_gaussian(float sigma)
+{
+    unsigned r = unsigned(std::ceil(3 * sigma));
+    r = r < 1 ? 1 : r > 127 ? 127 : r;
+    std::vector<float> k(2*r + 1);
+    float sum = 0;
+    for (unsigned i = 0; i < k.size(); ++i) {
+        float x = float(int(i) - int(r));
+        k[i] = std::exp(-x * x / (2 * sigma * sigma));
+        sum += k[i];
+    }
+    for (unsigned i = 0; i < k.size(); ++i) {
+        k[i] /= sum;
+    }
+    return k;
+}
+
+// Quantizes a normalized kernel to 7 fractional bits keeping the sum exact
+inline std::vector<int16_t> conv_quantize(const std::vector<float>& k)
+{
+    std::vector<int16_t> r(k.size());
+    int sum = 0;
+    for (unsigned i = 0; i < k.size(); ++i) {
+        r[i] = int16_t(std::floor(k[i] * 128 + 0.5f));
+        sum += r[i];
+    }
+    r[k.size() / 2] += int16_t(128 - sum);
+    return r;
+}
+
+/*  Sums the rows y-r ... y+r of the window into sum, or adds the row y+r
+    and subtracts the row y-r-1 if update is true.
+*/
+template<class T, class F>
+void box_rows(const T* src, std::size_t stride, std::size_t h, std::size_t y,
+              unsigned r, border_mode b, bool update, F f)
+{
+    if (update) {
+        std::ptrdiff_t ia = conv_border(std::ptrdiff_t(y) + r, h, b);
+        std::ptrdiff_t is = conv_border(std::ptrdiff_t(y) - r - 1, h, b);
+        f(ia < 0 ? nullptr : src + ia * stride, is < 0 ? nullptr : src + is * stride);
+    } else {
+        for (std::ptrdiff_t j = -std::ptrdiff_t(r); j <= std::ptrdiff_t(r); ++j) {
+            std::ptrdiff_t i = conv_border(std::ptrdiff_t(y) + j, h, b);
+            f(i < 0 ? nullptr : src + i * stride, nullptr);
+        }
+    }
+}
+
+} // namespace detail
+
+/** Applies a separable filter to an image of @a width x @a height float32
+    elements. The horizontal kernel @a kx has @a nx taps, the vertical kernel
+    @a ky has @a ny taps, both are anchored at the middle tap n/2:
+
+    @code
+    dst[y][x] = sum(ky[j] * kx[i] * src[y+j-ny/2][x+i-nx/2])
+    @endcode
+
+    The strides are in elements. The images must not overlap. The kernels
+    must have between 1 and 255 taps. The rounding of the results depends on
+    the availability of fused multiply-add.
+*/
+inline void filter_separable(const float* src, std::size_t src_stride,
+                             std::size_t width, std::size_t height,
+                             float* dst, std::size_t dst_stride,
+                             const float* kx, unsigned nx,
+                             const float* ky, unsigned ny,
+                             border_mode border = border_mode::replicate)
+{
+    detail::conv_f32_op op = { 0 };
+    detail::conv_separable(src, src_stride, width, height, dst, dst_stride,
+                           kx, nx, ky, ny, border, op);
+}
+
+/** Applies a separable filter to an image of @a width x @a height 8-bit
+    elements. The kernels have @a shift fractional bits. Each pass computes
+
+    @code
+    r = clamp((sum(k[i] * x[i]) + round) >> shift)
+    @endcode
+
+    where round is half of the unit, the products and the running sums are
+    computed in int16_t with signed saturation in the order of the taps and
+    clamp saturates to [0, 255]. The result of the vertical pass is the input
+    of the horizontal pass. The absolute value of the coefficients must not
+    exceed 128 so that the products fit into int16_t.
+
+    The strides are in elements. The images must not overlap. The kernels
+    must have between 1 and 255 taps. @a shift must be less than 16.
+*/
+inline void filter_separable(const uint8_t* src, std::size_t src_stride,
+                             std::size_t width, std::size_t height,
+                             uint8_t* dst, std::size_t dst_stride,
+                             const int16_t* kx, unsigned nx,
+                             const int16_t* ky, unsigned ny, unsigned shift,
+                             border_mode border = border_mode::replicate)
+{
+    detail::conv_u8_op op = { shift };
+    detail::conv_separable(src, src_stride, width, height, dst, dst_stride,
+                           kx, nx, ky, ny, border, op);
+}
+
+/** Applies a Gaussian blur with standard deviation @a sigma to a float32
+    image. The kernel has 2*ceil(3*sigma)+1 taps, but not more than 255.
+    See filter_separable for the details.
+*/
+inline void gaussian_blur(const float* src, std::size_t src_stride,
+                          std::size_t width, std::size_t height,
+                          float* dst, std::size_t dst_stride, float sigma,
+                          border_mode border = border_mode::replicate)
+{
+    std::vector<float> k = detail::conv_gaussian(sigma);
+    unsigned n = unsigned(k.size());
+    filter_separable(src, src_stride, width, height, dst, dst_stride,
+                     k.data(), n, k.data(), n, border);
+}
+
+/** Applies a Gaussian blur with standard deviation @a sigma to an 8-bit
+    image. The kernel is quantized to 7 fractional bits, thus the taps that
+    are less than 1/256 of the center are dropped for large @a sigma. See
+    filter_separable for the details.
+*/
+inline void gaussian_blur(const uint8_t* src, std::size_t src_stride,
+                          std::size_t width, std::size_t height,
+                          uint8_t* dst, std::size_t dst_stride, float sigma,
+                          border_mode border = border_mode::replicate)
+{
+    std::vector<int16_t> k = detail::conv_quantize(detail::conv_gaussian(sigma));
+    unsigned n = unsigned(k.size());
+    filter_separable(src, src_stride, width, height, dst, dst_stride,
+                     k.data(), n, k.data(), n, 7, border);
+}
+
+/** Replaces each element of a float32 image with the mean of the square of
+    (2*radius+1) x (2*radius+1) elements centered at it. The cost per element
+    does not depend on the radius: the vertical sums of each column are
+    updated by adding the row that enters the window and subtracting the row
+    that leaves it, the horizontal sums are updated in the same way. The
+    running sums accumulate rounding errors.
+
+    The strides are in elements. The images must not overlap.
+*/
+inline void box_blur(const float* src, std::size_t src_stride,
+                     std::size_t width, std::size_t height,
+                     float* dst, std::size_t dst_stride, unsigned radius,
+                     border_mode border = border_mode::replicate)
+{
+    using V = typename detail::fast_vector<float>::type;
+    const unsigned L = V::length;
+    if (width == 0 || height == 0) {
+        return;
+    }
+    const unsigned n = 2*radius + 1;
+    const float scale = 1.0f / (float(n) * float(n));
+    std::vector<float> cols(width), t(width + n - 1);
+
+    for (std::size_t y = 0; y < height; ++y) {
+        float* c = cols.data();
+        detail::box_rows(src, src_stride, height, y, radius, border, y != 0,
+                         [&](const float* a, const float* s) {
+            std::size_t x = 0;
+            for (; x + L <= width; x += L) {
+                V v = load_u(c + x);
+                if (a) v = add(v, V(load_u(a + x)));
+                if (s) v = sub(v, V(load_u(s + x)));
+                store_u(c + x, v);
+            }
+            for (; x < width; ++x) {
+                c[x] += (a ? a[x] : 0) - (s ? s[x] : 0);
+            }
+        });
+
+        detail::conv_pad_row(c, width, radius, n - 1, border, t.data());
+        float* d = dst + y * dst_stride;
+        float sum = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            sum += t[i];
+        }
+        d[0] = sum * scale;
+        for (std::size_t x = 1; x < width; ++x) {
+            sum += t[x + n - 1] - t[x - 1];
+            d[x] = sum * scale;
+        }
+    }
+}
+
+/** Replaces each element of an 8-bit image with the rounded mean of the
+    square of (2*radius+1) x (2*radius+1) elements centered at it. The
+    vertical sums are kept in 16-bit elements, thus @a radius must not exceed
+    127. The results are exact. See the float32 overload for the details.
+*/
+inline void box_blur(const uint8_t* src, std::size_t src_stride,
+                     std::size_t width, std::size_t height,
+                     uint8_t* dst, std::size_t dst_stride, unsigned radius,
+                     border_mode border = border_mode::replicate)
+{
+    using V = detail::conv_vector;
+    using W = uint16<V::length>;
+    const unsigned L = V::length;
+    if (width == 0 || height == 0) {
+        return;
+    }
+    const unsigned n = 2*radius + 1;
+    const uint32_t area = n * n;
+    // (s * m) >> 40 equals s / area for s < 2^40 / area
+    const uint64_t m = ((uint64_t(1) << 40) + area - 1) / area;
+    std::vector<uint16_t> cols(width), t(width + n - 1);
+
+    for (std::size_t y = 0; y < height; ++y) {
+        uint16_t* c = cols.data();
+        detail::box_rows(src, src_stride, height, y, radius, border, y != 0,
+                         [&](const uint8_t* a, const uint8_t* s) {
+            std::size_t x = 0;
+            for (; x + L <= width; x += L) {
+                W v = load_u(c + x);
+                if (a) v = add(v, to_int16(V(load_u(a + x))));
+                if (s) v = sub(v, to_int16(V(load_u(s + x))));
+                store_u(c + x, v);
+            }
+            for (; x < width; ++x) {
+                c[x] = uint16_t(c[x] + (a ? a[x] : 0) - (s ? s[x] : 0));
+            }
+        });
+
+        detail::conv_pad_row(c, width, radius, n - 1, border, t.data());
+        uint8_t* d = dst + y * dst_stride;
+        uint32_t sum = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            sum += t[i];
+        }
+        d[0] = uint8_t(((sum + area/2) * m) >> 40);
+        for (std::size_t x = 1; x < width; ++x) {
+            sum += t[x + n - 1] - t[x - 1];
+            d[x] = uint8_t(((sum + area/2) * m) >> 40);
+        }
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,697 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_FFT_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_FFT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_packed2_u.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/permute2.h>
+#include <simdpp/core/permute4.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store_packed2_u.h>
+#include <simdpp/core/store_packed4_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/madd.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The transforms use the Stockham autosort algorithm, which needs no bit
+    reversal permutation: each stage reads one buffer and writes the other.
+    A stage of radix 4 with the sub-transform length l and the stride s
+    computes for each p in [0, l/4) and q in [0, s), with m = l/4 and
+    w = exp(-2*pi*i/l):
+
+        a, b, c, d = x[q + s*p], x[q + s*(p+m)], x[q + s*(p+2m)], x[q + s*(p+3m)]
+        y[q + s*(4p+0)] = (a + b + c + d)
+        y[q + s*(4p+1)] = (a - i*b - c + i*d) * w^p
+        y[q + s*(4p+2)] = (a - b + c - d) * w^2p
+        y[q + s*(4p+3)] = (a + i*b - c - i*d) * w^3p
+
+    and the next stage has the length l/4 and the stride 4s. A final stage
+    of radix 2 is added if log2(n) is odd.
+
+    The data is processed in split format, the real and the imaginary parts
+    are in separate arrays. The stages with s >= the vector length are
+    vectorized across q and use twiddles broadcast from scalars. The early
+    stages with s = 1 or s = 4 are vectorized across p and q together with
+    expanded twiddle tables; their outputs are interleaved with
+    store_packed4 (s = 1) or stored in blocks of four elements (s = 4). The
+    interleaved complex format is converted with load_packed2 and
+    store_packed2. The inverse transform is computed by swapping the real
+    and the imaginary parts of the input and the output.
+*/
+
+namespace detail {
+
+template<class T>
+using fft_buffer = std::vector<T, aligned_allocator<T, 64>>;
+
+struct fft_stage {
+    enum kind_t {
+        scalar,     // not vectorized
+        across_q,   // vectorized across q
+        across_pq   // vectorized across p and q, s < the vector length
+    };
+    std::size_t len;    // the length of the sub-transforms
+    std::size_t stride;
+    unsigned radix;
+    kind_t kind;
+    // the offset of the twiddles of the stage
+    std::size_t tw;
+};
+
+template<class V> struct fft_half;
+template<unsigned N> struct fft_half<float32<N>> { using type = float32<N/2>; };
+template<unsigned N> struct fft_half<float64<N>> { using type = float64<N/2>; };
+
+// Stores the blocks of four elements of a to p, p + stride, p + 2*stride, ...
+template<class V, bool Split = (V::length > 4)>
+struct fft_blocks4 {
+    template<class T>
+    static SIMDPP_INL void store(T* p, const V& a, std::size_t stride)
+    {
+        store_u(p, a);
+        (void) stride;
+    }
+};
+
+template<class V>
+struct fft_blocks4<V, true> {
+    template<class T>
+    static SIMDPP_INL void store(T* p, const V& a, std::size_t stride)
+    {
+        using H = typename fft_half<V>::type;
+        H lo, hi;
+        split(a, lo, hi);
+        fft_blocks4<H>::store(p, lo, stride);
+        fft_blocks4<H>::store(p + V::length / 8 * stride, hi, stride);
+    }
+};
+
+// Reverses the order of the elements
+SIMDPP_INL float32<4> fft_reverse(const float32<4>& a)
+{
+    return permute4<3,2,1,0>(a);
+}
+
+SIMDPP_INL float64<2> fft_reverse(const float64<2>& a)
+{
+    return permute2<1,0>(a);
+}
+
+template<unsigned N> SIMDPP_INL
+float32<N> fft_reverse(const float32<N>& a)
+{
+    float32<N/2> lo, hi;
+    split(a, lo, hi);
+    return combine(fft_reverse(hi), fft_reverse(lo));
+}
+
+template<unsigned N> SIMDPP_INL
+float64<N> fft_reverse(const float64<N>& a)
+{
+    float64<N/2> lo, hi;
+    split(a, lo, hi);
+    return combine(fft_reverse(hi), fft_reverse(lo));
+}
+
+// (r + i*im) *= (wr + i*wi)
+template<class V> SIMDPP_INL
+void fft_cmul(V& r, V& i, const V& wr, const V& wi)
+{
+    V t = sub(mul(r, wr), mul(i, wi));
+    i = madd(r, wi, V(mul(i, wr)));
+    r = t;
+}
+
+/*  The radix 4 butterfly without the twiddles. On return a, b, c, d hold
+    the outputs 0, 1, 2, 3.
+*/
+template<class V> SIMDPP_INL
+void fft_bfly4(V& ar, V& ai, V& br, V& bi, V& cr, V& ci, V& dr, V& di)
+{
+    V t0r = add(ar, cr), t0i = add(ai, ci);
+    V t1r = sub(ar, cr), t1i = sub(ai, ci);
+    V t2r = add(br, dr), t2i = add(bi, di);
+    V t3r = sub(br, dr), t3i = sub(bi, di);
+    ar = add(t0r, t2r);  ai = add(t0i, t2i);
+    cr = sub(t0r, t2r);  ci = sub(t0i, t2i);
+    br = add(t1r, t3i);  bi = sub(t1i, t3r);
+    dr = sub(t1r, t3i);  di = add(t1i, t3r);
+}
+
+template<class T>
+void fft_radix4_scalar(const T* xr, const T* xi, T* yr, T* yi,
+                       std::size_t m, std::size_t s, const T* tw)
+{
+    for (std::size_t p = 0; p < m; ++p) {
+        const T* w = tw + 6*p;
+        for (std::size_t q = 0; q < s; ++q) {
+            std::size_t i = q + s*p;
+            T ar = xr[i], ai = xi[i];
+            T br = xr[i + s*m], bi = xi[i + s*m];
+            T cr = xr[i + 2*s*m], ci = xi[i + 2*s*m];
+            T dr = xr[i + 3*s*m], di = xi[i + 3*s*m];
+            T t0r = ar + cr, t0i = ai + ci;
+            T t1r = ar - cr, t1i = ai - ci;
+            T t2r = br + dr, t2i = bi + di;
+            T t3r = br - dr, t3i = bi - di;
+            T y1r = t1r + t3i, y1i = t1i - t3r;
+            T y2r = t0r - t2r, y2i = t0i - t2i;
+            T y3r = t1r - t3i, y3i = t1i + t3r;
+            std::size_t o = q + 4*s*p;
+            yr[o] = t0r + t2r;
+            yi[o] = t0i + t2i;
+            yr[o + s] = y1r * w[0] - y1i * w[1];
+            yi[o + s] = y1r * w[1] + y1i * w[0];
+            yr[o + 2*s] = y2r * w[2] - y2i * w[3];
+            yi[o + 2*s] = y2r * w[3] + y2i * w[2];
+            yr[o + 3*s] = y3r * w[4] - y3i * w[5];
+            yi[o + 3*s] = y3r * w[5] + y3i * w[4];
+        }
+    }
+}
+
+template<class T>
+void fft_radix4_q(const T* xr, const T* xi, T* yr, T* yi,
+                  std::size_t m, std::size_t s, const T* tw)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+    std::size_t sm = s*m;
+    for (std::size_t p = 0; p < m; ++p) {
+        const T* w = tw + 6*p;
+        V w1r = make_float(w[0]), w1i = make_float(w[1]);
+        V w2r = make_float(w[2]), w2i = make_float(w[3]);
+        V w3r = make_float(w[4]), w3i = make_float(w[5]);
+        for (std::size_t q = 0; q < s; q += L) {
+            std::size_t i = q + s*p;
+            V ar = load_u(xr + i), ai = load_u(xi + i);
+            V br = load_u(xr + i + sm), bi = load_u(xi + i + sm);
+            V cr = load_u(xr + i + 2*sm), ci = load_u(xi + i + 2*sm);
+            V dr = load_u(xr + i + 3*sm), di = load_u(xi + i + 3*sm);
+            fft_bfly4(ar, ai, br, bi, cr, ci, dr, di);
+            if (p != 0) {
+                fft_cmul(br, bi, w1r, w1i);
+                fft_cmul(cr, ci, w2r, w2i);
+                fft_cmul(dr, di, w3r, w3i);
+            }
+            std::size_t o = q + 4*s*p;
+            store_u(yr + o, ar);  store_u(yi + o, ai);
+            store_u(yr + o + s, br);  store_u(yi + o + s, bi);
+            store_u(yr + o + 2*s, cr);  store_u(yi + o + 2*s, ci);
+            store_u(yr + o + 3*s, dr);  store_u(yi + o + 3*s, di);
+        }
+    }
+}
+
+/*  The twiddles are in six arrays of n/4 elements: the real and the
+    imaginary parts of w^p, w^2p, w^3p for each element index e = q + s*p.
+*/
+template<class T>
+void fft_radix4_pq(const T* xr, const T* xi, T* yr, T* yi,
+                   std::size_t n, std::size_t s, const T* tw)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+    std::size_t n4 = n / 4;
+    for (std::size_t e = 0; e < n4; e += L) {
+        V ar = load_u(xr + e), ai = load_u(xi + e);
+        V br = load_u(xr + e + n4), bi = load_u(xi + e + n4);
+        V cr = load_u(xr + e + 2*n4), ci = load_u(xi + e + 2*n4);
+        V dr = load_u(xr + e + 3*n4), di = load_u(xi + e + 3*n4);
+        fft_bfly4(ar, ai, br, bi, cr, ci, dr, di);
+        fft_cmul(br, bi, V(load(tw + e)), V(load(tw + n4 + e)));
+        fft_cmul(cr, ci, V(load(tw + 2*n4 + e)), V(load(tw + 3*n4 + e)));
+        fft_cmul(dr, di, V(load(tw + 4*n4 + e)), V(load(tw + 5*n4 + e)));
+        if (s == 1) {
+            store_packed4_u(yr + 4*e, ar, br, cr, dr);
+            store_packed4_u(yi + 4*e, ai, bi, ci, di);
+        } else {
+            // s == 4, the outputs of each p are four blocks of s elements
+            T* pr = yr + 4*e;
+            T* pi = yi + 4*e;
+            fft_blocks4<V>::store(pr, ar, 16);  fft_blocks4<V>::store(pi, ai, 16);
+            fft_blocks4<V>::store(pr + 4, br, 16);  fft_blocks4<V>::store(pi + 4, bi, 16);
+            fft_blocks4<V>::store(pr + 8, cr, 16);  fft_blocks4<V>::store(pi + 8, ci, 16);
+            fft_blocks4<V>::store(pr + 12, dr, 16);  fft_blocks4<V>::store(pi + 12, di, 16);
+        }
+    }
+}
+
+// The final stage of radix 2, all twiddles are one
+template<class T>
+void fft_radix2(const T* xr, const T* xi, T* yr, T* yi, std::size_t s, bool vec)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+    std::size_t q = 0;
+    if (vec) {
+        for (; q < s; q += L) {
+            V ar = load_u(xr + q), ai = load_u(xi + q);
+            V br = load_u(xr + q + s), bi = load_u(xi + q + s);
+            store_u(yr + q, add(ar, br));  store_u(yi + q, add(ai, bi));
+            store_u(yr + q + s, sub(ar, br));  store_u(yi + q + s, sub(ai, bi));
+        }
+    }
+    for (; q < s; ++q) {
+        T ar = xr[q], ai = xi[q], br = xr[q + s], bi = xi[q + s];
+        yr[q] = ar + br;  yi[q] = ai + bi;
+        yr[q + s] = ar - br;  yi[q + s] = ai - bi;
+    }
+}
+
+} // namespace detail
+
+/** A plan of the complex discrete Fourier transform of @a n points, @a n
+    must be a power of two. @a T is float or double.
+
+    @code
+    forward: X[k] = sum(x[j] * exp(-2*pi*i*j*k/n))
+    inverse: x[j] = sum(X[k] * exp(2*pi*i*j*k/n))
+    @endcode
+
+    The inverse transform is not normalized: inverse(forward(x)) = n*x.
+
+    The plan holds the twiddle tables and the work buffers, thus a single
+    plan must not be used by several threads at once. The transforms do not
+    allocate. The input and the output may be the same arrays.
+*/
+template<class T>
+class fft_plan {
+public:
+    explicit fft_plan(std::size_t n) :
+        n_(n),
+        work0_(2 * n),
+        work1_(2 * n)
+    {
+        plan();
+    }
+
+    std::size_t size() const { return n_; }
+
+    /// Computes the forward transform of data in split format
+    void forward(const T* re, const T* im, T* out_re, T* out_im)
+    {
+        transform(re, im, out_re, out_im);
+    }
+
+    /// Computes the inverse transform of data in split format
+    void inverse(const T* re, const T* im, T* out_re, T* out_im)
+    {
+        transform(im, re, out_im, out_re);
+    }
+
+    /// Computes the forward transform of interleaved complex data
+    void forward(const std::complex<T>* in, std::complex<T>* out)
+    {
+        transform_interleaved(reinterpret_cast<const T*>(in),
+                              reinterpret_cast<T*>(out), false);
+    }
+
+    /// Computes the inverse transform of interleaved complex data
+    void inverse(const std::complex<T>* in, std::complex<T>* out)
+    {
+        transform_interleaved(reinterpret_cast<const T*>(in),
+                              reinterpret_cast<T*>(out), true);
+    }
+
+private:
+    using V = typename detail::fast_vector<T>::type;
+    static const unsigned L = V::length;
+
+    void plan()
+    {
+        const double pi = 3.14159265358979323846;
+        std::size_t tw_size = 0;
+        for (std::size_t len = n_, s = 1; len > 1; ) {
+            detail::fft_stage st;
+            st.len = len;
+            st.stride = s;
+            st.radix = len % 4 == 0 ? 4 : 2;
+            st.tw = tw_size;
+            if (st.radix == 2) {
+                st.kind = s >= L ? detail::fft_stage::across_q : detail::fft_stage::scalar;
+            } else if (s >= L) {
+                st.kind = detail::fft_stage::across_q;
+                tw_size += 6 * (len / 4);
+            } else if (n_ / 4 >= L && (s == 1 || s == 4)) {
+                st.kind = detail::fft_stage::across_pq;
+                tw_size += 6 * (n_ / 4);
+            } else {
+                st.kind = detail::fft_stage::scalar;
+                tw_size += 6 * (len / 4);
+            }
+            // Keep the twiddle arrays aligned
+            tw_size = (tw_size + 15) / 16 * 16;
+            stages_.push_back(st);
+            len /= st.radix;
+            s *= st.radix;
+        }
+
+        twiddles_.resize(tw_size);
+        for (const detail::fft_stage& st : stages_) {
+            if (st.radix == 2) {
+                continue;
+            }
+            T* tw = twiddles_.data() + st.tw;
+            std::size_t m = st.len / 4;
+            if (st.kind == detail::fft_stage::across_pq) {
+                std::size_t n4 = n_ / 4;
+                for (std::size_t e = 0; e < n4; ++e) {
+                    std::size_t p = e / st.stride;
+                    for (unsigned c = 1; c <= 3; ++c) {
+                        double a = -2 * pi * double(c * p) / double(st.len);
+                        tw[(2*c - 2) * n4 + e] = T(std::cos(a));
+                        tw[(2*c - 1) * n4 + e] = T(std::sin(a));
+                    }
+                }
+            } else {
+                for (std::size_t p = 0; p < m; ++p) {
+                    for (unsigned c = 1; c <= 3; ++c) {
+                        double a = -2 * pi * double(c * p) / double(st.len);
+                        tw[6*p + 2*c - 2] = T(std::cos(a));
+                        tw[6*p + 2*c - 1] = T(std::sin(a));
+                    }
+                }
+            }
+        }
+    }
+
+    void run_stage(const detail::fft_stage& st, const T* xr, const T* xi,
+                   T* yr, T* yi) const
+    {
+        const T* tw = twiddles_.data() + st.tw;
+        if (st.radix == 2) {
+            detail::fft_radix2(xr, xi, yr, yi, st.stride,
+                               st.kind == detail::fft_stage::across_q);
+            return;
+        }
+        switch (st.kind) {
+        case detail::fft_stage::across_q:
+            detail::fft_radix4_q(xr, xi, yr, yi, st.len / 4, st.stride, tw);
+            break;
+        case detail::fft_stage::across_pq:
+            detail::fft_radix4_pq(xr, xi, yr, yi, n_, st.stride, tw);
+            break;
+        default:
+            detail::fft_radix4_scalar(xr, xi, yr, yi, st.len / 4, st.stride, tw);
+            break;
+        }
+    }
+
+    /*  Runs the stages from x, stage k writes to a if k is even and to b
+        otherwise. x may be b.
+    */
+    void run(const T* xr, const T* xi, T* ar, T* ai, T* br, T* bi) const
+    {
+        for (std::size_t k = 0; k < stages_.size(); ++k) {
+            T* yr = k % 2 == 0 ? ar : br;
+            T* yi = k % 2 == 0 ? ai : bi;
+            run_stage(stages_[k], xr, xi, yr, yi);
+            xr = yr;
+            xi = yi;
+        }
+    }
+
+    void transform(const T* re, const T* im, T* out_re, T* out_im)
+    {
+        T* tr = work0_.data();
+        T* ti = tr + n_;
+        if (stages_.empty()) {
+            std::memmove(out_re, re, n_ * sizeof(T));
+            std::memmove(out_im, im, n_ * sizeof(T));
+            return;
+        }
+        // The last stage must write to the output
+        if (stages_.size() % 2 == 1) {
+            if (re == out_re || im == out_im) {
+                std::memcpy(tr, re, n_ * sizeof(T));
+                std::memcpy(ti, im, n_ * sizeof(T));
+                re = tr;
+                im = ti;
+            }
+            run(re, im, out_re, out_im, tr, ti);
+        } else {
+            run(re, im, tr, ti, out_re, out_im);
+        }
+    }
+
+    void transform_interleaved(const T* in, T* out, bool inverse)
+    {
+        T* ar = work0_.data();
+        T* ai = ar + n_;
+        T* br = work1_.data();
+        T* bi = br + n_;
+
+        std::size_t i = 0;
+        for (; i + L <= n_; i += L) {
+            V r, m;
+            load_packed2_u(r, m, in + 2*i);
+            store_u(br + i, r);
+            store_u(bi + i, m);
+        }
+        for (; i < n_; ++i) {
+            br[i] = in[2*i];
+            bi[i] = in[2*i + 1];
+        }
+
+        if (inverse) {
+            run(bi, br, ai, ar, bi, br);
+        } else {
+            run(br, bi, ar, ai, br, bi);
+        }
+        const T* yr = stages_.size() % 2 == 1 ? ar : br;
+        const T* yi = stages_.size() % 2 == 1 ? ai : bi;
+
+        for (i = 0; i + L <= n_; i += L) {
+            store_packed2_u(out + 2*i, V(load(yr + i)), V(load(yi + i)));
+        }
+        for (; i < n_; ++i) {
+            out[2*i] = yr[i];
+            out[2*i + 1] = yi[i];
+        }
+    }
+
+    std::size_t n_;
+    std::vector<detail::fft_stage> stages_;
+    detail::fft_buffer<T> twiddles_;
+    detail::fft_buffer<T> work0_;
+    detail::fft_buffer<T> work1_;
+};
+
+/** A plan of the discrete Fourier transform of @a n real points, @a n must
+    be a power of two and at least 2. The transform of n real points is
+    computed as a complex transform of n/2 points followed by a
+    post-processing pass.
+
+    The forward transform outputs the n/2 + 1 non-redundant bins; the
+    imaginary parts of the first and the last bins are zero. The inverse
+    transform is not normalized: inverse(forward(x)) = n*x. The plan must
+    not be used by several threads at once.
+*/
+template<class T>
+class rfft_plan {
+public:
+    explicit rfft_plan(std::size_t n) :
+        n_(n),
+        fft_(n / 2),
+        wr_(n / 4 + 1),
+        wi_(n / 4 + 1),
+        work_(n)
+    {
+        const double pi = 3.14159265358979323846;
+        for (std::size_t k = 0; k <= n / 4; ++k) {
+            double a = -2 * pi * double(k) / double(n);
+            wr_[k] = T(std::cos(a));
+            wi_[k] = T(std::sin(a));
+        }
+    }
+
+    std::size_t size() const { return n_; }
+
+    /** Computes the forward transform of @a n real values. Stores n/2 + 1
+        bins to @a out_re and @a out_im.
+    */
+    void forward(const T* in, T* out_re, T* out_im)
+    {
+        std::size_t h = n_ / 2;
+        T* zr = work_.data();
+        T* zi = zr + h;
+        // The even and the odd values are the real and the imaginary parts
+        std::size_t i = 0;
+        for (; i + L <= h; i += L) {
+            V r, m;
+            load_packed2_u(r, m, in + 2*i);
+            store(zr + i, r);
+            store(zi + i, m);
+        }
+        for (; i < h; ++i) {
+            zr[i] = in[2*i];
+            zi[i] = in[2*i + 1];
+        }
+        fft_.forward(zr, zi, out_re, out_im);
+        split_spectrum(out_re, out_im);
+    }
+
+    /** Computes the inverse transform of n/2 + 1 bins, stores n real values
+        to @a out. The imaginary parts of the first and the last bins are
+        ignored.
+    */
+    void inverse(const T* re, const T* im, T* out)
+    {
+        std::size_t h = n_ / 2;
+        T* zr = work_.data();
+        T* zi = zr + h;
+        join_spectrum(re, im, zr, zi);
+        fft_.inverse(zr, zi, zr, zi);
+        std::size_t i = 0;
+        for (; i + L <= h; i += L) {
+            store_packed2_u(out + 2*i, V(load(zr + i)), V(load(zi + i)));
+        }
+        for (; i < h; ++i) {
+            out[2*i] = zr[i];
+            out[2*i + 1] = zi[i];
+        }
+    }
+
+private:
+    using V = typename detail::fast_vector<T>::type;
+    static const unsigned L = V::length;
+
+    /*  Z is the transform of z[j] = x[2j] + i*x[2j+1] of h = n/2 points.
+        For each pair k, h-k with a = Z[k], b = Z[h-k], w = exp(-2*pi*i*k/n):
+
+            E = (a + conj(b)) / 2,  O = (a - conj(b)) / 2i
+            X[k] = E + w*O,  X[h-k] = conj(E - w*O)
+    */
+    SIMDPP_INL void split_pair(T& ar, T& ai, T& br, T& bi, T wr, T wi) const
+    {
+        T er = (ar + br) / 2, ei = (ai - bi) / 2;
+        T or_ = (ai + bi) / 2, oi = (br - ar) / 2;
+        T tr = wr * or_ - wi * oi, ti = wr * oi + wi * or_;
+        ar = er + tr;  ai = ei + ti;
+        br = er - tr;  bi = ti - ei;
+    }
+
+    void split_spectrum(T* xr, T* xi) const
+    {
+        std::size_t h = n_ / 2;
+        T z0r = xr[0], z0i = xi[0];
+        xr[0] = z0r + z0i;  xi[0] = 0;
+        xr[h] = z0r - z0i;  xi[h] = 0;
+
+        V half = make_float(T(0.5));
+        std::size_t k = 1;
+        for (; 2 * (k + L) <= h + 1; k += L) {
+            std::size_t j = h - k - (L - 1);
+            V ar = load_u(xr + k), ai = load_u(xi + k);
+            V br = detail::fft_reverse(V(load_u(xr + j)));
+            V bi = detail::fft_reverse(V(load_u(xi + j)));
+            V wr = load_u(wr_.data() + k), wi = load_u(wi_.data() + k);
+            V er = mul(add(ar, br), half), ei = mul(sub(ai, bi), half);
+            V or_ = mul(add(ai, bi), half), oi = mul(sub(br, ar), half);
+            V tr = sub(mul(wr, or_), mul(wi, oi));
+            V ti = detail::madd(wr, oi, V(mul(wi, or_)));
+            store_u(xr + k, add(er, tr));
+            store_u(xi + k, add(ei, ti));
+            store_u(xr + j, detail::fft_reverse(V(sub(er, tr))));
+            store_u(xi + j, detail::fft_reverse(V(sub(ti, ei))));
+        }
+        for (; 2 * k <= h; ++k) {
+            std::size_t j = h - k;
+            T ar = xr[k], ai = xi[k], br = xr[j], bi = xi[j];
+            split_pair(ar, ai, br, bi, wr_[k], wi_[k]);
+            if (j == k) {
+                xr[k] = ar;  xi[k] = ai;
+            } else {
+                xr[k] = ar;  xi[k] = ai;
+                xr[j] = br;  xi[j] = bi;
+            }
+        }
+    }
+
+    /*  The inverse of split_spectrum multiplied by two. With
+        S = X[k] + conj(X[h-k]), D = X[k] - conj(X[h-k]) and
+        t = i * conj(w) * D:
+
+            Z[k] = S + t,  Z[h-k] = conj(S - t)
+    */
+    void join_spectrum(const T* xr, const T* xi, T* zr, T* zi) const
+    {
+        std::size_t h = n_ / 2;
+        zr[0] = xr[0] + xr[h];
+        zi[0] = xr[0] - xr[h];
+
+        std::size_t k = 1;
+        for (; 2 * (k + L) <= h + 1; k += L) {
+            std::size_t j = h - k - (L - 1);
+            V ar = load_u(xr + k), ai = load_u(xi + k);
+            V br = detail::fft_reverse(V(load_u(xr + j)));
+            V bi = detail::fft_reverse(V(load_u(xi + j)));
+            V wr = load_u(wr_.data() + k), wi = load_u(wi_.data() + k);
+            V sr = add(ar, br), si = sub(ai, bi);
+            V dr = sub(ar, br), di = add(ai, bi);
+            // conj(w) * D, then multiplied by i
+            V cr = detail::madd(wi, di, V(mul(wr, dr)));
+            V ci = sub(mul(wr, di), mul(wi, dr));
+            V tr = sub(V::zero(), ci), ti = cr;
+            store_u(zr + k, add(sr, tr));
+            store_u(zi + k, add(si, ti));
+            store_u(zr + j, detail::fft_reverse(V(sub(sr, tr))));
+            store_u(zi + j, detail::fft_reverse(V(sub(ti, si))));
+        }
+        for (; 2 * k <= h; ++k) {
+            std::size_t j = h - k;
+            T ar = xr[k], ai = xi[k], br = xr[j], bi = xi[j];
+            T wr = wr_[k], wi = wi_[k];
+            T sr = ar + br, si = ai - bi;
+            T dr = ar - br, di = ai + bi;
+            T cr = wr * dr + wi * di, ci = wr * di - wi * dr;
+            T tr = -ci, ti = cr;
+            zr[k] = sr + tr;  zi[k] = si + ti;
+            if (j != k) {
+                zr[j] = sr - tr;  zi[j] = ti - si;
+            }
+        }
+    }
+
+    std::size_t n_;
+    fft_plan<T> fft_;
+    detail::fft_buffer<T> wr_;
+    detail::fft_buffer<T> wi_;
+    detail::fft_buffer<T> work_;
+};
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
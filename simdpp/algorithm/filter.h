@@ -0,0 +1,481 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_FILTER_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_FILTER_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/bit_not.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/cache.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_ge.h>
+#include <simdpp/core/cmp_gt.h>
+#include <simdpp/core/cmp_le.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_splat.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/set_splat.h>
+#include <simdpp/detail/mask_bits.h>
+#include <simdpp/detail/mem_block.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Predicate for filter_bitmap and filter_select: selects the elements equal
+    to @a value.
+*/
+template<class T>
+struct pred_eq {
+    T value;
+
+    pred_eq(T v) : value(v) {}
+    bool operator()(T x) const { return x == value; }
+};
+
+/** Predicate for filter_bitmap and filter_select: selects the elements within
+    the inclusive range [@a lo, @a hi].
+*/
+template<class T>
+struct pred_range {
+    T lo, hi;
+
+    pred_range(T l, T h) : lo(l), hi(h) {}
+    bool operator()(T x) const { return lo <= x && x <= hi; }
+};
+
+/** Predicate for filter_bitmap and filter_select: selects the elements equal
+    to any of the @a size elements at @a values. The values are not copied.
+
+    For uint8_t columns, such as dictionary codes, the set is converted to a
+    256-bit bitset that is looked up with byte permutes, so the cost does not
+    depend on the size of the set. For uint16_t columns, sets of more than 8
+    values are converted to a 65536-bit bitset that is allocated on the heap.
+    The bitset is looked up with gathers on AVX2 and one element at a time
+    elsewhere. Other element types compare each element with all values.
+*/
+template<class T>
+struct pred_in {
+    const T* values;
+    std::size_t size;
+
+    pred_in(const T* v, std::size_t s) : values(v), size(s) {}
+    bool operator()(T x) const
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (x == values[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+namespace detail {
+
+// Unsigned comparison a > b, the result is returned as an element mask
+template<unsigned N> SIMDPP_INL
+uint8<N> v_cmp_gt_u(const uint8<N>& a, const uint8<N>& b)
+{
+    return uint8<N>(cmp_gt(a, b));
+}
+
+template<unsigned N> SIMDPP_INL
+uint16<N> v_cmp_gt_u(const uint16<N>& a, const uint16<N>& b)
+{
+    return uint16<N>(cmp_gt(a, b));
+}
+
+template<unsigned N> SIMDPP_INL
+uint32<N> v_cmp_gt_u(const uint32<N>& a, const uint32<N>& b)
+{
+    return uint32<N>(cmp_gt(a, b));
+}
+
+template<unsigned N> SIMDPP_INL
+uint64<N> v_cmp_gt_u(const uint64<N>& a, const uint64<N>& b)
+{
+    // there's no 64-bit comparison, compute the borrow of b - a instead and
+    // widen it to all bits of the element
+    uint64<N> t = bit_or(bit_andnot(a, b), bit_andnot(sub(b, a), bit_xor(a, b)));
+    t = shift_r<63>(t);
+    return sub(uint64<N>::zero(), t);
+}
+
+/*  Evaluates a predicate on a vector of type V. The bits() member returns a
+    bit mask with one bit per element.
+*/
+template<class V, class P> struct filter_eval;
+
+template<class V, class T>
+struct filter_eval<V, pred_eq<T>> {
+    V value;
+
+    filter_eval(const pred_eq<T>& p) { value = load_splat(&p.value); }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        return mask_bits(cmp_eq(x, value));
+    }
+};
+
+// Integer ranges are checked with a single unsigned comparison:
+// lo <= x <= hi  <=>  x - lo <= hi - lo
+// hi - lo wraps around when lo > hi, such ranges select no elements
+template<class V, class T>
+struct filter_eval<V, pred_range<T>> {
+    using U = typename remove_sign<V>::type;
+    using UT = typename U::element_type;
+    U lo, span;
+    uint64_t all;
+
+    filter_eval(const pred_range<T>& p)
+    {
+        UT l = UT(p.lo);
+        UT s = UT(UT(p.hi) - UT(p.lo));
+        lo = load_splat(&l);
+        span = load_splat(&s);
+        all = p.lo <= p.hi ? (uint64_t(2) << (V::length - 1)) - 1 : 0;
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        U d = sub(U(x), lo);
+        return ~mask_bits(v_cmp_gt_u(d, span)) & all;
+    }
+};
+
+template<class V>
+struct filter_eval<V, pred_range<float>> {
+    V lo, hi;
+
+    filter_eval(const pred_range<float>& p)
+    {
+        lo = load_splat(&p.lo);
+        hi = load_splat(&p.hi);
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        return mask_bits(bit_and(cmp_ge(x, lo), cmp_le(x, hi)));
+    }
+};
+
+template<class V>
+struct filter_eval<V, pred_range<double>> {
+    V lo, hi;
+
+    filter_eval(const pred_range<double>& p)
+    {
+        lo = load_splat(&p.lo);
+        hi = load_splat(&p.hi);
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        return mask_bits(bit_and(cmp_ge(x, lo), cmp_le(x, hi)));
+    }
+};
+
+// Compares each element of the vector with all values of the set
+template<class V, class T>
+struct filter_eval_list {
+    const T* values;
+    std::size_t size;
+
+    filter_eval_list(const pred_in<T>& p) : values(p.values), size(p.size) {}
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        if (size == 0) {
+            return 0;
+        }
+        V v = load_splat(values);
+        auto m = cmp_eq(x, v).eval();
+        for (std::size_t i = 1; i < size; ++i) {
+            v = load_splat(values + i);
+            m = bit_or(m, cmp_eq(x, v));
+        }
+        return mask_bits(m);
+    }
+};
+
+template<class V, class T>
+struct filter_eval<V, pred_in<T>> : filter_eval_list<V, T> {
+    filter_eval(const pred_in<T>& p) : filter_eval_list<V, T>(p) {}
+};
+
+// Looks up each element of the vector in a bitset one at a time
+template<class V, unsigned Bits>
+struct filter_eval_bitset {
+    using T = typename V::element_type;
+    uint64_t set[Bits / 64];
+
+    template<class P>
+    void init(const P& p)
+    {
+        for (unsigned i = 0; i < Bits / 64; ++i) {
+            set[i] = 0;
+        }
+        for (std::size_t i = 0; i < p.size; ++i) {
+            T c = p.values[i];
+            set[c / 64] |= uint64_t(1) << (c % 64);
+        }
+    }
+
+    SIMDPP_INL bool test(T c) const
+    {
+        return (set[c / 64] >> (c % 64)) & 1;
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        mem_block<V> b(x);
+        uint64_t r = 0;
+        for (unsigned i = 0; i < V::length; ++i) {
+            r |= uint64_t(test(b[i])) << i;
+        }
+        return r;
+    }
+};
+
+template<class V>
+struct filter_eval<V, pred_in<uint8_t>> {
+#if SIMDPP_USE_SSE2 && !SIMDPP_USE_SSSE3
+    // there's no byte permute on SSE2
+    filter_eval_bitset<V, 256> set;
+
+    filter_eval(const pred_in<uint8_t>& p) { set.init(p); }
+
+    SIMDPP_INL uint64_t bits(const V& x) const { return set.bits(x); }
+#else
+    // set_lo and set_hi hold the bytes 0-15 and 16-31 of the bitset, the
+    // tables are repeated in each 128-bit lane
+    V set_lo, set_hi, bit;
+
+    filter_eval(const pred_in<uint8_t>& p)
+    {
+        SIMDPP_ALIGN(64) uint8_t tlo[V::length];
+        SIMDPP_ALIGN(64) uint8_t thi[V::length];
+        SIMDPP_ALIGN(64) uint8_t tbit[V::length];
+        uint8_t set[32] = {};
+        for (std::size_t i = 0; i < p.size; ++i) {
+            set[p.values[i] >> 3] |= 1 << (p.values[i] & 7);
+        }
+        for (unsigned i = 0; i < V::length; ++i) {
+            tlo[i] = set[i % 16];
+            thi[i] = set[16 + i % 16];
+            tbit[i] = 1 << (i % 8);
+        }
+        set_lo = load(tlo);
+        set_hi = load(thi);
+        bit = load(tbit);
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        V c15 = splat(15);
+        V c7 = splat(7);
+        V idx = shift_r<3>(x);
+        V idx4 = bit_and(idx, c15);
+        V lo = permute_bytes16(set_lo, idx4);
+        V hi = permute_bytes16(set_hi, idx4);
+        V row = blend(hi, lo, cmp_gt(idx, c15));
+        V b = permute_bytes16(bit, V(bit_and(x, c7)));
+        return mask_bits(cmp_neq(bit_and(row, b), V::zero()));
+    }
+#endif
+};
+
+// Looks up each element of the vector in a 65536-bit bitset one at a time
+template<class V> SIMDPP_INL
+uint64_t filter_bitset16_bits(const uint32_t* set, const V& x)
+{
+    mem_block<V> b(x);
+    uint64_t r = 0;
+    for (unsigned i = 0; i < V::length; ++i) {
+        uint16_t c = b[i];
+        r |= uint64_t((set[c / 32] >> (c % 32)) & 1) << i;
+    }
+    return r;
+}
+
+#if SIMDPP_USE_AVX2
+/*  Gathers the bitset words of 8 elements that are widened to 32 bits and
+    moves the bit of each element to the sign bit of its word
+*/
+SIMDPP_INL unsigned filter_bitset16_bits8(const uint32_t* set, __m256i c)
+{
+    __m256i w = _mm256_i32gather_epi32(reinterpret_cast<const int*>(set),
+                                       _mm256_srli_epi32(c, 5), 4);
+    __m256i s = _mm256_sub_epi32(_mm256_set1_epi32(31),
+                                 _mm256_and_si256(c, _mm256_set1_epi32(31)));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_sllv_epi32(w, s)));
+}
+
+SIMDPP_INL uint64_t filter_bitset16_bits(const uint32_t* set, const uint16<16>& x)
+{
+    __m256i a = x;
+    __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(a));
+    __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(a, 1));
+    return filter_bitset16_bits8(set, lo) | (filter_bitset16_bits8(set, hi) << 8);
+}
+#endif
+
+/*  Sets of up to 8 values are compared directly. Larger sets are converted
+    to a 65536-bit bitset, which is allocated only in that case.
+*/
+template<class V>
+struct filter_eval<V, pred_in<uint16_t>> {
+    filter_eval_list<V, uint16_t> small;
+    std::vector<uint32_t> set;
+
+    filter_eval(const pred_in<uint16_t>& p) : small(p)
+    {
+        if (p.size > 8) {
+            set.assign(65536 / 32, 0);
+            for (std::size_t i = 0; i < p.size; ++i) {
+                uint16_t c = p.values[i];
+                set[c / 32] |= uint32_t(1) << (c % 32);
+            }
+        }
+    }
+
+    SIMDPP_INL uint64_t bits(const V& x) const
+    {
+        return set.empty() ? small.bits(x) : filter_bitset16_bits(set.data(), x);
+    }
+};
+
+/*  The column is processed in blocks of 64 elements, each producing one
+    64-bit word of the bitmap. The inner loop has a constant trip count of
+    64 / V::length and is fully unrolled by the compiler.
+*/
+template<class T, class E, class P, class F>
+void v_filter_blocks(const T* col, std::size_t n, const P& pred, const E& eval,
+                     F&& emit)
+{
+    using V = typename fast_vector<T>::type;
+    const unsigned L = V::length;
+    const std::size_t prefetch_distance = 1024 / sizeof(T);
+
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        for (unsigned j = 0; j < 64 * sizeof(T); j += 64) {
+            prefetch_read(reinterpret_cast<const char*>(col + i + prefetch_distance) + j);
+        }
+        uint64_t word = 0;
+        for (unsigned j = 0; j < 64; j += L) {
+            V x = load_u(col + i + j);
+            word |= eval.bits(x) << j;
+        }
+        emit(i, word);
+    }
+    if (i < n) {
+        uint64_t word = 0;
+        for (unsigned j = 0; i + j < n; ++j) {
+            word |= uint64_t(pred(col[i+j])) << j;
+        }
+        emit(i, word);
+    }
+}
+
+} // namespace detail
+
+/** Evaluates a predicate on each of the @a n elements of a column and stores
+    the results to a bitmap. Bit @c i%64 of @c bitmap[i/64] is set if the
+    predicate holds for @c col[i]. The bits past @a n in the last word are
+    cleared. The bitmap must hold at least (n+63)/64 words.
+
+    @a pred is one of pred_eq, pred_range or pred_in with the same element type
+    as the column. The supported element types are uint8_t, int8_t, uint16_t,
+    int16_t, uint32_t, int32_t, uint64_t, int64_t, float and double.
+
+    @code
+    filter_bitmap(col, n, pred_range<int32_t>(10, 20), bitmap);
+    @endcode
+*/
+template<class T, class P>
+void filter_bitmap(const T* col, std::size_t n, const P& pred, uint64_t* bitmap)
+{
+    using V = typename detail::fast_vector<T>::type;
+    detail::filter_eval<V, P> eval(pred);
+    detail::v_filter_blocks(col, n, pred, eval,
+                            [bitmap](std::size_t i, uint64_t word)
+    {
+        bitmap[i / 64] = word;
+    });
+}
+
+/** Evaluates a predicate on each of the @a n elements of a column and stores
+    the indices of the elements for which it holds to @a sel in increasing
+    order. Returns the number of stored indices. @a sel must have room for
+    @a n indices. @a n must not exceed 2^32.
+
+    See filter_bitmap for the supported predicates and element types.
+*/
+template<class T, class P>
+std::size_t filter_select(const T* col, std::size_t n, const P& pred, uint32_t* sel)
+{
+    using V = typename detail::fast_vector<T>::type;
+    detail::filter_eval<V, P> eval(pred);
+    uint32_t* out = sel;
+    detail::v_filter_blocks(col, n, pred, eval,
+                            [&out](std::size_t i, uint64_t word)
+    {
+        while (word != 0) {
+            *out++ = uint32_t(i + detail::ctz64(word));
+            word &= word - 1;
+        }
+    });
+    return out - sel;
+}
+
+/** Converts a bitmap produced by filter_bitmap to a selection vector. Returns
+    the number of stored indices. @a sel must have room for @a n indices.
+*/
+inline std::size_t bitmap_to_select(const uint64_t* bitmap, std::size_t n,
+                                    uint32_t* sel)
+{
+    uint32_t* out = sel;
+    for (std::size_t i = 0; i < n; i += 64) {
+        uint64_t word = bitmap[i / 64];
+        if (n - i < 64) {
+            word &= (uint64_t(1) << (n - i)) - 1;
+        }
+        while (word != 0) {
+            *out++ = uint32_t(i + detail::ctz64(word));
+            word &= word - 1;
+        }
+    }
+    return out - sel;
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,319 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_FIND_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_FIND_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_splat.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/detail/mask_bits.h>
+#include <simdpp/detail/mem_block.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+/*  The search functions below share the same structure. If the buffer is at
+    least one vector long, the first vector is checked with an unaligned load.
+    The main loop then continues from the next aligned boundary, rechecking a
+    few elements, and processes four aligned vectors per iteration, testing
+    their combined mask with a single extraction. The last partial vector is
+    checked with an unaligned load that ends at the end of the buffer, and
+    the elements that were already checked are masked out. Thus memory
+    outside the buffer is never accessed.
+
+    The operations are described by classes with the following members:
+     - mask<Aligned>(i): returns the mask for the elements [i, i+L)
+     - test(i): returns the result for the element i
+     - aligned_offset(): returns the index of the first element, other than
+       the 0-th, that is aligned to the vector size
+*/
+
+template<bool Aligned> struct find_load;
+
+template<> struct find_load<true> {
+    template<class V, class T>
+    static SIMDPP_INL V run(const T* p) { return load(p); }
+};
+
+template<> struct find_load<false> {
+    template<class V, class T>
+    static SIMDPP_INL V run(const T* p) { return load_u(p); }
+};
+
+template<class V, class T> SIMDPP_INL
+std::size_t find_aligned_offset(const T* p)
+{
+    std::size_t off = (reinterpret_cast<uintptr_t>(p) % sizeof(V)) / sizeof(T);
+    return off == 0 ? V::length : V::length - off;
+}
+
+// Returns the mask of bits [from, 64)
+SIMDPP_INL uint64_t find_bits_from(unsigned from)
+{
+    return from >= 64 ? 0 : ~uint64_t(0) << from;
+}
+
+template<class V>
+struct find_eq_op {
+    using T = typename V::element_type;
+    const T* p;
+    T scalar;
+    V value;
+
+    find_eq_op(const T* ptr, T v) : p(ptr), scalar(v) { value = load_splat(&v); }
+
+    template<bool A> SIMDPP_INL
+    typename V::mask_vector_type mask(std::size_t i) const
+    {
+        V x = find_load<A>::template run<V>(p + i);
+        return cmp_eq(x, value);
+    }
+
+    SIMDPP_INL bool test(std::size_t i) const { return p[i] == scalar; }
+    SIMDPP_INL std::size_t aligned_offset() const { return find_aligned_offset<V>(p); }
+};
+
+template<class V>
+struct find_any_op {
+    using T = typename V::element_type;
+    const T* p;
+    const T* set;
+    std::size_t set_size;
+
+    find_any_op(const T* ptr, const T* s, std::size_t size) :
+        p(ptr), set(s), set_size(size) {}
+
+    template<bool A> SIMDPP_INL
+    typename V::mask_vector_type mask(std::size_t i) const
+    {
+        V x = find_load<A>::template run<V>(p + i);
+        V v = load_splat(set);
+        typename V::mask_vector_type m = cmp_eq(x, v);
+        for (std::size_t k = 1; k < set_size; ++k) {
+            v = load_splat(set + k);
+            m = bit_or(m, cmp_eq(x, v));
+        }
+        return m;
+    }
+
+    SIMDPP_INL bool test(std::size_t i) const
+    {
+        for (std::size_t k = 0; k < set_size; ++k) {
+            if (p[i] == set[k]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SIMDPP_INL std::size_t aligned_offset() const { return find_aligned_offset<V>(p); }
+};
+
+// Only the first buffer can be aligned, the second one is loaded unaligned
+template<class V>
+struct find_neq_op {
+    using T = typename V::element_type;
+    const T* a;
+    const T* b;
+
+    find_neq_op(const T* pa, const T* pb) : a(pa), b(pb) {}
+
+    template<bool A> SIMDPP_INL
+    typename V::mask_vector_type mask(std::size_t i) const
+    {
+        V x = find_load<A>::template run<V>(a + i);
+        V y = load_u(b + i);
+        return cmp_neq(x, y);
+    }
+
+    SIMDPP_INL bool test(std::size_t i) const { return a[i] != b[i]; }
+    SIMDPP_INL std::size_t aligned_offset() const { return find_aligned_offset<V>(a); }
+};
+
+template<class V, class Op>
+std::size_t v_find_first(std::size_t n, const Op& op)
+{
+    const unsigned L = V::length;
+
+    if (n < L) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (op.test(i)) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    uint64_t m = mask_bits(op.template mask<false>(0));
+    if (m != 0) {
+        return ctz64(m);
+    }
+
+    std::size_t i = op.aligned_offset();
+    for (; i + 4*L <= n; i += 4*L) {
+        typename V::mask_vector_type m0, m1, m2, m3;
+        m0 = op.template mask<true>(i);
+        m1 = op.template mask<true>(i + L);
+        m2 = op.template mask<true>(i + 2*L);
+        m3 = op.template mask<true>(i + 3*L);
+        if (mask_bits(bit_or(bit_or(m0, m1), bit_or(m2, m3))) != 0) {
+            m = mask_bits(m0);
+            if (m != 0) return i + ctz64(m);
+            m = mask_bits(m1);
+            if (m != 0) return i + L + ctz64(m);
+            m = mask_bits(m2);
+            if (m != 0) return i + 2*L + ctz64(m);
+            m = mask_bits(m3);
+            return i + 3*L + ctz64(m);
+        }
+    }
+    for (; i + L <= n; i += L) {
+        m = mask_bits(op.template mask<true>(i));
+        if (m != 0) {
+            return i + ctz64(m);
+        }
+    }
+    if (i < n) {
+        std::size_t last = n - L;
+        m = mask_bits(op.template mask<false>(last));
+        m &= find_bits_from(i - last);
+        if (m != 0) {
+            return last + ctz64(m);
+        }
+    }
+    return n;
+}
+
+/*  Counts the set elements of the masks. Within the main loop the masks
+    (all ones, i.e. -1 per element) are subtracted from per-element counters,
+    which are flushed before they can overflow.
+*/
+template<class V, class Op>
+std::size_t v_count(std::size_t n, const Op& op)
+{
+    using U = typename remove_sign<V>::type;
+    const unsigned L = V::length;
+    // at most 4 additions per iteration; 8-bit counters overflow at 256
+    const unsigned max_iter = 63;
+
+    std::size_t r = 0;
+    if (n < L) {
+        for (std::size_t i = 0; i < n; ++i) {
+            r += op.test(i);
+        }
+        return r;
+    }
+
+    std::size_t i = op.aligned_offset();
+    r = popcount64(mask_bits(op.template mask<false>(0)) & ~find_bits_from(i));
+
+    while (i + 4*L <= n) {
+        U acc = U::zero();
+        for (unsigned iter = 0; iter < max_iter && i + 4*L <= n; ++iter, i += 4*L) {
+            acc = sub(acc, U(op.template mask<true>(i)));
+            acc = sub(acc, U(op.template mask<true>(i + L)));
+            acc = sub(acc, U(op.template mask<true>(i + 2*L)));
+            acc = sub(acc, U(op.template mask<true>(i + 3*L)));
+        }
+        mem_block<U> b(acc);
+        for (unsigned k = 0; k < L; ++k) {
+            r += b[k];
+        }
+    }
+    for (; i + L <= n; i += L) {
+        r += popcount64(mask_bits(op.template mask<true>(i)));
+    }
+    if (i < n) {
+        std::size_t last = n - L;
+        uint64_t m = mask_bits(op.template mask<false>(last));
+        r += popcount64(m & find_bits_from(i - last));
+    }
+    return r;
+}
+
+} // namespace detail
+
+/** Returns the index of the first element of the buffer [p, p+n) that is
+    equal to @a value, or @a n if there is no such element.
+
+    The supported element types are uint8_t, uint16_t, uint32_t and uint64_t
+    and the corresponding signed types. Memory outside the buffer is never
+    accessed.
+*/
+template<class T>
+std::size_t find_first(const T* p, std::size_t n, T value)
+{
+    using V = typename detail::fast_vector<T>::type;
+    return detail::v_find_first<V>(n, detail::find_eq_op<V>(p, value));
+}
+
+/** Returns the index of the first element of the buffer [p, p+n) that is
+    equal to any of the @a set_size elements at @a set, or @a n if there is no
+    such element.
+
+    The cost of each vector is proportional to @a set_size, the function is
+    intended for small sets such as delimiter characters.
+
+    The supported element types are the same as for find_first.
+*/
+template<class T>
+std::size_t find_first_of(const T* p, std::size_t n, const T* set,
+                          std::size_t set_size)
+{
+    using V = typename detail::fast_vector<T>::type;
+    if (set_size == 0) {
+        return n;
+    }
+    return detail::v_find_first<V>(n, detail::find_any_op<V>(p, set, set_size));
+}
+
+/** Returns the number of elements of the buffer [p, p+n) that are equal to
+    @a value.
+
+    The supported element types are the same as for find_first.
+*/
+template<class T>
+std::size_t count(const T* p, std::size_t n, T value)
+{
+    using V = typename detail::fast_vector<T>::type;
+    return detail::v_count<V>(n, detail::find_eq_op<V>(p, value));
+}
+
+/** Returns the index of the first position at which the buffers [a, a+n) and
+    [b, b+n) differ, or @a n if they are equal.
+
+    The supported element types are the same as for find_first.
+*/
+template<class T>
+std::size_t mismatch(const T* a, const T* b, std::size_t n)
+{
+    using V = typename detail::fast_vector<T>::type;
+    return detail::v_find_first<V>(n, detail::find_neq_op<V>(a, b));
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
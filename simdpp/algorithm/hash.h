@@ -0,0 +1,469 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_HASH_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_HASH_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_mull.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/set_splat.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/unzip_hi.h>
+#include <simdpp/core/unzip_lo.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The vectorized paths read the input as little-endian words and rely on
+    mull, which is not available on ALTIVEC, thus ALTIVEC uses the scalar code.
+    Both produce identical results.
+*/
+#if SIMDPP_USE_ALTIVEC
+#define SIMDPP_HASH_USE_VECTOR 0
+#else
+#define SIMDPP_HASH_USE_VECTOR 1
+#endif
+
+namespace detail {
+
+const uint32_t hash_p32_1 = 0x9e3779b1;
+const uint32_t hash_p32_2 = 0x85ebca77;
+const uint32_t hash_p32_3 = 0xc2b2ae3d;
+const uint32_t hash_p32_4 = 0x27d4eb2f;
+const uint32_t hash_p32_5 = 0x165667b1;
+const uint64_t hash_p64_1 = 0x9e3779b185ebca87;
+const uint64_t hash_p64_2 = 0xc2b2ae3d27d4eb4f;
+const uint64_t hash_p64_3 = 0x165667b19e3779f9;
+
+const unsigned hash_stripe_size = 64;
+const unsigned hash_block_stripes = 16;
+
+inline uint32_t hash_read32(const uint8_t* p)
+{
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+           uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+inline uint64_t hash_read64(const uint8_t* p)
+{
+    return uint64_t(hash_read32(p)) | uint64_t(hash_read32(p + 4)) << 32;
+}
+
+inline uint32_t hash_rotl32(uint32_t x, unsigned r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+inline uint32_t hash_fmix32(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+inline uint64_t hash_fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+}
+
+/*  Calls f(stripe, index) for each 64-byte stripe of the buffer. The last
+    partial stripe is zero-padded.
+*/
+template<class F>
+void hash_for_each_stripe(const uint8_t* p, std::size_t len, F& f)
+{
+    std::size_t s = 0;
+    for (; len >= hash_stripe_size; len -= hash_stripe_size, ++s) {
+        f(p + s * hash_stripe_size, s);
+    }
+    if (len > 0) {
+        SIMDPP_ALIGN(64) uint8_t last[hash_stripe_size] = {};
+        std::memcpy(last, p + s * hash_stripe_size, len);
+        f(last, s);
+    }
+}
+
+inline uint32_t hash32_merge(const uint32_t* acc, std::size_t len, uint32_t seed)
+{
+    uint32_t h = seed + hash_p32_5 + uint32_t(len);
+    for (unsigned i = 0; i < 16; ++i) {
+        h = hash_rotl32(h + acc[i] * hash_p32_3, 17) * hash_p32_4;
+    }
+    h ^= h >> 15;
+    h *= hash_p32_2;
+    h ^= h >> 13;
+    h *= hash_p32_3;
+    h ^= h >> 16;
+    return h;
+}
+
+inline uint64_t hash64_merge(const uint64_t* acc, std::size_t len, uint64_t seed)
+{
+    uint64_t h = uint64_t(len) * hash_p64_1 + seed;
+    for (unsigned i = 0; i < 8; ++i) {
+        h = (h ^ hash_fmix64(acc[i])) * hash_p64_2;
+    }
+    return hash_fmix64(h);
+}
+
+inline uint64_t hash64_key(uint64_t seed, unsigned i)
+{
+    return (hash_p64_1 * (i + 1)) ^ seed;
+}
+
+struct hash32_scalar_round {
+    uint32_t acc[16];
+
+    void operator()(const uint8_t* p, std::size_t)
+    {
+        for (unsigned i = 0; i < 16; ++i) {
+            acc[i] = acc[i] + hash_read32(p + 4*i) * hash_p32_2;
+            acc[i] = hash_rotl32(acc[i], 13) * hash_p32_1;
+        }
+    }
+};
+
+struct hash64_scalar_round {
+    uint64_t acc[8];
+    uint64_t key[8];
+
+    void operator()(const uint8_t* p, std::size_t s)
+    {
+        for (unsigned i = 0; i < 8; ++i) {
+            uint64_t w = hash_read64(p + 8*i);
+            uint64_t k = w ^ key[i];
+            acc[i] += w + (k & 0xffffffff) * (k >> 32);
+        }
+        if (s % hash_block_stripes == hash_block_stripes - 1) {
+            for (unsigned i = 0; i < 8; ++i) {
+                acc[i] ^= acc[i] >> 47;
+                acc[i] ^= key[7-i];
+                acc[i] *= hash_p32_1;
+            }
+        }
+    }
+};
+
+inline uint32_t hash32_scalar(const uint8_t* p, std::size_t len, uint32_t seed)
+{
+    hash32_scalar_round r;
+    for (unsigned i = 0; i < 16; ++i) {
+        r.acc[i] = seed + hash_p32_1 * (i + 1);
+    }
+    hash_for_each_stripe(p, len, r);
+    return hash32_merge(r.acc, len, seed);
+}
+
+inline uint64_t hash64_scalar(const uint8_t* p, std::size_t len, uint64_t seed)
+{
+    hash64_scalar_round r;
+    for (unsigned i = 0; i < 8; ++i) {
+        r.acc[i] = hash_p64_3 * (i + 1);
+        r.key[i] = hash64_key(seed, i);
+    }
+    hash_for_each_stripe(p, len, r);
+    return hash64_merge(r.acc, len, seed);
+}
+
+#if SIMDPP_HASH_USE_VECTOR
+// Splits 64-bit elements into their low and high 32-bit halves
+SIMDPP_INL void hash_split64(const uint64<4>& x, uint32<4>& lo, uint32<4>& hi)
+{
+    uint32<4> a, b;
+    split(uint32<8>(x), a, b);
+    lo = unzip4_lo(a, b);
+    hi = unzip4_hi(a, b);
+}
+
+/*  Multiplies 64-bit elements by a constant and returns the low 64 bits of
+    the products. The 32x32-bit partial products that affect the result are
+    computed with mull and mul_lo.
+*/
+SIMDPP_INL uint64<4> hash_mul64(const uint64<4>& x, uint64_t c)
+{
+    uint32<4> lo, hi;
+    hash_split64(x, lo, hi);
+    uint32<4> c_lo = splat(uint32_t(c));
+    uint32<4> c_hi = splat(uint32_t(c >> 32));
+    uint64<4> p = mull(lo, c_lo);
+    uint32<4> cross = add(mul_lo(lo, c_hi), mul_lo(hi, c_lo));
+    uint32<4> z = uint32<4>::zero();
+    uint32<8> cross64 = combine(zip4_lo(z, cross), zip4_hi(z, cross));
+    return add(p, uint64<4>(cross64));
+}
+
+template<unsigned S> SIMDPP_INL
+uint64<4> hash_xorshift(const uint64<4>& x)
+{
+    return bit_xor(x, shift_r<S>(x));
+}
+
+SIMDPP_INL uint64<4> hash_fmix64(const uint64<4>& x)
+{
+    uint64<4> h = hash_xorshift<33>(x);
+    h = hash_mul64(h, 0xff51afd7ed558ccd);
+    h = hash_xorshift<33>(h);
+    h = hash_mul64(h, 0xc4ceb9fe1a85ec53);
+    return hash_xorshift<33>(h);
+}
+
+struct hash32_vector_round {
+    using V = uint32<16>;
+    V acc, p1, p2;
+
+    void operator()(const uint8_t* p, std::size_t)
+    {
+        V w = load_u(p);
+        acc = add(acc, mul_lo(w, p2));
+        acc = bit_or(shift_l<13>(acc), shift_r<19>(acc));
+        acc = mul_lo(acc, p1);
+    }
+};
+
+struct hash64_vector_round {
+    using V = uint64<4>;
+    V acc0, acc1, key0, key1, rkey0, rkey1;
+
+    SIMDPP_INL static V accumulate(const V& acc, const uint8_t* p, const V& key)
+    {
+        V w = load_u(p);
+        uint32<4> lo, hi;
+        hash_split64(bit_xor(w, key), lo, hi);
+        return add(acc, add(w, mull(lo, hi)));
+    }
+
+    SIMDPP_INL static V scramble(const V& acc, const V& key)
+    {
+        V a = bit_xor(hash_xorshift<47>(acc), key);
+        return hash_mul64(a, hash_p32_1);
+    }
+
+    void operator()(const uint8_t* p, std::size_t s)
+    {
+        acc0 = accumulate(acc0, p, key0);
+        acc1 = accumulate(acc1, p + 32, key1);
+        if (s % hash_block_stripes == hash_block_stripes - 1) {
+            acc0 = scramble(acc0, rkey0);
+            acc1 = scramble(acc1, rkey1);
+        }
+    }
+};
+#endif
+
+} // namespace detail
+
+/** Computes a 32-bit hash of the buffer [data, data+len).
+
+    The buffer is split into 64-byte stripes, the last partial stripe is
+    padded with zero bytes. Each stripe is read as 16 little-endian 32-bit
+    words w[i], which are mixed into 16 independent lanes:
+
+    @code
+    acc[i] = seed + 0x9e3779b1 * (i + 1)                // initialization
+    acc[i] = rotl(acc[i] + w[i] * 0x85ebca77, 13) * 0x9e3779b1  // each stripe
+    @endcode
+
+    The lanes are then merged and the result is finalized:
+
+    @code
+    h = seed + 0x165667b1 + len
+    h = rotl(h + acc[i] * 0xc2b2ae3d, 17) * 0x27d4eb2f  // for i = 0..15
+    h ^= h >> 15; h *= 0x85ebca77; h ^= h >> 13; h *= 0xc2b2ae3d; h ^= h >> 16
+    @endcode
+
+    All arithmetic is modulo 2^32, len is truncated to 32 bits. The result
+    doesn't depend on the architecture. The hash is not cryptographic.
+*/
+inline uint32_t hash32(const void* data, std::size_t len, uint32_t seed = 0)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+#if SIMDPP_HASH_USE_VECTOR
+    detail::hash32_vector_round r;
+    SIMDPP_ALIGN(64) uint32_t init[16];
+    for (unsigned i = 0; i < 16; ++i) {
+        init[i] = seed + detail::hash_p32_1 * (i + 1);
+    }
+    r.acc = load(init);
+    r.p1 = splat(detail::hash_p32_1);
+    r.p2 = splat(detail::hash_p32_2);
+    detail::hash_for_each_stripe(p, len, r);
+    store(init, r.acc);
+    return detail::hash32_merge(init, len, seed);
+#else
+    return detail::hash32_scalar(p, len, seed);
+#endif
+}
+
+/** Computes a 64-bit hash of the buffer [data, data+len).
+
+    The buffer is split into 64-byte stripes, the last partial stripe is
+    padded with zero bytes. Each stripe is read as 8 little-endian 64-bit
+    words w[i], which are accumulated into 8 independent lanes. After every
+    16th stripe the lanes are scrambled.
+
+    @code
+    key[i] = (0x9e3779b185ebca87 * (i + 1)) ^ seed
+    acc[i] = 0x165667b19e3779f9 * (i + 1)               // initialization
+
+    k = w[i] ^ key[i]                                   // each stripe
+    acc[i] += w[i] + (k & 0xffffffff) * (k >> 32)
+
+    acc[i] ^= acc[i] >> 47                              // each 16th stripe
+    acc[i] ^= key[7-i]
+    acc[i] *= 0x9e3779b1
+    @endcode
+
+    The lanes are then merged and the result is finalized with the
+    MurmurHash3 fmix64 function:
+
+    @code
+    h = len * 0x9e3779b185ebca87 + seed
+    h = (h ^ fmix64(acc[i])) * 0xc2b2ae3d27d4eb4f       // for i = 0..7
+    h = fmix64(h)
+    @endcode
+
+    All arithmetic is modulo 2^64. The result doesn't depend on the
+    architecture. The hash is not cryptographic.
+*/
+inline uint64_t hash64(const void* data, std::size_t len, uint64_t seed = 0)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+#if SIMDPP_HASH_USE_VECTOR
+    detail::hash64_vector_round r;
+    SIMDPP_ALIGN(32) uint64_t acc[8];
+    SIMDPP_ALIGN(32) uint64_t key[8];
+    SIMDPP_ALIGN(32) uint64_t rkey[8];
+    for (unsigned i = 0; i < 8; ++i) {
+        acc[i] = detail::hash_p64_3 * (i + 1);
+        key[i] = detail::hash64_key(seed, i);
+        rkey[i] = detail::hash64_key(seed, 7 - i);
+    }
+    r.acc0 = load(acc);
+    r.acc1 = load(acc + 4);
+    r.key0 = load(key);
+    r.key1 = load(key + 4);
+    r.rkey0 = load(rkey);
+    r.rkey1 = load(rkey + 4);
+    detail::hash_for_each_stripe(p, len, r);
+    store(acc, r.acc0);
+    store(acc + 4, r.acc1);
+    return detail::hash64_merge(acc, len, seed);
+#else
+    return detail::hash64_scalar(p, len, seed);
+#endif
+}
+
+/** Hashes @a n 32-bit keys, one key per vector element, and stores the
+    results to @a out. The keys and the results may alias.
+
+    @code
+    out[i] = fmix32(keys[i] ^ fmix32(seed + 0x9e3779b1))
+    @endcode
+
+    fmix32 is the MurmurHash3 finalizer:
+    @code
+    h ^= h >> 16; h *= 0x85ebca6b; h ^= h >> 13; h *= 0xc2b2ae35; h ^= h >> 16
+    @endcode
+*/
+inline void hash32_batch(const uint32_t* keys, std::size_t n, uint32_t seed,
+                         uint32_t* out)
+{
+    using V = uint32v;
+    const unsigned L = V::length;
+    uint32_t s = detail::hash_fmix32(seed + detail::hash_p32_1);
+    std::size_t i = 0;
+
+    V vs = splat(s);
+    V c1 = splat(0x85ebca6b);
+    V c2 = splat(0xc2b2ae35);
+    for (; i + L <= n; i += L) {
+        V h = load_u(keys + i);
+        h = bit_xor(h, vs);
+        h = bit_xor(h, shift_r<16>(h));
+        h = mul_lo(h, c1);
+        h = bit_xor(h, shift_r<13>(h));
+        h = mul_lo(h, c2);
+        h = bit_xor(h, shift_r<16>(h));
+        store_u(out + i, h);
+    }
+    for (; i < n; ++i) {
+        out[i] = detail::hash_fmix32(keys[i] ^ s);
+    }
+}
+
+/** Hashes @a n 64-bit keys, one key per vector element, and stores the
+    results to @a out. The keys and the results may alias.
+
+    @code
+    out[i] = fmix64(keys[i] ^ fmix64(seed + 0x9e3779b185ebca87))
+    @endcode
+
+    fmix64 is the MurmurHash3 finalizer:
+    @code
+    h ^= h >> 33; h *= 0xff51afd7ed558ccd; h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53; h ^= h >> 33
+    @endcode
+
+    The 64-bit multiplications are composed of 32-bit multiplications.
+*/
+inline void hash64_batch(const uint64_t* keys, std::size_t n, uint64_t seed,
+                         uint64_t* out)
+{
+    uint64_t s = detail::hash_fmix64(seed + detail::hash_p64_1);
+    std::size_t i = 0;
+#if SIMDPP_HASH_USE_VECTOR
+    using V = uint64<4>;
+    V vs = splat(s);
+    for (; i + 4 <= n; i += 4) {
+        V h = load_u(keys + i);
+        h = detail::hash_fmix64(bit_xor(h, vs));
+        store_u(out + i, h);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = detail::hash_fmix64(keys[i] ^ s);
+    }
+}
+
+#undef SIMDPP_HASH_USE_VECTOR
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,446 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_HASH_TABLE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_HASH_TABLE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/cache.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/set_splat.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+/*  The hash tables use open addressing. The slots are split into groups of
+    hash_group_size slots, each slot has a control byte that is either empty,
+    deleted or holds the 7 low bits of the hash of the key (h2). A lookup
+    compares all control bytes of a group with h2 at once and checks the keys
+    of the matching slots only. The remaining bits of the hash select the
+    first group (h1), the next groups are probed quadratically until a group
+    with an empty slot is found.
+*/
+const unsigned hash_group_size = SIMDPP_FAST_INT8_SIZE;
+
+const uint8_t hash_ctrl_empty = 0x80;
+const uint8_t hash_ctrl_deleted = 0xfe;
+
+SIMDPP_INL uint64_t hash_group_bits(const uint8x16& m)
+{
+    return byte_mask_bits_sparse(m);
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint64_t hash_group_bits(const uint8x32& m)
+{
+    return extract_bits_any(m);
+}
+#endif
+
+// Returns the index of the slot that corresponds to the lowest set bit
+SIMDPP_INL unsigned hash_bit_index(uint64_t bits)
+{
+    return ctz64(bits) >> byte_mask_sparse_shift;
+}
+
+struct hash_group {
+    using V = uint8<hash_group_size>;
+    using S = int8<hash_group_size>;
+    V ctrl;
+
+    hash_group(const uint8_t* p) { ctrl = load(p); }
+
+    SIMDPP_INL uint64_t match(uint8_t h2) const
+    {
+        V v = splat(h2);
+        return hash_group_bits(V(cmp_eq(ctrl, v)));
+    }
+
+    SIMDPP_INL uint64_t match_empty() const
+    {
+        V v = splat(hash_ctrl_empty);
+        return hash_group_bits(V(cmp_eq(ctrl, v)));
+    }
+
+    // empty and deleted slots have the most significant bit set
+    SIMDPP_INL uint64_t match_free() const
+    {
+        return hash_group_bits(V(cmp_lt(S(ctrl), S::zero())));
+    }
+};
+
+/*  The table stores the slots in a vector, thus the keys and values must be
+    default constructible and assignable. Slot must have a member named first
+    that holds the key.
+*/
+template<class Slot, class K, class Hash, class Eq>
+class hash_table {
+public:
+    static const std::size_t npos = std::size_t(-1);
+    static const unsigned G = hash_group_size;
+    // prefetch distance of the batch lookups, in keys
+    static const unsigned batch_distance = 8;
+
+    hash_table(std::size_t capacity, const Hash& hash, const Eq& eq) :
+        group_mask_(0), size_(0), growth_left_(0), hash_(hash), eq_(eq)
+    {
+        resize(groups_for(capacity));
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return slots_.size(); }
+
+    void clear()
+    {
+        std::size_t groups = group_mask_ + 1;
+        ctrl_.clear();
+        slots_.clear();
+        resize(groups);
+    }
+
+    void reserve(std::size_t n)
+    {
+        std::size_t groups = groups_for(n);
+        if (groups > group_mask_ + 1) {
+            rehash(groups);
+        }
+    }
+
+    std::size_t find(const K& key) const
+    {
+        return find_hashed(key, hash_key(key));
+    }
+
+    /*  Stores the index of the slot of each key, or npos, to idx. The control
+        groups and the slots of the keys that are looked up batch_distance
+        keys later are prefetched so that the lookups overlap the cache
+        misses of the later ones.
+    */
+    void find_batch(const K* keys, std::size_t n, std::size_t* idx) const
+    {
+        const unsigned D = batch_distance;
+        uint64_t hashes[D];
+        for (std::size_t i = 0; i < D && i < n; ++i) {
+            hashes[i] = hash_key(keys[i]);
+            prefetch_group(hashes[i]);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            uint64_t h = hashes[i % D];
+            if (i + D < n) {
+                hashes[i % D] = hash_key(keys[i + D]);
+                prefetch_group(hashes[i % D]);
+            }
+            idx[i] = find_hashed(keys[i], h);
+        }
+    }
+
+    /*  Returns the index of the slot of the key and whether the key was
+        inserted. The key of a new slot is set, the rest of the slot is left
+        as is.
+    */
+    std::pair<std::size_t, bool> insert(const K& key)
+    {
+        uint64_t h = hash_key(key);
+        std::size_t i = find_hashed(key, h);
+        if (i != npos) {
+            return std::make_pair(i, false);
+        }
+        i = find_free(h);
+        if (growth_left_ == 0 && ctrl_[i] == hash_ctrl_empty) {
+            // grow, or only drop the deleted slots if there are many
+            std::size_t groups = group_mask_ + 1;
+            rehash(size_ + 1 > capacity() / 2 ? groups * 2 : groups);
+            i = find_free(h);
+        }
+        if (ctrl_[i] == hash_ctrl_empty) {
+            growth_left_--;
+        }
+        ctrl_[i] = hash_h2(h);
+        slots_[i].first = key;
+        size_++;
+        return std::make_pair(i, true);
+    }
+
+    bool erase(const K& key)
+    {
+        std::size_t i = find(key);
+        if (i == npos) {
+            return false;
+        }
+        ctrl_[i] = hash_ctrl_deleted;
+        slots_[i] = Slot();
+        size_--;
+        return true;
+    }
+
+    Slot& slot(std::size_t i) { return slots_[i]; }
+    const Slot& slot(std::size_t i) const { return slots_[i]; }
+
+private:
+    static std::size_t groups_for(std::size_t n)
+    {
+        // the maximum load factor is 7/8
+        std::size_t groups = 1;
+        while (groups * G * 7 / 8 < n) {
+            groups *= 2;
+        }
+        return groups;
+    }
+
+    uint64_t hash_key(const K& key) const
+    {
+        // std::hash is often the identity function for integers
+        uint64_t h = uint64_t(hash_(key)) * 0x9e3779b97f4a7c15ull;
+        return h ^ (h >> 29);
+    }
+
+    static uint8_t hash_h2(uint64_t h) { return h & 0x7f; }
+
+    std::size_t hash_group_index(uint64_t h) const
+    {
+        return std::size_t(h >> 7) & group_mask_;
+    }
+
+    void prefetch_group(uint64_t h) const
+    {
+        std::size_t g = hash_group_index(h);
+        prefetch_read(ctrl_.data() + g * G);
+        prefetch_read(slots_.data() + g * G);
+    }
+
+    std::size_t find_hashed(const K& key, uint64_t h) const
+    {
+        uint8_t h2 = hash_h2(h);
+        std::size_t g = hash_group_index(h);
+        for (std::size_t step = 1; ; ++step) {
+            hash_group group(ctrl_.data() + g * G);
+            uint64_t m = group.match(h2);
+            while (m != 0) {
+                std::size_t i = g * G + hash_bit_index(m);
+                if (eq_(slots_[i].first, key)) {
+                    return i;
+                }
+                m &= m - 1;
+            }
+            if (group.match_empty() != 0) {
+                return npos;
+            }
+            g = (g + step) & group_mask_;
+        }
+    }
+
+    // Returns the first empty or deleted slot on the probe sequence
+    std::size_t find_free(uint64_t h) const
+    {
+        std::size_t g = hash_group_index(h);
+        for (std::size_t step = 1; ; ++step) {
+            hash_group group(ctrl_.data() + g * G);
+            uint64_t m = group.match_free();
+            if (m != 0) {
+                return g * G + hash_bit_index(m);
+            }
+            g = (g + step) & group_mask_;
+        }
+    }
+
+    void resize(std::size_t groups)
+    {
+        ctrl_.assign(groups * G, hash_ctrl_empty);
+        slots_.resize(groups * G);
+        group_mask_ = groups - 1;
+        growth_left_ = groups * G * 7 / 8;
+        size_ = 0;
+    }
+
+    void rehash(std::size_t groups)
+    {
+        std::vector<uint8_t, aligned_allocator<uint8_t, G>> old_ctrl;
+        std::vector<Slot> old_slots;
+        old_ctrl.swap(ctrl_);
+        old_slots.swap(slots_);
+        resize(groups);
+
+        for (std::size_t i = 0; i < old_ctrl.size(); ++i) {
+            if ((old_ctrl[i] & 0x80) == 0) {
+                uint64_t h = hash_key(old_slots[i].first);
+                std::size_t j = find_free(h);
+                ctrl_[j] = hash_h2(h);
+                slots_[j] = std::move(old_slots[i]);
+                growth_left_--;
+                size_++;
+            }
+        }
+    }
+
+    std::vector<uint8_t, aligned_allocator<uint8_t, G>> ctrl_;
+    std::vector<Slot> slots_;
+    std::size_t group_mask_;
+    std::size_t size_;
+    std::size_t growth_left_;
+    Hash hash_;
+    Eq eq_;
+};
+
+template<class K, class V>
+struct hash_map_slot {
+    K first;
+    V second;
+};
+
+template<class K>
+struct hash_set_slot {
+    K first;
+};
+
+} // namespace detail
+
+/** An open-addressing hash map that looks up groups of 16 slots (32 on AVX2)
+    at once using the control bytes of the slots.
+
+    The keys and the values must be default constructible and assignable. The
+    references and pointers to the values are invalidated by insertions.
+*/
+template<class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class hash_map {
+public:
+    hash_map(std::size_t capacity = 0, const Hash& hash = Hash(),
+             const Eq& eq = Eq()) :
+        table_(capacity, hash, eq) {}
+
+    std::size_t size() const { return table_.size(); }
+    bool empty() const { return table_.size() == 0; }
+    void clear() { table_.clear(); }
+    void reserve(std::size_t n) { table_.reserve(n); }
+
+    /// Inserts the key if it's not present. Returns whether it was inserted.
+    bool insert(const K& key, const V& value)
+    {
+        std::pair<std::size_t, bool> r = table_.insert(key);
+        if (r.second) {
+            table_.slot(r.first).second = value;
+        }
+        return r.second;
+    }
+
+    /// Returns the value of the key, inserting a default value if needed.
+    V& operator[](const K& key)
+    {
+        std::pair<std::size_t, bool> r = table_.insert(key);
+        if (r.second) {
+            table_.slot(r.first).second = V();
+        }
+        return table_.slot(r.first).second;
+    }
+
+    /// Returns a pointer to the value of the key or nullptr if not present.
+    V* find(const K& key)
+    {
+        std::size_t i = table_.find(key);
+        return i == table_.npos ? nullptr : &table_.slot(i).second;
+    }
+
+    const V* find(const K& key) const
+    {
+        std::size_t i = table_.find(key);
+        return i == table_.npos ? nullptr : &table_.slot(i).second;
+    }
+
+    /** Looks up @a n keys and stores the pointers to their values, or nullptr,
+        to @a values. Returns the number of found keys. The memory of later
+        keys is prefetched while the earlier ones are looked up.
+    */
+    std::size_t find_batch(const K* keys, std::size_t n, const V** values) const
+    {
+        std::size_t idx[256];
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < n; i += 256) {
+            std::size_t m = n - i < 256 ? n - i : 256;
+            table_.find_batch(keys + i, m, idx);
+            for (std::size_t k = 0; k < m; ++k) {
+                if (idx[k] == table_.npos) {
+                    values[i + k] = nullptr;
+                } else {
+                    values[i + k] = &table_.slot(idx[k]).second;
+                    found++;
+                }
+            }
+        }
+        return found;
+    }
+
+    bool erase(const K& key) { return table_.erase(key); }
+
+private:
+    detail::hash_table<detail::hash_map_slot<K, V>, K, Hash, Eq> table_;
+};
+
+/** An open-addressing hash set. See hash_map for details.
+*/
+template<class K, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class hash_set {
+public:
+    hash_set(std::size_t capacity = 0, const Hash& hash = Hash(),
+             const Eq& eq = Eq()) :
+        table_(capacity, hash, eq) {}
+
+    std::size_t size() const { return table_.size(); }
+    bool empty() const { return table_.size() == 0; }
+    void clear() { table_.clear(); }
+    void reserve(std::size_t n) { table_.reserve(n); }
+
+    /// Inserts the key if it's not present. Returns whether it was inserted.
+    bool insert(const K& key) { return table_.insert(key).second; }
+
+    bool contains(const K& key) const { return table_.find(key) != table_.npos; }
+
+    /** Looks up @a n keys and stores whether each is present to @a found.
+        Returns the number of present keys.
+    */
+    std::size_t contains_batch(const K* keys, std::size_t n, bool* found) const
+    {
+        std::size_t idx[256];
+        std::size_t r = 0;
+        for (std::size_t i = 0; i < n; i += 256) {
+            std::size_t m = n - i < 256 ? n - i : 256;
+            table_.find_batch(keys + i, m, idx);
+            for (std::size_t k = 0; k < m; ++k) {
+                found[i + k] = idx[k] != table_.npos;
+                r += found[i + k];
+            }
+        }
+        return r;
+    }
+
+    bool erase(const K& key) { return table_.erase(key); }
+
+private:
+    detail::hash_table<detail::hash_set_slot<K>, K, Hash, Eq> table_;
+};
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,279 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_MOTION_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_MOTION_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_sad.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The search strategies of block motion estimation
+enum class motion_search {
+    /// Every candidate within the search window is evaluated
+    full,
+    /** The large diamond pattern (8 points at distance 2) is moved to the
+        best candidate until the center is the best, then the small diamond
+        pattern (4 points at distance 1) refines the result. Finds a local
+        minimum only, but evaluates far fewer candidates.
+    */
+    diamond
+};
+
+/// The result of a block motion search
+struct motion_vector {
+    /// The horizontal offset of the best matching block in the reference
+    int x;
+    /// The vertical offset of the best matching block in the reference
+    int y;
+    /// The sum of absolute differences between the blocks
+    unsigned sad;
+};
+
+/*  The blocks are compared with sad on 128-bit vectors: a row of a 16x16
+    block or two rows of an 8x8 block per vector. The rows of the current
+    block are loaded once per search and kept in registers, thus each
+    candidate costs one unaligned load and one sad per vector.
+*/
+
+namespace detail {
+
+SIMDPP_INL uint8<16> motion_load2x8(const uint8_t* p, std::size_t stride)
+{
+    uint64_t r0, r1;
+    std::memcpy(&r0, p, 8);
+    std::memcpy(&r1, p + stride, 8);
+    return uint8<16>(uint64<2>(make_uint(r0, r1)));
+}
+
+SIMDPP_INL unsigned motion_total(const uint64<2>& s)
+{
+    return unsigned(extract<0>(s) + extract<1>(s));
+}
+
+// The rows of the current block of S x S pixels
+template<unsigned S> struct motion_block;
+
+template<> struct motion_block<16> {
+    uint8<16> r[16];
+
+    SIMDPP_INL motion_block(const uint8_t* p, std::size_t stride)
+    {
+        for (unsigned i = 0; i < 16; ++i) {
+            r[i] = load_u(p + i*stride);
+        }
+    }
+
+    SIMDPP_INL unsigned sad_with(const uint8_t* p, std::size_t stride) const
+    {
+        uint64<2> s = sad(r[0], (uint8<16>) load_u(p));
+        for (unsigned i = 1; i < 16; ++i) {
+            s = add(s, sad(r[i], (uint8<16>) load_u(p + i*stride)));
+        }
+        return motion_total(s);
+    }
+};
+
+template<> struct motion_block<8> {
+    uint8<16> r[4];
+
+    SIMDPP_INL motion_block(const uint8_t* p, std::size_t stride)
+    {
+        for (unsigned i = 0; i < 4; ++i) {
+            r[i] = motion_load2x8(p + 2*i*stride, stride);
+        }
+    }
+
+    SIMDPP_INL unsigned sad_with(const uint8_t* p, std::size_t stride) const
+    {
+        uint64<2> s = sad(r[0], motion_load2x8(p, stride));
+        for (unsigned i = 1; i < 4; ++i) {
+            s = add(s, sad(r[i], motion_load2x8(p + 2*i*stride, stride)));
+        }
+        return motion_total(s);
+    }
+};
+
+struct motion_window {
+    int x0, x1, y0, y1;
+
+    bool contains(int x, int y) const
+    {
+        return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+    }
+};
+
+template<unsigned S>
+motion_vector motion_search_full(const motion_block<S>& cur, const uint8_t* ref,
+                                 std::size_t stride, const motion_window& w)
+{
+    motion_vector best = { 0, 0, cur.sad_with(ref, stride) };
+    for (int y = w.y0; y <= w.y1; ++y) {
+        const uint8_t* row = ref + std::ptrdiff_t(y) * std::ptrdiff_t(stride);
+        for (int x = w.x0; x <= w.x1; ++x) {
+            unsigned s = cur.sad_with(row + x, stride);
+            if (s < best.sad) {
+                best.x = x;
+                best.y = y;
+                best.sad = s;
+            }
+        }
+    }
+    return best;
+}
+
+// Moves best to the best of the given offsets from it, returns whether moved
+template<unsigned S>
+bool motion_diamond_step(const motion_block<S>& cur, const uint8_t* ref,
+                         std::size_t stride, const motion_window& w,
+                         const int (*pattern)[2], unsigned n, motion_vector& best)
+{
+    motion_vector c = best;
+    for (unsigned i = 0; i < n; ++i) {
+        int x = c.x + pattern[i][0];
+        int y = c.y + pattern[i][1];
+        if (!w.contains(x, y)) {
+            continue;
+        }
+        const uint8_t* p = ref + std::ptrdiff_t(y) * std::ptrdiff_t(stride) + x;
+        unsigned s = cur.sad_with(p, stride);
+        if (s < best.sad) {
+            best.x = x;
+            best.y = y;
+            best.sad = s;
+        }
+    }
+    return best.x != c.x || best.y != c.y;
+}
+
+template<unsigned S>
+motion_vector motion_search_diamond(const motion_block<S>& cur, const uint8_t* ref,
+                                    std::size_t stride, const motion_window& w)
+{
+    static const int large[8][2] = {
+        { 0, -2 }, { -1, -1 }, { 1, -1 }, { -2, 0 },
+        { 2, 0 }, { -1, 1 }, { 1, 1 }, { 0, 2 }
+    };
+    static const int small[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+
+    motion_vector best = { 0, 0, cur.sad_with(ref, stride) };
+    // Each step strictly decreases the SAD, thus the loop terminates
+    while (motion_diamond_step(cur, ref, stride, w, large, 8, best)) {}
+    motion_diamond_step(cur, ref, stride, w, small, 4, best);
+    return best;
+}
+
+template<unsigned S>
+motion_vector motion_search_block(const uint8_t* cur, std::size_t cur_stride,
+                                  const uint8_t* ref, std::size_t ref_stride,
+                                  const motion_window& w, motion_search method)
+{
+    motion_block<S> b(cur, cur_stride);
+    if (method == motion_search::full) {
+        return motion_search_full(b, ref, ref_stride, w);
+    }
+    return motion_search_diamond(b, ref, ref_stride, w);
+}
+
+} // namespace detail
+
+/** Returns the sum of absolute differences between the blocks of 16x16
+    pixels at @a a and @a b. The strides are in bytes.
+*/
+inline unsigned block_sad_16x16(const uint8_t* a, std::size_t a_stride,
+                                const uint8_t* b, std::size_t b_stride)
+{
+    return detail::motion_block<16>(a, a_stride).sad_with(b, b_stride);
+}
+
+/** Returns the sum of absolute differences between the blocks of 8x8
+    pixels at @a a and @a b. The strides are in bytes.
+*/
+inline unsigned block_sad_8x8(const uint8_t* a, std::size_t a_stride,
+                              const uint8_t* b, std::size_t b_stride)
+{
+    return detail::motion_block<8>(a, a_stride).sad_with(b, b_stride);
+}
+
+/** Finds the block of the reference image that best matches the block of
+    @a size x @a size pixels at @a cur. @a ref points to the pixel of the
+    reference image at the position of the block. The candidates are the
+    blocks at the offsets [@a x0, @a x1] x [@a y0, @a y1] from @a ref, the
+    range must include zero and all candidate blocks must be readable.
+
+    @a size must be 8 or 16. The strides are in bytes. Of several candidates
+    with the same SAD the zero offset is preferred, then the one found first.
+*/
+inline motion_vector block_motion_search(const uint8_t* cur, std::size_t cur_stride,
+                                         const uint8_t* ref, std::size_t ref_stride,
+                                         unsigned size, int x0, int x1, int y0, int y1,
+                                         motion_search method)
+{
+    detail::motion_window w = { x0, x1, y0, y1 };
+    if (size == 8) {
+        return detail::motion_search_block<8>(cur, cur_stride, ref, ref_stride, w, method);
+    }
+    return detail::motion_search_block<16>(cur, cur_stride, ref, ref_stride, w, method);
+}
+
+/** Estimates the motion of each block of @a size x @a size pixels of the
+    image @a cur relative to the image @a ref. Both images have
+    @a width x @a height pixels and the same @a stride in bytes. The blocks
+    are searched within @a range pixels in each direction, limited to the
+    reference image.
+
+    The results are stored to @a out in the order of the blocks in the
+    image, (width / size) * (height / size) in total. Partial blocks at the
+    right and the bottom edges are skipped. @a size must be 8 or 16.
+
+    The blocks are independent, thus the image can be split into bands of
+    block rows which are processed by separate threads.
+*/
+inline void motion_estimate(const uint8_t* cur, const uint8_t* ref, std::size_t stride,
+                            std::size_t width, std::size_t height, unsigned size,
+                            int range, motion_search method, motion_vector* out)
+{
+    std::size_t bw = width / size;
+    std::size_t bh = height / size;
+    for (std::size_t by = 0; by < bh; ++by) {
+        for (std::size_t bx = 0; bx < bw; ++bx) {
+            int px = int(bx * size);
+            int py = int(by * size);
+            int mx = int(width - size) - px;
+            int my = int(height - size) - py;
+            int x0 = -range > -px ? -range : -px;
+            int y0 = -range > -py ? -range : -py;
+            int x1 = range < mx ? range : mx;
+            int y1 = range < my ? range : my;
+            std::size_t off = std::size_t(py) * stride + std::size_t(px);
+            *out++ = block_motion_search(cur + off, stride, ref + off, stride, size,
+                                         x0, x1, y0, y1, method);
+        }
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
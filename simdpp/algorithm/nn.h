@@ -0,0 +1,354 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_NN_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_NN_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/cmp_gt.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_div.h>
+#include <simdpp/core/f_max.h>
+#include <simdpp/core/f_min.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/f_rsqrt_e.h>
+#include <simdpp/core/f_rsqrt_rh.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/make_int.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/madd.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  Row kernels of neural network inference. Each kernel makes at most two
+    passes over a row of float32 values and does not allocate. The rows are
+    processed in vectors of twice the native width so that the reductions
+    keep two independent accumulators. The elements past the last full
+    vector are processed one at a time; the exponent is then computed by the
+    same vector code, thus the results of softmax and gelu do not depend on
+    the position of an element within the row.
+
+    The exponent is computed by nn_exp: the argument is split into
+    n*ln(2) + r with |r| <= ln(2)/2 and exp(r) is approximated by a
+    polynomial of degree 6 (the Cephes expf coefficients), 2^n is assembled
+    in the exponent bits. The relative error is within 2 ulp where the
+    result is a finite normal number. The result is 0 for the arguments
+    below that range, the arguments above it are clamped. nn_gelu returns 0
+    where exp overflows, i.e. for x below about -10.1. The exact result is
+    then below 5e-38 in magnitude.
+
+    The results depend on the architecture within the rounding error, because
+    fmadd is used only where it is supported.
+*/
+
+namespace detail {
+
+static const unsigned nn_width = SIMDPP_FAST_FLOAT32_SIZE * 2;
+using nn_vector = float32<nn_width>;
+
+template<unsigned N> SIMDPP_INL
+float32<N> nn_exp(const float32<N>& x)
+{
+    using F = float32<N>;
+    using I = int32<N>;
+
+    // 1.5 * 2^23: adding it rounds to an integer kept in the low mantissa bits
+    const F round_magic = make_float(12582912.0);
+    const F lo = make_float(-87.3365478515625), hi = make_float(88.3762626647949);
+    F a = min(max(x, lo), hi);
+    F t = madd(a, F(make_float(1.44269504088896341)), round_magic);
+    F n = sub(t, round_magic);
+    F r = sub(a, mul(n, 0.693359375));
+    r = sub(r, mul(n, -2.12194440e-4));
+
+    F p = make_float(1.9875691500e-4);
+    p = madd(p, r, F(make_float(1.3981999507e-3)));
+    p = madd(p, r, F(make_float(8.3334519073e-3)));
+    p = madd(p, r, F(make_float(4.1665795894e-2)));
+    p = madd(p, r, F(make_float(1.6666665459e-1)));
+    p = madd(p, r, F(make_float(5.0000001201e-1)));
+    p = madd(F(mul(p, r)), r, F(add(r, 1.0)));
+
+    /*  The low bits of t hold n + 2^22; (n + 127) << 23 is the exponent of
+        2^n, the higher bits are shifted out.
+    */
+    I e = add(I(t), I(make_int(127)));
+    e = shift_l<23>(e);
+    return bit_andnot(F(mul(p, F(e))), cmp_lt(x, lo));
+}
+
+// GELU with the tanh approximation: x * sigmoid(2*sqrt(2/pi)*(x + 0.044715*x^3))
+template<unsigned N> SIMDPP_INL
+float32<N> nn_gelu(const float32<N>& x)
+{
+    using F = float32<N>;
+    F x2 = mul(x, x);
+    F z = mul(x, F(madd(x2, F(make_float(-0.0713548162726)),
+                        F(make_float(-1.59576912160573)))));
+    F r = div(x, F(add(nn_exp(z), 1.0)));
+    return bit_andnot(r, cmp_gt(z, F(make_float(88.3762626647949))));
+}
+
+// Applies a vector function to a scalar
+template<class F> SIMDPP_INL
+float nn_scalar(F f, float x)
+{
+    float32<4> v = splat(x);
+    return extract<0>(f(v));
+}
+
+SIMDPP_INL float nn_reduce_add(const float32<4>& a)
+{
+    SIMDPP_ALIGN(16) float t[4];
+    store(t, a);
+    return (t[0] + t[1]) + (t[2] + t[3]);
+}
+
+template<unsigned N> SIMDPP_INL
+float nn_reduce_add(const float32<N>& a)
+{
+    float32<N/2> l, h;
+    split(a, l, h);
+    return nn_reduce_add(float32<N/2>(add(l, h)));
+}
+
+SIMDPP_INL float nn_reduce_max(const float32<4>& a)
+{
+    SIMDPP_ALIGN(16) float t[4];
+    store(t, a);
+    return std::max(std::max(t[0], t[1]), std::max(t[2], t[3]));
+}
+
+template<unsigned N> SIMDPP_INL
+float nn_reduce_max(const float32<N>& a)
+{
+    float32<N/2> l, h;
+    split(a, l, h);
+    return nn_reduce_max(float32<N/2>(max(l, h)));
+}
+
+} // namespace detail
+
+/** Computes max(x, 0) for each element of the row @a in of @a n elements.
+    @a out may be the same array as @a in.
+*/
+inline void relu(const float* in, std::size_t n, float* out)
+{
+    using V = detail::nn_vector;
+    const unsigned W = detail::nn_width;
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        V x = load_u(in + i);
+        store_u(out + i, max(x, V::zero()));
+    }
+    for (; i < n; ++i) {
+        out[i] = std::max(in[i], 0.0f);
+    }
+}
+
+/** Computes GELU for each element of the row @a in of @a n elements using
+    the tanh approximation:
+
+    @code
+    gelu(x) = 0.5 * x * (1 + tanh(sqrt(2/pi) * (x + 0.044715 * x^3)))
+    @endcode
+
+    @a out may be the same array as @a in.
+*/
+inline void gelu(const float* in, std::size_t n, float* out)
+{
+    using V = detail::nn_vector;
+    const unsigned W = detail::nn_width;
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        V x = load_u(in + i);
+        store_u(out + i, detail::nn_gelu(x));
+    }
+    for (; i < n; ++i) {
+        out[i] = detail::nn_scalar(detail::nn_gelu<4>, in[i]);
+    }
+}
+
+/** Computes the softmax of the row @a in of @a n elements:
+
+    @code
+    out[i] = exp(in[i] - max(in)) / sum(exp(in[j] - max(in)))
+    @endcode
+
+    The row is split into at most 64 blocks of at least 1024 elements. The
+    first pass stores exp(in[i] - m) for each block, where m is the maximum
+    of the block, and combines the sums of the blocks relative to the
+    running maximum; a block is read twice while it is in the cache. The
+    second pass multiplies each block by exp(m - max(in)) / sum. Thus the
+    exponent is computed once per element. @a out may be the same array as
+    @a in.
+*/
+inline void softmax(const float* in, std::size_t n, float* out)
+{
+    using V = detail::nn_vector;
+    using detail::nn_exp;
+    using detail::nn_scalar;
+    const unsigned W = detail::nn_width;
+    const std::size_t max_blocks = 64;
+
+    std::size_t block = std::max<std::size_t>(1024, (n + max_blocks - 1) / max_blocks);
+    block = (block + W - 1) / W * W;
+
+    float bmax[max_blocks];
+    float m = std::numeric_limits<float>::lowest();
+    float s = 0;
+    for (std::size_t b = 0, i0 = 0; i0 < n; ++b, i0 += block) {
+        const float* src = in + i0;
+        float* dst = out + i0;
+        std::size_t len = std::min(block, n - i0);
+        std::size_t vlen = len / W * W;
+
+        V vm = splat(std::numeric_limits<float>::lowest());
+        for (std::size_t i = 0; i < vlen; i += W) {
+            vm = max(vm, V(load_u(src + i)));
+        }
+        float bm = detail::nn_reduce_max(vm);
+        for (std::size_t i = vlen; i < len; ++i) {
+            bm = std::max(bm, src[i]);
+        }
+
+        V vbm = splat(bm);
+        V vs = V::zero();
+        for (std::size_t i = 0; i < vlen; i += W) {
+            V e = nn_exp(V(sub(V(load_u(src + i)), vbm)));
+            store_u(dst + i, e);
+            vs = add(vs, e);
+        }
+        float bs = detail::nn_reduce_add(vs);
+        for (std::size_t i = vlen; i < len; ++i) {
+            float e = nn_scalar(nn_exp<4>, src[i] - bm);
+            dst[i] = e;
+            bs += e;
+        }
+
+        if (bm > m) {
+            s = s * nn_scalar(nn_exp<4>, m - bm) + bs;
+            m = bm;
+        } else {
+            s += bs * nn_scalar(nn_exp<4>, bm - m);
+        }
+        bmax[b] = bm;
+    }
+
+    for (std::size_t b = 0, i0 = 0; i0 < n; ++b, i0 += block) {
+        float* dst = out + i0;
+        std::size_t len = std::min(block, n - i0);
+        float f = nn_scalar(nn_exp<4>, bmax[b] - m) / s;
+        V vf = splat(f);
+        std::size_t i = 0;
+        for (; i + W <= len; i += W) {
+            store_u(dst + i, mul(V(load_u(dst + i)), vf));
+        }
+        for (; i < len; ++i) {
+            dst[i] *= f;
+        }
+    }
+}
+
+/** Normalizes the row @a in of @a n elements to zero mean and unit
+    variance, then scales and shifts it:
+
+    @code
+    out[i] = (in[i] - mean) / sqrt(variance + eps) * gamma[i] + beta[i]
+    @endcode
+
+    @a gamma and @a beta may be null, which is the same as all ones and all
+    zeros respectively. The first pass computes the sums of the elements and
+    of their squares, shifted by the first element to limit the
+    cancellation. The reciprocal square root is an estimate refined by one
+    Newton-Raphson step. @a out may be the same array as @a in.
+*/
+inline void layer_norm(const float* in, std::size_t n, const float* gamma,
+                       const float* beta, float eps, float* out)
+{
+    using V = detail::nn_vector;
+    using detail::madd;
+    const unsigned W = detail::nn_width;
+    if (n == 0) {
+        return;
+    }
+
+    float k = in[0];
+    V vk = splat(k);
+    V s1 = V::zero(), s2 = V::zero();
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        V d = sub(V(load_u(in + i)), vk);
+        s1 = add(s1, d);
+        s2 = madd(d, d, s2);
+    }
+    float t1 = detail::nn_reduce_add(s1);
+    float t2 = detail::nn_reduce_add(s2);
+    for (; i < n; ++i) {
+        float d = in[i] - k;
+        t1 += d;
+        t2 += d * d;
+    }
+    float dm = t1 / n;
+    float var = std::max(t2 / n - dm * dm, 0.0f);
+    float mean = k + dm;
+
+    float32<4> va = splat(var + eps);
+    float32<4> vr0 = rsqrt_e(va);
+    float rstd = extract<0>(rsqrt_rh(vr0, va));
+
+    V vm = splat(mean), vr = splat(rstd);
+    for (i = 0; i + W <= n; i += W) {
+        V x = mul(V(sub(V(load_u(in + i)), vm)), vr);
+        if (gamma && beta) {
+            x = madd(x, V(load_u(gamma + i)), V(load_u(beta + i)));
+        } else if (gamma) {
+            x = mul(x, V(load_u(gamma + i)));
+        } else if (beta) {
+            x = add(x, V(load_u(beta + i)));
+        }
+        store_u(out + i, x);
+    }
+    for (; i < n; ++i) {
+        float x = (in[i] - mean) * rstd;
+        if (gamma) {
+            x *= gamma[i];
+        }
+        if (beta) {
+            x += beta[i];
+        }
+        out[i] = x;
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,393 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_PARSE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_PARSE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/store.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC
+#define SIMDPP_PARSE_USE_PERMUTE 1
+#else
+#define SIMDPP_PARSE_USE_PERMUTE 0
+#endif
+
+/*  The permutation that moves the first n bytes of a vector to its end and
+    zeroes the rest is loaded from offset n of this table.
+*/
+struct parse_tables {
+    SIMDPP_ALIGN(16) uint8_t align_digits[32];
+    uint64_t pow10[20];
+    double pow10_exact[23];
+
+    parse_tables()
+    {
+        for (unsigned i = 0; i < 16; ++i) {
+            align_digits[i] = 0x80;
+            align_digits[i + 16] = i;
+        }
+        uint64_t p = 1;
+        for (unsigned i = 0; i < 20; ++i, p *= 10) {
+            pow10[i] = p;
+        }
+        double d = 1;
+        for (unsigned i = 0; i < 23; ++i, d *= 10) {
+            pow10_exact[i] = d;
+        }
+    }
+};
+
+inline const parse_tables& get_parse_tables()
+{
+    static const parse_tables t;
+    return t;
+}
+
+/*  Converts 16 decimal digits (values 0 to 9, the most significant first) to
+    an integer. Adjacent digits are combined with a multiply-add in 16-bit
+    lanes, then adjacent pairs in 32-bit lanes and quads in 64-bit lanes, as
+    pmaddubsw and pmaddwd would do. The low half of each lane holds the more
+    significant part and the multiplications by 10, 100 and 10000 fit the
+    half lanes, thus mul_lo suffices.
+
+    On big-endian ALTIVEC the more significant part is in the high half of
+    each lane, thus the digits are combined by scalar code there. Both produce
+    identical results.
+*/
+SIMDPP_INL uint64_t parse_digits16_value(const uint8<16>& d)
+{
+#if SIMDPP_USE_ALTIVEC
+    SIMDPP_ALIGN(16) uint8_t b[16];
+    store(b, d);
+    uint64_t r = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+        r = r * 10 + b[i];
+    }
+    return r;
+#else
+    uint16<8> w = uint16<8>(d);
+    uint16<8> low8 = make_uint(0x00ff);
+    uint16<8> k10 = make_uint(10);
+    uint16<8> t0 = mul_lo(bit_and(w, low8), k10);
+    uint16<8> v1 = add(t0, uint16<8>(shift_r<8>(w)));
+
+    uint16<8> k100 = make_uint(100, 0);
+    uint32<4> t1 = uint32<4>(mul_lo(v1, k100));
+    uint32<4> v1h = shift_r<16>(uint32<4>(v1));
+    uint32<4> v2 = add(t1, v1h);
+
+    uint32<4> k10000 = make_uint(10000, 0);
+    uint64<2> t2 = uint64<2>(mul_lo(v2, k10000));
+    uint64<2> v2h = shift_r<32>(uint64<2>(v2));
+    uint64<2> v3 = add(t2, v2h);
+
+    return extract<0>(v3) * 100000000 + extract<1>(v3);
+#endif
+}
+
+/*  Returns the number of leading decimal digits of the 16 bytes at @a p and
+    stores their value to @a value.
+*/
+SIMDPP_INL unsigned parse_digits16(const uint8_t* p, uint64_t& value)
+{
+    using I = int8<16>;
+    uint8<16> x = load_u(p);
+    uint8<16> zero = make_uint('0');
+    uint8<16> d = sub(x, zero);
+    // the digits are moved to the bottom of the signed range
+    uint8<16> bias = make_uint(0x80);
+    uint8<16> limit = make_uint(0x80 + 10);
+    I t = I(add(d, bias));
+    uint64_t bits = mask_bits(cmp_lt(t, I(limit)));
+    unsigned n = ctz64(~bits);
+    if (n == 0) {
+        value = 0;
+        return 0;
+    }
+
+    // right-align the digits, the non-digit bytes become leading zeros
+#if SIMDPP_PARSE_USE_PERMUTE
+    uint8<16> idx = load_u(get_parse_tables().align_digits + n);
+    d = permute_zbytes16(d, idx);
+#else
+    SIMDPP_ALIGN(16) uint8_t buf[32];
+    std::memset(buf, 0, 16);
+    store(buf + 16, d);
+    d = load_u(buf + n);
+#endif
+    value = parse_digits16_value(d);
+    return n;
+}
+
+/*  Parses the digits at [p, end). Returns the pointer past the digits. Up to
+    19 digits the value is exact, @a ndigits is set to the number of digits
+    in any case.
+*/
+SIMDPP_INL const uint8_t* parse_digits(const uint8_t* p, const uint8_t* end,
+                                   uint64_t& value, unsigned& ndigits)
+{
+    const parse_tables& t = get_parse_tables();
+    value = 0;
+    ndigits = 0;
+    for (;;) {
+        uint64_t v;
+        unsigned n;
+        if (end - p >= 16) {
+            n = parse_digits16(p, v);
+        } else {
+            uint8_t buf[16] = { 0 };
+            std::memcpy(buf, p, end - p);
+            n = parse_digits16(buf, v);
+        }
+        if (ndigits + n <= 19) {
+            value = value * t.pow10[n] + v;
+        }
+        ndigits += n;
+        p += n;
+        if (n < 16 || p == end) {
+            return p;
+        }
+    }
+}
+
+SIMDPP_INL bool parse_is_digit(const uint8_t* p, const uint8_t* end)
+{
+    return p < end && uint8_t(*p - '0') < 10;
+}
+
+/*  Parses a decimal floating-point number. If the mantissa has at most 19
+    significant digits, fits 53 bits and the exponent is within [-22, 22],
+    the value is computed by a single exact multiplication or division,
+    which is correctly rounded. Otherwise the text is passed to strtod.
+*/
+inline const char* parse_double_impl(const char* str, const char* str_end,
+                                     double& value)
+{
+    const parse_tables& t = get_parse_tables();
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(str);
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(str_end);
+    const uint8_t* start = p;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    uint64_t int_value, frac_value = 0;
+    unsigned int_digits, frac_digits = 0;
+    p = parse_digits(p, end, int_value, int_digits);
+    if (p < end && *p == '.') {
+        p = parse_digits(p + 1, end, frac_value, frac_digits);
+    }
+    if (int_digits + frac_digits == 0) {
+        return nullptr;
+    }
+    int exponent = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const uint8_t* e = p + 1;
+        bool exp_negative = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            exp_negative = *e == '-';
+            ++e;
+        }
+        // an exponent without digits is not a part of the number
+        if (parse_is_digit(e, end)) {
+            for (; parse_is_digit(e, end); ++e) {
+                if (exponent < 100000) {
+                    exponent = exponent * 10 + (*e - '0');
+                }
+            }
+            exponent = exp_negative ? -exponent : exponent;
+            p = e;
+        }
+    }
+
+    if (int_digits + frac_digits <= 19) {
+        uint64_t m = int_value * t.pow10[frac_digits] + frac_value;
+        int e10 = exponent - int(frac_digits);
+        if (m == 0) {
+            value = negative ? -0.0 : 0.0;
+            return reinterpret_cast<const char*>(p);
+        }
+        if (m <= (uint64_t(1) << 53) && e10 >= -22 && e10 <= 22) {
+            double d = double(m);
+            d = e10 >= 0 ? d * t.pow10_exact[e10] : d / t.pow10_exact[-e10];
+            value = negative ? -d : d;
+            return reinterpret_cast<const char*>(p);
+        }
+    }
+
+    // the hard cases are handled by strtod on a null-terminated copy
+    std::size_t len = p - start;
+    char buf[64];
+    std::string long_buf;
+    const char* s = buf;
+    if (len < sizeof(buf)) {
+        std::memcpy(buf, start, len);
+        buf[len] = 0;
+    } else {
+        long_buf.assign(reinterpret_cast<const char*>(start), len);
+        s = long_buf.c_str();
+    }
+    value = std::strtod(s, nullptr);
+    return reinterpret_cast<const char*>(p);
+}
+
+inline const char* parse_uint64_impl(const char* str, const char* str_end,
+                                     uint64_t& value)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(str);
+    uint64_t v;
+    unsigned n;
+    const uint8_t* r = parse_digits(p, reinterpret_cast<const uint8_t*>(str_end), v, n);
+    if (n == 0) {
+        return nullptr;
+    }
+    if (n > 19) {
+        // the value is exact only up to 19 digits
+        for (; n > 19 && *p == '0'; --n, ++p) {}
+        if (n > 20) {
+            return nullptr;
+        }
+        unsigned n19;
+        parse_digits(p, p + 19, v, n19);
+        if (n == 20) {
+            uint64_t d = p[19] - '0';
+            if (v > (~uint64_t(0) - d) / 10) {
+                return nullptr;
+            }
+            v = v * 10 + d;
+        }
+    }
+    value = v;
+    return reinterpret_cast<const char*>(r);
+}
+
+template<class T, class Parse>
+std::size_t parse_column(const char* p, std::size_t len, char delimiter,
+                         T* out, Parse parse)
+{
+    const char* end = p + len;
+    std::size_t n = 0;
+    while (p < end) {
+        p = parse(p, end, out[n]);
+        if (p == nullptr || (p < end && *p != delimiter)) {
+            break;
+        }
+        ++n;
+        ++p;
+    }
+    return n;
+}
+
+} // namespace detail
+
+/** Parses the unsigned decimal integer at the start of [p, end). Returns the
+    pointer past the last digit, or nullptr if there are no digits or the
+    value does not fit 32 bits.
+
+    Up to 16 digits are loaded at once and validated with a single
+    comparison. The digits are right-aligned with a byte permutation and
+    reduced with multiply-add steps (see parse_digits16_value).
+*/
+inline const char* parse_uint32(const char* p, const char* end, uint32_t& value)
+{
+    uint64_t v;
+    const char* r = detail::parse_uint64_impl(p, end, v);
+    if (r == nullptr || v > 0xffffffff) {
+        return nullptr;
+    }
+    value = uint32_t(v);
+    return r;
+}
+
+/** Parses the unsigned decimal integer at the start of [p, end). Returns the
+    pointer past the last digit, or nullptr if there are no digits or the
+    value does not fit 64 bits. See parse_uint32 for details.
+*/
+inline const char* parse_uint64(const char* p, const char* end, uint64_t& value)
+{
+    return detail::parse_uint64_impl(p, end, value);
+}
+
+/** Parses the decimal floating-point number at the start of [p, end): an
+    optional sign, digits with an optional decimal point and an optional
+    exponent. Returns the pointer past the number or nullptr if there is no
+    number.
+
+    Numbers with up to 19 significant digits, a mantissa that fits 53 bits
+    and an exponent within [-22, 22] (after moving the decimal point to the
+    end) are converted exactly by the fast path. The digits are parsed as in
+    parse_uint32. Other numbers are converted by std::strtod, which depends
+    on the decimal point of the C locale.
+*/
+inline const char* parse_double(const char* p, const char* end, double& value)
+{
+    return detail::parse_double_impl(p, end, value);
+}
+
+/** Parses a column of unsigned integers separated by @a delimiter, e.g. '\\n'
+    or ','. Stores the values to @a out and returns their number. Parsing
+    stops at the end of the buffer or at the first field that is not a valid
+    number. A delimiter after the last field is allowed.
+*/
+inline std::size_t parse_uint32_column(const char* p, std::size_t len,
+                                       char delimiter, uint32_t* out)
+{
+    return detail::parse_column(p, len, delimiter, out, parse_uint32);
+}
+
+/// Parses a column of unsigned 64-bit integers. See parse_uint32_column.
+inline std::size_t parse_uint64_column(const char* p, std::size_t len,
+                                       char delimiter, uint64_t* out)
+{
+    return detail::parse_column(p, len, delimiter, out, parse_uint64);
+}
+
+/// Parses a column of floating-point numbers. See parse_uint32_column.
+inline std::size_t parse_double_column(const char* p, std::size_t len,
+                                       char delimiter, double* out)
+{
+    return detail::parse_column(p, len, delimiter, out, parse_double);
+}
+
+#undef SIMDPP_PARSE_USE_PERMUTE
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
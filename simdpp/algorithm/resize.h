@@ -0,0 +1,537 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_RESIZE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_RESIZE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_max.h>
+#include <simdpp/core/f_min.h>
+#include <simdpp/core/f_mul.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_avg.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load_packed2_u.h>
+#include <simdpp/core/load_packed4_u.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_float.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_packed4_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_float32.h>
+#include <simdpp/core/to_int32.h>
+#include <simdpp/detail/madd.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The interpolation methods of image resizing
+enum class resize_mode {
+    /** Linear interpolation between the two nearest pixels in each direction.
+        The pixel centers of the images are aligned. Suitable for upscaling
+        and for downscaling by less than 2 times.
+    */
+    bilinear,
+    /** Each destination pixel is the average of the source area it covers,
+        weighted by the covered fraction of each source pixel. Suitable for
+        downscaling.
+    */
+    area
+};
+
+/*  Both methods are computed as separable filters with precomputed
+    coefficient tables: for each destination column and row the tables hold
+    the indices of the source pixels and their weights. The horizontal pass
+    is computed first for each source row that is needed and the results
+    are kept in a small ring of rows, so that each source row is processed
+    once. The vertical pass then combines the rows of the ring and is
+    vectorized across the whole destination row.
+
+    RGBA images are converted to float32 for the computation. Each pixel of
+    the horizontal pass is a float32<4> vector. The vertical pass separates
+    the channels with load_packed4 and packs the rounded results back to
+    pixels.
+
+    When the source is exactly twice as large as the destination in both
+    directions, each destination pixel is the mean of a 2x2 block. This case
+    is computed directly: with i_avg for RGBA images and with load_packed2 for
+    float32 images.
+*/
+
+namespace detail {
+
+using resize_fvector = typename fast_vector<float>::type;
+using resize_uvector32 = uint32<resize_fvector::length>;
+using resize_vector8 = uint8<resize_fvector::length * 4>;
+
+struct resize_axis {
+    unsigned taps;
+    std::vector<std::size_t> index;
+    std::vector<float> weight;
+};
+
+// Computes the coefficient table of resizing a row or column of n to m pixels
+inline void resize_make_axis(resize_axis& a, std::size_t n, std::size_t m,
+                             resize_mode mode)
+{
+    double r = double(n) / double(m);
+    a.taps = mode == resize_mode::bilinear ? 2 : unsigned(std::ceil(r)) + 1;
+    a.index.assign(m * a.taps, 0);
+    a.weight.assign(m * a.taps, 0.0f);
+
+    for (std::size_t i = 0; i < m; ++i) {
+        std::size_t* idx = &a.index[i * a.taps];
+        float* w = &a.weight[i * a.taps];
+        if (mode == resize_mode::bilinear) {
+            double s = (i + 0.5) * r - 0.5;
+            s = s < 0 ? 0 : s;
+            std::size_t s0 = std::size_t(s);
+            if (s0 >= n - 1) {
+                idx[0] = idx[1] = n - 1;
+                w[0] = 1.0f;
+                continue;
+            }
+            idx[0] = s0;
+            idx[1] = s0 + 1;
+            w[1] = float(s - double(s0));
+            w[0] = 1.0f - w[1];
+        } else {
+            double b = double(i) * r;
+            double e = double(i + 1) * r;
+            std::size_t s0 = std::size_t(b);
+            double sum = 0;
+            for (unsigned k = 0; k < a.taps; ++k) {
+                std::size_t j = s0 + k;
+                idx[k] = j < n ? j : n - 1;
+                double lo = double(j) > b ? double(j) : b;
+                double hi = double(j + 1) < e ? double(j + 1) : e;
+                if (j < n && hi > lo) {
+                    w[k] = float(hi - lo);
+                    sum += hi - lo;
+                }
+            }
+            for (unsigned k = 0; k < a.taps; ++k) {
+                w[k] = float(w[k] / sum);
+            }
+        }
+    }
+}
+
+SIMDPP_INL uint8_t resize_round(float x)
+{
+    x += 0.5f;
+    return uint8_t(x < 0 ? 0 : x > 255 ? 255 : x);
+}
+
+SIMDPP_INL resize_uvector32 resize_round(const resize_fvector& x)
+{
+    resize_fvector r = add(x, (resize_fvector) make_float(0.5f));
+    r = min(max(r, (resize_fvector) resize_fvector::zero()),
+            (resize_fvector) make_float(255.0f));
+    return resize_uvector32(to_int32(r));
+}
+
+/*  The shift of the byte at offset B of a pixel within its 32-bit element.
+    The first byte is the least significant one on little-endian
+    architectures, but the most significant one on big-endian ALTIVEC.
+*/
+template<unsigned B>
+struct resize_byte {
+#if SIMDPP_USE_ALTIVEC
+    static const unsigned shift = 8 * (3 - B);
+#else
+    static const unsigned shift = 8 * B;
+#endif
+};
+
+// Returns the byte at offset B of each pixel as float32
+template<unsigned B> SIMDPP_INL
+resize_fvector resize_channel(const resize_uvector32& x)
+{
+    const unsigned L = resize_fvector::length;
+    resize_uvector32 r = shift_r<resize_byte<B>::shift>(x);
+    if (resize_byte<B>::shift != 24) {
+        r = bit_and(r, (resize_uvector32) make_uint(0xff));
+    }
+    return to_float32(int32<L>(r));
+}
+
+// Converts a row of width RGBA pixels to float32
+inline void resize_expand_rgba(const uint8_t* src, std::size_t width, float* dst)
+{
+    using F = resize_fvector;
+    using U = resize_uvector32;
+    const unsigned L = F::length;
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        U p = load_u(src + 4*i);
+        store_packed4_u(dst + 4*i, resize_channel<0>(p), resize_channel<1>(p),
+                        resize_channel<2>(p), resize_channel<3>(p));
+    }
+    for (i *= 4; i < 4*width; ++i) {
+        dst[i] = float(src[i]);
+    }
+}
+
+// The horizontal pass of float32 RGBA pixels
+inline void resize_h_rgba(const float* row, const resize_axis& ax,
+                          std::size_t width, float* dst)
+{
+    const unsigned m = ax.taps;
+    for (std::size_t x = 0; x < width; ++x) {
+        const std::size_t* idx = &ax.index[x * m];
+        const float* w = &ax.weight[x * m];
+        float32<4> s = float32<4>::zero();
+        for (unsigned k = 0; k < m; ++k) {
+            float32<4> p = load_u(row + 4*idx[k]);
+            s = madd(p, (float32<4>) make_float(w[k]), s);
+        }
+        store_u(dst + 4*x, s);
+    }
+}
+
+/*  The horizontal pass of single channel images. The source pixels of
+    adjacent destination pixels are not at a fixed offset, thus this pass is
+    not vectorized.
+*/
+inline void resize_h_plane(const float* row, const resize_axis& ax,
+                           std::size_t width, float* dst)
+{
+    const unsigned m = ax.taps;
+    for (std::size_t x = 0; x < width; ++x) {
+        const std::size_t* idx = &ax.index[x * m];
+        const float* w = &ax.weight[x * m];
+        float s = 0;
+        for (unsigned k = 0; k < m; ++k) {
+            s += w[k] * row[idx[k]];
+        }
+        dst[x] = s;
+    }
+}
+
+// The vertical pass of float32 RGBA rows of width pixels
+inline void resize_v_rgba(const float* const* rows, const float* w, unsigned m,
+                          std::size_t width, uint8_t* dst)
+{
+    using F = resize_fvector;
+    using U = resize_uvector32;
+    const unsigned L = F::length;
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        F c[4];
+        for (unsigned j = 0; j < 4; ++j) {
+            c[j] = F::zero();
+        }
+        for (unsigned k = 0; k < m; ++k) {
+            F wk = make_float(w[k]);
+            F p[4];
+            load_packed4_u(p[0], p[1], p[2], p[3], rows[k] + 4*i);
+            for (unsigned j = 0; j < 4; ++j) {
+                c[j] = madd(p[j], wk, c[j]);
+            }
+        }
+        U r = shift_l<resize_byte<0>::shift>(resize_round(c[0]));
+        r = bit_or(r, shift_l<resize_byte<1>::shift>(resize_round(c[1])));
+        r = bit_or(r, shift_l<resize_byte<2>::shift>(resize_round(c[2])));
+        r = bit_or(r, shift_l<resize_byte<3>::shift>(resize_round(c[3])));
+        store_u(dst + 4*i, r);
+    }
+    for (i *= 4; i < 4*width; ++i) {
+        float s = 0;
+        for (unsigned k = 0; k < m; ++k) {
+            s += w[k] * rows[k][i];
+        }
+        dst[i] = resize_round(s);
+    }
+}
+
+// The vertical pass of single channel rows
+inline void resize_v_plane(const float* const* rows, const float* w, unsigned m,
+                           std::size_t width, float* dst)
+{
+    using F = resize_fvector;
+    const unsigned L = F::length;
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        F s = F::zero();
+        for (unsigned k = 0; k < m; ++k) {
+            F p = load_u(rows[k] + i);
+            s = madd(p, (F) make_float(w[k]), s);
+        }
+        store_u(dst + i, s);
+    }
+    for (; i < width; ++i) {
+        float s = 0;
+        for (unsigned k = 0; k < m; ++k) {
+            s += w[k] * rows[k][i];
+        }
+        dst[i] = s;
+    }
+}
+
+/*  Computes width RGBA pixels from the 2x2 blocks of rows r0 and r1 as
+    (a + b + c + d + 2) >> 2. The vertical pairs are averaged with rounding
+    down, floor((a+c)/2) = avg(a, c) - ((a^c) & 1), and the dropped bits are
+    kept. The horizontal average of the two halves then needs a correction
+    of 1 if both dropped bits are set and the sum of the halves is even.
+*/
+inline void resize_half_rgba(const uint8_t* r0, const uint8_t* r1,
+                             std::size_t width, uint8_t* dst)
+{
+    using V = resize_vector8;
+    using U = resize_uvector32;
+    const unsigned L = U::length;
+    V one = make_uint(1);
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        U e0, o0, e1, o1;
+        load_packed2_u(e0, o0, r0 + 8*i);
+        load_packed2_u(e1, o1, r1 + 8*i);
+        V be = bit_and(bit_xor(V(e0), V(e1)), one);
+        V bo = bit_and(bit_xor(V(o0), V(o1)), one);
+        V fe = sub(avg(V(e0), V(e1)), be);
+        V fo = sub(avg(V(o0), V(o1)), bo);
+        V r = add(avg(fe, fo), bit_andnot(bit_and(be, bo), bit_xor(fe, fo)));
+        store_u(dst + 4*i, r);
+    }
+    for (; i < width; ++i) {
+        for (unsigned c = 0; c < 4; ++c) {
+            unsigned s = r0[8*i + c] + r0[8*i + 4 + c] + r1[8*i + c] + r1[8*i + 4 + c];
+            dst[4*i + c] = uint8_t((s + 2) >> 2);
+        }
+    }
+}
+
+// Computes width pixels as the means of the 2x2 blocks of rows r0 and r1
+inline void resize_half_plane(const float* r0, const float* r1,
+                              std::size_t width, float* dst)
+{
+    using F = resize_fvector;
+    const unsigned L = F::length;
+    F q = make_float(0.25f);
+
+    std::size_t i = 0;
+    for (; i + L <= width; i += L) {
+        F e0, o0, e1, o1;
+        load_packed2_u(e0, o0, r0 + 2*i);
+        load_packed2_u(e1, o1, r1 + 2*i);
+        store_u(dst + i, mul(add(add(e0, o0), add(e1, o1)), q));
+    }
+    for (; i < width; ++i) {
+        dst[i] = ((r0[2*i] + r0[2*i + 1]) + (r1[2*i] + r1[2*i + 1])) * 0.25f;
+    }
+}
+
+struct resize_rgba_op {
+    using T = uint8_t;
+    static const unsigned C = 4;
+    std::vector<float> row;
+
+    void horizontal(const uint8_t* src, std::size_t src_width,
+                    const resize_axis& ax, std::size_t width, float* dst)
+    {
+        row.resize(4 * src_width);
+        resize_expand_rgba(src, src_width, row.data());
+        resize_h_rgba(row.data(), ax, width, dst);
+    }
+
+    void vertical(const float* const* rows, const float* w, unsigned m,
+                  std::size_t width, uint8_t* dst)
+    {
+        resize_v_rgba(rows, w, m, width, dst);
+    }
+
+    void half(const uint8_t* r0, const uint8_t* r1, std::size_t width, uint8_t* dst)
+    {
+        resize_half_rgba(r0, r1, width, dst);
+    }
+};
+
+struct resize_plane_op {
+    using T = float;
+    static const unsigned C = 1;
+
+    void horizontal(const float* src, std::size_t, const resize_axis& ax,
+                    std::size_t width, float* dst)
+    {
+        resize_h_plane(src, ax, width, dst);
+    }
+
+    void vertical(const float* const* rows, const float* w, unsigned m,
+                  std::size_t width, float* dst)
+    {
+        resize_v_plane(rows, w, m, width, dst);
+    }
+
+    void half(const float* r0, const float* r1, std::size_t width, float* dst)
+    {
+        resize_half_plane(r0, r1, width, dst);
+    }
+};
+
+template<class Op>
+void resize_rows(const typename Op::T* src, std::size_t src_stride,
+                 std::size_t src_width, std::size_t src_height,
+                 typename Op::T* dst, std::size_t dst_stride,
+                 std::size_t dst_width, std::size_t dst_height,
+                 resize_mode mode, std::size_t row_begin, std::size_t row_end,
+                 Op& op)
+{
+    row_end = row_end < dst_height ? row_end : dst_height;
+    if (src_width == 0 || src_height == 0 || dst_width == 0 || row_begin >= row_end) {
+        return;
+    }
+    if (src_width == 2 * dst_width && src_height == 2 * dst_height) {
+        for (std::size_t y = row_begin; y < row_end; ++y) {
+            const typename Op::T* r0 = src + 2 * y * src_stride;
+            op.half(r0, r0 + src_stride, dst_width, dst + y * dst_stride);
+        }
+        return;
+    }
+
+    resize_axis ax, ay;
+    resize_make_axis(ax, src_width, dst_width, mode);
+    resize_make_axis(ay, src_height, dst_height, mode);
+
+    // Source row r is kept in slot r % m. The rows of each destination row
+    // are consecutive, thus they never share a slot.
+    const unsigned m = ay.taps;
+    const std::size_t n = Op::C * dst_width;
+    const std::size_t none = ~std::size_t(0);
+    std::vector<float> ring(n * m);
+    std::vector<std::size_t> cached(m, none);
+    std::vector<const float*> rows(m);
+    std::vector<float> w(m);
+
+    for (std::size_t y = row_begin; y < row_end; ++y) {
+        unsigned count = 0;
+        for (unsigned k = 0; k < m; ++k) {
+            if (ay.weight[y*m + k] == 0) {
+                continue;
+            }
+            std::size_t r = ay.index[y*m + k];
+            float* slot = &ring[(r % m) * n];
+            if (cached[r % m] != r) {
+                op.horizontal(src + r * src_stride, src_width, ax, dst_width, slot);
+                cached[r % m] = r;
+            }
+            rows[count] = slot;
+            w[count++] = ay.weight[y*m + k];
+        }
+        op.vertical(rows.data(), w.data(), count, dst_width, dst + y * dst_stride);
+    }
+}
+
+} // namespace detail
+
+/** Resizes an image of @a src_width x @a src_height RGBA pixels with 8-bit
+    channels to @a dst_width x @a dst_height pixels. Only the destination
+    rows [@a row_begin, @a row_end) are computed, thus the image can be split
+    into bands of rows which are resized by separate threads. The whole
+    source image may be read by each band.
+
+    The channels are interpolated independently in float32 and rounded to
+    the nearest integer. When the source is exactly twice as large as the
+    destination the result is the exactly rounded mean of each 2x2 block,
+    (a + b + c + d + 2) >> 2, in both modes.
+
+    The strides are in bytes. The images must not overlap.
+
+    The function has a plain signature. It takes 11 arguments, while the
+    dispatcher macros support at most 9, thus it can be dispatched with
+    SIMDPP_MAKE_DISPATCHER_VOID1 from a wrapper in SIMDPP_ARCH_NAMESPACE that
+    takes the arguments as a struct.
+*/
+inline void resize_rgba_rows(const uint8_t* src, std::size_t src_stride,
+                             std::size_t src_width, std::size_t src_height,
+                             uint8_t* dst, std::size_t dst_stride,
+                             std::size_t dst_width, std::size_t dst_height,
+                             resize_mode mode, std::size_t row_begin,
+                             std::size_t row_end)
+{
+    detail::resize_rgba_op op;
+    detail::resize_rows(src, src_stride, src_width, src_height,
+                        dst, dst_stride, dst_width, dst_height,
+                        mode, row_begin, row_end, op);
+}
+
+/** Resizes an image of RGBA pixels with 8-bit channels. See
+    resize_rgba_rows for the details.
+*/
+inline void resize_rgba(const uint8_t* src, std::size_t src_stride,
+                        std::size_t src_width, std::size_t src_height,
+                        uint8_t* dst, std::size_t dst_stride,
+                        std::size_t dst_width, std::size_t dst_height,
+                        resize_mode mode)
+{
+    resize_rgba_rows(src, src_stride, src_width, src_height,
+                     dst, dst_stride, dst_width, dst_height,
+                     mode, 0, dst_height);
+}
+
+/** Resizes a single channel float32 image of @a src_width x @a src_height
+    elements to @a dst_width x @a dst_height elements. Only the destination
+    rows [@a row_begin, @a row_end) are computed, see resize_rgba_rows.
+
+    The strides are in elements. The images must not overlap. The rounding
+    of the results depends on the availability of fused multiply-add.
+*/
+inline void resize_plane_rows(const float* src, std::size_t src_stride,
+                              std::size_t src_width, std::size_t src_height,
+                              float* dst, std::size_t dst_stride,
+                              std::size_t dst_width, std::size_t dst_height,
+                              resize_mode mode, std::size_t row_begin,
+                              std::size_t row_end)
+{
+    detail::resize_plane_op op;
+    detail::resize_rows(src, src_stride, src_width, src_height,
+                        dst, dst_stride, dst_width, dst_height,
+                        mode, row_begin, row_end, op);
+}
+
+/** Resizes a single channel float32 image. See resize_plane_rows for the
+    details.
+*/
+inline void resize_plane(const float* src, std::size_t src_stride,
+                         std::size_t src_width, std::size_t src_height,
+                         float* dst, std::size_t dst_stride,
+                         std::size_t dst_width, std::size_t dst_height,
+                         resize_mode mode)
+{
+    resize_plane_rows(src, src_stride, src_width, src_height,
+                      dst, dst_stride, dst_width, dst_height,
+                      mode, 0, dst_height);
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,360 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SCAN_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SCAN_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <simdpp/types.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_sub.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/prefix_sum.h>
+#include <simdpp/core/set_splat.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/mem_block.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The functions in this file operate on buffers of arbitrary length and
+    alignment. The supported element types are uint8_t, int8_t, uint16_t,
+    int16_t, uint32_t, int32_t, uint64_t, int64_t, float and double. Each
+    native vector is processed with prefix_sum and the running total is carried
+    to the next vector as a broadcast of its last element. Only the carry
+    addition is serially dependent, thus two vectors are processed per
+    iteration to hide the latency of the log-step prefix sum.
+*/
+
+namespace detail {
+
+template<class V, class T>
+T v_inclusive_scan(const T* src, T* dst, std::size_t n, T init)
+{
+    const unsigned L = V::length;
+    std::size_t i = 0;
+
+    if (n >= L) {
+        V carry = splat(init);
+        for (; i + 2*L <= n; i += 2*L) {
+            V a0 = load_u(src + i);
+            V a1 = load_u(src + i + L);
+            a0 = prefix_sum(a0);
+            a1 = prefix_sum(a1);
+            a0 = add(a0, carry);
+            carry = splat<L-1>(a0);
+            a1 = add(a1, carry);
+            carry = splat<L-1>(a1);
+            store_u(dst + i, a0);
+            store_u(dst + i + L, a1);
+        }
+        if (i + L <= n) {
+            V a0 = load_u(src + i);
+            a0 = prefix_sum(a0);
+            a0 = add(a0, carry);
+            store_u(dst + i, a0);
+            i += L;
+        }
+        init = dst[i-1];
+    }
+    for (; i < n; ++i) {
+        init = T(init + src[i]);
+        dst[i] = init;
+    }
+    return init;
+}
+
+template<class V, class T>
+T v_exclusive_scan(const T* src, T* dst, std::size_t n, T init)
+{
+    const unsigned L = V::length;
+    std::size_t i = 0;
+
+    if (n >= L) {
+        V carry = splat(init);
+        for (; i + 2*L <= n; i += 2*L) {
+            V a0 = load_u(src + i);
+            V a1 = load_u(src + i + L);
+            V r0 = prefix_sum(a0);
+            V r1 = prefix_sum(a1);
+            r0 = add(r0, carry);
+            carry = splat<L-1>(r0);
+            r1 = add(r1, carry);
+            carry = splat<L-1>(r1);
+            store_u(dst + i, sub(r0, a0));
+            store_u(dst + i + L, sub(r1, a1));
+        }
+        if (i + L <= n) {
+            V a0 = load_u(src + i);
+            V r0 = prefix_sum(a0);
+            r0 = add(r0, carry);
+            carry = splat<L-1>(r0);
+            store_u(dst + i, sub(r0, a0));
+            i += L;
+        }
+        // src may have been overwritten, take the total from the carry
+        init = T(detail::mem_block<V>(carry)[0]);
+    }
+    for (; i < n; ++i) {
+        T x = src[i];
+        dst[i] = init;
+        init = T(init + x);
+    }
+    return init;
+}
+
+} // namespace detail
+
+/// @{
+/** Computes the inclusive prefix sum of a buffer.
+
+    @code
+    dst[0] = init + src[0]
+    dst[1] = init + src[0] + src[1]
+    ...
+    dst[n-1] = init + src[0] + ... + src[n-1]
+    @endcode
+
+    Returns the total, i.e. @a init plus the sum of all elements, which can be
+    passed as @a init when scanning the next block of a stream. @a src and
+    @a dst may point to the same buffer, otherwise they must not overlap.
+
+    Integer sums wrap around on overflow. Floating-point sums are computed in
+    log2(N) steps within each vector, thus the rounding differs from a
+    sequential summation.
+*/
+template<class T>
+T inclusive_scan(const T* src, T* dst, std::size_t n, T init = T())
+{
+    using V = typename detail::fast_vector<T>::type;
+    return detail::v_inclusive_scan<V>(src, dst, n, init);
+}
+/// @}
+
+/// @{
+/** Computes the exclusive prefix sum of a buffer.
+
+    @code
+    dst[0] = init
+    dst[1] = init + src[0]
+    ...
+    dst[n-1] = init + src[0] + ... + src[n-2]
+    @endcode
+
+    Returns the total, i.e. @a init plus the sum of all elements, which can be
+    passed as @a init when scanning the next block of a stream. @a src and
+    @a dst may point to the same buffer, otherwise they must not overlap.
+
+    The exclusive sum is computed by subtracting each element from the
+    inclusive sum, thus for floating-point types the result may differ from a
+    sequential summation by more than the rounding error of inclusive_scan.
+*/
+template<class T>
+T exclusive_scan(const T* src, T* dst, std::size_t n, T init = T())
+{
+    using V = typename detail::fast_vector<T>::type;
+    return detail::v_exclusive_scan<V>(src, dst, n, init);
+}
+/// @}
+
+/// @{
+/** Computes the differences between successive elements of a buffer.
+
+    @code
+    dst[0] = src[0] - prev
+    dst[1] = src[1] - src[0]
+    ...
+    dst[n-1] = src[n-1] - src[n-2]
+    @endcode
+
+    Returns the last element of @a src (or @a prev if @a n is zero), which can
+    be passed as @a prev when encoding the next block of a stream. @a src and
+    @a dst may point to the same buffer, otherwise they must not overlap.
+*/
+template<class T>
+T delta_encode(const T* src, T* dst, std::size_t n, T prev = T())
+{
+    using V = typename detail::fast_vector<T>::type;
+    const unsigned L = V::length;
+
+    if (n == 0) {
+        return prev;
+    }
+    T last = src[n-1];
+
+    // The buffer is processed from the end, so that each iteration reads only
+    // the elements that have not been overwritten when encoding in place
+    std::size_t i = n;
+    for (; i >= L + 1; i -= L) {
+        V cur = load_u(src + i - L);
+        V pre = load_u(src + i - L - 1);
+        store_u(dst + i - L, sub(cur, pre));
+    }
+    for (; i > 1; --i) {
+        dst[i-1] = T(src[i-1] - src[i-2]);
+    }
+    dst[0] = T(src[0] - prev);
+    return last;
+}
+/// @}
+
+/// @{
+/** Reverses delta_encode: computes the inclusive prefix sum of a buffer
+    starting at @a prev.
+
+    @code
+    dst[0] = prev + src[0]
+    dst[1] = dst[0] + src[1]
+    ...
+    dst[n-1] = dst[n-2] + src[n-1]
+    @endcode
+
+    Returns the last decoded element (or @a prev if @a n is zero). @a src and
+    @a dst may point to the same buffer, otherwise they must not overlap.
+*/
+template<class T>
+T delta_decode(const T* src, T* dst, std::size_t n, T prev = T())
+{
+    return inclusive_scan(src, dst, n, prev);
+}
+/// @}
+
+/// @{
+/** Computes the differences between elements of a buffer that are four
+    positions apart (D4 delta coding).
+
+    @code
+    dst[0..3] = src[0..3] - prev[0..3]
+    dst[4] = src[4] - src[0]
+    ...
+    dst[n-1] = src[n-1] - src[n-5]
+    @endcode
+
+    Compared to delta_encode, the decoding of D4 deltas does not need a prefix
+    sum within the vector, but the compression of the deltas is usually
+    somewhat worse.
+
+    @a prev must point to four elements. On return they are replaced with the
+    encoding state for the next block: @a prev[j] is set to the last element
+    of @a src whose index modulo 4 is @a j. When a stream is processed in
+    several blocks, @a n must be a multiple of 4 for all blocks except the last.
+    @a src and @a dst may point to the same buffer, otherwise they must not
+    overlap.
+
+    Only 32-bit and 64-bit element types are supported.
+*/
+template<class T>
+void delta_encode4(const T* src, T* dst, std::size_t n, T* prev)
+{
+    static_assert(sizeof(T) >= 4, "Only 32-bit and 64-bit elements are supported");
+    using V = typename detail::fast_vector<T>::type;
+    const unsigned L = V::length;
+
+    T last[4];
+    for (unsigned j = 0; j < 4; ++j) {
+        last[j] = prev[j];
+    }
+    for (std::size_t k = n > 4 ? n - 4 : 0; k < n; ++k) {
+        last[k % 4] = src[k];
+    }
+
+    // processed from the end for in-place operation, see delta_encode
+    std::size_t i = n;
+    for (; i >= L + 4; i -= L) {
+        V cur = load_u(src + i - L);
+        V pre = load_u(src + i - L - 4);
+        store_u(dst + i - L, sub(cur, pre));
+    }
+    for (; i > 4; --i) {
+        dst[i-1] = T(src[i-1] - src[i-5]);
+    }
+    for (std::size_t k = 0; k < i; ++k) {
+        dst[k] = T(src[k] - prev[k]);
+    }
+
+    for (unsigned j = 0; j < 4; ++j) {
+        prev[j] = last[j];
+    }
+}
+/// @}
+
+/// @{
+/** Reverses delta_encode4.
+
+    @code
+    dst[0..3] = prev[0..3] + src[0..3]
+    dst[4] = dst[0] + src[4]
+    ...
+    dst[n-1] = dst[n-5] + src[n-1]
+    @endcode
+
+    @a prev must point to four elements. On return they are replaced with the
+    decoding state for the next block: @a prev[j] is set to the last element
+    of @a dst whose index modulo 4 is @a j. When a stream is processed in
+    several blocks, @a n must be a multiple of 4 for all blocks except the last.
+    @a src and @a dst may point to the same buffer, otherwise they must not
+    overlap.
+
+    The carry is a 4-element vector, thus each group of four elements costs a
+    single addition. Four groups are processed per iteration.
+
+    Only 32-bit and 64-bit element types are supported.
+*/
+template<class T>
+void delta_decode4(const T* src, T* dst, std::size_t n, T* prev)
+{
+    static_assert(sizeof(T) >= 4, "Only 32-bit and 64-bit elements are supported");
+    using V = typename detail::vector_of<T, 4>::type;
+
+    V carry = load_u(prev);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        V a0 = load_u(src + i);
+        V a1 = load_u(src + i + 4);
+        V a2 = load_u(src + i + 8);
+        V a3 = load_u(src + i + 12);
+        a0 = add(a0, carry);
+        a1 = add(a1, a0);
+        a2 = add(a2, a1);
+        a3 = add(a3, a2);
+        carry = a3;
+        store_u(dst + i, a0);
+        store_u(dst + i + 4, a1);
+        store_u(dst + i + 8, a2);
+        store_u(dst + i + 12, a3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        V a0 = load_u(src + i);
+        carry = add(a0, carry);
+        store_u(dst + i, carry);
+    }
+    store_u(prev, carry);
+
+    for (; i < n; ++i) {
+        T x = T(src[i] + prev[i % 4]);
+        dst[i] = x;
+        prev[i % 4] = x;
+    }
+}
+/// @}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
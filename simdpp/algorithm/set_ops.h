@@ -0,0 +1,285 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SET_OPS_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SET_OPS_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute4.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/mask_bits.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+/*  The set operations work on blocks of four elements. Each element of the
+    block of the first set is compared with all elements of the block of the
+    second set by comparing against the four rotations of the latter. The
+    block whose last element is smaller is then advanced, or both if the last
+    elements are equal. An element of the first set may be compared against
+    several blocks of the second set, thus for the difference the matches are
+    accumulated until the block of the first set is advanced.
+
+    When one set is much smaller than the other, each element of the smaller
+    set is instead looked up in the larger one with an exponential search.
+*/
+
+// The size ratio above which the galloping search is used
+const std::size_t set_gallop_ratio = 32;
+
+template<class V> SIMDPP_INL
+unsigned set_match(const V& a, const V& b)
+{
+    V b1 = permute4<1,2,3,0>(b);
+    V b2 = permute4<2,3,0,1>(b);
+    V b3 = permute4<3,0,1,2>(b);
+    return mask_bits(bit_or(bit_or(cmp_eq(a, b), cmp_eq(a, b1)),
+                            bit_or(cmp_eq(a, b2), cmp_eq(a, b3))));
+}
+
+template<class T>
+struct set_store_sink {
+    T* out;
+    std::size_t n;
+
+    set_store_sink(T* o) : out(o), n(0) {}
+
+    SIMDPP_INL void push(T x) { out[n++] = x; }
+
+    SIMDPP_INL void push_bits(const T* p, unsigned bits)
+    {
+        while (bits != 0) {
+            out[n++] = p[ctz64(bits)];
+            bits &= bits - 1;
+        }
+    }
+};
+
+template<class T>
+struct set_count_sink {
+    std::size_t n;
+
+    set_count_sink() : n(0) {}
+
+    SIMDPP_INL void push(T) { n++; }
+    SIMDPP_INL void push_bits(const T*, unsigned bits) { n += popcount64(bits); }
+};
+
+/*  Returns the index of the first element of [p+j, p+n) that is not less
+    than x. The search range is doubled until it contains such element.
+*/
+template<class T>
+std::size_t set_gallop(const T* p, std::size_t n, std::size_t j, T x)
+{
+    std::size_t step = 4;
+    while (j + step <= n && p[j + step - 1] < x) {
+        j += step;
+        step *= 2;
+    }
+    std::size_t hi = std::min(j + step, n);
+    return std::lower_bound(p + j, p + hi, x) - p;
+}
+
+/*  Pushes the elements of [a, a+na) that are (or, if Difference is true, are
+    not) present in the much larger set [b, b+nb).
+*/
+template<bool Difference, class T, class Sink>
+void set_gallop_scan(const T* a, std::size_t na, const T* b, std::size_t nb,
+                     Sink& sink)
+{
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < na; ++i) {
+        j = set_gallop(b, nb, j, a[i]);
+        bool found = j < nb && b[j] == a[i];
+        if (found != Difference) {
+            sink.push(a[i]);
+        }
+    }
+}
+
+template<class V, bool Difference, class Sink>
+void v_set_scan(const typename V::element_type* a, std::size_t na,
+                const typename V::element_type* b, std::size_t nb,
+                Sink& sink)
+{
+    using T = typename V::element_type;
+    const unsigned L = 4;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    unsigned found = 0;
+
+    while (i + L <= na && j + L <= nb) {
+        V va = load_u(a + i);
+        V vb = load_u(b + j);
+        unsigned m = set_match(va, vb);
+        if (!Difference) {
+            sink.push_bits(a + i, m);
+        }
+        found |= m;
+
+        T amax = a[i + L - 1];
+        T bmax = b[j + L - 1];
+        if (amax <= bmax) {
+            if (Difference) {
+                sink.push_bits(a + i, ~found & 0xf);
+            }
+            i += L;
+            found = 0;
+        }
+        if (bmax <= amax) {
+            j += L;
+        }
+    }
+
+    // The elements of the current block that have been found are matched by
+    // elements before b[j]
+    for (unsigned k = 0; i < na; ++i, ++k) {
+        if (k < L && (found >> k) & 1) {
+            continue;
+        }
+        while (j < nb && b[j] < a[i]) {
+            j++;
+        }
+        bool f = j < nb && b[j] == a[i];
+        if (f != Difference) {
+            sink.push(a[i]);
+        }
+    }
+}
+
+template<class T, class Sink>
+void set_intersect_impl(const T* a, std::size_t na, const T* b, std::size_t nb,
+                        Sink& sink)
+{
+    using V = typename vector_of<T, 4>::type;
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na * set_gallop_ratio < nb) {
+        set_gallop_scan<false>(a, na, b, nb, sink);
+    } else {
+        v_set_scan<V, false>(a, na, b, nb, sink);
+    }
+}
+
+} // namespace detail
+
+/** Computes the intersection of the sorted sets [a, a+na) and [b, b+nb) and
+    stores it to @a out, which must have room for the smaller of @a na and
+    @a nb elements. Returns the number of stored elements.
+
+    The sets must be sorted in ascending order and must not contain duplicate
+    elements. The supported element types are uint32_t and uint64_t.
+*/
+template<class T>
+std::size_t set_intersect(const T* a, std::size_t na,
+                          const T* b, std::size_t nb, T* out)
+{
+    detail::set_store_sink<T> sink(out);
+    detail::set_intersect_impl(a, na, b, nb, sink);
+    return sink.n;
+}
+
+/** Returns the size of the intersection of the sorted sets [a, a+na) and
+    [b, b+nb). The requirements are the same as for set_intersect.
+*/
+template<class T>
+std::size_t set_intersect_count(const T* a, std::size_t na,
+                                const T* b, std::size_t nb)
+{
+    detail::set_count_sink<T> sink;
+    detail::set_intersect_impl(a, na, b, nb, sink);
+    return sink.n;
+}
+
+/** Stores the elements of the sorted set [a, a+na) that are not present in
+    the sorted set [b, b+nb) to @a out, which must have room for @a na
+    elements. Returns the number of stored elements.
+
+    The requirements are the same as for set_intersect.
+*/
+template<class T>
+std::size_t set_difference(const T* a, std::size_t na,
+                           const T* b, std::size_t nb, T* out)
+{
+    using V = typename detail::vector_of<T, 4>::type;
+    detail::set_store_sink<T> sink(out);
+    if (na * detail::set_gallop_ratio < nb) {
+        detail::set_gallop_scan<true>(a, na, b, nb, sink);
+    } else {
+        detail::v_set_scan<V, true>(a, na, b, nb, sink);
+    }
+    return sink.n;
+}
+
+/** Computes the union of the sorted sets [a, a+na) and [b, b+nb) and stores
+    it to @a out, which must have room for na+nb elements. Returns the number
+    of stored elements.
+
+    Runs of four elements that precede the next element of the other set are
+    copied with a single vector. The requirements are the same as for
+    set_intersect.
+*/
+template<class T>
+std::size_t set_union(const T* a, std::size_t na,
+                      const T* b, std::size_t nb, T* out)
+{
+    using V = typename detail::vector_of<T, 4>::type;
+    const unsigned L = 4;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t o = 0;
+
+    while (i < na && j < nb) {
+        if (i + L <= na && a[i + L - 1] < b[j]) {
+            V v = load_u(a + i);
+            store_u(out + o, v);
+            i += L;
+            o += L;
+        } else if (j + L <= nb && b[j + L - 1] < a[i]) {
+            V v = load_u(b + j);
+            store_u(out + o, v);
+            j += L;
+            o += L;
+        } else if (a[i] < b[j]) {
+            out[o++] = a[i++];
+        } else if (b[j] < a[i]) {
+            out[o++] = b[j++];
+        } else {
+            out[o++] = a[i++];
+            j++;
+        }
+    }
+    std::copy(a + i, a + na, out + o);
+    o += na - i;
+    std::copy(b + j, b + nb, out + o);
+    o += nb - j;
+    return o;
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
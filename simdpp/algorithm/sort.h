@@ -0,0 +1,869 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SORT_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SORT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <simdpp/types.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/cast.h>
+#include <simdpp/core/cmp_gt.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/f_max.h>
+#include <simdpp/core/f_min.h>
+#include <simdpp/core/i_max.h>
+#include <simdpp/core/i_min.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_splat.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute4.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/transpose.h>
+#include <simdpp/core/unzip_hi.h>
+#include <simdpp/core/unzip_lo.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
+#include <simdpp/detail/mask_bits.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The vectorized partition relies on permute_bytes16, which is not available
+    on SSE2, thus SSE2 uses the scalar partition.
+
+    AVX2 and AVX-512 partition a full native vector at a time: AVX2 moves the
+    elements with a cross-lane permute, AVX-512 stores each side with a
+    compressing store.
+*/
+#if SIMDPP_USE_SSE2 && !SIMDPP_USE_SSSE3
+#define SIMDPP_SORT_USE_PERMUTE 0
+#else
+#define SIMDPP_SORT_USE_PERMUTE 1
+#endif
+
+#if SIMDPP_USE_AVX512
+#define SIMDPP_SORT_PARTITION_LENGTH 16
+#elif SIMDPP_USE_AVX2
+#define SIMDPP_SORT_PARTITION_LENGTH 8
+#else
+#define SIMDPP_SORT_PARTITION_LENGTH 4
+#endif
+
+namespace detail {
+
+template<class V> SIMDPP_INL
+void sort_check_vector()
+{
+    static_assert(V::length == 4 && sizeof(typename V::element_type) == 4,
+                  "Only vectors of four 32-bit elements are supported");
+}
+
+/*  The sorting network works either on vectors of keys or on sort_kv, which
+    additionally holds the indices of the keys. The indices are moved together
+    with the keys, which allows the payload of each key to be found after the
+    network has completed.
+*/
+template<class V> struct sort_kv {
+    V k;
+    uint32<4> i;
+};
+
+template<class V> SIMDPP_INL
+void sort_minmax(V& a, V& b)
+{
+    V t = min(a, b);
+    b = max(a, b);
+    a = t;
+}
+
+template<class V> SIMDPP_INL
+void sort_minmax(sort_kv<V>& a, sort_kv<V>& b)
+{
+    // both the keys and the indices are selected with the same mask, thus
+    // the pairs are kept together even if the keys are unordered (NaN)
+    auto mk = cmp_gt(a.k, b.k);
+    mask_int32<4> mi = bit_cast<mask_int32<4>>(mk);
+    V lk = blend(b.k, a.k, mk);
+    V hk = blend(a.k, b.k, mk);
+    uint32<4> li = blend(b.i, a.i, mi);
+    uint32<4> hi = blend(a.i, b.i, mi);
+    a.k = lk; a.i = li;
+    b.k = hk; b.i = hi;
+}
+
+template<class V> SIMDPP_INL
+void sort_zip2(V& l, V& h)
+{
+    using U64 = uint64<2>;
+    V x = V(zip2_lo(U64(l), U64(h)));
+    h = V(zip2_hi(U64(l), U64(h)));
+    l = x;
+}
+
+template<class V> SIMDPP_INL
+void sort_unzip4(V& l, V& h)
+{
+    V x = unzip4_lo(l, h);
+    h = unzip4_hi(l, h);
+    l = x;
+}
+
+template<class V> SIMDPP_INL
+void sort_zip4(V& l, V& h)
+{
+    V x = zip4_lo(l, h);
+    h = zip4_hi(l, h);
+    l = x;
+}
+
+template<class V> SIMDPP_INL
+void sort_reverse(V& a)
+{
+    a = permute4<3,2,1,0>(a);
+}
+
+template<class V> SIMDPP_INL
+void sort_transpose4(V& a0, V& a1, V& a2, V& a3)
+{
+    transpose4(a0, a1, a2, a3);
+}
+
+template<class V> SIMDPP_INL
+void sort_zip2(sort_kv<V>& l, sort_kv<V>& h)
+{
+    sort_zip2(l.k, h.k);
+    sort_zip2(l.i, h.i);
+}
+
+template<class V> SIMDPP_INL
+void sort_unzip4(sort_kv<V>& l, sort_kv<V>& h)
+{
+    sort_unzip4(l.k, h.k);
+    sort_unzip4(l.i, h.i);
+}
+
+template<class V> SIMDPP_INL
+void sort_zip4(sort_kv<V>& l, sort_kv<V>& h)
+{
+    sort_zip4(l.k, h.k);
+    sort_zip4(l.i, h.i);
+}
+
+template<class V> SIMDPP_INL
+void sort_reverse(sort_kv<V>& a)
+{
+    sort_reverse(a.k);
+    sort_reverse(a.i);
+}
+
+template<class V> SIMDPP_INL
+void sort_transpose4(sort_kv<V>& a0, sort_kv<V>& a1,
+                     sort_kv<V>& a2, sort_kv<V>& a3)
+{
+    transpose4(a0.k, a1.k, a2.k, a3.k);
+    transpose4(a0.i, a1.i, a2.i, a3.i);
+}
+
+// Sorts each of two bitonic vectors
+template<class E> SIMDPP_INL
+void bitonic_clean2(E& l, E& h)
+{
+    // elements 0-1 against 2-3
+    sort_zip2(l, h);
+    sort_minmax(l, h);
+    // even elements against odd elements
+    sort_unzip4(l, h);
+    sort_minmax(l, h);
+    sort_zip4(l, h);
+    sort_zip2(l, h);
+}
+
+// Sorts the two bitonic sequences of 8 elements [a0, a1] and [b0, b1]
+template<class E> SIMDPP_INL
+void bitonic_clean8x2(E& a0, E& a1, E& b0, E& b1)
+{
+    sort_minmax(a0, a1);
+    sort_minmax(b0, b1);
+    bitonic_clean2(a0, a1);
+    bitonic_clean2(b0, b1);
+}
+
+template<class E> SIMDPP_INL
+void v_bitonic_merge(E& a, E& b)
+{
+    sort_reverse(b);
+    sort_minmax(a, b);
+    bitonic_clean2(a, b);
+}
+
+template<class E> SIMDPP_INL
+void v_sort16(E& a0, E& a1, E& a2, E& a3)
+{
+    sort_minmax(a0, a1);
+    sort_minmax(a2, a3);
+    sort_minmax(a0, a2);
+    sort_minmax(a1, a3);
+    sort_minmax(a1, a2);
+    sort_transpose4(a0, a1, a2, a3);
+
+    v_bitonic_merge(a0, a1);
+    v_bitonic_merge(a2, a3);
+
+    sort_reverse(a2);
+    sort_reverse(a3);
+    sort_minmax(a0, a3);
+    sort_minmax(a1, a2);
+    bitonic_clean8x2(a0, a1, a3, a2);
+    std::swap(a2, a3);
+}
+
+template<class T> struct sort_traits {
+    static T max_value() { return std::numeric_limits<T>::max(); }
+};
+
+template<> struct sort_traits<float> {
+    static float max_value() { return std::numeric_limits<float>::infinity(); }
+};
+
+/*  Shuffle masks indexed by the bit mask of the elements that belong to the
+    left side of the partition. The selected elements are moved to the front
+    of the vector and the rest to the back, preserving their order.
+
+    partition_perm8 holds the same permutations for vectors of eight 32-bit
+    elements, one 4-bit source index per element.
+*/
+struct sort_tables {
+    SIMDPP_ALIGN(16) uint8_t partition_shuffle[16][16];
+#if SIMDPP_SORT_PARTITION_LENGTH == 8
+    uint32_t partition_perm8[256];
+#endif
+
+    sort_tables()
+    {
+        for (unsigned m = 0; m < 16; ++m) {
+            unsigned pos = 0;
+            for (unsigned pass = 0; pass < 2; ++pass) {
+                for (unsigned k = 0; k < 4; ++k) {
+                    if (((m >> k) & 1) != pass) {
+                        for (unsigned j = 0; j < 4; ++j) {
+                            partition_shuffle[m][4*pos+j] = 4*k + j;
+                        }
+                        pos++;
+                    }
+                }
+            }
+        }
+#if SIMDPP_SORT_PARTITION_LENGTH == 8
+        for (unsigned m = 0; m < 256; ++m) {
+            unsigned pos = 0;
+            uint32_t perm = 0;
+            for (unsigned pass = 0; pass < 2; ++pass) {
+                for (unsigned k = 0; k < 8; ++k) {
+                    if (((m >> k) & 1) != pass) {
+                        perm |= k << (4*pos);
+                        pos++;
+                    }
+                }
+            }
+            partition_perm8[m] = perm;
+        }
+#endif
+    }
+};
+
+inline const sort_tables& get_sort_tables()
+{
+    static const sort_tables t;
+    return t;
+}
+
+template<unsigned N, class V> SIMDPP_INL
+unsigned sort_mask_bits(const any_vec<N,V>& m)
+{
+    return mask_bits(m);
+}
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL unsigned sort_mask_bits(const mask_int32<16>& m)
+{
+    __mmask16 r = m;
+    return r;
+}
+
+SIMDPP_INL unsigned sort_mask_bits(const mask_float32<16>& m)
+{
+    __mmask16 r = m;
+    return r;
+}
+#endif
+
+/*  Returns the bit mask of the elements that are less than the pivot, or, if
+    Le is true, that are not greater than the pivot.
+*/
+template<bool Le> struct sort_pred;
+
+template<> struct sort_pred<false> {
+    template<class V> static SIMDPP_INL
+    unsigned bits(const V& x, const V& p) { return sort_mask_bits(cmp_lt(x, p)); }
+
+    template<class T> static SIMDPP_INL
+    bool test(T x, T p) { return x < p; }
+};
+
+template<> struct sort_pred<true> {
+    template<class V> static SIMDPP_INL
+    unsigned bits(const V& x, const V& p)
+    {
+        return ~sort_mask_bits(cmp_gt(x, p)) & ((1u << V::length) - 1);
+    }
+
+    template<class T> static SIMDPP_INL
+    bool test(T x, T p) { return !(x > p); }
+};
+
+/*  Moves the elements of a vector of L elements to the two sides of the
+    partition. The elements selected by the bit mask go to [lw, lw+count),
+    the rest to [rw-(L-count), rw). The stores may overwrite the rest of
+    [lw, lw+L) and [rw-L, rw).
+*/
+template<unsigned L> struct sort_partitioner;
+
+#if SIMDPP_SORT_USE_PERMUTE
+template<> struct sort_partitioner<4> {
+    uint32<4> shuffle;
+    unsigned count;
+
+    SIMDPP_INL sort_partitioner(unsigned m) : count(popcount64(m))
+    {
+        shuffle = load(get_sort_tables().partition_shuffle[m]);
+    }
+
+    template<class V, class T> SIMDPP_INL
+    void store(const V& x, T* lw, T* rw) const
+    {
+        V r = V(permute_bytes16(uint32<4>(x), shuffle));
+        store_u(lw, r);
+        store_u(rw - 4, r);
+    }
+};
+#endif
+
+#if SIMDPP_SORT_PARTITION_LENGTH == 8
+template<> struct sort_partitioner<8> {
+    uint32<8> perm;
+    unsigned count;
+
+    SIMDPP_INL sort_partitioner(unsigned m) : count(popcount64(m))
+    {
+        __m256i idx = _mm256_set1_epi32(get_sort_tables().partition_perm8[m]);
+        idx = _mm256_srlv_epi32(idx, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+        perm = _mm256_and_si256(idx, _mm256_set1_epi32(7));
+    }
+
+    template<class V, class T> SIMDPP_INL
+    void store(const V& x, T* lw, T* rw) const
+    {
+        uint32<8> r = _mm256_permutevar8x32_epi32(uint32<8>(x), perm);
+        store_u(lw, V(r));
+        store_u(rw - 8, V(r));
+    }
+};
+#endif
+
+#if SIMDPP_SORT_PARTITION_LENGTH == 16
+template<> struct sort_partitioner<16> {
+    __mmask16 m;
+    unsigned count;
+
+    SIMDPP_INL sort_partitioner(unsigned bits) : m(bits), count(popcount64(bits)) {}
+
+    template<class V, class T> SIMDPP_INL
+    void store(const V& x, T* lw, T* rw) const
+    {
+        __m512i v = uint32<16>(x);
+        _mm512_mask_compressstoreu_epi32(lw, m, v);
+        _mm512_mask_compressstoreu_epi32(rw - (16 - count), __mmask16(~m), v);
+    }
+};
+#endif
+
+/*  The elements being sorted. sort_keys refers to an array of keys,
+    sort_pairs additionally to an array of payload values that are moved
+    together with the keys.
+*/
+template<class T>
+struct sort_keys {
+    using key_type = T;
+    T* k;
+
+    template<unsigned N> struct buffer {
+        T k[N];
+        sort_keys data() { return sort_keys{k}; }
+    };
+
+    sort_keys advance(std::size_t i) const { return sort_keys{k + i}; }
+    T key(std::size_t i) const { return k[i]; }
+    void swap(std::size_t i, std::size_t j) const { std::swap(k[i], k[j]); }
+
+    // Copies [i, i+n) to [j, j+n) of @a to
+    void copy(std::size_t i, std::size_t n, const sort_keys& to, std::size_t j) const
+    {
+        std::copy(k + i, k + i + n, to.k + j);
+    }
+
+    // Moves the vector at i, whose keys have been loaded to x, to the sides
+    template<unsigned L, class V> SIMDPP_INL
+    void partition(const sort_partitioner<L>& part, const V& x, std::size_t,
+                   std::size_t lw, std::size_t rw) const
+    {
+        part.store(x, k + lw, k + rw);
+    }
+};
+
+template<class T, class P>
+struct sort_pairs {
+    using key_type = T;
+    T* k;
+    P* v;
+
+    template<unsigned N> struct buffer {
+        T k[N];
+        P v[N];
+        sort_pairs data() { return sort_pairs{k, v}; }
+    };
+
+    sort_pairs advance(std::size_t i) const { return sort_pairs{k + i, v + i}; }
+    T key(std::size_t i) const { return k[i]; }
+
+    void swap(std::size_t i, std::size_t j) const
+    {
+        std::swap(k[i], k[j]);
+        std::swap(v[i], v[j]);
+    }
+
+    void copy(std::size_t i, std::size_t n, const sort_pairs& to, std::size_t j) const
+    {
+        std::copy(k + i, k + i + n, to.k + j);
+        std::copy(v + i, v + i + n, to.v + j);
+    }
+
+    template<unsigned L, class V> SIMDPP_INL
+    void partition(const sort_partitioner<L>& part, const V& x, std::size_t i,
+                   std::size_t lw, std::size_t rw) const
+    {
+        using PV = typename vector_of<P, L>::type;
+        PV y = load_u(v + i);
+        part.store(x, k + lw, k + rw);
+        part.store(y, v + lw, v + rw);
+    }
+};
+
+// Moves the elements [0, n) of @a in to the sides [lw, ...) and [..., rw)
+template<bool Le, class D> SIMDPP_INL
+void sort_scatter(const D& in, std::size_t n, typename D::key_type pivot,
+                  const D& out, std::size_t& lw, std::size_t& rw)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (sort_pred<Le>::test(in.key(i), pivot)) {
+            in.copy(i, 1, out, lw++);
+        } else {
+            in.copy(i, 1, out, --rw);
+        }
+    }
+}
+
+/*  Partitions the first n elements of @a d in place so that the elements
+    satisfying the predicate come first. Returns their number. L is the
+    number of elements partitioned at a time.
+
+    The first and the last vectors are saved aside, which leaves one vector
+    of free space at each end of the buffer. The next vector is always read
+    from the side with less free space, thus after the read both sides have
+    room for a full vector. The partitioned vector is stored to both sides,
+    the elements that don't belong to a side land in its free space and are
+    overwritten later. Once all of the buffer has been read, the saved
+    vectors and the remaining elements are moved with scalar code.
+*/
+template<bool Le, unsigned L, class D>
+std::size_t v_partition(const D& d, std::size_t n,
+                        typename D::key_type pivot)
+{
+    std::size_t lw = 0;
+    std::size_t rw = n;
+
+#if SIMDPP_SORT_USE_PERMUTE
+    using V = typename vector_of<typename D::key_type, L>::type;
+    if (n >= 2*L) {
+        V pv = load_splat(&pivot);
+        typename D::template buffer<3*L> saved;
+        D s = saved.data();
+        d.copy(0, L, s, 0);
+        d.copy(n - L, L, s, L);
+
+        std::size_t lr = L;
+        std::size_t rr = n - L;
+        while (rr - lr >= L) {
+            std::size_t i;
+            if (lr - lw <= rw - rr) {
+                i = lr;
+                lr += L;
+            } else {
+                rr -= L;
+                i = rr;
+            }
+            V x = load_u(d.k + i);
+            sort_partitioner<L> part(sort_pred<Le>::bits(x, pv));
+            d.partition(part, x, i, lw, rw);
+            lw += part.count;
+            rw -= L - part.count;
+        }
+        std::size_t rest = rr - lr;
+        d.copy(lr, rest, s, 2*L);
+        sort_scatter<Le>(s, 2*L + rest, pivot, d, lw, rw);
+        return lw;
+    }
+#endif
+    // scalar partition
+    while (lw < rw) {
+        if (sort_pred<Le>::test(d.key(lw), pivot)) {
+            ++lw;
+        } else {
+            --rw;
+            d.swap(lw, rw);
+        }
+    }
+    return lw;
+}
+
+/*  Partitions with full native vectors where the buffer is large enough and
+    with four elements at a time otherwise.
+*/
+template<bool Le, class D>
+std::size_t sort_partition(const D& d, std::size_t n,
+                           typename D::key_type pivot)
+{
+    const unsigned L = SIMDPP_SORT_PARTITION_LENGTH;
+    if (L > 4 && n < 2*L) {
+        return v_partition<Le, 4>(d, n, pivot);
+    }
+    return v_partition<Le, L>(d, n, pivot);
+}
+
+/*  Sorts up to 16 elements using the sorting network. The missing elements
+    are padded with the largest value.
+*/
+template<class T>
+void v_sort_small(const sort_keys<T>& d, std::size_t n)
+{
+    using V = typename vector_of<T, 4>::type;
+    SIMDPP_ALIGN(16) T buf[16];
+    for (std::size_t i = 0; i < n; ++i) {
+        buf[i] = d.k[i];
+    }
+    for (std::size_t i = n; i < 16; ++i) {
+        buf[i] = sort_traits<T>::max_value();
+    }
+    V a0 = load(buf);
+    V a1 = load(buf + 4);
+    V a2 = load(buf + 8);
+    V a3 = load(buf + 12);
+    v_sort16(a0, a1, a2, a3);
+    store(buf, a0);
+    store(buf + 4, a1);
+    store(buf + 8, a2);
+    store(buf + 12, a3);
+    for (std::size_t i = 0; i < n; ++i) {
+        d.k[i] = buf[i];
+    }
+}
+
+/*  The keys are sorted together with their indices. The padding gets the
+    indices past n, thus it can be skipped even if some of the keys are equal
+    to the padding value.
+*/
+template<class T, class P>
+void v_sort_small(const sort_pairs<T,P>& d, std::size_t n)
+{
+    using V = typename vector_of<T, 4>::type;
+    SIMDPP_ALIGN(16) T buf[16];
+    SIMDPP_ALIGN(16) uint32_t idx[16];
+    P values[16];
+    for (std::size_t i = 0; i < n; ++i) {
+        buf[i] = d.k[i];
+        values[i] = d.v[i];
+    }
+    for (std::size_t i = n; i < 16; ++i) {
+        buf[i] = sort_traits<T>::max_value();
+    }
+    for (unsigned i = 0; i < 16; ++i) {
+        idx[i] = i;
+    }
+    sort_kv<V> a0 = { load(buf), load(idx) };
+    sort_kv<V> a1 = { load(buf + 4), load(idx + 4) };
+    sort_kv<V> a2 = { load(buf + 8), load(idx + 8) };
+    sort_kv<V> a3 = { load(buf + 12), load(idx + 12) };
+    v_sort16(a0, a1, a2, a3);
+    store(buf, a0.k);
+    store(buf + 4, a1.k);
+    store(buf + 8, a2.k);
+    store(buf + 12, a3.k);
+    store(idx, a0.i);
+    store(idx + 4, a1.i);
+    store(idx + 8, a2.i);
+    store(idx + 12, a3.i);
+
+    std::size_t j = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+        if (idx[i] < n) {
+            d.k[j] = buf[i];
+            d.v[j] = values[idx[i]];
+            j++;
+        }
+    }
+}
+
+template<class T>
+void sort_fallback(const sort_keys<T>& d, std::size_t n)
+{
+    std::sort(d.k, d.k + n);
+}
+
+template<class T, class P>
+void sort_fallback(const sort_pairs<T,P>& d, std::size_t n)
+{
+    std::vector<std::pair<T, P>> buf(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        buf[i] = std::make_pair(d.k[i], d.v[i]);
+    }
+    std::sort(buf.begin(), buf.end(),
+              [](const std::pair<T, P>& a, const std::pair<T, P>& b)
+              { return a.first < b.first; });
+    for (std::size_t i = 0; i < n; ++i) {
+        d.k[i] = buf[i].first;
+        d.v[i] = buf[i].second;
+    }
+}
+
+template<class T>
+T sort_median3(T a, T b, T c)
+{
+    if (a > b) std::swap(a, b);
+    if (b > c) std::swap(b, c);
+    return a > b ? a : b;
+}
+
+template<class D>
+void v_sort(D d, std::size_t n, unsigned depth)
+{
+    using T = typename D::key_type;
+    while (n > 16) {
+        if (depth == 0) {
+            sort_fallback(d, n);
+            return;
+        }
+        depth--;
+
+        T pivot = sort_median3(d.key(0), d.key(n/2), d.key(n-1));
+        std::size_t c = sort_partition<false>(d, n, pivot);
+        if (c == 0) {
+            // the pivot is the smallest element. Move all elements equal to
+            // it to the front, they don't need further sorting.
+            c = sort_partition<true>(d, n, pivot);
+            d = d.advance(c);
+            n -= c;
+            continue;
+        }
+        // recurse into the smaller side to bound the stack depth
+        if (c < n - c) {
+            v_sort(d, c, depth);
+            d = d.advance(c);
+            n -= c;
+        } else {
+            v_sort(d.advance(c), n - c, depth);
+            n = c;
+        }
+    }
+    v_sort_small(d, n);
+}
+
+inline unsigned sort_depth(std::size_t n)
+{
+    unsigned depth = 0;
+    for (std::size_t i = n; i > 1; i >>= 1) {
+        depth += 2;
+    }
+    return depth;
+}
+
+// Merges three sorted sequences
+template<class T>
+T* merge3_scalar(const T* a, const T* ae, const T* b, const T* be,
+                 const T* c, const T* ce, T* out)
+{
+    while (a != ae || b != be || c != ce) {
+        const T** m = nullptr;
+        if (a != ae) m = &a;
+        if (b != be && (m == nullptr || *b < **m)) m = &b;
+        if (c != ce && (m == nullptr || *c < **m)) m = &c;
+        *out++ = *(*m)++;
+    }
+    return out;
+}
+
+} // namespace detail
+
+/** Merges two vectors that are each sorted in ascending order. On return
+    @a a contains the lower and @a b the upper half of the sorted sequence.
+
+    The vectors must contain four 32-bit elements (uint32x4, int32x4 or
+    float32x4).
+*/
+template<class V> SIMDPP_INL
+void bitonic_merge(V& a, V& b)
+{
+    detail::sort_check_vector<V>();
+    detail::v_bitonic_merge(a, b);
+}
+
+/** Sorts the 16 elements held in the four vectors in ascending order. On
+    return @a a0 holds the smallest four elements and @a a3 the largest.
+
+    The vectors are first sorted column-wise with a sorting network and then
+    transposed so that each vector holds a sorted run. The runs are combined
+    with bitonic merges.
+
+    The vectors must contain four 32-bit elements (uint32x4, int32x4 or
+    float32x4). NaN values result in unspecified order.
+*/
+template<class V> SIMDPP_INL
+void sort16(V& a0, V& a1, V& a2, V& a3)
+{
+    detail::sort_check_vector<V>();
+    detail::v_sort16(a0, a1, a2, a3);
+}
+
+/** Merges the sorted sequences [a, a+na) and [b, b+nb) into @a out, which
+    must have room for na+nb elements and must not overlap the inputs.
+    Returns the pointer past the last written element.
+
+    Four elements are merged at a time with bitonic_merge. The next vector is
+    loaded from the input whose next element is smaller.
+
+    The supported element types are uint32_t, int32_t and float.
+*/
+template<class T>
+T* merge(const T* a, std::size_t na, const T* b, std::size_t nb, T* out)
+{
+    using V = typename detail::vector_of<T, 4>::type;
+    const unsigned L = 4;
+    detail::sort_check_vector<V>();
+
+    const T* ae = a + na;
+    const T* be = b + nb;
+    if (na < L || nb < L) {
+        return detail::merge3_scalar(a, ae, b, be, b, b, out);
+    }
+
+    V x = load_u(a);
+    V y = load_u(b);
+    a += L;
+    b += L;
+    bitonic_merge(x, y);
+    store_u(out, x);
+    out += L;
+
+    while (std::size_t(ae - a) >= L && std::size_t(be - b) >= L) {
+        if (*a <= *b) {
+            x = load_u(a);
+            a += L;
+        } else {
+            x = load_u(b);
+            b += L;
+        }
+        bitonic_merge(x, y);
+        store_u(out, x);
+        out += L;
+    }
+
+    SIMDPP_ALIGN(16) T rest[L];
+    store(rest, y);
+    return detail::merge3_scalar(a, ae, b, be, rest + 0, rest + L, out);
+}
+
+/** Sorts the buffer [p, p+n) in ascending order.
+
+    The buffer is split with quicksort. The partition step compares a vector
+    against the pivot, converts the result to a bit mask and uses it to move
+    the elements of each side together: with a byte shuffle looked up from a
+    table, with a cross-lane permute on AVX2 and with compressing stores on
+    AVX-512. Partitions of up to 16 elements are sorted with sort16. The
+    recursion depth is limited, std::sort is used for the partitions that
+    would exceed it.
+
+    The sort is not stable. The supported element types are uint32_t, int32_t
+    and float. NaN values result in unspecified order.
+
+    64-bit integer keys are not supported as the library has no min, max or
+    ordered comparison of 64-bit integer elements. Such operations exist for
+    float64 elements, but float64 keys are not implemented yet: the sorting
+    network and the partition tables are built for four 32-bit elements per
+    vector.
+*/
+template<class T>
+void sort(T* p, std::size_t n)
+{
+    using V = typename detail::vector_of<T, 4>::type;
+    detail::sort_check_vector<V>();
+    detail::v_sort(detail::sort_keys<T>{p}, n, detail::sort_depth(n));
+}
+
+/** Sorts the keys [keys, keys+n) in ascending order and reorders the payload
+    [values, values+n) in the same way, i.e. each value stays with its key.
+
+    The algorithm is the same as in sort(). The payload is moved with the
+    same shuffles as the keys in the partition step and carried through the
+    sorting network as the index of each key. The order of the pairs with
+    equal keys is unspecified.
+
+    The supported key types are the same as in sort(). The payload must be
+    uint32_t, int32_t or float.
+*/
+template<class K, class P>
+void sort(K* keys, P* values, std::size_t n)
+{
+    using V = typename detail::vector_of<K, 4>::type;
+    using PV = typename detail::vector_of<P, 4>::type;
+    detail::sort_check_vector<V>();
+    detail::sort_check_vector<PV>();
+    detail::v_sort(detail::sort_pairs<K,P>{keys, values}, n,
+                   detail::sort_depth(n));
+}
+
+#undef SIMDPP_SORT_USE_PERMUTE
+#undef SIMDPP_SORT_PARTITION_LENGTH
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,342 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_STRUCTURAL_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_STRUCTURAL_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// The formats supported by structural_scanner
+enum class structural_format {
+    json,
+    csv
+};
+
+namespace detail {
+
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON
+#define SIMDPP_STRUCTURAL_USE_PERMUTE 1
+#else
+#define SIMDPP_STRUCTURAL_USE_PERMUTE 0
+#endif
+
+const unsigned structural_block = 64;
+
+/*  The character classes. Each character of the format is assigned one bit
+    that is set in the entries of both nibble tables. All characters sharing
+    a bit must be closed under the exchange of nibbles, otherwise the lookup
+    would also classify the mixed characters.
+*/
+enum : uint8_t {
+    structural_op_bits = 0x07,      // {}[] : , in JSON, delimiter and \n in CSV
+    structural_ws_bits = 0x18,      // space, \t \n \r in JSON, \r in CSV
+    structural_quote_bit = 0x20,
+    structural_backslash_bit = 0x40
+};
+
+// The bit masks of the character classes of a 64-byte block
+struct structural_masks {
+    uint64_t op, ws, quote, backslash;
+};
+
+// Returns the mask of the bytes of @a c that have any of @a bits set
+template<class V> SIMDPP_INL
+uint64_t structural_class_bits(const V& c, const V& bits)
+{
+    V z = V(cmp_eq(bit_and(c, bits), V::zero()));
+    return ~byte_mask_bits(z) & ((uint64_t(1) << (V::length - 1) << 1) - 1);
+}
+
+/*  Returns the mask of the characters escaped by a backslash. @a prev_escaped
+    carries whether the first character of the next block is escaped. A
+    backslash escapes the next character unless it is escaped itself, thus
+    the escaped characters are those that follow an odd-length run of
+    backslashes. The runs are found by adding their starts to the backslash
+    mask separately for even and odd starting positions.
+*/
+SIMDPP_INL uint64_t structural_escaped(uint64_t backslash, uint64_t& prev_escaped)
+{
+    const uint64_t even_bits = 0x5555555555555555;
+    backslash &= ~prev_escaped;
+    uint64_t follows_escape = backslash << 1 | prev_escaped;
+    uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    uint64_t even_runs = odd_starts + backslash;
+    prev_escaped = even_runs < odd_starts ? 1 : 0;
+    uint64_t invert = even_runs << 1;
+    return (even_bits ^ invert) & follows_escape;
+}
+
+/*  Returns the prefix XOR of the bits of @a x: each bit of the result is the
+    parity of the bits of @a x up to and including it. This is a carry-less
+    multiplication by all ones.
+*/
+SIMDPP_INL uint64_t structural_prefix_xor(uint64_t x)
+{
+#if SIMDPP_USE_PCLMUL
+    __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&x));
+    __m128i r = _mm_clmulepi64_si128(a, _mm_set1_epi8(-1), 0);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&x), r);
+    return x;
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+} // namespace detail
+
+/** Finds the structural characters in JSON or CSV text (the first stage of a
+    parser). The text may be passed in chunks of any size, the state between
+    the chunks is carried over. The positions are offsets from the start of
+    the stream and are stored in increasing order.
+
+    For JSON the structural characters are { } [ ] : and , outside strings,
+    the opening quotes of strings and the first characters of other scalars
+    (numbers, true, false, null). Quotes escaped by backslashes do not
+    terminate strings. In malformed text, a quote directly following another
+    scalar opens a string, but is not reported.
+
+    For CSV the structural characters are the delimiters and \n outside
+    quoted fields. A doubled quote inside a quoted field needs no special
+    handling, since it leaves the field quoted.
+
+    The text is processed in 64-byte blocks of uint8<16> or, on AVX2,
+    uint8<32> vectors. The bytes are classified with two nibble lookups
+    (permute_bytes16), the masks of the classes are converted to bits with
+    extract_bits_any and the quoted regions are found by a
+    carry-less prefix XOR (PCLMUL) of the quote mask. On SSE2 and ALTIVEC,
+    which lack byte permutes, the bytes are classified with a scalar table.
+*/
+class structural_scanner {
+public:
+    /** Creates a scanner. @a delimiter and @a quote are used only for CSV and
+        must be distinct and different from \n and \r.
+    */
+    structural_scanner(structural_format format = structural_format::json,
+                       char delimiter = ',', char quote = '"') :
+        format_(format)
+    {
+        std::memset(low_, 0, sizeof(low_));
+        std::memset(high_, 0, sizeof(high_));
+        if (format == structural_format::json) {
+            const char* brackets = "{}[]";
+            for (const char* c = brackets; *c; ++c) {
+                add_class(*c, 0x01);
+            }
+            add_class(':', 0x02);
+            add_class(',', 0x04);
+            add_class(' ', 0x08);
+            add_class('\t', 0x10);
+            add_class('\n', 0x10);
+            add_class('\r', 0x10);
+            add_class('"', detail::structural_quote_bit);
+            add_class('\\', detail::structural_backslash_bit);
+        } else {
+            add_class(delimiter, 0x01);
+            add_class('\n', 0x02);
+            add_class('\r', 0x08);
+            add_class(quote, detail::structural_quote_bit);
+        }
+        for (unsigned i = 0; i < 256; ++i) {
+            table_[i] = low_[i & 0xf] & high_[i >> 4];
+        }
+        for (unsigned i = 16; i < 64; ++i) {
+            low_[i] = low_[i % 16];
+            high_[i] = high_[i % 16];
+        }
+        reset();
+    }
+
+    /// Resets the state to the start of a new stream
+    void reset()
+    {
+        pos_ = 0;
+        prev_escaped_ = 0;
+        prev_in_string_ = 0;
+        prev_scalar_ = 0;
+        buf_len_ = 0;
+    }
+
+    /** Scans the next @a len bytes of the stream and stores the positions of
+        the structural characters to @a out. Returns the pointer past the last
+        stored position. The last partial 64-byte block is buffered until
+        more data or finish() completes it, thus @a out must have room for
+        @a len + 63 positions.
+    */
+    uint64_t* scan(const char* p, std::size_t len, uint64_t* out)
+    {
+        const unsigned B = detail::structural_block;
+        const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+        if (buf_len_ > 0) {
+            std::size_t n = B - buf_len_ < len ? B - buf_len_ : len;
+            std::memcpy(buf_ + buf_len_, b, n);
+            buf_len_ += unsigned(n);
+            b += n;
+            len -= n;
+            if (buf_len_ < B) {
+                return out;
+            }
+            out = scan_block(buf_, out);
+            buf_len_ = 0;
+        }
+        for (; len >= B; len -= B, b += B) {
+            out = scan_block(b, out);
+        }
+        std::memcpy(buf_, b, len);
+        buf_len_ = unsigned(len);
+        return out;
+    }
+
+    /** Scans the buffered end of the stream. Returns the pointer past the
+        last stored position. @a out must have room for 64 positions.
+    */
+    uint64_t* finish(uint64_t* out)
+    {
+        if (buf_len_ > 0) {
+            // spaces neither start tokens nor change the quoting
+            std::memset(buf_ + buf_len_, ' ', detail::structural_block - buf_len_);
+            out = scan_block(buf_, out);
+            buf_len_ = 0;
+        }
+        return out;
+    }
+
+    /// Returns whether the scanned text ends inside a string or quoted field
+    bool in_string() const { return prev_in_string_ != 0; }
+
+private:
+    void add_class(char c, uint8_t bit)
+    {
+        uint8_t u = uint8_t(c);
+        low_[u & 0xf] |= bit;
+        high_[u >> 4] |= bit;
+    }
+
+    SIMDPP_INL detail::structural_masks classify(const uint8_t* p) const
+    {
+        using V = detail::fast_vector<uint8_t>::type;
+        const unsigned B = detail::structural_block;
+#if SIMDPP_STRUCTURAL_USE_PERMUTE
+        V low = load_u(low_);
+        V high = load_u(high_);
+        V mask = make_uint(0x0f);
+#else
+        SIMDPP_ALIGN(64) uint8_t cls[B];
+        for (unsigned i = 0; i < B; ++i) {
+            cls[i] = table_[p[i]];
+        }
+#endif
+        V op_bits = make_uint(detail::structural_op_bits);
+        V ws_bits = make_uint(detail::structural_ws_bits);
+        V quote_bit = make_uint(detail::structural_quote_bit);
+        V backslash_bit = make_uint(detail::structural_backslash_bit);
+
+        detail::structural_masks m = { 0, 0, 0, 0 };
+        for (unsigned i = 0; i < B; i += V::length) {
+#if SIMDPP_STRUCTURAL_USE_PERMUTE
+            V in = load_u(p + i);
+            V in_high = shift_r<4>(in);
+            V c = bit_and(permute_bytes16(low, V(bit_and(in, mask))),
+                          permute_bytes16(high, in_high));
+#else
+            V c = load(cls + i);
+#endif
+            m.op |= detail::structural_class_bits(c, op_bits) << i;
+            m.ws |= detail::structural_class_bits(c, ws_bits) << i;
+            m.quote |= detail::structural_class_bits(c, quote_bit) << i;
+            if (format_ == structural_format::json) {
+                m.backslash |= detail::structural_class_bits(c, backslash_bit) << i;
+            }
+        }
+        return m;
+    }
+
+    uint64_t* scan_block(const uint8_t* p, uint64_t* out)
+    {
+        detail::structural_masks m = classify(p);
+        uint64_t quote = m.quote;
+        if (format_ == structural_format::json) {
+            quote &= ~detail::structural_escaped(m.backslash, prev_escaped_);
+        }
+        // set from the opening quote up to the character before the closing one
+        uint64_t in_string = detail::structural_prefix_xor(quote) ^ prev_in_string_;
+        prev_in_string_ = uint64_t(int64_t(in_string) >> 63);
+
+        uint64_t bits;
+        if (format_ == structural_format::json) {
+            uint64_t scalar = ~(m.op | m.ws);
+            uint64_t nonquote_scalar = scalar & ~quote;
+            uint64_t follows_scalar = nonquote_scalar << 1 | prev_scalar_;
+            prev_scalar_ = nonquote_scalar >> 63;
+            uint64_t scalar_start = scalar & ~follows_scalar;
+            // the string contents and the closing quotes
+            uint64_t string_tail = in_string ^ quote;
+            bits = (m.op | scalar_start) & ~string_tail;
+        } else {
+            bits = m.op & ~in_string;
+        }
+
+        // four positions are stored per iteration to avoid mispredicted
+        // branches, the extra stores land in the room required by scan()
+        uint64_t* end = out + detail::popcount64(bits);
+        const uint64_t guard = uint64_t(1) << 63;
+        while (out < end) {
+            for (unsigned k = 0; k < 4; ++k) {
+                out[k] = pos_ + detail::ctz64(bits | guard);
+                bits &= bits - 1;
+            }
+            out += 4;
+        }
+        pos_ += detail::structural_block;
+        return end;
+    }
+
+    structural_format format_;
+    uint8_t low_[64];
+    uint8_t high_[64];
+    uint8_t table_[256];
+    uint8_t buf_[64];
+    uint64_t pos_;
+    uint64_t prev_escaped_;
+    uint64_t prev_in_string_;
+    uint64_t prev_scalar_;
+    unsigned buf_len_;
+};
+
+#undef SIMDPP_STRUCTURAL_USE_PERMUTE
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
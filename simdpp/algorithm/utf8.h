@@ -0,0 +1,517 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_UTF8_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_UTF8_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <simdpp/types.h>
+#include <simdpp/core/align.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub_sat.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_int16.h>
+#include <simdpp/core/to_int32.h>
+#include <simdpp/core/unzip_lo.h>
+#include <simdpp/detail/insn/shuffle128.h>
+#include <simdpp/detail/mask_bits.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON
+#define SIMDPP_UTF8_USE_PERMUTE 1
+#else
+#define SIMDPP_UTF8_USE_PERMUTE 0
+#endif
+
+using utf8_vector = typename fast_vector<uint8_t>::type;
+
+// The number of bytes the validation and the ASCII check process at once
+const unsigned utf8_chunk_size = 64;
+
+#if SIMDPP_UTF8_USE_PERMUTE
+/*  Returns the vector of the bytes that precede each byte of @a a by @a S
+    positions, @a prev being the preceding vector. On AVX2 the lanes are
+    first joined as [prev.hi, a.lo], since align16 works within 128-bit lanes.
+*/
+template<unsigned S> SIMDPP_INL
+uint8<16> utf8_prev(const uint8<16>& a, const uint8<16>& prev)
+{
+    return align16<16-S>(prev, a);
+}
+
+#if SIMDPP_USE_AVX2
+template<unsigned S> SIMDPP_INL
+uint8<32> utf8_prev(const uint8<32>& a, const uint8<32>& prev)
+{
+    uint8<32> t = shuffle1_128<1,0>(prev, a);
+    return align16<16-S>(t, a);
+}
+#endif
+
+/*  The lookup tables of the validation, indexed by the high and low nibbles
+    of the first byte and by the high nibble of the second byte of each pair
+    of adjacent bytes. Each bit identifies one kind of error and is set in
+    all three tables only for the byte pairs that exhibit it. The tables are
+    repeated for each 128-bit lane.
+*/
+struct utf8_tables {
+    enum {
+        too_short = 1 << 0,     // lead byte or ASCII followed by a lead byte or ASCII
+        too_long = 1 << 1,      // ASCII followed by a continuation
+        overlong_3 = 1 << 2,
+        too_large = 1 << 3,     // above U+10FFFF
+        surrogate = 1 << 4,
+        overlong_2 = 1 << 5,
+        too_large_1000 = 1 << 6,
+        overlong_4 = 1 << 6,
+        two_conts = 1 << 7,     // two continuations, valid only after 3- and 4-byte leads
+        carry = too_short | too_long | two_conts
+    };
+
+    SIMDPP_ALIGN(32) uint8_t byte1_high[32];
+    SIMDPP_ALIGN(32) uint8_t byte1_low[32];
+    SIMDPP_ALIGN(32) uint8_t byte2_high[32];
+    // the maximum values of the last three bytes of a complete input
+    SIMDPP_ALIGN(32) uint8_t max_last[64];
+
+    utf8_tables()
+    {
+        static const uint8_t b1h[16] = {
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4
+        };
+        static const uint8_t b1l[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000
+        };
+        static const uint8_t b2h[16] = {
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short
+        };
+        for (unsigned i = 0; i < 32; ++i) {
+            byte1_high[i] = b1h[i % 16];
+            byte1_low[i] = b1l[i % 16];
+            byte2_high[i] = b2h[i % 16];
+        }
+        std::memset(max_last, 0xff, 64);
+        max_last[61] = 0xf0 - 1;
+        max_last[62] = 0xe0 - 1;
+        max_last[63] = 0xc0 - 1;
+    }
+};
+
+inline const utf8_tables& get_utf8_tables()
+{
+    static const utf8_tables t;
+    return t;
+}
+
+#endif
+
+// Returns whether all bytes in the vector are ASCII
+template<class V> SIMDPP_INL
+bool utf8_is_ascii(const V& a)
+{
+    using I = int8<V::length>;
+    return byte_mask_bits(V(cmp_lt(I(a), I::zero()))) == 0;
+}
+
+#if SIMDPP_UTF8_USE_PERMUTE
+
+/*  Validates UTF-8 text one vector at a time. Every pair of adjacent bytes is
+    classified with three table lookups, which detects all errors except
+    missing or superfluous continuations after 3- and 4-byte leads. These are
+    detected by comparing the bytes two and three positions back with the
+    smallest 3- and 4-byte leads. The errors are accumulated and checked at
+    the end.
+*/
+template<class V>
+struct utf8_checker {
+    V error, prev_input, prev_incomplete;
+    V table1_high, table1_low, table2_high, max_last;
+    V mask_low4, lead3, lead4, mask_high1;
+
+    utf8_checker()
+    {
+        const utf8_tables& t = get_utf8_tables();
+        error = prev_input = prev_incomplete = V::zero();
+        table1_high = load(t.byte1_high);
+        table1_low = load(t.byte1_low);
+        table2_high = load(t.byte2_high);
+        max_last = load(t.max_last + 64 - V::length);
+        mask_low4 = (V) make_uint(0x0f);
+        lead3 = (V) make_uint(0xe0 - 0x80);
+        lead4 = (V) make_uint(0xf0 - 0x80);
+        mask_high1 = (V) make_uint(0x80);
+    }
+
+    SIMDPP_INL void check(const V& input)
+    {
+        V prev1 = utf8_prev<1>(input, prev_input);
+        V b1h = permute_bytes16(table1_high, V(shift_r<4>(prev1)));
+        V b1l = permute_bytes16(table1_low, V(bit_and(prev1, mask_low4)));
+        V b2h = permute_bytes16(table2_high, V(shift_r<4>(input)));
+        V special = bit_and(bit_and(b1h, b1l), b2h);
+
+        // the high bit is set for the bytes that must be continuations
+        // because of a 3- or 4-byte lead
+        V third = sub_sat(utf8_prev<2>(input, prev_input), lead3);
+        V fourth = sub_sat(utf8_prev<3>(input, prev_input), lead4);
+        V must23 = bit_and(bit_or(third, fourth), mask_high1);
+
+        error = bit_or(error, bit_xor(must23, special));
+        prev_incomplete = sub_sat(input, max_last);
+        prev_input = input;
+    }
+
+    // Checks utf8_chunk_size bytes starting at p
+    SIMDPP_INL void check_chunk(const uint8_t* p)
+    {
+        const unsigned n = utf8_chunk_size / V::length;
+        V in[n];
+        V any = V::zero();
+        for (unsigned k = 0; k < n; ++k) {
+            in[k] = load_u(p + k * V::length);
+            any = bit_or(any, in[k]);
+        }
+        if (utf8_is_ascii(any)) {
+            // an ASCII chunk is valid, but it can't complete a sequence
+            error = bit_or(error, prev_incomplete);
+            prev_incomplete = V::zero();
+            prev_input = in[n-1];
+            return;
+        }
+        for (unsigned k = 0; k < n; ++k) {
+            check(in[k]);
+        }
+    }
+
+    // Returns whether the text up to this point is valid and complete
+    SIMDPP_INL bool valid() const
+    {
+        V e = bit_or(error, prev_incomplete);
+        return byte_mask_bits(V(cmp_eq(e, V::zero()))) ==
+               (uint64_t(1) << (V::length - 1) << 1) - 1;
+    }
+};
+#endif
+
+/*  Decodes a single UTF-8 sequence starting at p. Returns the pointer past
+    the sequence or nullptr if the sequence is invalid, overlong, encodes a
+    surrogate or a value above U+10FFFF, or is truncated by @a end.
+*/
+inline const uint8_t* utf8_decode_one(const uint8_t* p, const uint8_t* end,
+                                      uint32_t& cp)
+{
+    uint32_t c = p[0];
+    if (c < 0x80) {
+        cp = c;
+        return p + 1;
+    }
+    if (c < 0xc2 || c > 0xf4) {
+        return nullptr;
+    }
+    unsigned len = c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4;
+    if (std::size_t(end - p) < len) {
+        return nullptr;
+    }
+    cp = c & (0x7f >> len);
+    for (unsigned k = 1; k < len; ++k) {
+        if ((p[k] & 0xc0) != 0x80) {
+            return nullptr;
+        }
+        cp = cp << 6 | (p[k] & 0x3f);
+    }
+    if ((len == 3 && (cp < 0x800 || (cp >= 0xd800 && cp < 0xe000))) ||
+        (len == 4 && (cp < 0x10000 || cp > 0x10ffff))) {
+        return nullptr;
+    }
+    return p + len;
+}
+
+// Encodes a code point as UTF-8. The code point must be valid.
+inline char* utf8_encode_one(uint32_t cp, char* out)
+{
+    if (cp < 0x80) {
+        *out++ = char(cp);
+    } else if (cp < 0x800) {
+        *out++ = char(0xc0 | cp >> 6);
+        *out++ = char(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+        *out++ = char(0xe0 | cp >> 12);
+        *out++ = char(0x80 | ((cp >> 6) & 0x3f));
+        *out++ = char(0x80 | (cp & 0x3f));
+    } else {
+        *out++ = char(0xf0 | cp >> 18);
+        *out++ = char(0x80 | ((cp >> 12) & 0x3f));
+        *out++ = char(0x80 | ((cp >> 6) & 0x3f));
+        *out++ = char(0x80 | (cp & 0x3f));
+    }
+    return out;
+}
+
+/*  Decodes UTF-8 text into code points, which are passed to @a put. ASCII
+    vectors are passed to @a put_ascii instead, other vectors are decoded by
+    the scalar code up to the end of the vector or of the sequence that
+    crosses it. Returns false if the text is invalid.
+*/
+template<class PutAscii, class Put> SIMDPP_INL
+bool utf8_decode(const uint8_t* p, std::size_t len, PutAscii put_ascii, Put put)
+{
+    using V = utf8_vector;
+    const uint8_t* end = p + len;
+    while (std::size_t(end - p) >= V::length) {
+        V b = load_u(p);
+        if (utf8_is_ascii(b)) {
+            put_ascii(b);
+            p += V::length;
+            continue;
+        }
+        const uint8_t* vend = p + V::length;
+        while (p < vend) {
+            uint32_t cp;
+            p = utf8_decode_one(p, end, cp);
+            if (p == nullptr) {
+                return false;
+            }
+            put(cp);
+        }
+    }
+    while (p < end) {
+        uint32_t cp;
+        p = utf8_decode_one(p, end, cp);
+        if (p == nullptr) {
+            return false;
+        }
+        put(cp);
+    }
+    return true;
+}
+
+} // namespace detail
+
+/** Returns whether [p, p+len) is valid UTF-8 text as defined in RFC 3629:
+    overlong sequences, surrogates (U+D800 to U+DFFF), values above U+10FFFF
+    and truncated sequences are rejected.
+
+    The text is processed in chunks of 64 bytes. Chunks that contain only
+    ASCII characters are skipped after a single check, other chunks are
+    validated with table lookups on each pair of adjacent bytes
+    (permute_bytes16). The last partial chunk is copied to a zero-padded
+    buffer. On SSE2 and ALTIVEC, which lack byte permutes, only the ASCII
+    check is vectorized and other bytes are validated by the scalar code.
+
+    The function has a plain signature, so it can be dispatched with
+    SIMDPP_MAKE_DISPATCHER_RET2 from a wrapper in SIMDPP_ARCH_NAMESPACE.
+*/
+inline bool validate_utf8(const char* p, std::size_t len)
+{
+    using V = detail::utf8_vector;
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+#if SIMDPP_UTF8_USE_PERMUTE
+    const unsigned C = detail::utf8_chunk_size;
+    detail::utf8_checker<V> checker;
+
+    std::size_t i = 0;
+    for (; i + C <= len; i += C) {
+        checker.check_chunk(b + i);
+    }
+    if (i < len) {
+        uint8_t buf[C];
+        std::memset(buf, 0, C);
+        std::memcpy(buf, b + i, len - i);
+        checker.check_chunk(buf);
+    }
+    return checker.valid();
+#else
+    return detail::utf8_decode(b, len, [](const V&) {}, [](uint32_t) {});
+#endif
+}
+
+/** Converts UTF-8 text [in, in+len) to UTF-16 in native byte order. Code
+    points above U+FFFF are encoded as surrogate pairs.
+
+    The output buffer must be at least @a len elements long. Returns the
+    pointer past the last written element, or nullptr if the input is not
+    valid UTF-8 (see validate_utf8). ASCII vectors are widened with to_int16.
+*/
+inline char16_t* utf8_to_utf16(const char* in, std::size_t len, char16_t* out)
+{
+    using V = detail::utf8_vector;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    bool ok = detail::utf8_decode(p, len,
+        [&out](const V& b) {
+            store_u(out, to_int16(b));
+            out += V::length;
+        },
+        [&out](uint32_t cp) {
+            if (cp < 0x10000) {
+                *out++ = char16_t(cp);
+            } else {
+                cp -= 0x10000;
+                *out++ = char16_t(0xd800 | cp >> 10);
+                *out++ = char16_t(0xdc00 | (cp & 0x3ff));
+            }
+        });
+    return ok ? out : nullptr;
+}
+
+/** Converts UTF-8 text [in, in+len) to UTF-32 in native byte order.
+
+    The output buffer must be at least @a len elements long. Returns the
+    pointer past the last written element, or nullptr if the input is not
+    valid UTF-8 (see validate_utf8). ASCII vectors are widened with to_int16
+    and to_int32.
+*/
+inline char32_t* utf8_to_utf32(const char* in, std::size_t len, char32_t* out)
+{
+    using V = detail::utf8_vector;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    bool ok = detail::utf8_decode(p, len,
+        [&out](const V& b) {
+            // the elements are less than 0x80, thus the sign extension of
+            // to_int32 does not matter
+            store_u(out, to_int32(to_int16(b)));
+            out += V::length;
+        },
+        [&out](uint32_t cp) {
+            *out++ = char32_t(cp);
+        });
+    return ok ? out : nullptr;
+}
+
+/** Converts UTF-16 text [in, in+len) in native byte order to UTF-8.
+
+    The output buffer must be at least 3*len bytes long. Returns the pointer
+    past the last written byte, or nullptr if the input contains unpaired
+    surrogates. Runs of 16 ASCII characters are narrowed with unzip16_lo.
+*/
+inline char* utf16_to_utf8(const char16_t* in, std::size_t len, char* out)
+{
+    const uint16_t* p = reinterpret_cast<const uint16_t*>(in);
+    const uint16_t* end = p + len;
+    uint16<8> non_ascii = make_uint(0xff80);
+
+    while (p < end) {
+        if (end - p >= 16) {
+            uint16<8> a = load_u(p);
+            uint16<8> b = load_u(p + 8);
+            uint16<8> t = bit_and(bit_or(a, b), non_ascii);
+            if (detail::byte_mask_bits(uint8<16>(cmp_eq(t, uint16<8>::zero()))) == 0xffff) {
+                store_u(out, unzip16_lo(uint8<16>(a), uint8<16>(b)));
+                out += 16;
+                p += 16;
+                continue;
+            }
+        }
+        // decode up to 16 units, stopping at the end of a surrogate pair
+        const uint16_t* vend = end - p > 16 ? p + 16 : end;
+        while (p < vend) {
+            uint32_t cp = *p++;
+            if (cp >= 0xd800 && cp < 0xe000) {
+                if (cp >= 0xdc00 || p == end || *p < 0xdc00 || *p >= 0xe000) {
+                    return nullptr;
+                }
+                cp = 0x10000 + ((cp - 0xd800) << 10) + (*p++ - 0xdc00);
+            }
+            out = detail::utf8_encode_one(cp, out);
+        }
+    }
+    return out;
+}
+
+/** Converts UTF-32 text [in, in+len) in native byte order to UTF-8.
+
+    The output buffer must be at least 4*len bytes long. Returns the pointer
+    past the last written byte, or nullptr if the input contains surrogates
+    or values above U+10FFFF. Runs of 16 ASCII characters are narrowed with
+    unzip8_lo and unzip16_lo.
+*/
+inline char* utf32_to_utf8(const char32_t* in, std::size_t len, char* out)
+{
+    const uint32_t* p = reinterpret_cast<const uint32_t*>(in);
+    const uint32_t* end = p + len;
+    uint32<4> non_ascii = make_uint(0xffffff80);
+
+    while (p < end) {
+        if (end - p >= 16) {
+            uint32<4> a0 = load_u(p), a1 = load_u(p + 4);
+            uint32<4> a2 = load_u(p + 8), a3 = load_u(p + 12);
+            uint32<4> t = bit_and(bit_or(bit_or(a0, a1), bit_or(a2, a3)), non_ascii);
+            if (detail::byte_mask_bits(uint8<16>(cmp_eq(t, uint32<4>::zero()))) == 0xffff) {
+                uint16<8> b0 = unzip8_lo(uint16<8>(a0), uint16<8>(a1));
+                uint16<8> b1 = unzip8_lo(uint16<8>(a2), uint16<8>(a3));
+                store_u(out, unzip16_lo(uint8<16>(b0), uint8<16>(b1)));
+                out += 16;
+                p += 16;
+                continue;
+            }
+        }
+        const uint32_t* vend = end - p > 16 ? p + 16 : end;
+        for (; p < vend; ++p) {
+            uint32_t cp = *p;
+            if ((cp >= 0xd800 && cp < 0xe000) || cp > 0x10ffff) {
+                return nullptr;
+            }
+            out = detail::utf8_encode_one(cp, out);
+        }
+    }
+    return out;
+}
+
+#undef SIMDPP_UTF8_USE_PERMUTE
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
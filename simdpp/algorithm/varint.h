@@ -0,0 +1,369 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_VARINT_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_VARINT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/set_splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/*  The vectorized paths rely on permute_zbytes16, which is not available on
+    SSE2, and on the little-endian byte order of the encoded formats, thus
+    SSE2 and ALTIVEC use the scalar code.
+*/
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON
+#define SIMDPP_VARINT_USE_PERMUTE 1
+#else
+#define SIMDPP_VARINT_USE_PERMUTE 0
+#endif
+
+namespace detail {
+
+/*  Stream VByte tables indexed by the control byte. The decode table expands
+    the data bytes of four integers into four 32-bit elements, the encode
+    table compacts the significant bytes of four 32-bit elements.
+*/
+struct streamvbyte_tables {
+    SIMDPP_ALIGN(16) uint8_t decode_shuffle[256][16];
+    SIMDPP_ALIGN(16) uint8_t encode_shuffle[256][16];
+    uint8_t length[256];
+
+    streamvbyte_tables()
+    {
+        for (unsigned c = 0; c < 256; ++c) {
+            unsigned pos = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                unsigned len = ((c >> (2*k)) & 3) + 1;
+                for (unsigned j = 0; j < 4; ++j) {
+                    decode_shuffle[c][4*k+j] = j < len ? pos + j : 0x80;
+                }
+                for (unsigned j = 0; j < len; ++j) {
+                    encode_shuffle[c][pos+j] = 4*k + j;
+                }
+                pos += len;
+            }
+            for (unsigned j = pos; j < 16; ++j) {
+                encode_shuffle[c][j] = 0x80;
+            }
+            length[c] = pos;
+        }
+    }
+};
+
+inline const streamvbyte_tables& get_streamvbyte_tables()
+{
+    static const streamvbyte_tables t;
+    return t;
+}
+
+// Returns the number of significant bytes of x minus one
+inline unsigned streamvbyte_code(uint32_t x)
+{
+    return (x > 0xff) + (x > 0xffff) + (x > 0xffffff);
+}
+
+/*  Masked VByte tables indexed by the continuation bits of an 8-byte window.
+    The shuffle moves each of the leading 1- and 2-byte varints into a 16-bit
+    element. Decoding stops at the first varint that is longer than 2 bytes or
+    that crosses the window boundary.
+*/
+struct varint_tables {
+    SIMDPP_ALIGN(16) uint8_t shuffle[256][16];
+    uint8_t count[256];
+    uint8_t consumed[256];
+
+    varint_tables()
+    {
+        for (unsigned m = 0; m < 256; ++m) {
+            unsigned pos = 0;
+            unsigned cnt = 0;
+            while (pos < 8) {
+                if (((m >> pos) & 1) == 0) {
+                    shuffle[m][2*cnt] = pos;
+                    shuffle[m][2*cnt+1] = 0x80;
+                    pos += 1;
+                } else if (pos + 1 < 8 && ((m >> (pos+1)) & 1) == 0) {
+                    shuffle[m][2*cnt] = pos;
+                    shuffle[m][2*cnt+1] = pos + 1;
+                    pos += 2;
+                } else {
+                    break;
+                }
+                cnt++;
+            }
+            for (unsigned j = 2*cnt; j < 16; ++j) {
+                shuffle[m][j] = 0x80;
+            }
+            count[m] = cnt;
+            consumed[m] = pos;
+        }
+    }
+};
+
+inline const varint_tables& get_varint_tables()
+{
+    static const varint_tables t;
+    return t;
+}
+
+/*  Decodes a single LEB128 varint. Returns the pointer past the varint or
+    nullptr if the input is truncated or the varint is longer than 5 bytes.
+    Bits that do not fit into 32 bits are discarded.
+*/
+inline const uint8_t* varint_decode_one(const uint8_t* in, const uint8_t* in_end,
+                                        uint32_t* dst)
+{
+    uint32_t x = 0;
+    for (unsigned shift = 0; shift < 35; shift += 7) {
+        if (in == in_end) {
+            return nullptr;
+        }
+        uint8_t b = *in++;
+        x |= uint32_t(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            *dst = x;
+            return in;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace detail
+
+/** Returns the maximum number of bytes streamvbyte_encode may write when
+    encoding @a n integers.
+*/
+inline std::size_t streamvbyte_max_encoded_size(std::size_t n)
+{
+    return (n + 3) / 4 + 4*n;
+}
+
+/** Encodes 32-bit integers using the Stream VByte format.
+
+    The output consists of (n+3)/4 control bytes followed by the data bytes.
+    Each control byte describes four integers, two bits per integer starting
+    from the least significant bits, each storing the number of data bytes of
+    the integer minus one. The data bytes of each integer are stored in
+    little-endian order.
+
+    The output buffer must be at least streamvbyte_max_encoded_size(n) bytes
+    long, even though usually fewer bytes are written, because the vector code
+    writes 16 bytes for each group of four integers. Returns the pointer past
+    the last written data byte.
+*/
+inline uint8_t* streamvbyte_encode(const uint32_t* src, std::size_t n,
+                                   uint8_t* out)
+{
+    uint8_t* ctrl = out;
+    uint8_t* data = out + (n + 3) / 4;
+    std::size_t i = 0;
+
+#if SIMDPP_VARINT_USE_PERMUTE
+    // maps the nonzero byte bits of an integer to the number of its
+    // significant bytes minus one
+    static const uint8_t nibble_code[16] = {
+        0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+    };
+    const detail::streamvbyte_tables& t = detail::get_streamvbyte_tables();
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4 x = load_u(src + i);
+        uint8x16 b = uint8x16(x);
+        unsigned m = extract_bits_any(uint8x16(cmp_neq(b, uint8x16::zero())));
+        unsigned c = nibble_code[m & 0xf] |
+                     (nibble_code[(m >> 4) & 0xf] << 2) |
+                     (nibble_code[(m >> 8) & 0xf] << 4) |
+                     (nibble_code[(m >> 12) & 0xf] << 6);
+        uint8x16 shuf = load(t.encode_shuffle[c]);
+        store_u(data, permute_zbytes16(b, shuf));
+        *ctrl++ = c;
+        data += t.length[c];
+    }
+#endif
+
+    for (; i < n; i += 4) {
+        unsigned c = 0;
+        for (unsigned k = 0; k < 4 && i + k < n; ++k) {
+            uint32_t x = src[i+k];
+            unsigned code = detail::streamvbyte_code(x);
+            c |= code << (2*k);
+            for (unsigned j = 0; j <= code; ++j) {
+                *data++ = uint8_t(x >> (8*j));
+            }
+        }
+        *ctrl++ = c;
+    }
+    return data;
+}
+
+/** Decodes @a n 32-bit integers encoded in the Stream VByte format from the
+    buffer [in, in_end). See streamvbyte_encode for the description of the
+    format.
+
+    Returns the pointer past the last consumed data byte, or nullptr if the
+    input is truncated. The input is not copied: the data bytes are decoded
+    directly from the given buffer, and the buffer does not need any padding.
+*/
+inline const uint8_t* streamvbyte_decode(const uint8_t* in, const uint8_t* in_end,
+                                         uint32_t* dst, std::size_t n)
+{
+    std::size_t ctrl_len = (n + 3) / 4;
+    if (std::size_t(in_end - in) < ctrl_len) {
+        return nullptr;
+    }
+    const uint8_t* ctrl = in;
+    const uint8_t* data = in + ctrl_len;
+    std::size_t i = 0;
+
+#if SIMDPP_VARINT_USE_PERMUTE
+    const detail::streamvbyte_tables& t = detail::get_streamvbyte_tables();
+
+    // each group loads 16 data bytes regardless of its length
+    for (; i + 4 <= n && in_end - data >= 16; i += 4) {
+        unsigned c = *ctrl++;
+        uint8x16 b = load_u(data);
+        uint8x16 shuf = load(t.decode_shuffle[c]);
+        store_u(dst + i, permute_zbytes16(b, shuf));
+        data += t.length[c];
+    }
+#endif
+
+    for (; i < n; i += 4) {
+        unsigned c = *ctrl++;
+        for (unsigned k = 0; k < 4 && i + k < n; ++k) {
+            unsigned len = ((c >> (2*k)) & 3) + 1;
+            if (std::size_t(in_end - data) < len) {
+                return nullptr;
+            }
+            uint32_t x = 0;
+            for (unsigned j = 0; j < len; ++j) {
+                x |= uint32_t(data[j]) << (8*j);
+            }
+            dst[i+k] = x;
+            data += len;
+        }
+    }
+    return data;
+}
+
+/** Returns the maximum number of bytes varint_encode may write when encoding
+    @a n integers.
+*/
+inline std::size_t varint_max_encoded_size(std::size_t n)
+{
+    return 5*n;
+}
+
+/** Encodes 32-bit integers as LEB128 varints: 7 bits per byte starting from
+    the least significant bits, the most significant bit of each byte being
+    set if more bytes follow. This is the encoding of unsigned varints in
+    Protocol Buffers.
+
+    Returns the pointer past the last written byte.
+*/
+inline uint8_t* varint_encode(const uint32_t* src, std::size_t n, uint8_t* out)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        uint32_t x = src[i];
+        while (x >= 0x80) {
+            *out++ = uint8_t(x | 0x80);
+            x >>= 7;
+        }
+        *out++ = uint8_t(x);
+    }
+    return out;
+}
+
+/** Decodes @a n LEB128 varints from the buffer [in, in_end). Varints longer
+    than 5 bytes are rejected, the bits that do not fit into 32 bits are
+    discarded.
+
+    The vector code examines 8 bytes at a time: the continuation bits are
+    extracted with extract_bits and a table lookup yields the shuffle that
+    moves the leading 1- and 2-byte varints into 16-bit elements, up to 8 of
+    them at once. Longer varints are decoded one at a time.
+
+    Returns the pointer past the last consumed byte, or nullptr if the input
+    is truncated or malformed. The buffer does not need any padding.
+*/
+inline const uint8_t* varint_decode(const uint8_t* in, const uint8_t* in_end,
+                                    uint32_t* dst, std::size_t n)
+{
+    std::size_t i = 0;
+
+#if SIMDPP_VARINT_USE_PERMUTE
+    const detail::varint_tables& t = detail::get_varint_tables();
+    uint16x8 low7 = splat(0x007f);
+    uint16x8 high7 = splat(0x7f00);
+    uint16x8 zero = uint16x8::zero();
+
+    // each step loads 16 bytes and stores 8 integers
+    while (i + 8 <= n && in_end - in >= 16) {
+        uint8x16 b = load_u(in);
+        // the continuation flag is bit 7 of each byte. extract_bits_any is
+        // defined only for bytes that are 0x00 or 0xff and would need a
+        // comparison against zero first, while extract_bits<7> yields the
+        // same mask directly: on SSE2 both are a single movemask
+        unsigned m = extract_bits<7>(b) & 0xff;
+        unsigned cnt = t.count[m];
+        if (cnt == 0) {
+            in = detail::varint_decode_one(in, in_end, dst + i);
+            if (in == nullptr) {
+                return nullptr;
+            }
+            i++;
+            continue;
+        }
+        uint8x16 shuf = load(t.shuffle[m]);
+        uint16x8 x = uint16x8(permute_zbytes16(b, shuf));
+        x = bit_or(bit_and(x, low7), shift_r<1>(uint16x8(bit_and(x, high7))));
+        store_u(dst + i, zip8_lo(x, zero));
+        store_u(dst + i + 4, zip8_hi(x, zero));
+        i += cnt;
+        in += t.consumed[m];
+    }
+#endif
+
+    for (; i < n; ++i) {
+        in = detail::varint_decode_one(in, in_end, dst + i);
+        if (in == nullptr) {
+            return nullptr;
+        }
+    }
+    return in;
+}
+
+#undef SIMDPP_VARINT_USE_PERMUTE
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -9,6 +9,7 @@
 #define LIBSIMDPP_CORE_ALIGNED_ALLOCATOR_H
 
 #include <memory>
+#include <stdexcept>
 #include <cstddef>
 #include <cstdint>
 
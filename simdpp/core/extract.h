@@ -314,6 +314,32 @@ SIMDPP_INL uint16_t extract_bits_any(const uint8x16& ca)
 #endif
 }
 
+/** Extracts a bit from each byte of each element of a int8x32 vector.
+
+    This operation is only sensible if each byte within the vector is either
+    0x00 or 0xff.
+
+    @code
+    r = ((a[0] & 0x??) ? 0x01 : 0) |
+        ((a[1] & 0x??) ? 0x02 : 0) |
+        ...
+        ((a[31] & 0x??) ? 0x80000000 : 0)
+    @endcode
+
+    @icost{SSE2-AVX, 3}
+    @icost{NEON, 13-15}
+    @icost{ALTIVEC, 17-19}
+*/
+SIMDPP_INL uint32_t extract_bits_any(const uint8x32& a)
+{
+#if SIMDPP_USE_AVX2
+    return _mm256_movemask_epi8(a);
+#else
+    return extract_bits_any(a.vec(0)) |
+           (uint32_t(extract_bits_any(a.vec(1))) << 16);
+#endif
+}
+
 /** Extracts specific bit from each byte of each element of a int8x16 vector.
 
     The default template argument selects the bits from each byte in most
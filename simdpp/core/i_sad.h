@@ -0,0 +1,55 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_I_SAD_H
+#define LIBSIMDPP_SIMDPP_CORE_I_SAD_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/i_sad.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Computes the sums of the absolute differences of unsigned 8-bit values.
+    Each 64-bit element of the result holds the sum of the corresponding
+    8 bytes.
+
+    @code
+    r0 = abs(a0 - b0) + abs(a1 - b1) + ... + abs(a7 - b7)
+    ...
+    rM = abs(a(N-8) - b(N-8)) + ... + abs(aN - bN)
+    @endcode
+
+    @par 128-bit version:
+    @icost{SSE2-AVX2, 1}
+    @icost{NEON, 4}
+    @icost{ALTIVEC, 12-15}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, 2}
+    @icost{AVX2, 1}
+    @icost{NEON, 8}
+    @icost{ALTIVEC, 24-30}
+*/
+template<unsigned N, class E1, class E2> SIMDPP_INL
+uint64<N/8> sad(const uint8<N,E1>& a, const uint8<N,E2>& b)
+{
+    return detail::insn::i_sad(a.eval(), b.eval());
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
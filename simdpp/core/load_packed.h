@@ -0,0 +1,74 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_LOAD_PACKED_H
+#define LIBSIMDPP_SIMDPP_CORE_LOAD_PACKED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/mem_packed_n.h>
+#include <simdpp/detail/get_expr.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Loads values packed in groups of K, de-interleaves them and stores the
+    result into K vectors.
+
+    @code
+    v[0]   = [ *(p),     *(p+K),     *(p+2*K),   ... , *(p+M*K-K) ]
+    v[1]   = [ *(p+1),   *(p+K+1),   *(p+2*K+1), ... , *(p+M*K-K+1) ]
+    ...
+    v[K-1] = [ *(p+K-1), *(p+2*K-1), *(p+3*K-1), ... , *(p+M*K-1) ]
+    @endcode
+
+    Here M is the number of elements in the vector. K must be within [2, 8].
+    For K equal to 2, 3 and 4 this is equivalent to load_packed2,
+    load_packed3 and load_packed4.
+
+    @a p must be aligned to the vector size in bytes
+*/
+template<unsigned K, class V> SIMDPP_INL
+void load_packed(V (&v)[K], const void* p)
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be loaded");
+    static_assert(K >= 2 && K <= 8, "K must be within [2, 8]");
+    typename detail::get_expr_nosign<V>::type r[K];
+    detail::insn::i_load_packed_n<K, true>(r, reinterpret_cast<const char*>(p));
+    for (unsigned i = 0; i < K; ++i) {
+        v[i] = r[i];
+    }
+}
+
+/** Loads values packed in groups of K, de-interleaves them and stores the
+    result into K vectors. See load_packed for the details.
+
+    @a p must be aligned to the element size
+*/
+template<unsigned K, class V> SIMDPP_INL
+void load_packed_u(V (&v)[K], const void* p)
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be loaded");
+    static_assert(K >= 2 && K <= 8, "K must be within [2, 8]");
+    typename detail::get_expr_nosign<V>::type r[K];
+    detail::insn::i_load_packed_n<K, false>(r, reinterpret_cast<const char*>(p));
+    for (unsigned i = 0; i < K; ++i) {
+        v[i] = r[i];
+    }
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
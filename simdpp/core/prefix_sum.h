@@ -0,0 +1,137 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_PREFIX_SUM_H
+#define LIBSIMDPP_SIMDPP_CORE_PREFIX_SUM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/prefix_sum.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/// @{
+/** Computes the inclusive prefix sum of the elements of a vector.
+
+    @code
+    r0 = a0
+    r1 = a0 + a1
+    r2 = a0 + a1 + a2
+    ...
+    rN = a0 + a1 + ... + aN
+    @endcode
+
+    Integer sums wrap around on overflow. Floating-point sums are computed in
+    log2(N) steps, thus the rounding differs from a sequential summation.
+
+    @par int8
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 8}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 19-20}
+    @icost{AVX2, 12}
+
+    @par int16
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 6}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 15-16}
+    @icost{AVX2, 10}
+
+    @par int32, float32
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 4}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 11}
+    @icost{AVX2, 8}
+
+    @par int64, float64
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, 2}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, 6}
+    @icost{AVX2, 6}
+    @novec{ALTIVEC}
+*/
+template<unsigned N, class E> SIMDPP_INL
+uint8<N, uint8<N>> prefix_sum(const uint8<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+int8<N, int8<N>> prefix_sum(const int8<N,E>& a)
+{
+    return int8<N>(detail::insn::i_prefix_sum(uint8<N>(a.eval())));
+}
+
+template<unsigned N, class E> SIMDPP_INL
+uint16<N, uint16<N>> prefix_sum(const uint16<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+int16<N, int16<N>> prefix_sum(const int16<N,E>& a)
+{
+    return int16<N>(detail::insn::i_prefix_sum(uint16<N>(a.eval())));
+}
+
+template<unsigned N, class E> SIMDPP_INL
+uint32<N, uint32<N>> prefix_sum(const uint32<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+int32<N, int32<N>> prefix_sum(const int32<N,E>& a)
+{
+    return int32<N>(detail::insn::i_prefix_sum(uint32<N>(a.eval())));
+}
+
+template<unsigned N, class E> SIMDPP_INL
+uint64<N, uint64<N>> prefix_sum(const uint64<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+int64<N, int64<N>> prefix_sum(const int64<N,E>& a)
+{
+    return int64<N>(detail::insn::i_prefix_sum(uint64<N>(a.eval())));
+}
+
+template<unsigned N, class E> SIMDPP_INL
+float32<N, float32<N>> prefix_sum(const float32<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+float64<N, float64<N>> prefix_sum(const float64<N,E>& a)
+{
+    return detail::insn::i_prefix_sum(a.eval());
+}
+/// @}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
+
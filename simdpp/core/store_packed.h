@@ -0,0 +1,74 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_STORE_PACKED_H
+#define LIBSIMDPP_SIMDPP_CORE_STORE_PACKED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/mem_packed_n.h>
+#include <simdpp/detail/get_expr.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Interleaves values from K vectors and stores the result into successive
+    locations starting from @a p.
+
+    @code
+    [ *(p),     *(p+K),     *(p+2*K),   ... , *(p+M*K-K) ]   = v[0]
+    [ *(p+1),   *(p+K+1),   *(p+2*K+1), ... , *(p+M*K-K+1) ] = v[1]
+    ...
+    [ *(p+K-1), *(p+2*K-1), *(p+3*K-1), ... , *(p+M*K-1) ]   = v[K-1]
+    @endcode
+
+    Here M is the number of elements in the vector. K must be within [2, 8].
+    For K equal to 2, 3 and 4 this is equivalent to store_packed2,
+    store_packed3 and store_packed4.
+
+    @a p must be aligned to the vector size in bytes
+*/
+template<unsigned K, class V> SIMDPP_INL
+void store_packed(void* p, const V (&v)[K])
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be stored");
+    static_assert(K >= 2 && K <= 8, "K must be within [2, 8]");
+    typename detail::get_expr_nosign<V>::type r[K];
+    for (unsigned i = 0; i < K; ++i) {
+        r[i] = v[i];
+    }
+    detail::insn::i_store_packed_n<K, true>(reinterpret_cast<char*>(p), r);
+}
+
+/** Interleaves values from K vectors and stores the result into successive
+    locations starting from @a p. See store_packed for the details.
+
+    @a p must be aligned to the element size
+*/
+template<unsigned K, class V> SIMDPP_INL
+void store_packed_u(void* p, const V (&v)[K])
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be stored");
+    static_assert(K >= 2 && K <= 8, "K must be within [2, 8]");
+    typename detail::get_expr_nosign<V>::type r[K];
+    for (unsigned i = 0; i < K; ++i) {
+        r[i] = v[i];
+    }
+    detail::insn::i_store_packed_n<K, false>(reinterpret_cast<char*>(p), r);
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
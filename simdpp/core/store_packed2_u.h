@@ -0,0 +1,54 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_STORE_PACKED2_U_H
+#define LIBSIMDPP_SIMDPP_CORE_STORE_PACKED2_U_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/store_packed_u.h>
+#include <simdpp/detail/get_expr.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Interleaves values from two vectors and stores the result into successive
+    locations starting from @a p.
+
+    @code
+    [ *(p),   *(p+2), *(p+4), ... , *(p+M*2-2) ] = a
+    [ *(p+1), *(p+3), *(p+5), ... , *(p+M*2-1) ] = b
+    @endcode
+
+    Here M is the number of elements in the vector
+
+    @a p must be aligned to the element size
+*/
+template<unsigned N, class V1, class V2> SIMDPP_INL
+void store_packed2_u(void* p,
+                     const any_vec<N,V1>& a, const any_vec<N,V2>& b)
+{
+    static_assert(!is_mask<V1>::value && !is_mask<V2>::value,
+                  "Mask types can not be stored");
+    static_assert(V1::size_tag == V2::size_tag,
+                  "Vector elements must have the same size");
+    using T = typename detail::get_expr_nosign<V1>::type;
+    detail::insn::i_store_packed2_u(reinterpret_cast<char*>(p),
+                                    T(a.wrapped().eval()), T(b.wrapped().eval()));
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,59 @@
+/*  Copyright (C) 2013-2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_STORE_U_H
+#define LIBSIMDPP_SIMDPP_CORE_STORE_U_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/store_u.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Stores a 128-bit or 256-bit integer, 32-bit or 64-bit float vector to an
+    unaligned memory location.
+
+    @par 128-bit version:
+
+    @code
+    *(p) = a[0..127]
+    @endcode
+    @a p must be aligned to the element size.
+
+    @icost{ALTIVEC, 17}
+
+    @par 256-bit version:
+
+    @code
+    *(p) = a[0..255]
+    @endcode
+    @a p must be aligned to the element size.
+
+    @icost{SSE2-SSE4.1, NEON, 2}
+    @icost{AVX (integer vectors), 2}
+    @icost{ALTIVEC, 34}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void store_u(void* p, const any_vec<N,V>& a)
+{
+    static_assert(!is_mask<V>::value, "Masks can not be stored"); // FIXME: automatically convert
+    detail::insn::i_store_u(reinterpret_cast<char*>(p), a.wrapped().eval());
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
+
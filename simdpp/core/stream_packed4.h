@@ -0,0 +1,62 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_STREAM_PACKED4_H
+#define LIBSIMDPP_SIMDPP_CORE_STREAM_PACKED4_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/store_packed_u.h>
+#include <simdpp/detail/get_expr.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+
+/** Interleaves values from four vectors and stores the result into successive
+    locations starting from @a p without polluting the caches, if possible.
+
+    @code
+    [ *(p),   *(p+4), *(p+8), ... , *(p+M*4-4) ] = a
+    [ *(p+1), *(p+5), *(p+9), ... , *(p+M*4-3) ] = b
+    [ *(p+2), *(p+6), *(p+10), ... , *(p+M*4-2) ] = c
+    [ *(p+3), *(p+7), *(p+11), ... , *(p+M*4-1) ] = d
+    @endcode
+
+    Here M is the number of elements in the vector
+
+    @a p must be aligned to the vector size in bytes. This is intended for
+    large outputs that are not read again soon. See stream for the details.
+*/
+template<unsigned N, class V1, class V2, class V3, class V4> SIMDPP_INL
+void stream_packed4(void* p,
+                    const any_vec<N,V1>& a, const any_vec<N,V2>& b,
+                    const any_vec<N,V3>& c, const any_vec<N,V4>& d)
+{
+    static_assert(!is_mask<V1>::value && !is_mask<V2>::value &&
+                  !is_mask<V3>::value && !is_mask<V4>::value,
+                  "Mask types can not be stored");
+    static_assert(V1::size_tag == V2::size_tag &&
+                  V1::size_tag == V3::size_tag &&
+                  V1::size_tag == V4::size_tag,
+                  "Vector elements must have the same size");
+    using T = typename detail::get_expr_nosign<V1>::type;
+    detail::insn::i_stream_packed4(reinterpret_cast<char*>(p),
+                                   T(a.wrapped().eval()), T(b.wrapped().eval()),
+                                   T(c.wrapped().eval()), T(d.wrapped().eval()));
+}
+
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -18,6 +18,7 @@
 #include <simdpp/core/detail/vec_insert.h>
 #include <simdpp/core/to_int64.h>
 #include <simdpp/core/combine.h>
+#include <simdpp/core/split.h>
 #include <simdpp/core/zip_hi.h>
 #include <simdpp/core/zip_lo.h>
 
@@ -92,6 +93,10 @@ int32<16> expr_eval(const expr_mull<int16<16,E1>,
     int16<16> b = q.b.eval();
     int16x16 lo = _mm256_mullo_epi16(a, b);
     int16x16 hi = _mm256_mulhi_epi16(a, b);
+    // zip works within 128-bit lanes, so swap the middle 64-bit quarters to
+    // get the results in order
+    lo = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(3,1,2,0));
+    hi = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(3,1,2,0));
     return (int32<16>) combine(zip8_lo(lo, hi), zip8_hi(lo, hi));
 }
 #endif
@@ -147,6 +152,10 @@ uint32<16> expr_eval(const expr_mull<uint16<16,E1>,
     uint16<16> b = q.b.eval();
     int16x16 lo = _mm256_mullo_epi16(a, b);
     int16x16 hi = _mm256_mulhi_epu16(a, b);
+    // zip works within 128-bit lanes, so swap the middle 64-bit quarters to
+    // get the results in order
+    lo = _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(3,1,2,0));
+    hi = _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(3,1,2,0));
     return (uint32<16>) combine(zip8_lo(lo, hi), zip8_hi(lo, hi));
 }
 #endif
@@ -205,14 +214,32 @@ int64<8> expr_eval(const expr_mull<int32<8,E1>,
 {
     int32<8> a = q.a.eval();
     int32<8> b = q.b.eval();
-    int32x8 al, ah, bl, bh;
+    int32x4 al, ah, bl, bh;
     int64x4 rl, rh;
-    al = zip4_lo(a, a);
-    bl = zip4_lo(b, b);
-    ah = zip4_hi(a, a);
-    bh = zip4_hi(b, b);
-    rl = _mm256_mul_epi32(al, bl);
-    rh = _mm256_mul_epi32(ah, bh);
+    split(a, al, ah);
+    split(b, bl, bh);
+    rl = _mm256_mul_epi32(_mm256_cvtepi32_epi64(al), _mm256_cvtepi32_epi64(bl));
+    rh = _mm256_mul_epi32(_mm256_cvtepi32_epi64(ah), _mm256_cvtepi32_epi64(bh));
+    return combine(rl, rh);
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+template<class R, class E1, class E2> SIMDPP_INL
+int64<16> expr_eval(const expr_mull<int32<16,E1>,
+                                    int32<16,E2>>& q)
+{
+    int32<16> a = q.a.eval();
+    int32<16> b = q.b.eval();
+    int32<8> al, ah, bl, bh;
+    int64<8> rl, rh;
+
+    split(a, al, ah);
+    split(b, bl, bh);
+
+    rl = _mm512_mul_epi32(to_int64(al).eval(), to_int64(bl).eval());
+    rh = _mm512_mul_epi32(to_int64(ah).eval(), to_int64(bh).eval());
+
     return combine(rl, rh);
 }
 #endif
@@ -271,14 +298,12 @@ uint64<8> expr_eval(const expr_mull<uint32<8,E1>,
 {
     uint32<8> a = q.a.eval();
     uint32<8> b = q.b.eval();
-    uint32x8 al, ah, bl, bh;
+    uint32x4 al, ah, bl, bh;
     uint64x4 rl, rh;
-    al = zip4_lo(a, a); // FIXME; extract halves and use cvtepu32_epi64
-    bl = zip4_lo(b, b);
-    ah = zip4_hi(a, a);
-    bh = zip4_hi(b, b);
-    rl = _mm256_mul_epu32(al, bl);
-    rh = _mm256_mul_epu32(ah, bh);
+    split(a, al, ah);
+    split(b, bl, bh);
+    rl = _mm256_mul_epu32(_mm256_cvtepu32_epi64(al), _mm256_cvtepu32_epi64(bl));
+    rh = _mm256_mul_epu32(_mm256_cvtepu32_epi64(ah), _mm256_cvtepu32_epi64(bh));
     return combine(rl, rh);
 }
 #endif
@@ -13,6 +13,7 @@
 #endif
 
 #include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
 #include <simdpp/core/bit_not.h>
 #include <simdpp/core/cmp_eq.h>
 #include <simdpp/detail/not_implemented.h>
@@ -129,9 +130,9 @@ SIMDPP_INL mask_int64x2 i_cmp_neq(const uint64x2& a, const uint64x2& b)
     r32 = (uint32x4)cmp_eq(uint32x4(a), uint32x4(b));
     // swap the 32-bit halves
     r32s = bit_or(shift_l<32>(r32), shift_r<32>(r32));
-    // combine the results. Each 32-bit half is ORed with the neighbouring pair
-    r32 = bit_or(r32, r32s);
-    return r32;
+    // combine the results. Each 32-bit half is ANDed with the neighbouring pair
+    r32 = bit_and(r32, r32s);
+    return (mask_int64x2) bit_not(r32);
 #elif SIMDPP_USE_ALTIVEC
     uint16x8 mask = make_shuffle_bytes16_mask<0, 2, 1, 3>(mask);
     uint32x4 a0, b0, r, ones;
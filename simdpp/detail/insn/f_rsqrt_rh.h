@@ -34,7 +34,7 @@ V v_rsqrt_rh(const V& x,const V& a)
     x2 = mul(x, x);
     r = mul(a, x2);
     r = sub(3.0, r);
-    const auto tmp_x = mul(x, 0.5);
+    V tmp_x = mul(x, 0.5);
     r = mul(tmp_x, r);
 
     return r;
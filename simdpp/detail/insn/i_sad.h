@@ -0,0 +1,103 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_I_SAD_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_I_SAD_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub_sat.h>
+#include <simdpp/core/make_uint.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+#if SIMDPP_USE_ALTIVEC
+/*  The absolute differences are summed in three steps, each of which adds
+    the two halves of the elements of twice the width of the previous step.
+*/
+SIMDPP_INL uint64x2 v_emul_sad(const uint8x16& a, const uint8x16& b)
+{
+    uint8x16 d = bit_or(sub_sat(a, b), sub_sat(b, a));
+    uint16x8 d16 = uint16x8(d);
+    d16 = add(bit_and(d16, 0xff), shift_r<8>(d16));
+    uint32x4 d32 = uint32x4(d16);
+    d32 = add(bit_and(d32, 0xffff), shift_r<16>(d32));
+    uint64x2 d64 = uint64x2(d32);
+    return add(bit_and(d64, make_uint(0xffffffff)), shift_r<32>(d64));
+}
+#endif
+
+SIMDPP_INL uint64x2 i_sad(const uint8x16& a, const uint8x16& b)
+{
+#if SIMDPP_USE_NULL
+    uint64x2 r;
+    for (unsigned i = 0; i < 2; ++i) {
+        uint64_t s = 0;
+        for (unsigned j = 0; j < 8; ++j) {
+            uint8_t x = a.el(i*8 + j);
+            uint8_t y = b.el(i*8 + j);
+            s += x > y ? x - y : y - x;
+        }
+        r.el(i) = s;
+    }
+    return r;
+#elif SIMDPP_USE_SSE2
+    return _mm_sad_epu8(a, b);
+#elif SIMDPP_USE_NEON
+    uint16x8 d16 = vpaddlq_u8(vabdq_u8(a, b));
+    return vpaddlq_u32(vpaddlq_u16(d16));
+#elif SIMDPP_USE_ALTIVEC
+    return v_emul_sad(a, b);
+#endif
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint64x4 i_sad(const uint8x32& a, const uint8x32& b)
+{
+    return _mm256_sad_epu8(a, b);
+}
+#endif
+
+template<unsigned N> SIMDPP_INL
+uint64<N/8> i_sad(const uint8<N>& a, const uint8<N>& b)
+{
+#if SIMDPP_USE_AVX512
+    /*  There are no 512-bit byte vectors, each native vector of the result
+        is combined from the results of two 256-bit vectors.
+    */
+    uint64<N/8> r;
+    for (unsigned i = 0; i < r.vec_length; ++i) {
+        r.vec(i) = combine(i_sad(a.vec(2*i), b.vec(2*i)),
+                           i_sad(a.vec(2*i+1), b.vec(2*i+1)));
+    }
+    return r;
+#else
+    SIMDPP_VEC_ARRAY_IMPL2(uint64<N/8>, i_sad, a, b);
+#endif
+}
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,285 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_LOAD_PACKED_U_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_LOAD_PACKED_U_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/detail/null/memory.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+/*  The unaligned variants load each native vector with an unaligned load and
+    then de-interleave the data in registers in the same way as the aligned
+    variants. Unaligned loads have the same cost as aligned loads on data that
+    is actually aligned on all supported x86 architectures since Nehalem.
+
+    The NEON vld2q, vld3q and vld4q instructions need only the alignment of
+    the element, thus they are used directly for the native vectors.
+*/
+template<class B> SIMDPP_INL
+void v_load_packed2_u(B& a, B& b, const char* p)
+{
+#if SIMDPP_USE_NULL
+    detail::null::load_packed2(a, b, p);
+#else
+    const unsigned veclen = sizeof(B);
+    a = load_u(p);
+    b = load_u(p + veclen);
+    mem_unpack2(a, b);
+#endif
+}
+
+#if SIMDPP_USE_NEON
+SIMDPP_INL void v_load_packed2_u(uint8x16& a, uint8x16& b, const char* p)
+{
+    auto r = vld2q_u8(reinterpret_cast<const uint8_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+
+SIMDPP_INL void v_load_packed2_u(uint16x8& a, uint16x8& b, const char* p)
+{
+    auto r = vld2q_u16(reinterpret_cast<const uint16_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+
+SIMDPP_INL void v_load_packed2_u(uint32x4& a, uint32x4& b, const char* p)
+{
+    auto r = vld2q_u32(reinterpret_cast<const uint32_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void v_load_packed2_u(float32x4& a, float32x4& b, const char* p)
+{
+    auto r = vld2q_f32(reinterpret_cast<const float*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void v_load_packed2_u(uint64x2& a, uint64x2& b, const char* p)
+{
+    auto r = vld2q_u64(reinterpret_cast<const uint64_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+
+SIMDPP_INL void v_load_packed2_u(float64x2& a, float64x2& b, const char* p)
+{
+    auto r = vld2q_f64(reinterpret_cast<const double*>(p));
+    a = r.val[0];
+    b = r.val[1];
+}
+#endif
+#endif
+
+template<class V> SIMDPP_INL
+void i_load_packed2_u(V& a, V& b, const char* p)
+{
+    const unsigned veclen = sizeof(typename V::base_vector_type);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        v_load_packed2_u(a.vec(i), b.vec(i), p);
+        p += veclen*2;
+    }
+}
+
+template<class B> SIMDPP_INL
+void v_load_packed3_u(B& a, B& b, B& c, const char* p)
+{
+#if SIMDPP_USE_NULL
+    detail::null::load_packed3(a, b, c, p);
+#else
+    const unsigned veclen = sizeof(B);
+    a = load_u(p);
+    b = load_u(p + veclen);
+    c = load_u(p + veclen*2);
+    mem_unpack3(a, b, c);
+#endif
+}
+
+#if SIMDPP_USE_NEON
+SIMDPP_INL void v_load_packed3_u(uint8x16& a, uint8x16& b, uint8x16& c, const char* p)
+{
+    auto r = vld3q_u8(reinterpret_cast<const uint8_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+
+SIMDPP_INL void v_load_packed3_u(uint16x8& a, uint16x8& b, uint16x8& c, const char* p)
+{
+    auto r = vld3q_u16(reinterpret_cast<const uint16_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+
+SIMDPP_INL void v_load_packed3_u(uint32x4& a, uint32x4& b, uint32x4& c, const char* p)
+{
+    auto r = vld3q_u32(reinterpret_cast<const uint32_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void v_load_packed3_u(float32x4& a, float32x4& b, float32x4& c, const char* p)
+{
+    auto r = vld3q_f32(reinterpret_cast<const float*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void v_load_packed3_u(uint64x2& a, uint64x2& b, uint64x2& c, const char* p)
+{
+    auto r = vld3q_u64(reinterpret_cast<const uint64_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+
+SIMDPP_INL void v_load_packed3_u(float64x2& a, float64x2& b, float64x2& c, const char* p)
+{
+    auto r = vld3q_f64(reinterpret_cast<const double*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+}
+#endif
+#endif
+
+template<class V> SIMDPP_INL
+void i_load_packed3_u(V& a, V& b, V& c, const char* p)
+{
+    const unsigned veclen = sizeof(typename V::base_vector_type);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        v_load_packed3_u(a.vec(i), b.vec(i), c.vec(i), p);
+        p += veclen*3;
+    }
+}
+
+template<class B> SIMDPP_INL
+void v_load_packed4_u(B& a, B& b, B& c, B& d, const char* p)
+{
+#if SIMDPP_USE_NULL
+    detail::null::load_packed4(a, b, c, d, p);
+#else
+    const unsigned veclen = sizeof(B);
+    a = load_u(p);
+    b = load_u(p + veclen);
+    c = load_u(p + veclen*2);
+    d = load_u(p + veclen*3);
+    mem_unpack4(a, b, c, d);
+#endif
+}
+
+#if SIMDPP_USE_NEON
+SIMDPP_INL void v_load_packed4_u(uint8x16& a, uint8x16& b, uint8x16& c, uint8x16& d,
+                                 const char* p)
+{
+    auto r = vld4q_u8(reinterpret_cast<const uint8_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+
+SIMDPP_INL void v_load_packed4_u(uint16x8& a, uint16x8& b, uint16x8& c, uint16x8& d,
+                                 const char* p)
+{
+    auto r = vld4q_u16(reinterpret_cast<const uint16_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+
+SIMDPP_INL void v_load_packed4_u(uint32x4& a, uint32x4& b, uint32x4& c, uint32x4& d,
+                                 const char* p)
+{
+    auto r = vld4q_u32(reinterpret_cast<const uint32_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void v_load_packed4_u(float32x4& a, float32x4& b, float32x4& c, float32x4& d,
+                                 const char* p)
+{
+    auto r = vld4q_f32(reinterpret_cast<const float*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void v_load_packed4_u(uint64x2& a, uint64x2& b, uint64x2& c, uint64x2& d,
+                                 const char* p)
+{
+    auto r = vld4q_u64(reinterpret_cast<const uint64_t*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+
+SIMDPP_INL void v_load_packed4_u(float64x2& a, float64x2& b, float64x2& c, float64x2& d,
+                                 const char* p)
+{
+    auto r = vld4q_f64(reinterpret_cast<const double*>(p));
+    a = r.val[0];
+    b = r.val[1];
+    c = r.val[2];
+    d = r.val[3];
+}
+#endif
+#endif
+
+template<class V> SIMDPP_INL
+void i_load_packed4_u(V& a, V& b, V& c, V& d, const char* p)
+{
+    const unsigned veclen = sizeof(typename V::base_vector_type);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        v_load_packed4_u(a.vec(i), b.vec(i), c.vec(i), d.vec(i), p);
+        p += veclen*4;
+    }
+}
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,448 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_MEM_PACKED_N_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_MEM_PACKED_N_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/split.h>
+#include <simdpp/detail/insn/load.h>
+#include <simdpp/detail/insn/load_packed2.h>
+#include <simdpp/detail/insn/load_packed3.h>
+#include <simdpp/detail/insn/load_packed4.h>
+#include <simdpp/detail/insn/load_u.h>
+#include <simdpp/detail/insn/mem_pack.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/detail/insn/store.h>
+#include <simdpp/detail/insn/store_packed2.h>
+#include <simdpp/detail/insn/store_packed3.h>
+#include <simdpp/detail/insn/store_packed4.h>
+#include <simdpp/detail/insn/store_u.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+/*  The generic versions of load_packed and store_packed operate on K native
+    vectors at a time. Group sizes that are products of 2, 3 and 4 are
+    composed from the existing mem_unpack and mem_pack networks: de-interleaving
+    the whole stream by 2 leaves the even and the odd channels in the even and
+    the odd vectors, which are then de-interleaved by K/2. The prime group
+    sizes 5 and 7 use a network of byte permutations within 128-bit lanes
+    instead: each lane of each result is the bitwise OR of one permutation of
+    every input lane. The network needs K*K permutations per K vectors, which
+    is slower than moving the elements one by one when there are only 4 or 2
+    elements per lane, thus it is used for 8 and 16-bit elements only.
+*/
+
+#if SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC
+#define SIMDPP_MEM_PACKED_N_USE_PERMUTE 1
+#endif
+
+/*  The permutation indices for K channels with S-byte elements. ld[j][s]
+    selects the bytes of channel j that come from the s-th 128-bit lane of
+    the interleaved data, st[s][j] selects the bytes of the s-th lane of the
+    interleaved data that come from channel j. The remaining bytes are zeroed.
+    Each index vector is repeated so that it can be loaded for any vector
+    width.
+*/
+template<unsigned K, unsigned S>
+struct mem_packed_n_tables {
+    SIMDPP_ALIGN(64) uint8_t ld[K][K][64];
+    SIMDPP_ALIGN(64) uint8_t st[K][K][64];
+
+    mem_packed_n_tables()
+    {
+        for (unsigned a = 0; a < K; ++a) {
+            for (unsigned b = 0; b < K; ++b) {
+                for (unsigned q = 0; q < 16; ++q) {
+                    // byte q of channel a within the interleaved data
+                    unsigned n = ((q / S) * K + a) * S + q % S;
+                    uint8_t l = n / 16 == b ? n % 16 : 0x80;
+                    // byte q of lane a of the interleaved data
+                    unsigned t = (a * 16 + q) / S;
+                    uint8_t s = t % K == b ? (t / K) * S + q % S : 0x80;
+                    for (unsigned r = 0; r < 64; r += 16) {
+                        ld[a][b][q + r] = l;
+                        st[a][b][q + r] = s;
+                    }
+                }
+            }
+        }
+    }
+};
+
+template<unsigned K, unsigned S>
+const mem_packed_n_tables<K,S>& get_mem_packed_n_tables()
+{
+    static const mem_packed_n_tables<K,S> tables;
+    return tables;
+}
+
+/*  Loads or stores P 128-bit lanes that are located @a stride bytes apart as
+    a single vector.
+*/
+template<unsigned P> struct mem_packed_n_lanes;
+
+template<> struct mem_packed_n_lanes<1> {
+    static SIMDPP_INL uint8<16> load(const char* p, unsigned)
+    {
+        return load_u(p);
+    }
+    static SIMDPP_INL void store(char* p, unsigned, const uint8<16>& a)
+    {
+        i_store_u(p, a);
+    }
+};
+
+template<> struct mem_packed_n_lanes<2> {
+    static SIMDPP_INL uint8<32> load(const char* p, unsigned stride)
+    {
+        uint8<16> a = load_u(p);
+        uint8<16> b = load_u(p + stride);
+        return combine(a, b);
+    }
+    static SIMDPP_INL void store(char* p, unsigned stride, const uint8<32>& a)
+    {
+        uint8<16> a0, a1;
+        split(a, a0, a1);
+        i_store_u(p, a0);
+        i_store_u(p + stride, a1);
+    }
+};
+
+template<> struct mem_packed_n_lanes<4> {
+    static SIMDPP_INL uint8<64> load(const char* p, unsigned stride)
+    {
+        uint8<32> a = mem_packed_n_lanes<2>::load(p, stride);
+        uint8<32> b = mem_packed_n_lanes<2>::load(p + 2*stride, stride);
+        return combine(a, b);
+    }
+    static SIMDPP_INL void store(char* p, unsigned stride, const uint8<64>& a)
+    {
+        uint8<32> a0, a1;
+        split(a, a0, a1);
+        mem_packed_n_lanes<2>::store(p, stride, a0);
+        mem_packed_n_lanes<2>::store(p + 2*stride, stride, a1);
+    }
+};
+
+template<bool Aligned> struct mem_packed_n_access;
+
+template<> struct mem_packed_n_access<true> {
+    template<class V> static SIMDPP_INL
+    void load(V& a, const char* p) { i_load(a, p); }
+    template<class V> static SIMDPP_INL
+    void store(char* p, const V& a) { i_store(p, a); }
+};
+
+template<> struct mem_packed_n_access<false> {
+    template<class V> static SIMDPP_INL
+    void load(V& a, const char* p) { i_load_u(a, p); }
+    template<class V> static SIMDPP_INL
+    void store(char* p, const V& a) { i_store_u(p, a); }
+};
+
+template<bool A, class V> SIMDPP_INL
+void v_mem_packed_n_load(V* v, unsigned k, const char* p)
+{
+    for (unsigned i = 0; i < k; ++i) {
+        mem_packed_n_access<A>::load(v[i], p + i * sizeof(V));
+    }
+}
+
+template<bool A, class V> SIMDPP_INL
+void v_mem_packed_n_store(char* p, const V* v, unsigned k)
+{
+    for (unsigned i = 0; i < k; ++i) {
+        mem_packed_n_access<A>::store(p + i * sizeof(V), v[i]);
+    }
+}
+
+#if SIMDPP_MEM_PACKED_N_USE_PERMUTE
+template<unsigned K, class V> SIMDPP_INL
+void v_mem_unpack_n_permute(V* v, const char* p)
+{
+    using U = uint8<sizeof(V)>;
+    const unsigned P = sizeof(V) / 16;
+    const auto& tables = get_mem_packed_n_tables<K, sizeof(typename V::element_type)>();
+
+    U t[K];
+    for (unsigned s = 0; s < K; ++s) {
+        t[s] = mem_packed_n_lanes<P>::load(p + 16*s, 16*K);
+    }
+    for (unsigned j = 0; j < K; ++j) {
+        U r = permute_zbytes16(t[0], U(load(tables.ld[j][0])));
+        for (unsigned s = 1; s < K; ++s) {
+            r = bit_or(r, permute_zbytes16(t[s], U(load(tables.ld[j][s]))));
+        }
+        v[j] = V(r);
+    }
+}
+
+template<unsigned K, class V> SIMDPP_INL
+void v_mem_pack_n_permute(char* p, const V* v)
+{
+    using U = uint8<sizeof(V)>;
+    const unsigned P = sizeof(V) / 16;
+    const auto& tables = get_mem_packed_n_tables<K, sizeof(typename V::element_type)>();
+
+    U t[K];
+    for (unsigned j = 0; j < K; ++j) {
+        t[j] = U(v[j]);
+    }
+    for (unsigned s = 0; s < K; ++s) {
+        U r = permute_zbytes16(t[0], U(load(tables.st[s][0])));
+        for (unsigned j = 1; j < K; ++j) {
+            r = bit_or(r, permute_zbytes16(t[j], U(load(tables.st[s][j]))));
+        }
+        mem_packed_n_lanes<P>::store(p + 16*s, 16*K, r);
+    }
+}
+#endif
+
+template<unsigned K, class V> SIMDPP_INL
+void v_mem_unpack_n_scalar(V* v, const char* p)
+{
+    using E = typename V::element_type;
+    const E* pe = reinterpret_cast<const E*>(p);
+    SIMDPP_ALIGN(64) E t[V::length];
+
+    for (unsigned j = 0; j < K; ++j) {
+        for (unsigned i = 0; i < V::length; ++i) {
+            t[i] = pe[i*K + j];
+        }
+        v[j] = load(t);
+    }
+}
+
+template<unsigned K, class V> SIMDPP_INL
+void v_mem_pack_n_scalar(char* p, const V* v)
+{
+    using E = typename V::element_type;
+    E* pe = reinterpret_cast<E*>(p);
+    SIMDPP_ALIGN(64) E t[V::length];
+
+    for (unsigned j = 0; j < K; ++j) {
+        i_store(reinterpret_cast<char*>(t), v[j]);
+        for (unsigned i = 0; i < V::length; ++i) {
+            pe[i*K + j] = t[i];
+        }
+    }
+}
+
+/*  De-interleaves or interleaves K native vectors. A selects aligned memory
+    access.
+*/
+template<unsigned K> struct mem_packed_n;
+
+template<> struct mem_packed_n<2> {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+        if (A) {
+            i_load_packed2(v[0], v[1], p);
+        } else {
+            v_mem_packed_n_load<A>(v, 2, p);
+            mem_unpack2(v[0], v[1]);
+        }
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+        if (A) {
+            i_store_packed2(p, v[0], v[1]);
+        } else {
+            mem_pack2(v[0], v[1]);
+            v_mem_packed_n_store<A>(p, v, 2);
+        }
+    }
+};
+
+template<> struct mem_packed_n<3> {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+        if (A) {
+            i_load_packed3(v[0], v[1], v[2], p);
+        } else {
+            v_mem_packed_n_load<A>(v, 3, p);
+            mem_unpack3(v[0], v[1], v[2]);
+        }
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+        if (A) {
+            i_store_packed3(p, v[0], v[1], v[2]);
+        } else {
+            mem_pack3(v[0], v[1], v[2]);
+            v_mem_packed_n_store<A>(p, v, 3);
+        }
+    }
+};
+
+template<> struct mem_packed_n<4> {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+        if (A) {
+            i_load_packed4(v[0], v[1], v[2], v[3], p);
+        } else {
+            v_mem_packed_n_load<A>(v, 4, p);
+            mem_unpack4(v[0], v[1], v[2], v[3]);
+        }
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+        if (A) {
+            i_store_packed4(p, v[0], v[1], v[2], v[3]);
+        } else {
+            mem_pack4(v[0], v[1], v[2], v[3]);
+            v_mem_packed_n_store<A>(p, v, 4);
+        }
+    }
+};
+
+template<> struct mem_packed_n<6> {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+        v_mem_packed_n_load<A>(v, 6, p);
+        mem_unpack2(v[0], v[1]);
+        mem_unpack2(v[2], v[3]);
+        mem_unpack2(v[4], v[5]);
+        mem_unpack3(v[0], v[2], v[4]);
+        mem_unpack3(v[1], v[3], v[5]);
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+        mem_pack3(v[0], v[2], v[4]);
+        mem_pack3(v[1], v[3], v[5]);
+        mem_pack2(v[0], v[1]);
+        mem_pack2(v[2], v[3]);
+        mem_pack2(v[4], v[5]);
+        v_mem_packed_n_store<A>(p, v, 6);
+    }
+};
+
+template<> struct mem_packed_n<8> {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+        v_mem_packed_n_load<A>(v, 8, p);
+        mem_unpack2(v[0], v[1]);
+        mem_unpack2(v[2], v[3]);
+        mem_unpack2(v[4], v[5]);
+        mem_unpack2(v[6], v[7]);
+        mem_unpack4(v[0], v[2], v[4], v[6]);
+        mem_unpack4(v[1], v[3], v[5], v[7]);
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+        mem_pack4(v[0], v[2], v[4], v[6]);
+        mem_pack4(v[1], v[3], v[5], v[7]);
+        mem_pack2(v[0], v[1]);
+        mem_pack2(v[2], v[3]);
+        mem_pack2(v[4], v[5]);
+        mem_pack2(v[6], v[7]);
+        v_mem_packed_n_store<A>(p, v, 8);
+    }
+};
+
+template<unsigned K> struct mem_packed_n_prime {
+    template<bool A, class V> static SIMDPP_INL
+    void load(V* v, const char* p)
+    {
+#if SIMDPP_MEM_PACKED_N_USE_PERMUTE
+        if (sizeof(typename V::element_type) <= 2) {
+            v_mem_unpack_n_permute<K>(v, p);
+            return;
+        }
+#endif
+        v_mem_unpack_n_scalar<K>(v, p);
+    }
+
+    template<bool A, class V> static SIMDPP_INL
+    void store(char* p, V* v)
+    {
+#if SIMDPP_MEM_PACKED_N_USE_PERMUTE
+        if (sizeof(typename V::element_type) <= 2) {
+            v_mem_pack_n_permute<K>(p, v);
+            return;
+        }
+#endif
+        v_mem_pack_n_scalar<K>(p, v);
+    }
+};
+
+template<> struct mem_packed_n<5> : mem_packed_n_prime<5> {};
+template<> struct mem_packed_n<7> : mem_packed_n_prime<7> {};
+
+template<unsigned K, bool A, class V> SIMDPP_INL
+void i_load_packed_n(V* v, const char* p)
+{
+    using B = typename V::base_vector_type;
+    const unsigned veclen = sizeof(B);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B r[K];
+        mem_packed_n<K>::template load<A>(r, p);
+        for (unsigned j = 0; j < K; ++j) {
+            v[j].vec(i) = r[j];
+        }
+        p += veclen*K;
+    }
+}
+
+template<unsigned K, bool A, class V> SIMDPP_INL
+void i_store_packed_n(char* p, const V* v)
+{
+    using B = typename V::base_vector_type;
+    const unsigned veclen = sizeof(B);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B r[K];
+        for (unsigned j = 0; j < K; ++j) {
+            r[j] = v[j].vec(i);
+        }
+        mem_packed_n<K>::template store<A>(p, r);
+        p += veclen*K;
+    }
+}
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#undef SIMDPP_MEM_PACKED_N_USE_PERMUTE
+
+#endif
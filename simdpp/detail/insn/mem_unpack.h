@@ -534,30 +534,28 @@ template<class V> SIMDPP_INL
 void v_mem_unpack4_shuffle128(any_vec<64,V>& qa, any_vec<64,V>& qb,
                               any_vec<64,V>& qc, any_vec<64,V>& qd)
 {
-    V a, b, c, d; // TODO: optimize. Using full-vector shuffle/permute will be faster
-
+    // transpose the 4x4 matrix of 128-bit items so that the n-th 128-bit
+    // lanes contain the 4n-th to (4n+3)-th items
+    V a, b, c, d, t0, t1, t2, t3;
 
     a = qa.wrapped();  b = qb.wrapped();  c = qc.wrapped();  d = qd.wrapped();
 
-    V t11, t12, t21, t22, t31, t32;
-    // [a0,b0,c0,a1]
-    // [b1,c1,a2,b2]
-    // [c2,a3,b3,c3]
-    t11 = a;
-    t12 = shuffle2_128<0,1,2,3>(c, b);
-    t21 = shuffle2_128<0,1,0,1>(a, b);
-    t22 = shuffle2_128<2,3,2,3>(b, c);
-    t31 = shuffle2_128<2,3,0,1>(a, b);
-    t32 = c;
-    // [a0,b0,c0,a1]
-    // [c2,a3,a2,b2]
-    // [a0,b0,b1,c1]
-    // [a2,b2,b3,c3]
-    // [c0,a1,b1,c1]
-    // [c2,a3,b3,c3]
-    a = shuffle2_128<0,3,2,1>(t11, t12);
-    b = shuffle2_128<1,2,1,2>(t21, t22);
-    c = shuffle2_128<0,3,0,3>(t31, t32);
+    // [a0,a1,b0,b1]
+    // [a2,a3,b2,b3]
+    // [c0,c1,d0,d1]
+    // [c2,c3,d2,d3]
+    t0 = shuffle2_128<0,1,0,1>(a, b);
+    t1 = shuffle2_128<2,3,2,3>(a, b);
+    t2 = shuffle2_128<0,1,0,1>(c, d);
+    t3 = shuffle2_128<2,3,2,3>(c, d);
+    // [a0,b0,c0,d0]
+    // [a1,b1,c1,d1]
+    // [a2,b2,c2,d2]
+    // [a3,b3,c3,d3]
+    a = shuffle2_128<0,2,0,2>(t0, t2);
+    b = shuffle2_128<1,3,1,3>(t0, t2);
+    c = shuffle2_128<0,2,0,2>(t1, t3);
+    d = shuffle2_128<1,3,1,3>(t1, t3);
 
     qa.wrapped() = a;  qb.wrapped() = b;  qc.wrapped() = c;  qd.wrapped() = d;
 }
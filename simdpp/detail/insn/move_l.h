@@ -232,7 +232,7 @@ float64<8> i_move2_l(const float64<8>& a)
     static_assert(shift <= 2, "Selector out of range");
     switch (shift) {
     case 0: return a;
-    case 1: return _mm512_maskz_shuffle_pd(0x55, a, a, _MM_SHUFFLE2(1, 1));
+    case 1: return _mm512_maskz_shuffle_pd(0x55, a, a, 0xff);
     case 2: return float64<8>::zero();
     }
 }
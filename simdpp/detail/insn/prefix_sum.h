@@ -0,0 +1,285 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_PREFIX_SUM_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_PREFIX_SUM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/move_r.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/split.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+/*  The prefix sum is computed in log2(L) steps, where L is the number of
+    elements within a 128-bit lane: at step k each element is added to the
+    element 2^k positions to the right. move#_r moves within each 128-bit lane
+    separately, thus wider native vectors need an additional step that adds
+    the total of the lower half to each element of the upper half.
+
+    The moves are done on unsigned integer vectors so that the floating-point
+    variants can reuse the same code.
+*/
+template<class V> SIMDPP_INL
+V v_prefix_sum_lane16(V a)
+{
+    a = add(a, move16_r<1>(a));
+    a = add(a, move16_r<2>(a));
+    a = add(a, move16_r<4>(a));
+    a = add(a, move16_r<8>(a));
+    return a;
+}
+
+template<class V> SIMDPP_INL
+V v_prefix_sum_lane8(V a)
+{
+    a = add(a, move8_r<1>(a));
+    a = add(a, move8_r<2>(a));
+    a = add(a, move8_r<4>(a));
+    return a;
+}
+
+template<class V, class U> SIMDPP_INL
+V v_prefix_sum_lane4(V a)
+{
+    a = add(a, V(move4_r<1>(U(a))));
+    a = add(a, V(move4_r<2>(U(a))));
+    return a;
+}
+
+template<class V, class U> SIMDPP_INL
+V v_prefix_sum_lane2(V a)
+{
+    return add(a, V(move2_r<1>(U(a))));
+}
+
+// Adds the last element of the lower half to all elements of the higher half
+template<class V, class H> SIMDPP_INL
+V v_prefix_sum_carry_halves(const V& a)
+{
+    H lo, hi;
+    split(a, lo, hi);
+    hi = add(hi, splat<H::length-1>(lo));
+    return combine(lo, hi);
+}
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL uint8x16 i_prefix_sum(const uint8x16& a)
+{
+    return v_prefix_sum_lane16(a);
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint8x32 i_prefix_sum(const uint8x32& a)
+{
+    uint8x32 r = v_prefix_sum_lane16(a);
+    return v_prefix_sum_carry_halves<uint8x32, uint8x16>(r);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL uint16x8 i_prefix_sum(const uint16x8& a)
+{
+    return v_prefix_sum_lane8(a);
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint16x16 i_prefix_sum(const uint16x16& a)
+{
+    uint16x16 r = v_prefix_sum_lane8(a);
+    return v_prefix_sum_carry_halves<uint16x16, uint16x8>(r);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL uint32x4 i_prefix_sum(const uint32x4& a)
+{
+    return v_prefix_sum_lane4<uint32x4, uint32x4>(a);
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint32x8 i_prefix_sum(const uint32x8& a)
+{
+    uint32x8 r = v_prefix_sum_lane4<uint32x8, uint32x8>(a);
+    return v_prefix_sum_carry_halves<uint32x8, uint32x4>(r);
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL uint32<16> i_prefix_sum(const uint32<16>& a)
+{
+    uint32<8> lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<7>(lo));
+    return combine(lo, hi);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL uint64x2 i_prefix_sum(const uint64x2& a)
+{
+    return v_prefix_sum_lane2<uint64x2, uint64x2>(a);
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL uint64x4 i_prefix_sum(const uint64x4& a)
+{
+    uint64x4 r = v_prefix_sum_lane2<uint64x4, uint64x4>(a);
+    return v_prefix_sum_carry_halves<uint64x4, uint64x2>(r);
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL uint64<8> i_prefix_sum(const uint64<8>& a)
+{
+    uint64<4> lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<3>(lo));
+    return combine(lo, hi);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL float32x4 i_prefix_sum(const float32x4& a)
+{
+    return v_prefix_sum_lane4<float32x4, uint32x4>(a);
+}
+
+#if SIMDPP_USE_AVX
+SIMDPP_INL float32x8 i_prefix_sum(const float32x8& a)
+{
+#if SIMDPP_USE_AVX2
+    float32x8 r = v_prefix_sum_lane4<float32x8, uint32x8>(a);
+    return v_prefix_sum_carry_halves<float32x8, float32x4>(r);
+#else
+    // there are no 256-bit integer moves on AVX
+    float32x4 lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<3>(lo));
+    return combine(lo, hi);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL float32<16> i_prefix_sum(const float32<16>& a)
+{
+    float32<8> lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<7>(lo));
+    return combine(lo, hi);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL float64x2 i_prefix_sum(const float64x2& a)
+{
+#if SIMDPP_USE_NULL || SIMDPP_USE_NEON32 || SIMDPP_USE_ALTIVEC
+    float64x2 r = a;
+    r.el(1) = r.el(0) + r.el(1);
+    return r;
+#else
+    return v_prefix_sum_lane2<float64x2, uint64x2>(a);
+#endif
+}
+
+#if SIMDPP_USE_AVX
+SIMDPP_INL float64x4 i_prefix_sum(const float64x4& a)
+{
+#if SIMDPP_USE_AVX2
+    float64x4 r = v_prefix_sum_lane2<float64x4, uint64x4>(a);
+    return v_prefix_sum_carry_halves<float64x4, float64x2>(r);
+#else
+    float64x2 lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<1>(lo));
+    return combine(lo, hi);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512
+SIMDPP_INL float64<8> i_prefix_sum(const float64<8>& a)
+{
+    float64<4> lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum(lo);
+    hi = i_prefix_sum(hi);
+    hi = add(hi, splat<3>(lo));
+    return combine(lo, hi);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+// Vectors consisting of several native vectors: the total of each native
+// vector is carried over to the next one
+template<class V> SIMDPP_INL
+V v_prefix_sum(const V& a)
+{
+    using B = typename V::base_vector_type;
+    V r;
+    B carry = B::zero();
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B x = i_prefix_sum(a.vec(i));
+        x = add(x, carry);
+        r.vec(i) = x;
+        carry = splat<B::length-1>(x);
+    }
+    return r;
+}
+
+template<unsigned N> SIMDPP_INL
+uint8<N> i_prefix_sum(const uint8<N>& a) { return v_prefix_sum(a); }
+template<unsigned N> SIMDPP_INL
+uint16<N> i_prefix_sum(const uint16<N>& a) { return v_prefix_sum(a); }
+template<unsigned N> SIMDPP_INL
+uint32<N> i_prefix_sum(const uint32<N>& a) { return v_prefix_sum(a); }
+template<unsigned N> SIMDPP_INL
+uint64<N> i_prefix_sum(const uint64<N>& a) { return v_prefix_sum(a); }
+template<unsigned N> SIMDPP_INL
+float32<N> i_prefix_sum(const float32<N>& a) { return v_prefix_sum(a); }
+template<unsigned N> SIMDPP_INL
+float64<N> i_prefix_sum(const float64<N>& a) { return v_prefix_sum(a); }
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
+
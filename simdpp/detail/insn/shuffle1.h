@@ -66,7 +66,8 @@ float64x4 i_shuffle1(const float64x4& a, const float64x4& b)
 template<unsigned s0, unsigned s1> SIMDPP_INL
 float64<8> i_shuffle1(const float64<8>& a, const float64<8>& b)
 {
-    return _mm512_shuffle_pd(a, b, s0 | s1<<1 | s0<<2 | s1<<3);
+    return _mm512_shuffle_pd(a, b, s0 | s1<<1 | s0<<2 | s1<<3 |
+                                   s0<<4 | s1<<5 | s0<<6 | s1<<7);
 }
 #endif
 
@@ -13,6 +13,7 @@
 #endif
 
 #include <simdpp/types.h>
+#include <simdpp/core/move_l.h>
 #include <simdpp/core/splat_n.h>
 #include <simdpp/sse/extract_half.h>
 #include <simdpp/detail/insn/shuffle128.h>
@@ -24,8 +25,8 @@ namespace SIMDPP_ARCH_NAMESPACE {
 namespace detail {
 namespace insn {
 
-// template<unsigned s, class V> SIMDPP_INL
-// V v_splat(V a);
+template<unsigned s, class V> SIMDPP_INL
+V v_splat(const V& a);
 
 // -----------------------------------------------------------------------------
 
@@ -182,7 +183,7 @@ float32<16> i_splat(const float32<16>& ca)
     static_assert(s < 16, "Access out of bounds");
     float32<16> a = ca;
     a = permute4<s%4,s%4,s%4,s%4>(a);
-    a = _mm512_shuffle_f32x4(a, a, s/4);
+    a = _mm512_shuffle_f32x4(a, a, ((s/4) << 6) + ((s/4) << 4) + ((s/4) << 2) + (s/4));
     return a;
 }
 #endif
@@ -13,6 +13,7 @@
 #endif
 
 #include <simdpp/types.h>
+#include <simdpp/core/move_l.h>
 #include <simdpp/core/bit_or.h>
 #include <simdpp/core/permute2.h>
 #include <simdpp/core/permute4.h>
@@ -0,0 +1,385 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_PACKED_U_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_PACKED_U_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/align.h>
+#include <simdpp/detail/insn/mem_pack.h>
+#include <simdpp/detail/insn/store_u.h>
+#include <simdpp/detail/insn/stream.h>
+#include <simdpp/detail/null/memory.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+/*  Both the unaligned and the non-temporal variants interleave each native
+    vector in registers in the same way as store_packed and differ only in
+    the instruction used to write the result.
+*/
+
+template<bool Stream> struct store_packed_op;
+
+template<> struct store_packed_op<false> {
+    template<class V> static SIMDPP_INL
+    void run(char* p, const V& a) { i_store_u(p, a); }
+};
+
+template<> struct store_packed_op<true> {
+    template<class V> static SIMDPP_INL
+    void run(char* p, const V& a) { i_stream(p, a); }
+};
+
+#if SIMDPP_USE_NEON
+/*  The NEON vst2q, vst3q and vst4q instructions need only the alignment of
+    the element, thus they are used directly for the native vectors. NEON has
+    no non-temporal stores. The remaining vectors are interleaved in
+    registers.
+*/
+template<class B> SIMDPP_INL
+void neon_store_packed2(char* p, const B& a, const B& b)
+{
+    const unsigned veclen = sizeof(B);
+    B ta = a, tb = b;
+    mem_pack2(ta, tb);
+    i_store_u(p, ta);
+    i_store_u(p + veclen, tb);
+}
+
+SIMDPP_INL void neon_store_packed2(char* p, const uint8x16& a, const uint8x16& b)
+{
+    uint8x16x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_u8(reinterpret_cast<uint8_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed2(char* p, const uint16x8& a, const uint16x8& b)
+{
+    uint16x8x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_u16(reinterpret_cast<uint16_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed2(char* p, const uint32x4& a, const uint32x4& b)
+{
+    uint32x4x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_u32(reinterpret_cast<uint32_t*>(p), t);
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void neon_store_packed2(char* p, const float32x4& a, const float32x4& b)
+{
+    float32x4x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_f32(reinterpret_cast<float*>(p), t);
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void neon_store_packed2(char* p, const uint64x2& a, const uint64x2& b)
+{
+    uint64x2x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_u64(reinterpret_cast<uint64_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed2(char* p, const float64x2& a, const float64x2& b)
+{
+    float64x2x2_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    vst2q_f64(reinterpret_cast<double*>(p), t);
+}
+#endif
+
+template<class B> SIMDPP_INL
+void neon_store_packed3(char* p, const B& a, const B& b, const B& c)
+{
+    const unsigned veclen = sizeof(B);
+    B ta = a, tb = b, tc = c;
+    mem_pack3(ta, tb, tc);
+    i_store_u(p, ta);
+    i_store_u(p + veclen, tb);
+    i_store_u(p + veclen*2, tc);
+}
+
+SIMDPP_INL void neon_store_packed3(char* p, const uint8x16& a, const uint8x16& b,
+                                   const uint8x16& c)
+{
+    uint8x16x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_u8(reinterpret_cast<uint8_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed3(char* p, const uint16x8& a, const uint16x8& b,
+                                   const uint16x8& c)
+{
+    uint16x8x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_u16(reinterpret_cast<uint16_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed3(char* p, const uint32x4& a, const uint32x4& b,
+                                   const uint32x4& c)
+{
+    uint32x4x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_u32(reinterpret_cast<uint32_t*>(p), t);
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void neon_store_packed3(char* p, const float32x4& a, const float32x4& b,
+                                   const float32x4& c)
+{
+    float32x4x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_f32(reinterpret_cast<float*>(p), t);
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void neon_store_packed3(char* p, const uint64x2& a, const uint64x2& b,
+                                   const uint64x2& c)
+{
+    uint64x2x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_u64(reinterpret_cast<uint64_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed3(char* p, const float64x2& a, const float64x2& b,
+                                   const float64x2& c)
+{
+    float64x2x3_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    vst3q_f64(reinterpret_cast<double*>(p), t);
+}
+#endif
+
+template<class B> SIMDPP_INL
+void neon_store_packed4(char* p, const B& a, const B& b, const B& c, const B& d)
+{
+    const unsigned veclen = sizeof(B);
+    B ta = a, tb = b, tc = c, td = d;
+    mem_pack4(ta, tb, tc, td);
+    i_store_u(p, ta);
+    i_store_u(p + veclen, tb);
+    i_store_u(p + veclen*2, tc);
+    i_store_u(p + veclen*3, td);
+}
+
+SIMDPP_INL void neon_store_packed4(char* p, const uint8x16& a, const uint8x16& b,
+                                   const uint8x16& c, const uint8x16& d)
+{
+    uint8x16x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_u8(reinterpret_cast<uint8_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed4(char* p, const uint16x8& a, const uint16x8& b,
+                                   const uint16x8& c, const uint16x8& d)
+{
+    uint16x8x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_u16(reinterpret_cast<uint16_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed4(char* p, const uint32x4& a, const uint32x4& b,
+                                   const uint32x4& c, const uint32x4& d)
+{
+    uint32x4x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_u32(reinterpret_cast<uint32_t*>(p), t);
+}
+
+#if !SIMDPP_USE_NEON_NO_FLT_SP
+SIMDPP_INL void neon_store_packed4(char* p, const float32x4& a, const float32x4& b,
+                                   const float32x4& c, const float32x4& d)
+{
+    float32x4x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_f32(reinterpret_cast<float*>(p), t);
+}
+#endif
+
+#if SIMDPP_USE_NEON64
+SIMDPP_INL void neon_store_packed4(char* p, const uint64x2& a, const uint64x2& b,
+                                   const uint64x2& c, const uint64x2& d)
+{
+    uint64x2x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_u64(reinterpret_cast<uint64_t*>(p), t);
+}
+
+SIMDPP_INL void neon_store_packed4(char* p, const float64x2& a, const float64x2& b,
+                                   const float64x2& c, const float64x2& d)
+{
+    float64x2x4_t t;
+    t.val[0] = a;
+    t.val[1] = b;
+    t.val[2] = c;
+    t.val[3] = d;
+    vst4q_f64(reinterpret_cast<double*>(p), t);
+}
+#endif
+#endif
+
+template<bool Stream, class V> SIMDPP_INL
+void v_store_packed2_any(char* p, const V& ca, const V& cb)
+{
+    using B = typename V::base_vector_type;
+    const unsigned veclen = sizeof(B);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B a = ca.vec(i), b = cb.vec(i);
+#if SIMDPP_USE_NULL
+        detail::null::store_packed2(p, a, b);
+#elif SIMDPP_USE_NEON
+        neon_store_packed2(p, a, b);
+#else
+        mem_pack2(a, b);
+        store_packed_op<Stream>::run(p, a);
+        store_packed_op<Stream>::run(p + veclen, b);
+#endif
+        p += veclen*2;
+    }
+}
+
+template<bool Stream, class V> SIMDPP_INL
+void v_store_packed3_any(char* p, const V& ca, const V& cb, const V& cc)
+{
+    using B = typename V::base_vector_type;
+    const unsigned veclen = sizeof(B);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B a = ca.vec(i), b = cb.vec(i), c = cc.vec(i);
+#if SIMDPP_USE_NULL
+        detail::null::store_packed3(p, a, b, c);
+#elif SIMDPP_USE_NEON
+        neon_store_packed3(p, a, b, c);
+#else
+        mem_pack3(a, b, c);
+        store_packed_op<Stream>::run(p, a);
+        store_packed_op<Stream>::run(p + veclen, b);
+        store_packed_op<Stream>::run(p + veclen*2, c);
+#endif
+        p += veclen*3;
+    }
+}
+
+template<bool Stream, class V> SIMDPP_INL
+void v_store_packed4_any(char* p, const V& ca, const V& cb, const V& cc,
+                         const V& cd)
+{
+    using B = typename V::base_vector_type;
+    const unsigned veclen = sizeof(B);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        B a = ca.vec(i), b = cb.vec(i), c = cc.vec(i), d = cd.vec(i);
+#if SIMDPP_USE_NULL
+        detail::null::store_packed4(p, a, b, c, d);
+#elif SIMDPP_USE_NEON
+        neon_store_packed4(p, a, b, c, d);
+#else
+        mem_pack4(a, b, c, d);
+        store_packed_op<Stream>::run(p, a);
+        store_packed_op<Stream>::run(p + veclen, b);
+        store_packed_op<Stream>::run(p + veclen*2, c);
+        store_packed_op<Stream>::run(p + veclen*3, d);
+#endif
+        p += veclen*4;
+    }
+}
+
+template<class V> SIMDPP_INL
+void i_store_packed2_u(char* p, const V& a, const V& b)
+{
+    v_store_packed2_any<false>(p, a, b);
+}
+
+template<class V> SIMDPP_INL
+void i_store_packed3_u(char* p, const V& a, const V& b, const V& c)
+{
+    v_store_packed3_any<false>(p, a, b, c);
+}
+
+template<class V> SIMDPP_INL
+void i_store_packed4_u(char* p, const V& a, const V& b, const V& c, const V& d)
+{
+    v_store_packed4_any<false>(p, a, b, c, d);
+}
+
+template<class V> SIMDPP_INL
+void i_stream_packed2(char* p, const V& a, const V& b)
+{
+    p = detail::assume_aligned(p, sizeof(typename V::base_vector_type));
+    v_store_packed2_any<true>(p, a, b);
+}
+
+template<class V> SIMDPP_INL
+void i_stream_packed3(char* p, const V& a, const V& b, const V& c)
+{
+    p = detail::assume_aligned(p, sizeof(typename V::base_vector_type));
+    v_store_packed3_any<true>(p, a, b, c);
+}
+
+template<class V> SIMDPP_INL
+void i_stream_packed4(char* p, const V& a, const V& b, const V& c, const V& d)
+{
+    p = detail::assume_aligned(p, sizeof(typename V::base_vector_type));
+    v_store_packed4_any<true>(p, a, b, c, d);
+}
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
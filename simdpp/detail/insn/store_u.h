@@ -0,0 +1,184 @@
+/*  Copyright (C) 2011-2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_U_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_U_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/mem_block.h>
+#include <simdpp/detail/null/memory.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+namespace insn {
+
+// collect some boilerplate here
+template<class V> SIMDPP_INL
+void v_store_u(char* p, const V& a);
+
+// -----------------------------------------------------------------------------
+
+SIMDPP_INL void i_store_u(char* p, const uint8x16& a)
+{
+#if SIMDPP_USE_NULL
+    detail::null::store(p, a);
+#elif SIMDPP_USE_SSE2
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);
+#elif SIMDPP_USE_NEON
+    vst1q_u8(reinterpret_cast<uint8_t*>(p), a);
+#elif SIMDPP_USE_ALTIVEC
+    // ALTIVEC does not have unaligned stores. Going through memory is faster
+    // than the lvsr/perm/select sequence that would touch two aligned blocks
+    detail::mem_block<uint8x16> b(a);
+    for (unsigned i = 0; i < 16; i++) {
+        p[i] = b[i];
+    }
+#endif
+}
+
+SIMDPP_INL void i_store_u(char* p, const uint16x8& a)
+{
+#if SIMDPP_USE_NEON
+    vst1q_u16(reinterpret_cast<uint16_t*>(p), a);
+#else
+    i_store_u(p, uint8x16(a));
+#endif
+}
+
+SIMDPP_INL void i_store_u(char* p, const uint32x4& a)
+{
+#if SIMDPP_USE_NEON
+    vst1q_u32(reinterpret_cast<uint32_t*>(p), a);
+#else
+    i_store_u(p, uint8x16(a));
+#endif
+}
+
+SIMDPP_INL void i_store_u(char* p, const uint64x2& a)
+{
+#if SIMDPP_USE_NEON
+    vst1q_u64(reinterpret_cast<uint64_t*>(p), a);
+#else
+    i_store_u(p, uint8x16(a));
+#endif
+}
+
+SIMDPP_INL void i_store_u(char* p, const float32x4& a)
+{
+    float* q = reinterpret_cast<float*>(p);
+#if SIMDPP_USE_NULL || SIMDPP_USE_NEON_NO_FLT_SP
+    detail::null::store(q, a);
+#elif SIMDPP_USE_SSE2
+    _mm_storeu_ps(q, a);
+#elif SIMDPP_USE_NEON
+    vst1q_f32(q, a);
+#elif SIMDPP_USE_ALTIVEC
+    i_store_u(p, uint8x16(a));
+#endif
+}
+
+SIMDPP_INL void i_store_u(char* p, const float64x2& a)
+{
+    double* q = reinterpret_cast<double*>(p);
+#if SIMDPP_USE_NULL || SIMDPP_USE_NEON32 || SIMDPP_USE_ALTIVEC
+    detail::null::store(q, a);
+#elif SIMDPP_USE_SSE2
+    _mm_storeu_pd(q, a);
+#elif SIMDPP_USE_NEON64
+    vst1q_f64(q, a);
+#endif
+}
+
+#if SIMDPP_USE_AVX2
+SIMDPP_INL void i_store_u(char* p, const uint8x32& a)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+}
+SIMDPP_INL void i_store_u(char* p, const uint16x16& a)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+}
+SIMDPP_INL void i_store_u(char* p, const uint32x8& a)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+}
+SIMDPP_INL void i_store_u(char* p, const uint64x4& a)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+}
+#endif
+#if SIMDPP_USE_AVX
+SIMDPP_INL void i_store_u(char* p, const float32x8& a)
+{
+    _mm256_storeu_ps(reinterpret_cast<float*>(p), a);
+}
+SIMDPP_INL void i_store_u(char* p, const float64x4& a)
+{
+    _mm256_storeu_pd(reinterpret_cast<double*>(p), a);
+}
+#endif
+#if SIMDPP_USE_AVX512
+SIMDPP_INL void i_store_u(char* p, const uint32<16>& a)
+{
+    _mm512_storeu_si512(p, a);
+}
+SIMDPP_INL void i_store_u(char* p, const uint64<8>& a)
+{
+    _mm512_storeu_si512(p, a);
+}
+SIMDPP_INL void i_store_u(char* p, const float32<16>& a)
+{
+    _mm512_storeu_ps(p, a);
+}
+SIMDPP_INL void i_store_u(char* p, const float64<8>& a)
+{
+    _mm512_storeu_pd(p, a);
+}
+#endif
+
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const uint8<N>& a) { v_store_u(p, a); }
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const uint16<N>& a) { v_store_u(p, a); }
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const uint32<N>& a) { v_store_u(p, a); }
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const uint64<N>& a) { v_store_u(p, a); }
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const float32<N>& a){ v_store_u(p, a); }
+template<unsigned N> SIMDPP_INL
+void i_store_u(char* p, const float64<N>& a){ v_store_u(p, a); }
+
+// -----------------------------------------------------------------------------
+
+template<class V> SIMDPP_INL
+void v_store_u(char* p, const V& a)
+{
+    unsigned veclen = sizeof(typename V::base_vector_type);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        i_store_u(p, a.vec(i));
+        p += veclen;
+    }
+}
+
+} // namespace insn
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
+
@@ -20,6 +20,7 @@
 #include <simdpp/core/zip_hi.h>
 #include <simdpp/core/zip_lo.h>
 #include <simdpp/detail/null/foreach.h>
+#include <simdpp/core/detail/vec_extract.h>
 #include <simdpp/core/detail/vec_insert.h>
 
 namespace simdpp {
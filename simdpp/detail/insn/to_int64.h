@@ -39,7 +39,7 @@ SIMDPP_INL int64x4 i_to_int64(const int32x4& a)
 #elif SIMDPP_USE_SSE4_1
     uint64x2 r1, r2;
     r1 = _mm_cvtepi32_epi64(a);
-    r2 = _mm_cvtepi32_epi64(move4_r<2>(a).eval());
+    r2 = _mm_cvtepi32_epi64(move4_l<2>(a).eval());
     return combine(r1, r2);
 #elif SIMDPP_USE_SSE2 || SIMDPP_USE_ALTIVEC
     int32x4 u;
@@ -103,7 +103,7 @@ SIMDPP_INL uint64x4 i_to_uint64(const uint32x4& a)
 #elif SIMDPP_USE_SSE4_1
     uint64x2 r1, r2;
     r1 = _mm_cvtepu32_epi64(a);
-    r2 = _mm_cvtepu32_epi64(move4_r<2>(a).eval());
+    r2 = _mm_cvtepu32_epi64(move4_l<2>(a).eval());
     return combine(r1, r2);
 #elif SIMDPP_USE_SSE2 || SIMDPP_USE_ALTIVEC
     return (uint64x4) combine(zip4_lo(a, uint32x4::zero()),
@@ -0,0 +1,66 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_MADD_H
+#define LIBSIMDPP_SIMDPP_DETAIL_MADD_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/f_fmadd.h>
+#include <simdpp/core/f_mul.h>
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+/*  Computes a*b + c. fmadd is used where it is supported, elsewhere the
+    multiplication and the addition are separate, thus the rounding of the
+    result depends on the architecture.
+*/
+#if SIMDPP_USE_NULL || SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4 || SIMDPP_USE_NEON64
+#define SIMDPP_DETAIL_MADD_USE_FMADD 1
+#else
+#define SIMDPP_DETAIL_MADD_USE_FMADD 0
+#endif
+
+template<unsigned N, class E1, class E2, class E3> SIMDPP_INL
+float32<N> madd(const float32<N,E1>& a, const float32<N,E2>& b,
+                const float32<N,E3>& c)
+{
+#if SIMDPP_DETAIL_MADD_USE_FMADD
+    return fmadd(a, b, c);
+#else
+    return add(mul(a, b), c);
+#endif
+}
+
+template<unsigned N, class E1, class E2, class E3> SIMDPP_INL
+float64<N> madd(const float64<N,E1>& a, const float64<N,E2>& b,
+                const float64<N,E3>& c)
+{
+#if SIMDPP_DETAIL_MADD_USE_FMADD
+    return fmadd(a, b, c);
+#else
+    return add(mul(a, b), c);
+#endif
+}
+
+#undef SIMDPP_DETAIL_MADD_USE_FMADD
+
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,186 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_MASK_BITS_H
+#define LIBSIMDPP_SIMDPP_DETAIL_MASK_BITS_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <cstdint>
+#include <simdpp/types.h>
+#include <simdpp/core/extract.h>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace simdpp {
+#ifndef SIMDPP_DOXYGEN
+namespace SIMDPP_ARCH_NAMESPACE {
+#endif
+namespace detail {
+
+/*  Scalar bit manipulation helpers used by the algorithms that convert vector
+    masks to bit masks.
+*/
+
+// Returns the index of the least significant set bit. x must not be zero.
+SIMDPP_INL unsigned ctz64(uint64_t x)
+{
+#if __GNUC__
+    return __builtin_ctzll(x);
+#elif _MSC_VER && (_M_X64 || _M_ARM64)
+    unsigned long r;
+    _BitScanForward64(&r, x);
+    return r;
+#else
+    unsigned r = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        r++;
+    }
+    return r;
+#endif
+}
+
+// Returns the index of the most significant set bit. x must not be zero.
+SIMDPP_INL unsigned msb64(uint64_t x)
+{
+#if __GNUC__
+    return 63 - __builtin_clzll(x);
+#elif _MSC_VER && (_M_X64 || _M_ARM64)
+    unsigned long r;
+    _BitScanReverse64(&r, x);
+    return r;
+#else
+    unsigned r = 0;
+    while (x >>= 1) {
+        r++;
+    }
+    return r;
+#endif
+}
+
+SIMDPP_INL unsigned popcount64(uint64_t x)
+{
+#if __GNUC__
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555);
+    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    return unsigned((x * 0x0101010101010101) >> 56);
+#endif
+}
+
+/*  Converts a bit mask with S identical bits per element into a bit mask with
+    a single bit per element.
+*/
+template<unsigned S> struct compress_bits;
+
+template<> struct compress_bits<1> {
+    static SIMDPP_INL uint64_t run(uint64_t x) { return x; }
+};
+
+template<> struct compress_bits<2> {
+    static SIMDPP_INL uint64_t run(uint64_t x)
+    {
+        x &= 0x5555555555555555;
+        x = (x | x >> 1) & 0x3333333333333333;
+        x = (x | x >> 2) & 0x0f0f0f0f0f0f0f0f;
+        x = (x | x >> 4) & 0x00ff00ff00ff00ff;
+        x = (x | x >> 8) & 0x0000ffff0000ffff;
+        x = (x | x >> 16) & 0x00000000ffffffff;
+        return x;
+    }
+};
+
+template<> struct compress_bits<4> {
+    static SIMDPP_INL uint64_t run(uint64_t x)
+    {
+        x &= 0x1111111111111111;
+        x = (x | x >> 3) & 0x0303030303030303;
+        x = (x | x >> 6) & 0x000f000f000f000f;
+        x = (x | x >> 12) & 0x000000ff000000ff;
+        x = (x | x >> 24) & 0x000000000000ffff;
+        return x;
+    }
+};
+
+template<> struct compress_bits<8> {
+    static SIMDPP_INL uint64_t run(uint64_t x)
+    {
+        x &= 0x0101010101010101;
+        x = (x | x >> 7) & 0x0003000300030003;
+        x = (x | x >> 14) & 0x0000000f0000000f;
+        x = (x | x >> 28) & 0x00000000000000ff;
+        return x;
+    }
+};
+
+/*  Returns a bit mask with one bit for each byte of a byte mask. Each byte of
+    the mask must be either 0x00 or 0xff. The vector must be at most 64 bytes
+    long.
+*/
+template<unsigned N> SIMDPP_INL
+uint64_t byte_mask_bits(const uint8<N>& a)
+{
+    static_assert(N <= 64, "Vector too long");
+    using B = typename uint8<N>::base_vector_type;
+    uint64_t r = 0;
+    for (unsigned i = 0; i < uint8<N>::vec_length; ++i) {
+        r |= uint64_t(extract_bits_any(a.vec(i))) << (i * B::length);
+    }
+    return r;
+}
+
+/*  Returns a bit mask in which each byte of a byte mask is represented by
+    1 << byte_mask_sparse_shift bits, only the most significant of which may
+    be set. Each byte of the mask must be either 0x00 or 0xff.
+
+    This is intended for code that only iterates over the set bits. NEON has
+    no movemask instruction and the emulation in extract_bits_any needs
+    several pairwise additions, whereas narrowing each 16-bit element with a
+    shift by 4 leaves four bits per byte with a single instruction.
+*/
+#if SIMDPP_USE_NEON
+const unsigned byte_mask_sparse_shift = 2;
+
+SIMDPP_INL uint64_t byte_mask_bits_sparse(const uint8x16& a)
+{
+    uint8x8_t r = vshrn_n_u16(vreinterpretq_u16_u8(a), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(r), 0) & 0x8888888888888888;
+}
+#else
+const unsigned byte_mask_sparse_shift = 0;
+
+SIMDPP_INL uint64_t byte_mask_bits_sparse(const uint8x16& a)
+{
+    return extract_bits_any(a);
+}
+#endif
+
+/*  Returns a bit mask with one bit for each element of a mask or a vector
+    whose elements have either all bits set or all bits unset. The least
+    significant bit corresponds to the first element.
+*/
+template<unsigned N, class V> SIMDPP_INL
+uint64_t mask_bits(const any_vec<N,V>& a)
+{
+    uint8<N> b = uint8<N>(a.wrapped().eval());
+    return compress_bits<N / V::length>::run(byte_mask_bits(b));
+}
+
+} // namespace detail
+#ifndef SIMDPP_DOXYGEN
+} // namespace SIMDPP_ARCH_NAMESPACE
+#endif
+} // namespace simdpp
+
+#endif
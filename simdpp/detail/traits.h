@@ -53,6 +53,37 @@ template<unsigned N, class E> struct remove_mask<mask_float64<N,E>> { using type
 
 */
 
+/*  Maps a scalar element type to the widest vector type that is natively
+    supported on the current architecture and has the same element type.
+ */
+template<class T> struct fast_vector;
+
+template<> struct fast_vector<uint8_t>  { using type = uint8v; };
+template<> struct fast_vector<int8_t>   { using type = int8v; };
+template<> struct fast_vector<uint16_t> { using type = uint16v; };
+template<> struct fast_vector<int16_t>  { using type = int16v; };
+template<> struct fast_vector<uint32_t> { using type = uint32v; };
+template<> struct fast_vector<int32_t>  { using type = int32v; };
+template<> struct fast_vector<uint64_t> { using type = uint64v; };
+template<> struct fast_vector<int64_t>  { using type = int64v; };
+template<> struct fast_vector<float>    { using type = float32v; };
+template<> struct fast_vector<double>   { using type = float64v; };
+
+/*  Maps a scalar element type and the number of elements to the corresponding
+    vector type.
+ */
+template<class T, unsigned N> struct vector_of;
+
+template<unsigned N> struct vector_of<uint8_t, N>  { using type = uint8<N>; };
+template<unsigned N> struct vector_of<int8_t, N>   { using type = int8<N>; };
+template<unsigned N> struct vector_of<uint16_t, N> { using type = uint16<N>; };
+template<unsigned N> struct vector_of<int16_t, N>  { using type = int16<N>; };
+template<unsigned N> struct vector_of<uint32_t, N> { using type = uint32<N>; };
+template<unsigned N> struct vector_of<int32_t, N>  { using type = int32<N>; };
+template<unsigned N> struct vector_of<uint64_t, N> { using type = uint64<N>; };
+template<unsigned N> struct vector_of<int64_t, N>  { using type = int64<N>; };
+template<unsigned N> struct vector_of<float, N>    { using type = float32<N>; };
+template<unsigned N> struct vector_of<double, N>   { using type = float64<N>; };
 
 } // namespace detail
 #ifndef SIMDPP_DOXYGEN
@@ -24,6 +24,10 @@ namespace simdpp {
     ORed flag sets is likely identify which instruction set the binary is more
     likely to run faster on.
 
+    X86_SSE4_2 and X86_PCLMUL were added later and use high bits, so that the
+    values of the other flags don't change. detail::arch_priority moves them
+    next to X86_SSE4_1 before the flag sets are compared.
+
     detail::select_version depends on this.
 */
 enum class Arch : std::uint32_t {
@@ -49,6 +53,10 @@ enum class Arch : std::uint32_t {
     X86_XOP = 1 << 9,
     /// Indicates x86 AVX-512F suppotr
     X86_AVX512F = 1 << 10,
+    /// Indicates x86 SSE4.2 support
+    X86_SSE4_2 = 1 << 16,
+    /// Indicates x86 PCLMULQDQ (carry-less multiplication) support
+    X86_PCLMUL = 1 << 17,
 
     /// Indicates ARM NEON support (SP and DP floating-point math is executed
     /// on VFP)
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <algorithm>
+#include <cstdint>
 #include <mutex>
 #include <functional>
 #include <vector>
@@ -75,6 +76,24 @@ struct FnVersion {
     VoidFunPtr fun_ptr;
 };
 
+/*  Returns a value that orders the flag sets in the same way as the values of
+    Arch would if X86_SSE4_2 and X86_PCLMUL directly followed X86_SSE4_1.
+*/
+inline std::uint64_t arch_priority(Arch arch)
+{
+    using T = std::uint64_t;
+    T a = static_cast<std::uint32_t>(arch);
+    T sse4_2 = static_cast<std::uint32_t>(Arch::X86_SSE4_2);
+    T pclmul = static_cast<std::uint32_t>(Arch::X86_PCLMUL);
+    T low = (static_cast<std::uint32_t>(Arch::X86_SSE4_1) << 1) - 1;
+
+    T r = (a & ~(sse4_2 | pclmul | low)) << 2;
+    r |= a & low;
+    r |= (a & sse4_2) ? (low + 1) : 0;
+    r |= (a & pclmul) ? (low + 1) << 1 : 0;
+    return r;
+}
+
 inline unsigned select_version_any(std::vector<FnVersion>& versions,
                                    const GetArchCb& get_info_cb)
 {
@@ -82,7 +101,8 @@ inline unsigned select_version_any(std::vector<FnVersion>& versions,
     Arch arch = get_info_cb();
     std::sort(versions.begin(), versions.end(),
               [](const FnVersion& lhs, const FnVersion& rhs) {
-                  return lhs.needed_arch > rhs.needed_arch;
+                  return arch_priority(lhs.needed_arch) >
+                         arch_priority(rhs.needed_arch);
               });
 
     unsigned i;
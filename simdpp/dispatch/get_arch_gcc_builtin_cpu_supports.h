@@ -17,14 +17,15 @@ namespace simdpp {
 */
 inline Arch get_arch_gcc_builtin_cpu_supports()
 {
-    Arch arch_info;
-#if (__GNUC__ >= 4) && (__GNUC_MINOR__ >= 8)
+    Arch arch_info = Arch::NONE_NULL;
+#if (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8))
 #if __i386__ || __amd64__
     if (__builtin_cpu_supports("avx2")) {
         arch_info |= Arch::X86_SSE2;
         arch_info |= Arch::X86_SSE3;
         arch_info |= Arch::X86_SSSE3;
         arch_info |= Arch::X86_SSE4_1;
+        arch_info |= Arch::X86_SSE4_2;
         arch_info |= Arch::X86_AVX;
         arch_info |= Arch::X86_AVX2;
     } else if (__builtin_cpu_supports("avx")) {
@@ -32,7 +33,14 @@ inline Arch get_arch_gcc_builtin_cpu_supports()
         arch_info |= Arch::X86_SSE3;
         arch_info |= Arch::X86_SSSE3;
         arch_info |= Arch::X86_SSE4_1;
+        arch_info |= Arch::X86_SSE4_2;
         arch_info |= Arch::X86_AVX;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        arch_info |= Arch::X86_SSE2;
+        arch_info |= Arch::X86_SSE3;
+        arch_info |= Arch::X86_SSSE3;
+        arch_info |= Arch::X86_SSE4_1;
+        arch_info |= Arch::X86_SSE4_2;
     } else if (__builtin_cpu_supports("sse4.1")) {
         arch_info |= Arch::X86_SSE2;
         arch_info |= Arch::X86_SSE3;
@@ -48,6 +56,17 @@ inline Arch get_arch_gcc_builtin_cpu_supports()
     } else if (__builtin_cpu_supports("sse2")) {
         arch_info |= Arch::X86_SSE2;
     }
+    if (__builtin_cpu_supports("pclmul")) {
+        arch_info |= Arch::X86_PCLMUL;
+    }
+#if __GNUC__ >= 5
+    if (__builtin_cpu_supports("fma")) {
+        arch_info |= Arch::X86_FMA3;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        arch_info |= Arch::X86_AVX512F;
+    }
+#endif
 #endif
 #endif
     return arch_info;
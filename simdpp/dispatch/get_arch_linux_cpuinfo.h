@@ -40,8 +40,11 @@ inline Arch get_arch_linux_cpuinfo()
     Arch a_sse3 = a_sse2 | Arch::X86_SSE3;
     Arch a_ssse3 = a_sse3 | Arch::X86_SSSE3;
     Arch a_sse4_1 = a_ssse3 | Arch::X86_SSE4_1;
-    Arch a_avx = a_sse4_1 | Arch::X86_AVX;
+    Arch a_sse4_2 = a_sse4_1 | Arch::X86_SSE4_2;
+    Arch a_pclmul = a_sse2 | Arch::X86_PCLMUL;
+    Arch a_avx = a_sse4_2 | Arch::X86_AVX;
     Arch a_avx2 = a_avx | Arch::X86_AVX2;
+    Arch a_avx512f = a_avx2 | Arch::X86_AVX512F;
     Arch a_fma3 = a_sse3 | Arch::X86_FMA3;
     Arch a_fma4 = a_sse3 | Arch::X86_FMA4;
     Arch a_xop = a_sse3 | Arch::X86_XOP;
@@ -51,8 +54,11 @@ inline Arch get_arch_linux_cpuinfo()
     features["pni"] = a_sse3;
     features["ssse3"] = a_ssse3;
     features["sse4_1"] = a_sse4_1;
+    features["sse4_2"] = a_sse4_2;
+    features["pclmulqdq"] = a_pclmul;
     features["avx"] = a_avx;
     features["avx2"] = a_avx2;
+    features["avx512f"] = a_avx512f;
     features["fma"] = a_fma3;
     features["fma4"] = a_fma4;
     features["xop"] = a_xop;
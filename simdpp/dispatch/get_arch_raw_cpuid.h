@@ -36,6 +36,25 @@ inline void get_cpuid(unsigned level, unsigned* eax, unsigned* ebx,
 #endif
 }
 
+inline void get_cpuid_count(unsigned level, unsigned subleaf,
+                            unsigned* eax, unsigned* ebx,
+                            unsigned* ecx, unsigned* edx)
+{
+#if __GNUC__ || defined(__clang__)
+    __cpuid_count(level, subleaf, *eax, *ebx, *ecx, *edx);
+#elif _MSC_VER
+    uint32_t regs[4];
+    __cpuidex((int*) regs, level, subleaf);
+    *eax = regs[0];
+    *ebx = regs[1];
+    *ecx = regs[2];
+    *edx = regs[3];
+#else
+    // TODO ICC
+    #error "unsupported compiler"
+#endif
+}
+
 inline uint64_t get_xcr(unsigned level)
 {
 #if (defined (_MSC_FULL_VER) && _MSC_FULL_VER >= 160040000) || (defined (__INTEL_COMPILER) && __INTEL_COMPILER >= 1200) // Microsoft or Intel compiler supporting _xgetbv intrinsic
@@ -61,6 +80,7 @@ inline Arch get_arch_raw_cpuid()
     uint32_t eax, ebx, ecx, edx;
     unsigned max_cpuid_level;
     bool xsave_xrstore_avail = false;
+    bool avx512_state_avail = false;
 
     detail::get_cpuid(0, &eax, &ebx, &ecx, &edx);
     max_cpuid_level = eax;
@@ -76,6 +96,10 @@ inline Arch get_arch_raw_cpuid()
             arch_info |= Arch::X86_SSSE3;
         if (ecx & (1 << 19))
             arch_info |= Arch::X86_SSE4_1;
+        if (ecx & (1 << 20))
+            arch_info |= Arch::X86_SSE4_2;
+        if (ecx & (1 << 1))
+            arch_info |= Arch::X86_PCLMUL;
         if (ecx & (1 << 12))
             arch_info |= Arch::X86_FMA3;
         if (ecx & (1 << 27)) {
@@ -83,6 +107,9 @@ inline Arch get_arch_raw_cpuid()
             uint64_t xcr = detail::get_xcr(0);
             if ((xcr & 6) == 6)
                 xsave_xrstore_avail = true;
+            // opmask and the upper halves of zmm0-15 and zmm16-31
+            if ((xcr & 0xe6) == 0xe6)
+                avx512_state_avail = true;
         }
 
         if (ecx & (1 << 28) && xsave_xrstore_avail)
@@ -97,10 +124,10 @@ inline Arch get_arch_raw_cpuid()
     }
 
     if (max_cpuid_level >= 0x00000007) {
-        detail::get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
-        if (ecx & (1 << 5) && xsave_xrstore_avail)
+        detail::get_cpuid_count(0x00000007, 0, &eax, &ebx, &ecx, &edx);
+        if (ebx & (1 << 5) && xsave_xrstore_avail)
             arch_info |= Arch::X86_AVX2;
-        if (ecx & (1 << 16) && xsave_xrstore_avail)
+        if (ebx & (1 << 16) && xsave_xrstore_avail && avx512_state_avail)
             arch_info |= Arch::X86_AVX512F;
     }
 
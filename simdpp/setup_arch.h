@@ -62,6 +62,39 @@
     #endif
 #endif
 
+#ifdef SIMDPP_ARCH_X86_SSE4_2
+    #ifndef SIMDPP_USE_SSE2
+        #define SIMDPP_USE_SSE2 1
+    #endif
+    #ifndef SIMDPP_USE_SSE3
+        #define SIMDPP_USE_SSE3 1
+    #endif
+    #ifndef SIMDPP_USE_SSSE3
+        #define SIMDPP_USE_SSSE3 1
+    #endif
+    #ifndef SIMDPP_USE_SSE4_1
+        #define SIMDPP_USE_SSE4_1 1
+    #endif
+    #ifndef SIMDPP_USE_SSE4_2
+        #define SIMDPP_USE_SSE4_2 1
+    #endif
+    #ifndef SIMDPP_ARCH_NOT_NULL
+        #define SIMDPP_ARCH_NOT_NULL
+    #endif
+#endif
+
+#ifdef SIMDPP_ARCH_X86_PCLMUL
+    #ifndef SIMDPP_USE_PCLMUL
+        #define SIMDPP_USE_PCLMUL 1
+    #endif
+    #ifndef SIMDPP_USE_SSE2
+        #define SIMDPP_USE_SSE2 1
+    #endif
+    #ifndef SIMDPP_ARCH_NOT_NULL
+        #define SIMDPP_ARCH_NOT_NULL
+    #endif
+#endif
+
 #ifdef SIMDPP_ARCH_X86_AVX
     #ifndef SIMDPP_USE_SSE2
         #define SIMDPP_USE_SSE2 1
@@ -75,6 +108,9 @@
     #ifndef SIMDPP_USE_SSE4_1
         #define SIMDPP_USE_SSE4_1 1
     #endif
+    #ifndef SIMDPP_USE_SSE4_2
+        #define SIMDPP_USE_SSE4_2 1
+    #endif
     #ifndef SIMDPP_USE_AVX
         #define SIMDPP_USE_AVX 1
     #endif
@@ -96,6 +132,9 @@
     #ifndef SIMDPP_USE_SSE4_1
         #define SIMDPP_USE_SSE4_1 1
     #endif
+    #ifndef SIMDPP_USE_SSE4_2
+        #define SIMDPP_USE_SSE4_2 1
+    #endif
     #ifndef SIMDPP_USE_AVX
         #define SIMDPP_USE_AVX 1
     #endif
@@ -165,6 +204,9 @@
     #ifndef SIMDPP_USE_SSE4_1
         #define SIMDPP_USE_SSE4_1 1
     #endif
+    #ifndef SIMDPP_USE_SSE4_2
+        #define SIMDPP_USE_SSE4_2 1
+    #endif
     #ifndef SIMDPP_USE_AVX
         #define SIMDPP_USE_AVX 1
     #endif
@@ -248,6 +290,20 @@
     #define SIMDPP_PP_SSE4_1
 #endif
 
+#ifdef SIMDPP_USE_SSE4_2
+    #define SIMDPP_PP_SSE4_2 _sse4p2
+    #include <nmmintrin.h>
+#else
+    #define SIMDPP_PP_SSE4_2
+#endif
+
+#ifdef SIMDPP_USE_PCLMUL
+    #define SIMDPP_PP_PCLMUL _pclmul
+    #include <wmmintrin.h>
+#else
+    #define SIMDPP_PP_PCLMUL
+#endif
+
 #ifdef SIMDPP_USE_AVX
     #define SIMDPP_PP_AVX _avx
     #include <immintrin.h>
@@ -355,17 +411,19 @@
 #define SIMDPP_PP_ARCH_CONCAT2  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT1, SIMDPP_PP_SSE3)
 #define SIMDPP_PP_ARCH_CONCAT3  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT2, SIMDPP_PP_SSSE3)
 #define SIMDPP_PP_ARCH_CONCAT4  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT3, SIMDPP_PP_SSE4_1)
-#define SIMDPP_PP_ARCH_CONCAT5  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT4, SIMDPP_PP_AVX)
-#define SIMDPP_PP_ARCH_CONCAT6  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT5, SIMDPP_PP_AVX2)
-#define SIMDPP_PP_ARCH_CONCAT7  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT6, SIMDPP_PP_FMA3)
-#define SIMDPP_PP_ARCH_CONCAT8  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT7, SIMDPP_PP_FMA4)
-#define SIMDPP_PP_ARCH_CONCAT9  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT8, SIMDPP_PP_XOP)
-#define SIMDPP_PP_ARCH_CONCAT10 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT9, SIMDPP_PP_AVX512)
-#define SIMDPP_PP_ARCH_CONCAT11 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT10, SIMDPP_PP_NEON)
-#define SIMDPP_PP_ARCH_CONCAT12 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT11, SIMDPP_PP_NEON_FLT_SP)
-#define SIMDPP_PP_ARCH_CONCAT13 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT12, SIMDPP_PP_ALTIVEC)
-
-#define SIMDPP_ARCH_NAMESPACE SIMDPP_PP_ARCH_CONCAT13
+#define SIMDPP_PP_ARCH_CONCAT5  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT4, SIMDPP_PP_SSE4_2)
+#define SIMDPP_PP_ARCH_CONCAT6  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT5, SIMDPP_PP_PCLMUL)
+#define SIMDPP_PP_ARCH_CONCAT7  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT6, SIMDPP_PP_AVX)
+#define SIMDPP_PP_ARCH_CONCAT8  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT7, SIMDPP_PP_AVX2)
+#define SIMDPP_PP_ARCH_CONCAT9  SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT8, SIMDPP_PP_FMA3)
+#define SIMDPP_PP_ARCH_CONCAT10 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT9, SIMDPP_PP_FMA4)
+#define SIMDPP_PP_ARCH_CONCAT11 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT10, SIMDPP_PP_XOP)
+#define SIMDPP_PP_ARCH_CONCAT12 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT11, SIMDPP_PP_AVX512)
+#define SIMDPP_PP_ARCH_CONCAT13 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT12, SIMDPP_PP_NEON)
+#define SIMDPP_PP_ARCH_CONCAT14 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT13, SIMDPP_PP_NEON_FLT_SP)
+#define SIMDPP_PP_ARCH_CONCAT15 SIMDPP_CONCAT(SIMDPP_PP_ARCH_CONCAT14, SIMDPP_PP_ALTIVEC)
+
+#define SIMDPP_ARCH_NAMESPACE SIMDPP_PP_ARCH_CONCAT15
 
 
 
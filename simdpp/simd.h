@@ -19,6 +19,30 @@
 #include <cstdlib>
 
 
+#include <simdpp/algorithm/alpha.h>
+#include <simdpp/algorithm/aos_soa.h>
+#include <simdpp/algorithm/ascii.h>
+#include <simdpp/algorithm/audio.h>
+#include <simdpp/algorithm/base64.h>
+#include <simdpp/algorithm/checksum.h>
+#include <simdpp/algorithm/color.h>
+#include <simdpp/algorithm/complex.h>
+#include <simdpp/algorithm/convolve.h>
+#include <simdpp/algorithm/fft.h>
+#include <simdpp/algorithm/filter.h>
+#include <simdpp/algorithm/find.h>
+#include <simdpp/algorithm/hash.h>
+#include <simdpp/algorithm/hash_table.h>
+#include <simdpp/algorithm/motion.h>
+#include <simdpp/algorithm/nn.h>
+#include <simdpp/algorithm/parse.h>
+#include <simdpp/algorithm/resize.h>
+#include <simdpp/algorithm/scan.h>
+#include <simdpp/algorithm/set_ops.h>
+#include <simdpp/algorithm/sort.h>
+#include <simdpp/algorithm/structural.h>
+#include <simdpp/algorithm/utf8.h>
+#include <simdpp/algorithm/varint.h>
 #include <simdpp/altivec/load1.h>
 #include <simdpp/core/align.h>
 #include <simdpp/core/aligned_allocator.h>
@@ -69,15 +93,20 @@
 #include <simdpp/core/i_mul.h>
 #include <simdpp/core/i_mull.h>
 #include <simdpp/core/i_neg.h>
+#include <simdpp/core/i_sad.h>
 #include <simdpp/core/i_shift_l.h>
 #include <simdpp/core/i_shift_r.h>
 #include <simdpp/core/i_sub.h>
 #include <simdpp/core/i_sub_sat.h>
 #include <simdpp/core/insert.h>
 #include <simdpp/core/load.h>
+#include <simdpp/core/load_packed.h>
 #include <simdpp/core/load_packed2.h>
+#include <simdpp/core/load_packed2_u.h>
 #include <simdpp/core/load_packed3.h>
+#include <simdpp/core/load_packed3_u.h>
 #include <simdpp/core/load_packed4.h>
+#include <simdpp/core/load_packed4_u.h>
 #include <simdpp/core/load_splat.h>
 #include <simdpp/core/load_u.h>
 #include <simdpp/core/make_float.h>
@@ -90,6 +119,7 @@
 #include <simdpp/core/permute4.h>
 #include <simdpp/core/permute_bytes16.h>
 #include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/prefix_sum.h>
 #include <simdpp/core/set_splat.h>
 #include <simdpp/core/shuffle1.h>
 #include <simdpp/core/shuffle2.h>
@@ -100,10 +130,18 @@
 #include <simdpp/core/store_first.h>
 #include <simdpp/core/store.h>
 #include <simdpp/core/store_last.h>
+#include <simdpp/core/store_packed.h>
 #include <simdpp/core/store_packed2.h>
+#include <simdpp/core/store_packed2_u.h>
 #include <simdpp/core/store_packed3.h>
+#include <simdpp/core/store_packed3_u.h>
 #include <simdpp/core/store_packed4.h>
+#include <simdpp/core/store_packed4_u.h>
+#include <simdpp/core/store_u.h>
 #include <simdpp/core/stream.h>
+#include <simdpp/core/stream_packed2.h>
+#include <simdpp/core/stream_packed3.h>
+#include <simdpp/core/stream_packed4.h>
 #include <simdpp/core/to_float32.h>
 #include <simdpp/core/to_float64.h>
 #include <simdpp/core/to_int16.h>
@@ -42,6 +42,12 @@ inline Arch this_compile_arch()
 #if SIMDPP_USE_SSE4_1
     res |= Arch::X86_SSE4_1;
 #endif
+#if SIMDPP_USE_SSE4_2
+    res |= Arch::X86_SSE4_2;
+#endif
+#if SIMDPP_USE_PCLMUL
+    res |= Arch::X86_PCLMUL;
+#endif
 #if SIMDPP_USE_AVX
     res |= Arch::X86_AVX;
 #endif
@@ -57,7 +63,7 @@ inline Arch this_compile_arch()
 #if SIMDPP_USE_XOP
     res |= Arch::X86_XOP;
 #endif
-#if SIMDPP_USE_AVX512F
+#if SIMDPP_USE_AVX512
     res |= Arch::X86_AVX512F;
 #endif
 #if SIMDPP_USE_NEON
@@ -0,0 +1,136 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Exactly rounded x / d for non-negative x and positive d
+unsigned alpha_ref_div(unsigned x, unsigned d)
+{
+    return (2*x + d) / (2*d);
+}
+
+unsigned alpha_ref_min255(unsigned x)
+{
+    return x > 255 ? 255 : x;
+}
+
+/*  Every combination of a color value and alpha, followed by random pixels.
+    The first n pixels are used.
+*/
+std::vector<uint8_t> alpha_pixels(std::size_t n, unsigned seed)
+{
+    std::srand(seed);
+    std::vector<uint8_t> v(4 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i < 65536) {
+            v[4*i] = uint8_t(i);
+            v[4*i + 1] = uint8_t(255 - i);
+            v[4*i + 2] = uint8_t(i * 7);
+            v[4*i + 3] = uint8_t(i >> 8);
+        } else {
+            for (unsigned j = 0; j < 4; ++j) {
+                v[4*i + j] = uint8_t(std::rand());
+            }
+        }
+    }
+    return v;
+}
+
+bool test_alpha_premultiply(std::size_t n, bool in_place)
+{
+    std::vector<uint8_t> src = alpha_pixels(n, unsigned(n));
+    std::vector<uint8_t> dst = src;
+    if (in_place) {
+        simdpp::premultiply_rgba(dst.data(), n, dst.data());
+    } else {
+        simdpp::premultiply_rgba(src.data(), n, dst.data());
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        unsigned a = src[4*i + 3];
+        for (unsigned j = 0; j < 3; ++j) {
+            if (dst[4*i + j] != alpha_ref_div(src[4*i + j] * a, 255)) {
+                return false;
+            }
+        }
+        if (dst[4*i + 3] != a) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_alpha_unpremultiply(std::size_t n, bool in_place)
+{
+    std::vector<uint8_t> src = alpha_pixels(n, unsigned(n + 1));
+    std::vector<uint8_t> dst = src;
+    if (in_place) {
+        simdpp::unpremultiply_rgba(dst.data(), n, dst.data());
+    } else {
+        simdpp::unpremultiply_rgba(src.data(), n, dst.data());
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        unsigned a = src[4*i + 3];
+        for (unsigned j = 0; j < 3; ++j) {
+            unsigned r = a == 0 ? 0 : alpha_ref_min255(alpha_ref_div(src[4*i + j] * 255, a));
+            if (dst[4*i + j] != r) {
+                return false;
+            }
+        }
+        if (dst[4*i + 3] != a) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_alpha_blend(std::size_t n, bool in_place)
+{
+    std::vector<uint8_t> src = alpha_pixels(n, unsigned(n + 2));
+    std::vector<uint8_t> bg(4 * n);
+    std::srand(unsigned(n));
+    for (std::size_t i = 0; i < bg.size(); ++i) {
+        bg[i] = uint8_t(std::rand());
+    }
+    std::vector<uint8_t> dst = bg;
+    if (in_place) {
+        simdpp::blend_over_rgba(src.data(), dst.data(), n, dst.data());
+    } else {
+        simdpp::blend_over_rgba(src.data(), bg.data(), n, dst.data());
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        unsigned ia = 255 - src[4*i + 3];
+        for (unsigned j = 0; j < 4; ++j) {
+            unsigned r = src[4*i + j] + alpha_ref_div(bg[4*i + j] * ia, 255);
+            if (dst[4*i + j] != alpha_ref_min255(r)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void test_alpha(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "alpha");
+
+    const std::size_t sizes[6] = { 0, 1, 7, 33, 65536, 65536 + 77 };
+    for (std::size_t n : sizes) {
+        for (unsigned p = 0; p < 2; ++p) {
+            TEST_CHECK(tc, test_alpha_premultiply(n, p == 1));
+            TEST_CHECK(tc, test_alpha_unpremultiply(n, p == 1));
+            TEST_CHECK(tc, test_alpha_blend(n, p == 1));
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
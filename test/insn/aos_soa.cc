@@ -0,0 +1,138 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Checks load_packed and store_packed (or load_packed_u and store_packed_u if
+// A is false) with K vectors against the scalar definition
+template<unsigned K, class V, bool A>
+bool test_packed_n()
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+    using U = typename simdpp::detail::get_expr_nosign<V>::type;
+    const unsigned L = V::length;
+    const unsigned off = A ? 0 : 1;
+
+    SIMDPP_ALIGN(64) E src[K*L + 1];
+    SIMDPP_ALIGN(64) E out[K*L + 1];
+    SIMDPP_ALIGN(64) E col[L];
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(src);
+    for (unsigned i = 0; i < sizeof(src); ++i) {
+        bytes[i] = uint8_t(i * 13 + 5);
+    }
+
+    const E* s = src + off;
+    V v[K];
+    if (A) {
+        load_packed(v, s);
+    } else {
+        load_packed_u(v, s);
+    }
+    for (unsigned j = 0; j < K; ++j) {
+        store(col, U(v[j]));
+        for (unsigned i = 0; i < L; ++i) {
+            if (std::memcmp(&col[i], &s[i*K + j], sizeof(E)) != 0) {
+                return false;
+            }
+        }
+    }
+
+    std::memset(out, 0, sizeof(out));
+    if (A) {
+        store_packed(out, v);
+    } else {
+        store_packed_u(out + off, v);
+    }
+    return std::memcmp(out + off, s, sizeof(E) * K * L) == 0;
+}
+
+template<unsigned K, class V>
+void test_packed_n_k(TestSuite& tc)
+{
+    TEST_CHECK(tc, (test_packed_n<K, V, true>()));
+    TEST_CHECK(tc, (test_packed_n<K, V, false>()));
+}
+
+template<class V>
+void test_packed_n_all(TestSuite& tc)
+{
+    test_packed_n_k<2, V>(tc);
+    test_packed_n_k<3, V>(tc);
+    test_packed_n_k<4, V>(tc);
+    test_packed_n_k<5, V>(tc);
+    test_packed_n_k<6, V>(tc);
+    test_packed_n_k<7, V>(tc);
+    test_packed_n_k<8, V>(tc);
+}
+
+template<unsigned B>
+void test_packed_n_width(TestSuite& tc)
+{
+    using namespace simdpp;
+    test_packed_n_all<uint8<B>>(tc);
+    test_packed_n_all<int8<B>>(tc);
+    test_packed_n_all<uint16<B/2>>(tc);
+    test_packed_n_all<uint32<B/4>>(tc);
+    test_packed_n_all<uint64<B/8>>(tc);
+    test_packed_n_all<float32<B/4>>(tc);
+    test_packed_n_all<float64<B/8>>(tc);
+}
+
+// Converts to structure of arrays and back and checks both results
+template<class T>
+bool test_aos_soa_roundtrip(unsigned k, std::size_t n)
+{
+    using namespace simdpp;
+    static T aos[10*200], back[10*200];
+    static T soa[10][200];
+    T* cols[10];
+    for (unsigned j = 0; j < 10; ++j) {
+        cols[j] = soa[j];
+    }
+    for (std::size_t i = 0; i < n*k; ++i) {
+        aos[i] = T(i * 7 + 1);
+    }
+
+    aos_to_soa(aos, n, k, cols);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (unsigned j = 0; j < k; ++j) {
+            if (soa[j][i] != aos[i*k + j]) {
+                return false;
+            }
+        }
+    }
+    std::memset(back, 0, sizeof(back));
+    soa_to_aos(cols, n, k, back);
+    return std::memcmp(back, aos, n * k * sizeof(T)) == 0;
+}
+
+void test_aos_soa(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "aos_soa");
+
+    test_packed_n_width<16>(tc);
+    test_packed_n_width<32>(tc);
+    test_packed_n_width<64>(tc);
+
+    for (unsigned k = 1; k <= 10; ++k) {
+        for (std::size_t n = 0; n < 200; n += 37) {
+            TEST_CHECK(tc, test_aos_soa_roundtrip<uint8_t>(k, n));
+            TEST_CHECK(tc, test_aos_soa_roundtrip<int16_t>(k, n));
+            TEST_CHECK(tc, test_aos_soa_roundtrip<float>(k, n));
+            TEST_CHECK(tc, test_aos_soa_roundtrip<double>(k, n));
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,76 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+void test_ascii(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "ascii");
+
+    // the characters around the letter ranges and the whitespace characters
+    const char chars[] = "@AZ[`az{ \t\n\v\f\r\x08\x0e\x80\xc1" "09";
+    const unsigned nchars = sizeof(chars) - 1;
+
+    static char text[300];
+    static char conv[300];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < sizeof(text); i++) {
+        seed = seed * 1103515245 + 12345;
+        text[i] = chars[(seed >> 16) % nchars];
+    }
+
+    // all lengths exercise the scalar, vector and tail paths
+    for (unsigned len = 0; len < 100; len += 7) {
+        ascii_to_lower(text + 1, len, conv);
+        TEST_PUSH(tc, uint32_t, crc32c(conv, len));
+        ascii_to_upper(text + 1, len, conv);
+        TEST_PUSH(tc, uint32_t, crc32c(conv, len));
+        // in place
+        std::memcpy(conv, text + 1, len);
+        ascii_to_lower(conv, len, conv);
+        TEST_PUSH(tc, uint32_t, crc32c(conv, len));
+
+        TEST_PUSH(tc, uint32_t, ascii_trim_left(text + 1, len));
+        TEST_PUSH(tc, uint32_t, ascii_trim_right(text + 1, len));
+    }
+
+    TEST_CHECK(tc, ascii_trim_left(" \t\r\nab ", 7) == 4);
+    TEST_CHECK(tc, ascii_trim_right(" ab \v\f", 6) == 3);
+    const char* spaces = "                                        \t\t\t\t\t\t\t\t";
+    TEST_CHECK(tc, ascii_trim_left(spaces, 48) == 48);
+    TEST_CHECK(tc, ascii_trim_right(spaces, 48) == 0);
+
+    // strlen from each alignment, the terminator at each position
+    static char str[200];
+    std::memset(str, 'x', sizeof(str));
+    for (unsigned off = 0; off < 40; off += 3) {
+        for (unsigned len = 0; len < 150; len += 11) {
+            str[off + len] = 0;
+            TEST_CHECK(tc, ascii_strlen(str + off) == len);
+            str[off + len] = 'x';
+        }
+    }
+
+    const char* a = "Hello, World! The quick brown fox jumps over the lazy dog.";
+    const char* b = "hELLO, wORLD! tHE QUICK BROWN FOX JUMPS OVER THE LAZY DOG.";
+    std::size_t n = std::strlen(a);
+    TEST_CHECK(tc, ascii_casecmp(a, n, b, n) == 0);
+    TEST_CHECK(tc, ascii_casecmp(a, n, b, n - 1) > 0);
+    TEST_CHECK(tc, ascii_casecmp(a, n - 1, b, n) < 0);
+    // '[' and '{' differ only in bit 5, but are not letters
+    TEST_CHECK(tc, ascii_casecmp("abc[", 4, "ABC{", 4) < 0);
+    TEST_CHECK(tc, ascii_casecmp("abc\xe1", 4, "abc\xc1", 4) > 0);
+    TEST_CHECK(tc, ascii_casecmp(text, 300, text, 300) == 0);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,204 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+std::vector<float> audio_random(std::size_t n, unsigned seed)
+{
+    std::srand(seed);
+    std::vector<float> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = float(std::rand()) / RAND_MAX * 2 - 1;
+    }
+    return v;
+}
+
+// Returns the size of the i-th block of a stream split into uneven blocks
+std::size_t audio_block(std::size_t i)
+{
+    const std::size_t sizes[8] = { 1, 0, 31, 1500, 7, 2048, 64, 333 };
+    return sizes[i % 8];
+}
+
+bool test_audio_fir(std::size_t ntaps, bool in_place)
+{
+    const std::size_t n = 6000;
+    std::vector<float> taps = audio_random(ntaps, unsigned(ntaps));
+    std::vector<float> x = audio_random(n, unsigned(ntaps + 1));
+    std::vector<float> y = in_place ? x : std::vector<float>(n);
+
+    simdpp::fir_filter f(taps.data(), ntaps);
+    for (std::size_t i = 0, b = 0; i < n; ++b) {
+        std::size_t m = std::min(audio_block(b), n - i);
+        f.process(in_place ? y.data() + i : x.data() + i, m, y.data() + i);
+        i += m;
+    }
+
+    double sum = 0;
+    for (float t : taps) {
+        sum += std::abs(t);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        double r = 0;
+        for (std::size_t j = 0; j < ntaps && j <= i; ++j) {
+            r += double(taps[j]) * x[i - j];
+        }
+        if (std::abs(r - y[i]) > 1e-5 * sum) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The coefficients of a lowpass section, different for each channel and section
+simdpp::biquad_coefs audio_lowpass(unsigned ch, unsigned s)
+{
+    const double pi = 3.14159265358979323846;
+    double w = 2 * pi * (0.05 + 0.01 * ch + 0.03 * s);
+    double alpha = std::sin(w) / (2 * 0.707);
+    double a0 = 1 + alpha;
+    double c = std::cos(w);
+    simdpp::biquad_coefs r;
+    r.b0 = float((1 - c) / 2 / a0);
+    r.b1 = float((1 - c) / a0);
+    r.b2 = float((1 - c) / 2 / a0);
+    r.a1 = float(-2 * c / a0);
+    r.a2 = float((1 - alpha) / a0);
+    return r;
+}
+
+bool test_audio_biquad(unsigned channels, unsigned sections, bool in_place)
+{
+    const std::size_t frames = 3000;
+    std::vector<float> x = audio_random(frames * channels, channels * 7 + sections);
+    std::vector<float> y = in_place ? x : std::vector<float>(frames * channels);
+
+    simdpp::biquad_cascade f(channels, sections);
+    for (unsigned s = 0; s < sections; ++s) {
+        for (unsigned ch = 0; ch < channels; ++ch) {
+            f.set_section(s, ch, audio_lowpass(ch, s));
+        }
+    }
+    for (std::size_t i = 0, b = 0; i < frames; ++b) {
+        std::size_t m = std::min(audio_block(b), frames - i);
+        const float* in = in_place ? y.data() : x.data();
+        f.process(in + i * channels, m, y.data() + i * channels);
+        i += m;
+    }
+
+    for (unsigned ch = 0; ch < channels; ++ch) {
+        std::vector<double> v(frames);
+        for (std::size_t i = 0; i < frames; ++i) {
+            v[i] = x[i * channels + ch];
+        }
+        for (unsigned s = 0; s < sections; ++s) {
+            simdpp::biquad_coefs c = audio_lowpass(ch, s);
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+            for (std::size_t i = 0; i < frames; ++i) {
+                double r = c.b0 * v[i] + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+                x2 = x1; x1 = v[i];
+                y2 = y1; y1 = r;
+                v[i] = r;
+            }
+        }
+        for (std::size_t i = 0; i < frames; ++i) {
+            if (std::abs(v[i] - y[i * channels + ch]) > 1e-4) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*  Resamples a sine that is well within the passband and compares the
+    output to the sine at the output rate. Also checks that splitting the
+    input into blocks does not change the output.
+*/
+bool test_audio_resampler(unsigned up, unsigned down)
+{
+    const double pi = 3.14159265358979323846;
+    const std::size_t n = 8000;
+    const double freq = 0.04;
+    std::vector<float> x(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = float(std::sin(2 * pi * freq * i));
+    }
+
+    simdpp::resampler whole(up, down);
+    std::vector<float> y(whole.output_size(n));
+    if (whole.process(x.data(), n, y.data()) != y.size()) {
+        return false;
+    }
+
+    simdpp::resampler split(up, down);
+    std::vector<float> z;
+    for (std::size_t i = 0, b = 0; i < n; ++b) {
+        std::size_t m = std::min(audio_block(b), n - i);
+        std::vector<float> t(split.output_size(m));
+        if (split.process(x.data() + i, m, t.data()) != t.size()) {
+            return false;
+        }
+        z.insert(z.end(), t.begin(), t.end());
+        i += m;
+    }
+    if (z != y) {
+        return false;
+    }
+
+    double ratio = double(whole.up()) / whole.down();
+    if (std::abs(double(y.size()) - n * ratio) > 1) {
+        return false;
+    }
+    double d = whole.delay();
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        double t = i / ratio - d;
+        if (t < 2 * d || t > n - 2 * d) {
+            continue;
+        }
+        if (std::abs(std::sin(2 * pi * freq * t) - y[i]) > 2e-3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_audio(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "audio");
+
+    const std::size_t taps[5] = { 1, 3, 17, 64, 129 };
+    for (std::size_t t : taps) {
+        TEST_CHECK(tc, test_audio_fir(t, false));
+        TEST_CHECK(tc, test_audio_fir(t, true));
+    }
+
+    const unsigned channels[7] = { 1, 2, 3, 5, 8, 13, 17 };
+    const unsigned sections[4] = { 0, 1, 3, 6 };
+    for (unsigned c : channels) {
+        for (unsigned s : sections) {
+            TEST_CHECK(tc, test_audio_biquad(c, s, false));
+            TEST_CHECK(tc, test_audio_biquad(c, s, true));
+        }
+    }
+
+    const unsigned ratios[7][2] = {
+        { 1, 1 }, { 160, 147 }, { 147, 160 }, { 2, 1 }, { 1, 2 }, { 3, 1 }, { 4, 12 }
+    };
+    for (const auto& r : ratios) {
+        TEST_CHECK(tc, test_audio_resampler(r[0], r[1]));
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
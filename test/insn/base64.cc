@@ -0,0 +1,103 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Returns whether [p, p+len) holds the given string
+bool test_base64_equal(const char* p, const char* end, const char* str)
+{
+    return std::size_t(end - p) == std::strlen(str) &&
+           std::memcmp(p, str, end - p) == 0;
+}
+
+void test_base64(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "base64");
+    const base64_alphabet url = base64_alphabet::url;
+    const base64_alphabet standard = base64_alphabet::standard;
+
+    // RFC 4648 test vectors
+    const char* plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+    const char* encoded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==",
+                              "Zm9vYmE=", "Zm9vYmFy" };
+    char enc[128];
+    uint8_t dec[128];
+    for (unsigned i = 0; i < 7; i++) {
+        std::size_t len = std::strlen(plain[i]);
+        char* end = base64_encode(plain[i], len, enc);
+        TEST_CHECK(tc, test_base64_equal(enc, end, encoded[i]));
+        TEST_CHECK(tc, std::size_t(end - enc) == base64_encoded_size(len));
+
+        uint8_t* dend = base64_decode(encoded[i], std::strlen(encoded[i]), dec);
+        TEST_CHECK(tc, dend == dec + len && std::memcmp(dec, plain[i], len) == 0);
+    }
+
+    // URL alphabet, no padding
+    const uint8_t special[] = { 0xfb, 0xff, 0xbf };
+    char* end = base64_encode(special, 2, enc, url, false);
+    TEST_CHECK(tc, test_base64_equal(enc, end, "-_8"));
+    end = base64_encode(special, 3, enc, standard);
+    TEST_CHECK(tc, test_base64_equal(enc, end, "+/+/"));
+    TEST_CHECK(tc, base64_decode("-_8", 3, dec, url) == dec + 2);
+    TEST_CHECK(tc, base64_decode("-_8=", 4, dec, url) == dec + 2);
+
+    // malformed input
+    const char* bad[] = { "Zg=", "Z===", "Zh==", "Zm9v\n", "Zm=v", "Zg==Zg==",
+                          "-_8=", "Z" };
+    for (const char* s : bad) {
+        TEST_CHECK(tc, base64_decode(s, std::strlen(s), dec) == nullptr);
+    }
+
+    end = hex_encode(special, 3, enc);
+    TEST_CHECK(tc, test_base64_equal(enc, end, "fbffbf"));
+    end = hex_encode(special, 3, enc, true);
+    TEST_CHECK(tc, test_base64_equal(enc, end, "FBFFBF"));
+    TEST_CHECK(tc, hex_decode("fBfFBf", 6, dec) == dec + 3 && dec[0] == 0xfb);
+    TEST_CHECK(tc, hex_decode("fbf", 3, dec) == nullptr);
+    TEST_CHECK(tc, hex_decode("fg", 2, dec) == nullptr);
+
+    // long buffers exercise the vector blocks and the scalar tails
+    const unsigned size = 1000;
+    static uint8_t data[size];
+    static char long_enc[size*2];
+    static uint8_t long_dec[size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+
+    const unsigned lengths[] = { 47, 48, 49, 95, 96, 97, 200, 1000 };
+    for (unsigned len : lengths) {
+        for (base64_alphabet a : { standard, url }) {
+            char* e = base64_encode(data + 1, len, long_enc, a);
+            TEST_PUSH(tc, uint32_t, crc32c(long_enc, e - long_enc));
+            uint8_t* d = base64_decode(long_enc, e - long_enc, long_dec, a);
+            TEST_CHECK(tc, d == long_dec + len &&
+                           std::memcmp(long_dec, data + 1, len) == 0);
+        }
+
+        char* e = hex_encode(data + 1, len, long_enc);
+        TEST_PUSH(tc, uint32_t, crc32c(long_enc, e - long_enc));
+        uint8_t* d = hex_decode(long_enc, e - long_enc, long_dec);
+        TEST_CHECK(tc, d == long_dec + len &&
+                       std::memcmp(long_dec, data + 1, len) == 0);
+
+        // an invalid character in the middle of the input
+        long_enc[len / 2] = '*';
+        TEST_CHECK(tc, hex_decode(long_enc, e - long_enc, long_dec) == nullptr);
+        TEST_CHECK(tc, base64_decode(long_enc, len / 3 * 4, long_dec) == nullptr);
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,75 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+void test_checksum(TestResults& res)
+{
+    using namespace simdpp;
+    namespace sd = simdpp::SIMDPP_ARCH_NAMESPACE::detail;
+    TestSuite& tc = NEW_TEST_SUITE(res, "checksum");
+
+    // known values
+    TEST_CHECK(tc, crc32c("123456789", 9) == 0xe3069283);
+    TEST_CHECK(tc, adler32("Wikipedia", 9) == 0x11e60398);
+    TEST_CHECK(tc, fletcher32("abcde", 5) == 0xf04fc729);
+    TEST_CHECK(tc, fletcher32("abcdef", 6) == 0x56502d2a);
+    TEST_CHECK(tc, crc32c(nullptr, 0) == 0);
+    TEST_CHECK(tc, adler32(nullptr, 0) == 1);
+
+    const unsigned size = 40000;
+    static uint8_t data[size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+
+    // the 3-way CRC blocks, Adler-32 NMAX blocks and the scalar tails
+    const unsigned lengths[] = { 1, 15, 16, 17, 767, 768, 1000, 5552, 5569,
+                                 12288, 13100, 39999 };
+
+    SIMDPP_ALIGN(16) uint32_t r[36];
+    unsigned k = 0;
+    for (unsigned len : lengths) {
+        r[k] = crc32c(data + 1, len);
+        r[k+1] = adler32(data + 1, len);
+        r[k+2] = fletcher32(data + 1, len);
+        TEST_CHECK(tc, r[k] == ~sd::crc32c_sw(~0u, data + 1, len));
+        TEST_CHECK(tc, r[k+1] == sd::adler32_scalar(1, data + 1, len));
+        TEST_CHECK(tc, r[k+2] == sd::fletcher32_scalar(0, data + 1, len));
+        k += 3;
+    }
+    for (unsigned i = 0; i < 36; i += 4) {
+        uint32x4 v = load(r + i);
+        TEST_PUSH(tc, uint32x4, v);
+    }
+
+    // checksums computed in pieces
+    uint32_t c = crc32c(data, 1000);
+    c = crc32c(data + 1000, size - 1000, c);
+    uint32_t a = adler32(data, 1000);
+    a = adler32(data + 1000, size - 1000, a);
+    uint32_t f = fletcher32(data, 1000);
+    f = fletcher32(data + 1000, size - 1000, f);
+    TEST_CHECK(tc, c == crc32c(data, size));
+    TEST_CHECK(tc, a == adler32(data, size));
+    TEST_CHECK(tc, f == fletcher32(data, size));
+
+    // maximum byte values stress the sums in the vector blocks
+    for (unsigned i = 0; i < size; i++) {
+        data[i] = 0xff;
+    }
+    TEST_CHECK(tc, adler32(data, size) == sd::adler32_scalar(1, data, size));
+    TEST_CHECK(tc, fletcher32(data, size) == sd::fletcher32_scalar(0, data, size));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,216 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// The fixed point formulas documented in color.h
+struct color_ref {
+    int k[3], y[3], u[3], v[3], c[4];
+    unsigned channels, ri, bi;
+
+    color_ref(simdpp::pixel_format fmt, simdpp::yuv_matrix m)
+    {
+        static const int c601[16] = { 77, 150, 29, 66, 129, 25, -38, -74, 112,
+                                      112, -94, -18, 102, 25, 52, 129 };
+        static const int c709[16] = { 54, 183, 19, 47, 157, 16, -26, -86, 112,
+                                      112, -102, -10, 115, 14, 34, 135 };
+        const int* t = m == simdpp::yuv_matrix::bt601 ? c601 : c709;
+        for (unsigned i = 0; i < 3; ++i) {
+            k[i] = t[i];
+            y[i] = t[3+i];
+            u[i] = t[6+i];
+            v[i] = t[9+i];
+        }
+        for (unsigned i = 0; i < 4; ++i) {
+            c[i] = t[12+i];
+        }
+        channels = (fmt == simdpp::pixel_format::rgba ||
+                    fmt == simdpp::pixel_format::bgra) ? 4 : 3;
+        bool swap = fmt == simdpp::pixel_format::bgr ||
+                    fmt == simdpp::pixel_format::bgra;
+        ri = swap ? 2 : 0;
+        bi = swap ? 0 : 2;
+    }
+
+    static int clamp(int x) { return x < 0 ? 0 : x > 255 ? 255 : x; }
+    static int sat(int x) { return x < -32768 ? -32768 : x > 32767 ? 32767 : x; }
+    static int shr(int x, unsigned n) { return x >= 0 ? x >> n : -((-x - 1) >> n) - 1; }
+
+    int dot(const int* w, int r, int g, int b) const
+    {
+        return shr(w[0]*r + w[1]*g + w[2]*b + 128, 8);
+    }
+
+    int gray(const uint8_t* p) const { return dot(k, p[ri], p[1], p[bi]); }
+    int luma(const uint8_t* p) const { return dot(y, p[ri], p[1], p[bi]) + 16; }
+
+    bool check_rgb(const uint8_t* p, int yy, int uu, int vv) const
+    {
+        int yt = ((yy * 257 * 19003) >> 16) - 1160;
+        uu -= 128;
+        vv -= 128;
+        return p[ri] == clamp(shr(sat(yt + c[0]*vv), 6)) &&
+               p[1] == clamp(shr(sat(yt - c[1]*uu - c[2]*vv), 6)) &&
+               p[bi] == clamp(shr(sat(yt + c[3]*uu), 6)) &&
+               (channels == 3 || p[3] == 0xff);
+    }
+};
+
+template<class T>
+void color_fill(std::vector<T>& v, unsigned seed)
+{
+    std::srand(seed);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = T(std::rand());
+    }
+}
+
+bool test_color_gray(simdpp::pixel_format fmt, simdpp::yuv_matrix m,
+                     std::size_t w, std::size_t h)
+{
+    color_ref ref(fmt, m);
+    std::size_t stride = w * ref.channels + 3;
+    std::vector<uint8_t> src(stride * h), dst((w + 1) * h);
+    color_fill(src, unsigned(w * 7 + h));
+
+    simdpp::rgb_to_gray(src.data(), stride, w, h, dst.data(), w + 1, fmt, m);
+    for (std::size_t r = 0; r < h; ++r) {
+        for (std::size_t i = 0; i < w; ++i) {
+            if (dst[r*(w+1) + i] != ref.gray(&src[r*stride + i*ref.channels])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_color_from_yuv(simdpp::pixel_format fmt, simdpp::yuv_matrix m,
+                         std::size_t w, std::size_t h, bool nv12)
+{
+    color_ref ref(fmt, m);
+    std::size_t cw = (w + 1) / 2;
+    std::size_t ch = (h + 1) / 2;
+    std::size_t stride = w * ref.channels + 5;
+    std::vector<uint8_t> y(w * h), u(cw * ch), v(cw * ch), uv(2 * cw * ch);
+    std::vector<uint8_t> dst(stride * h);
+    color_fill(y, unsigned(w + h));
+    color_fill(u, unsigned(w * 3 + h));
+    color_fill(v, unsigned(w * 5 + h));
+    for (std::size_t i = 0; i < u.size(); ++i) {
+        uv[2*i] = u[i];
+        uv[2*i+1] = v[i];
+    }
+
+    if (nv12) {
+        simdpp::nv12_to_rgb(y.data(), w, uv.data(), 2 * cw, w, h,
+                            dst.data(), stride, fmt, m);
+    } else {
+        simdpp::i420_to_rgb(y.data(), w, u.data(), cw, v.data(), cw, w, h,
+                            dst.data(), stride, fmt, m);
+    }
+    for (std::size_t r = 0; r < h; ++r) {
+        for (std::size_t i = 0; i < w; ++i) {
+            std::size_t c = r/2*cw + i/2;
+            if (!ref.check_rgb(&dst[r*stride + i*ref.channels], y[r*w + i], u[c], v[c])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_color_to_yuv(simdpp::pixel_format fmt, simdpp::yuv_matrix m,
+                       std::size_t w, std::size_t h, bool nv12)
+{
+    color_ref ref(fmt, m);
+    std::size_t cw = (w + 1) / 2;
+    std::size_t ch = (h + 1) / 2;
+    std::size_t stride = w * ref.channels + 1;
+    std::vector<uint8_t> src(stride * h);
+    std::vector<uint8_t> y(w * h), u(cw * ch), v(cw * ch), uv(2 * cw * ch);
+    color_fill(src, unsigned(w * 11 + h));
+
+    if (nv12) {
+        simdpp::rgb_to_nv12(src.data(), stride, w, h, y.data(), w,
+                            uv.data(), 2 * cw, fmt, m);
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            u[i] = uv[2*i];
+            v[i] = uv[2*i+1];
+        }
+    } else {
+        simdpp::rgb_to_i420(src.data(), stride, w, h, y.data(), w,
+                            u.data(), cw, v.data(), cw, fmt, m);
+    }
+
+    for (std::size_t r = 0; r < h; ++r) {
+        for (std::size_t i = 0; i < w; ++i) {
+            if (y[r*w + i] != ref.luma(&src[r*stride + i*ref.channels])) {
+                return false;
+            }
+        }
+    }
+    for (std::size_t r = 0; r < ch; ++r) {
+        for (std::size_t i = 0; i < cw; ++i) {
+            std::size_t r0 = 2*r, r1 = 2*r + 1 < h ? 2*r + 1 : 2*r;
+            std::size_t i0 = 2*i, i1 = 2*i + 1 < w ? 2*i + 1 : 2*i;
+            const uint8_t* p[4] = {
+                &src[r0*stride + i0*ref.channels], &src[r0*stride + i1*ref.channels],
+                &src[r1*stride + i0*ref.channels], &src[r1*stride + i1*ref.channels]
+            };
+            int s[3] = { 0, 0, 0 };
+            for (unsigned j = 0; j < 4; ++j) {
+                s[0] += p[j][ref.ri];
+                s[1] += p[j][1];
+                s[2] += p[j][ref.bi];
+            }
+            for (unsigned j = 0; j < 3; ++j) {
+                s[j] = (s[j] + 2) >> 2;
+            }
+            if (u[r*cw + i] != ref.dot(ref.u, s[0], s[1], s[2]) + 128 ||
+                v[r*cw + i] != ref.dot(ref.v, s[0], s[1], s[2]) + 128) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void test_color(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "color");
+
+    const pixel_format formats[4] = { pixel_format::rgb, pixel_format::bgr,
+                                      pixel_format::rgba, pixel_format::bgra };
+    const yuv_matrix matrices[2] = { yuv_matrix::bt601, yuv_matrix::bt709 };
+    const std::size_t widths[7] = { 1, 2, 7, 31, 64, 97, 130 };
+
+    for (unsigned f = 0; f < 4; ++f) {
+        for (unsigned m = 0; m < 2; ++m) {
+            for (unsigned w = 0; w < 7; ++w) {
+                for (std::size_t h = 1; h <= 4; ++h) {
+                    pixel_format pf = formats[f];
+                    yuv_matrix ym = matrices[m];
+                    std::size_t wd = widths[w];
+                    TEST_CHECK(tc, test_color_gray(pf, ym, wd, h));
+                    TEST_CHECK(tc, test_color_from_yuv(pf, ym, wd, h, true));
+                    TEST_CHECK(tc, test_color_from_yuv(pf, ym, wd, h, false));
+                    TEST_CHECK(tc, test_color_to_yuv(pf, ym, wd, h, true));
+                    TEST_CHECK(tc, test_color_to_yuv(pf, ym, wd, h, false));
+                }
+            }
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -30,6 +30,7 @@ void test_compare_n(TestSuite& tc)
     using int16_n = int16<B/2>;
     using uint32_n = uint32<B/4>;
     using int32_n = int32<B/4>;
+    using uint64_n = uint64<B/8>;
     using float32_n = float32<B/4>;
     using float64_n = float64<B/8>;
 
@@ -84,7 +85,20 @@ void test_compare_n(TestSuite& tc)
         TEST_COMPARE_TESTER_HELPER(tc, uint32_n, sl, sr);
     }
 
-    //int64_n not available
+    //int64_n, only the equality comparisons are available
+    {
+        uint64_n sl[] = {
+            (uint64_n) make_uint(0x1111111122222222, 0x2222222222222222),
+            (uint64_n) make_uint(0x0000000000000000, 0xffffffffffffffff),
+        };
+        uint64_n sr[] = {
+            (uint64_n) make_uint(0x1111111133333333, 0x2222222222222222),
+            (uint64_n) make_uint(0x0000000100000000, 0xffffffff00000000),
+        };
+
+        TEST_ARRAY_HELPER2(tc, uint64_n, cmp_eq, sl, sr);
+        TEST_ARRAY_HELPER2(tc, uint64_n, cmp_neq, sl, sr);
+    }
 
     float nanf = std::numeric_limits<float>::quiet_NaN();
     double nan = std::numeric_limits<double>::quiet_NaN();
@@ -0,0 +1,148 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T>
+std::vector<std::complex<T>> complex_random(std::size_t n, unsigned seed)
+{
+    std::srand(seed);
+    std::vector<std::complex<T>> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = std::complex<T>(T(std::rand()) / RAND_MAX * 200 - 100,
+                               T(std::rand()) / RAND_MAX * 200 - 100);
+    }
+    return v;
+}
+
+template<class T>
+bool complex_close(std::complex<double> ref, std::complex<T> x, double tol)
+{
+    return std::abs(ref - std::complex<double>(x)) <= tol;
+}
+
+template<class C, class R, class T>
+bool test_complex_ops(unsigned seed, double eps)
+{
+    const unsigned N = C::length;
+    std::vector<std::complex<T>> a = complex_random<T>(N + 1, seed);
+    std::vector<std::complex<T>> b = complex_random<T>(N + 1, seed + 100);
+    std::vector<T> s(N + 1);
+    for (unsigned i = 0; i < N + 1; ++i) {
+        s[i] = T(std::rand()) / RAND_MAX * 4 - 2;
+    }
+    // Unaligned
+    const std::complex<T>* pa = a.data() + 1;
+    const std::complex<T>* pb = b.data() + 1;
+    const T* ps = s.data() + 1;
+
+    C va = simdpp::load_complex_u<N>(pa);
+    C vb = simdpp::load_complex_u<N>(pb);
+    std::vector<std::complex<T>> r(N + 1);
+    std::complex<T>* pr = r.data() + 1;
+
+    // Interleaved and split loads and stores
+    std::vector<T> re(N + 1), im(N + 1);
+    simdpp::store_complex_u(re.data() + 1, im.data() + 1, va);
+    for (unsigned i = 0; i < N; ++i) {
+        if (re[i + 1] != pa[i].real() || im[i + 1] != pa[i].imag()) {
+            return false;
+        }
+    }
+    C vc = simdpp::load_complex_u<N>(re.data() + 1, im.data() + 1);
+    simdpp::store_complex_u(pr, vc);
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != pa[i]) {
+            return false;
+        }
+    }
+    R vre = va.real(), vim = va.imag();
+    simdpp::store_complex_u(pr, C(vim, vre));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != std::complex<T>(pa[i].imag(), pa[i].real())) {
+            return false;
+        }
+    }
+
+    simdpp::store_complex_u(pr, simdpp::add(va, vb));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != pa[i] + pb[i]) {
+            return false;
+        }
+    }
+    simdpp::store_complex_u(pr, simdpp::sub(va, vb));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != pa[i] - pb[i]) {
+            return false;
+        }
+    }
+    simdpp::store_complex_u(pr, simdpp::conj(va));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != std::conj(pa[i])) {
+            return false;
+        }
+    }
+    simdpp::store_complex_u(pr, simdpp::scale(va, ps[0]));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != pa[i] * ps[0]) {
+            return false;
+        }
+    }
+    R vs = simdpp::load_u(ps);
+    simdpp::store_complex_u(pr, simdpp::scale(va, vs));
+    for (unsigned i = 0; i < N; ++i) {
+        if (pr[i] != pa[i] * ps[i]) {
+            return false;
+        }
+    }
+
+    // The rounding depends on fused multiply-add
+    simdpp::store_complex_u(pr, simdpp::mul(va, vb));
+    for (unsigned i = 0; i < N; ++i) {
+        std::complex<double> ref = std::complex<double>(pa[i]) * std::complex<double>(pb[i]);
+        double tol = eps * std::abs(pa[i]) * std::abs(pb[i]);
+        if (!complex_close(ref, pr[i], tol)) {
+            return false;
+        }
+    }
+    std::vector<T> n(N);
+    simdpp::store_u(n.data(), simdpp::norm(va));
+    for (unsigned i = 0; i < N; ++i) {
+        double ref = std::norm(std::complex<double>(pa[i]));
+        if (std::abs(ref - n[i]) > eps * ref) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_complex(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "complex");
+
+    using namespace simdpp;
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        TEST_CHECK(tc, (test_complex_ops<complex_float32<4>, float32<4>, float>(seed, 1e-6)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float32<8>, float32<8>, float>(seed, 1e-6)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float32<16>, float32<16>, float>(seed, 1e-6)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float32<32>, float32<32>, float>(seed, 1e-6)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float64<2>, float64<2>, double>(seed, 1e-15)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float64<4>, float64<4>, double>(seed, 1e-15)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float64<8>, float64<8>, double>(seed, 1e-15)));
+        TEST_CHECK(tc, (test_complex_ops<complex_float64<16>, float64<16>, double>(seed, 1e-15)));
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
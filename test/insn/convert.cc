@@ -8,9 +8,25 @@
 #include "../utils/test_helpers.h"
 #include "../utils/test_results.h"
 #include <simdpp/simd.h>
+#include <vector>
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
+// Checks a conversion against the scalar conversion of each element so that
+// a defect shared with the reference arch is caught as well
+template<class RE, class E, class R>
+void test_converted(TestSuite& ts, const E* in, const R& r)
+{
+    using namespace simdpp;
+    RE out[R::length];
+    store_u(out, r);
+    bool ok = true;
+    for (unsigned i = 0; i < R::length; i++) {
+        ok = ok && out[i] == RE(in[i]);
+    }
+    TEST_CHECK(ts, ok);
+}
+
 template<unsigned B>
 void test_convert_n(TestSuite& ts)
 {
@@ -20,7 +36,7 @@ void test_convert_n(TestSuite& ts)
     using  int8_n = int8<B>;
     using uint16_n = uint16<B/2>;
     using  int16_n = int16<B/2>;
-    //using uint16_2n = uint16<B>;
+    using uint16_2n = uint16<B>;
     using  int16_2n = int16<B>;
     using uint32_n = uint32<B/4>;
     using  int32_n = int32<B/4>;
@@ -28,7 +44,7 @@ void test_convert_n(TestSuite& ts)
     using  int32_2n = int32<B/2>;
     //using uint64_n = uint64<B/8>;
     //using  int64_n = int64<B/8>;
-    //using uint64_2n = uint64<B/4>;
+    using uint64_2n = uint64<B/4>;
     using  int64_2n = int64<B/4>;
     using float32_n =  float32<B/4>;
     //using float32_2n = float32<B/2>;
@@ -43,6 +59,17 @@ void test_convert_n(TestSuite& ts)
     };
     TEST_ARRAY_HELPER1_T(ts, int16_2n,  int8_n, to_int16, s);
     TEST_ARRAY_HELPER1_T(ts, int16_2n, uint8_n, to_int16, s);
+
+    int8_t ie[B];
+    uint8_t ue[B];
+    for (unsigned i = 0; i < B; i++) {
+        ie[i] = int8_t(i * 37 - 100);
+        ue[i] = uint8_t(i * 37 + 100);
+    }
+    int8_n iv = load_u(ie);
+    uint8_n uv = load_u(ue);
+    test_converted<int16_t>(ts, ie, uint16_2n(to_int16(iv)));
+    test_converted<int16_t>(ts, ue, uint16_2n(to_int16(uv)));
     }
 
     //int16
@@ -66,6 +93,17 @@ void test_convert_n(TestSuite& ts)
     TEST_ARRAY_HELPER1_T(ts, int64_2n,  int32_n, to_int64, s);
     TEST_ARRAY_HELPER1_T(ts, int64_2n, uint32_n, to_int64, s);
 
+    int32_t ie[B/4];
+    uint32_t ue[B/4];
+    for (unsigned i = 0; i < B/4; i++) {
+        ie[i] = int32_t(i * 0x12345679 - 0x70000000);
+        ue[i] = uint32_t(i * 0x12345679 + 0x70000000);
+    }
+    int32_n iv = load_u(ie);
+    uint32_n uv = load_u(ue);
+    test_converted<int64_t>(ts, ie, uint64_2n(to_int64(iv)));
+    test_converted<int64_t>(ts, ue, uint64_2n(to_int64(uv)));
+
     int32_n sf[] = {
         (int32_n) make_uint(1, 100),
         (int32_n) make_uint(-1, -100),
@@ -112,6 +150,13 @@ void test_convert_n(TestSuite& ts)
     };
 
     TEST_ARRAY_HELPER1_T(ts, int32_n, float64_2n, to_int32, sf);
+
+    std::vector<double, aligned_allocator<double, sizeof(float64_2n)>> fe(B/4);
+    for (unsigned i = 0; i < B/4; i++) {
+        fe[i] = double(int32_t(i * 0x12345679 - 0x70000000));
+    }
+    float64_2n fv = load(fe.data());
+    test_converted<int32_t>(ts, fe.data(), uint32_n(to_int32(fv)));
     }
 }
 
@@ -0,0 +1,236 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Returns the source index of i for an image of n elements, or -1 for zero
+long conv_ref_index(long i, long n, simdpp::border_mode b)
+{
+    while (i < 0 || i >= n) {
+        if (b == simdpp::border_mode::zero) {
+            return -1;
+        }
+        if (b == simdpp::border_mode::replicate || n == 1) {
+            return i < 0 ? 0 : n - 1;
+        }
+        i = i < 0 ? -i : 2 * (n - 1) - i;
+    }
+    return i;
+}
+
+// The 8-bit filter pass as documented in filter_separable
+template<class Get>
+int conv_ref_u8(const int16_t* k, unsigned n, long i, long size,
+                simdpp::border_mode b, unsigned shift, Get get)
+{
+    int acc = shift ? 1 << (shift - 1) : 0;
+    for (unsigned j = 0; j < n; ++j) {
+        long s = conv_ref_index(i + long(j) - long(n/2), size, b);
+        if (s < 0) {
+            continue;
+        }
+        acc += int16_t(k[j] * get(s));
+        acc = acc < -32768 ? -32768 : acc > 32767 ? 32767 : acc;
+    }
+    acc = acc >= 0 ? acc >> shift : -((-acc - 1) >> shift) - 1;
+    return acc < 0 ? 0 : acc > 255 ? 255 : acc;
+}
+
+bool test_filter_u8(std::size_t w, std::size_t h, unsigned nx, unsigned ny,
+                    unsigned shift, simdpp::border_mode b)
+{
+    std::srand(unsigned(w * 31 + h * 7 + nx + ny));
+    std::size_t stride = w + 3;
+    std::vector<uint8_t> src(stride * h), dst(stride * h), tmp(w * h);
+    std::vector<int16_t> kx(nx), ky(ny);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = uint8_t(std::rand());
+    }
+    for (unsigned i = 0; i < nx; ++i) {
+        kx[i] = int16_t(std::rand() % 161 - 32);
+    }
+    for (unsigned i = 0; i < ny; ++i) {
+        ky[i] = int16_t(std::rand() % 161 - 32);
+    }
+
+    simdpp::filter_separable(src.data(), stride, w, h, dst.data(), stride,
+                             kx.data(), nx, ky.data(), ny, shift, b);
+
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            tmp[y*w + x] = uint8_t(conv_ref_u8(ky.data(), ny, long(y), long(h), b, shift,
+                                   [&](long s) { return src[s*stride + x]; }));
+        }
+    }
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            int r = conv_ref_u8(kx.data(), nx, long(x), long(w), b, shift,
+                                [&](long s) { return tmp[y*w + s]; });
+            if (dst[y*stride + x] != r) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_filter_f32(std::size_t w, std::size_t h, unsigned nx, unsigned ny,
+                     simdpp::border_mode b)
+{
+    std::srand(unsigned(w * 17 + h * 5 + nx + ny));
+    std::size_t stride = w + 1;
+    std::vector<float> src(stride * h), dst(stride * h);
+    std::vector<float> kx(nx), ky(ny);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = float(std::rand() % 1000) / 4;
+    }
+    for (unsigned i = 0; i < nx; ++i) {
+        kx[i] = float(std::rand() % 200 - 50) / 128;
+    }
+    for (unsigned i = 0; i < ny; ++i) {
+        ky[i] = float(std::rand() % 200 - 50) / 128;
+    }
+
+    simdpp::filter_separable(src.data(), stride, w, h, dst.data(), stride,
+                             kx.data(), nx, ky.data(), ny, b);
+
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            double r = 0, mag = 0;
+            for (unsigned j = 0; j < ny; ++j) {
+                long sy = conv_ref_index(long(y + j) - long(ny/2), long(h), b);
+                for (unsigned i = 0; i < nx; ++i) {
+                    long sx = conv_ref_index(long(x + i) - long(nx/2), long(w), b);
+                    if (sy < 0 || sx < 0) {
+                        continue;
+                    }
+                    double t = double(ky[j]) * kx[i] * src[sy*stride + sx];
+                    r += t;
+                    mag += std::fabs(t);
+                }
+            }
+            if (std::fabs(dst[y*stride + x] - r) > 1e-5 * mag + 1e-6) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_box_u8(std::size_t w, std::size_t h, unsigned radius, simdpp::border_mode b)
+{
+    std::srand(unsigned(w * 3 + h + radius));
+    std::vector<uint8_t> src(w * h), dst(w * h);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = uint8_t(std::rand());
+    }
+    simdpp::box_blur(src.data(), w, w, h, dst.data(), w, radius, b);
+
+    long n = 2 * long(radius) + 1;
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            long sum = 0;
+            for (long j = -long(radius); j <= long(radius); ++j) {
+                long sy = conv_ref_index(long(y) + j, long(h), b);
+                for (long i = -long(radius); i <= long(radius); ++i) {
+                    long sx = conv_ref_index(long(x) + i, long(w), b);
+                    if (sy >= 0 && sx >= 0) {
+                        sum += src[sy*w + sx];
+                    }
+                }
+            }
+            if (dst[y*w + x] != (sum + n*n/2) / (n*n)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_box_f32(std::size_t w, std::size_t h, unsigned radius, simdpp::border_mode b)
+{
+    std::srand(unsigned(w * 5 + h + radius));
+    std::vector<float> src(w * h), dst(w * h);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = float(std::rand() % 256);
+    }
+    simdpp::box_blur(src.data(), w, w, h, dst.data(), w, radius, b);
+
+    long n = 2 * long(radius) + 1;
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            double sum = 0;
+            for (long j = -long(radius); j <= long(radius); ++j) {
+                long sy = conv_ref_index(long(y) + j, long(h), b);
+                for (long i = -long(radius); i <= long(radius); ++i) {
+                    long sx = conv_ref_index(long(x) + i, long(w), b);
+                    if (sy >= 0 && sx >= 0) {
+                        sum += src[sy*w + sx];
+                    }
+                }
+            }
+            if (std::fabs(dst[y*w + x] - sum / double(n*n)) > 1e-3) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A blur of a constant image with the edges replicated is the same image
+bool test_gaussian_constant(std::size_t w, std::size_t h, float sigma)
+{
+    std::vector<uint8_t> s8(w * h, 200), d8(w * h);
+    std::vector<float> sf(w * h, 0.75f), df(w * h);
+    simdpp::gaussian_blur(s8.data(), w, w, h, d8.data(), w, sigma);
+    simdpp::gaussian_blur(sf.data(), w, w, h, df.data(), w, sigma);
+    for (std::size_t i = 0; i < w * h; ++i) {
+        if (d8[i] != 200 || std::fabs(df[i] - 0.75f) > 1e-5f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_convolve(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "convolve");
+
+    const border_mode borders[3] = { border_mode::replicate, border_mode::reflect,
+                                     border_mode::zero };
+    const std::size_t widths[5] = { 1, 5, 37, 130, 1100 };
+    const unsigned taps[4] = { 1, 3, 4, 9 };
+
+    for (unsigned b = 0; b < 3; ++b) {
+        for (unsigned w = 0; w < 5; ++w) {
+            for (unsigned t = 0; t < 4; ++t) {
+                std::size_t wd = widths[w];
+                unsigned n = taps[t];
+                TEST_CHECK(tc, test_filter_u8(wd, 6, n, taps[3 - t], 7, borders[b]));
+                TEST_CHECK(tc, test_filter_u8(wd, 3, n, n, 0, borders[b]));
+                TEST_CHECK(tc, test_filter_f32(wd, 5, n, taps[3 - t], borders[b]));
+            }
+            TEST_CHECK(tc, test_box_u8(widths[w], 9, 0, borders[b]));
+            TEST_CHECK(tc, test_box_u8(widths[w], 9, 2, borders[b]));
+            TEST_CHECK(tc, test_box_u8(widths[w], 4, 6, borders[b]));
+            TEST_CHECK(tc, test_box_f32(widths[w], 9, 2, borders[b]));
+            TEST_CHECK(tc, test_box_f32(widths[w], 4, 6, borders[b]));
+        }
+    }
+    TEST_CHECK(tc, test_gaussian_constant(50, 20, 1.5f));
+    TEST_CHECK(tc, test_gaussian_constant(7, 3, 4.0f));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -36,6 +36,11 @@ int test_dispatcher4(int arg, int arg2, int arg3, int arg4)
     return arg + arg2 + arg3 + arg4;
 }
 
+bool test_dispatcher_utf8(const char* p, std::size_t len)
+{
+    return simdpp::validate_utf8(p, len);
+}
+
 } // namespace SIMDPP_ARCH_NAMESPACE
 
 SIMDPP_MAKE_DISPATCHER_RET0(test_dispatcher, simdpp::Arch)
@@ -43,3 +48,4 @@ SIMDPP_MAKE_DISPATCHER_RET1(test_dispatcher1, int, int)
 SIMDPP_MAKE_DISPATCHER_RET2(test_dispatcher2, int, int, int)
 SIMDPP_MAKE_DISPATCHER_RET3(test_dispatcher3, int, int, int, int)
 SIMDPP_MAKE_DISPATCHER_RET4(test_dispatcher4, int, int, int, int, int)
+SIMDPP_MAKE_DISPATCHER_RET2(test_dispatcher_utf8, bool, const char*, std::size_t)
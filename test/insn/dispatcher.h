@@ -6,6 +6,7 @@
 */
 
 #include <simdpp/dispatch/arch.h>
+#include <cstddef>
 
 simdpp::Arch get_supported_arch(); // in main_dispatcher.cc
 simdpp::Arch test_dispatcher();
@@ -14,3 +15,4 @@ int test_dispatcher1(int arg);
 int test_dispatcher2(int arg, int arg2);
 int test_dispatcher3(int arg, int arg2, int arg3);
 int test_dispatcher4(int arg, int arg2, int arg3, int arg4);
+bool test_dispatcher_utf8(const char* p, std::size_t len);
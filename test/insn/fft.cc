@@ -0,0 +1,169 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// The reference transform: iterative radix 2 in double precision
+std::vector<std::complex<double>> fft_ref(std::vector<std::complex<double>> x, bool inverse)
+{
+    const double pi = 3.14159265358979323846;
+    std::size_t n = x.size();
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(x[i], x[j]);
+        }
+    }
+    for (std::size_t len = 2; len <= n; len *= 2) {
+        for (std::size_t i = 0; i < n; i += len) {
+            for (std::size_t k = 0; k < len / 2; ++k) {
+                double a = 2 * pi * double(k) / double(len) * (inverse ? 1 : -1);
+                std::complex<double> w(std::cos(a), std::sin(a));
+                std::complex<double> u = x[i + k], v = x[i + k + len/2] * w;
+                x[i + k] = u + v;
+                x[i + k + len/2] = u - v;
+            }
+        }
+    }
+    return x;
+}
+
+template<class T>
+std::vector<T> fft_random(std::size_t n, unsigned seed)
+{
+    std::srand(seed);
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = T(std::rand()) / RAND_MAX * 2 - 1;
+    }
+    return v;
+}
+
+// Returns whether the relative RMS error of (re, im) is within tol
+template<class T>
+bool fft_close(const std::vector<std::complex<double>>& ref,
+               const T* re, const T* im, double tol)
+{
+    double err = 0, norm = 0;
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+        err += std::norm(ref[i] - std::complex<double>(re[i], im[i]));
+        norm += std::norm(ref[i]);
+    }
+    return err <= tol * tol * norm;
+}
+
+template<class T>
+bool test_fft_complex(std::size_t n, double tol)
+{
+    std::vector<T> re = fft_random<T>(n, unsigned(n));
+    std::vector<T> im = fft_random<T>(n, unsigned(n + 1));
+    std::vector<std::complex<double>> x(n);
+    std::vector<std::complex<T>> c(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = std::complex<double>(re[i], im[i]);
+        c[i] = std::complex<T>(re[i], im[i]);
+    }
+    std::vector<std::complex<double>> ref = fft_ref(x, false);
+    std::vector<std::complex<double>> iref = fft_ref(x, true);
+
+    simdpp::fft_plan<T> plan(n);
+    std::vector<T> yr(n), yi(n);
+
+    plan.forward(re.data(), im.data(), yr.data(), yi.data());
+    if (!fft_close(ref, yr.data(), yi.data(), tol)) {
+        return false;
+    }
+    plan.inverse(re.data(), im.data(), yr.data(), yi.data());
+    if (!fft_close(iref, yr.data(), yi.data(), tol)) {
+        return false;
+    }
+
+    // In place
+    yr = re;
+    yi = im;
+    plan.forward(yr.data(), yi.data(), yr.data(), yi.data());
+    if (!fft_close(ref, yr.data(), yi.data(), tol)) {
+        return false;
+    }
+
+    // Interleaved, the results are the same as of the split format
+    std::vector<std::complex<T>> y(n);
+    plan.forward(c.data(), y.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (y[i] != std::complex<T>(yr[i], yi[i])) {
+            return false;
+        }
+    }
+    plan.inverse(y.data(), y.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs(std::complex<double>(y[i]) - double(n) * x[i]) > tol * n * 4) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class T>
+bool test_fft_real(std::size_t n, double tol)
+{
+    std::vector<T> in = fft_random<T>(n, unsigned(n + 2));
+    std::vector<std::complex<double>> x(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = in[i];
+    }
+    std::vector<std::complex<double>> ref = fft_ref(x, false);
+    ref.resize(n / 2 + 1);
+
+    simdpp::rfft_plan<T> plan(n);
+    std::vector<T> re(n / 2 + 1), im(n / 2 + 1);
+    plan.forward(in.data(), re.data(), im.data());
+    if (!fft_close(ref, re.data(), im.data(), tol)) {
+        return false;
+    }
+    if (im[0] != 0 || im[n / 2] != 0) {
+        return false;
+    }
+
+    std::vector<T> out(n);
+    plan.inverse(re.data(), im.data(), out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs(out[i] - double(n) * in[i]) > tol * n * 4) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_fft(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "fft");
+
+    for (std::size_t n = 1; n <= 1 << 14; n *= 2) {
+        TEST_CHECK(tc, test_fft_complex<float>(n, 1e-5));
+        TEST_CHECK(tc, test_fft_complex<double>(n, 1e-13));
+        if (n >= 2) {
+            TEST_CHECK(tc, test_fft_real<float>(n, 1e-5));
+            TEST_CHECK(tc, test_fft_real<double>(n, 1e-13));
+        }
+    }
+    TEST_CHECK(tc, test_fft_complex<float>(1 << 20, 1e-5));
+    TEST_CHECK(tc, test_fft_real<float>(1 << 20, 1e-5));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
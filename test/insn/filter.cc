@@ -0,0 +1,123 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T, class P>
+void test_filter_pred(TestSuite& tc, const T* col, unsigned n, const P& pred)
+{
+    using namespace simdpp;
+
+    // 200 elements need 4 bitmap words
+    uint64_t bitmap[4] = {};
+    filter_bitmap(col, n, pred, bitmap);
+    uint64x2 r0 = load_u(bitmap);
+    uint64x2 r1 = load_u(bitmap + 2);
+    TEST_PUSH(tc, uint64x2, r0);
+    TEST_PUSH(tc, uint64x2, r1);
+
+    uint32_t sel[200] = {};
+    uint32_t sel2[200] = {};
+    unsigned count = filter_select(col, n, pred, sel);
+    unsigned count2 = bitmap_to_select(bitmap, n, sel2);
+    TEST_PUSH(tc, uint16_t, count);
+    TEST_CHECK(tc, count == count2);
+
+    // the scalar predicate is the reference
+    bool bits_ok = true;
+    unsigned count_ref = 0;
+    for (unsigned i = 0; i < n; i++) {
+        bool bit = (bitmap[i / 64] >> (i % 64)) & 1;
+        bits_ok = bits_ok && bit == pred(col[i]);
+        count_ref += pred(col[i]) ? 1 : 0;
+    }
+    TEST_CHECK(tc, bits_ok);
+    TEST_CHECK(tc, count == count_ref);
+    for (unsigned i = 0; i < 200; i += 4) {
+        uint32x4 s = load_u(sel + i);
+        TEST_PUSH(tc, uint32x4, s);
+    }
+}
+
+template<class T>
+void test_filter_type(TestSuite& tc)
+{
+    using namespace simdpp;
+    const unsigned size = 200;
+    T col[size];
+    for (unsigned i = 0; i < size; i++) {
+        col[i] = T((i * 37) % 61);
+    }
+    const T in_list[] = { T(3), T(17), T(40), T(60), T(8), T(5), T(1), T(33),
+                          T(21), T(50) };
+
+    const unsigned lengths[] = { 200, 128, 45 };
+    for (unsigned n : lengths) {
+        test_filter_pred(tc, col, n, pred_eq<T>(T(17)));
+        test_filter_pred(tc, col, n, pred_range<T>(T(10), T(30)));
+        test_filter_pred(tc, col, n, pred_range<T>(T(30), T(30)));
+        test_filter_pred(tc, col, n, pred_range<T>(T(30), T(10)));
+        test_filter_pred(tc, col, n, pred_in<T>(in_list, 3));
+        test_filter_pred(tc, col, n, pred_in<T>(in_list, 10));
+        test_filter_pred(tc, col, n, pred_in<T>(in_list, 0));
+    }
+}
+
+template<class T>
+void test_filter_signed_type(TestSuite& tc)
+{
+    using namespace simdpp;
+    const unsigned size = 200;
+    T col[size];
+    for (unsigned i = 0; i < size; i++) {
+        col[i] = T(int((i * 37) % 61) - 30);
+    }
+    test_filter_pred(tc, col, size, pred_range<T>(T(-10), T(10)));
+    test_filter_pred(tc, col, size, pred_range<T>(T(-30), T(-20)));
+    test_filter_pred(tc, col, size, pred_range<T>(T(10), T(-10)));
+}
+
+// Dictionary codes spanning the whole range of uint16_t
+void test_filter_uint16_codes(TestSuite& tc)
+{
+    using namespace simdpp;
+    const unsigned size = 200;
+    uint16_t col[size];
+    for (unsigned i = 0; i < size; i++) {
+        col[i] = uint16_t(i * 7919 % 65536);
+    }
+    const uint16_t in_list[] = { 0, 65535, 7919, 15838, 32768, 31, 32,
+                                 uint16_t(199 * 7919 % 65536), 1000, 63360,
+                                 uint16_t(100 * 7919 % 65536), 12 };
+    test_filter_pred(tc, col, size, pred_in<uint16_t>(in_list, 8));
+    test_filter_pred(tc, col, size, pred_in<uint16_t>(in_list, 12));
+}
+
+void test_filter(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "filter");
+
+    test_filter_type<uint8_t>(tc);
+    test_filter_type<uint16_t>(tc);
+    test_filter_uint16_codes(tc);
+    test_filter_type<uint32_t>(tc);
+    test_filter_type<uint64_t>(tc);
+    test_filter_type<float>(tc);
+    test_filter_type<double>(tc);
+
+    test_filter_signed_type<int8_t>(tc);
+    test_filter_signed_type<int16_t>(tc);
+    test_filter_signed_type<int32_t>(tc);
+    test_filter_signed_type<int64_t>(tc);
+    test_filter_signed_type<float>(tc);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
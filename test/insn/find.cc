@@ -0,0 +1,93 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// The standard algorithms are the reference
+template<class T>
+bool test_find_ok(const T* a, const T* b, unsigned n, const T* set)
+{
+    using namespace simdpp;
+    const T values[] = { T(96), T(30), T(1), T(120), T(5) };
+    for (T v : values) {
+        if (find_first(a, n, v) != std::size_t(std::find(a, a + n, v) - a) ||
+            count(a, n, v) != std::size_t(std::count(a, a + n, v))) {
+            return false;
+        }
+    }
+    for (unsigned k = 1; k <= 3; k++) {
+        if (find_first_of(a, n, set, k) !=
+                std::size_t(std::find_first_of(a, a + n, set, set + k) - a)) {
+            return false;
+        }
+    }
+    return find_first_of(a, n, set, 0) == n &&
+           mismatch(a, b, n) == std::size_t(std::mismatch(a, a + n, b).first - a) &&
+           mismatch(a, a, n) == n;
+}
+
+template<class T>
+void test_find_type(TestSuite& tc)
+{
+    using namespace simdpp;
+
+    const unsigned size = 300;
+    SIMDPP_ALIGN(64) T a[size];
+    SIMDPP_ALIGN(64) T b[size];
+    for (unsigned i = 0; i < size; i++) {
+        a[i] = T(i % 97);
+        b[i] = a[i];
+    }
+    b[250] = T(200);
+
+    const T set[] = { T(95), T(60), T(13) };
+
+    // different offsets exercise the unaligned head and tail
+    const unsigned offsets[] = { 0, 1, 3, 7 };
+    const unsigned lengths[] = { 290, 100, 40, 5, 0 };
+    for (unsigned off : offsets) {
+        for (unsigned n : lengths) {
+            TEST_PUSH(tc, uint16_t, find_first(a + off, n, T(96)));
+            TEST_PUSH(tc, uint16_t, find_first(a + off, n, T(30)));
+            TEST_PUSH(tc, uint16_t, find_first(a + off, n, T(1)));
+            TEST_PUSH(tc, uint16_t, find_first(a + off, n, T(120)));
+            TEST_PUSH(tc, uint16_t, find_first_of(a + off, n, set, 3));
+            TEST_PUSH(tc, uint16_t, find_first_of(a + off, n, set, 1));
+            TEST_PUSH(tc, uint16_t, count(a + off, n, T(5)));
+            TEST_PUSH(tc, uint16_t, count(a + off, n, T(120)));
+            TEST_PUSH(tc, uint16_t, mismatch(a + off, b + off, n));
+            TEST_PUSH(tc, uint16_t, mismatch(a + off, a + off, n));
+            TEST_CHECK(tc, test_find_ok(a + off, b + off, n, set));
+        }
+    }
+
+    // counts that exceed the range of the per-element counters
+    for (unsigned i = 0; i < size; i++) {
+        b[i] = T(7);
+    }
+    TEST_PUSH(tc, uint16_t, count(b + 1, size - 1, T(7)));
+    TEST_CHECK(tc, count(b + 1, size - 1, T(7)) == size - 1);
+}
+
+void test_find(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "find");
+
+    test_find_type<uint8_t>(tc);
+    test_find_type<uint16_t>(tc);
+    test_find_type<uint32_t>(tc);
+    test_find_type<uint64_t>(tc);
+    test_find_type<int8_t>(tc);
+    test_find_type<int32_t>(tc);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,96 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+void test_hash(TestResults& res)
+{
+    using namespace simdpp;
+    namespace sd = simdpp::SIMDPP_ARCH_NAMESPACE::detail;
+    TestSuite& tc = NEW_TEST_SUITE(res, "hash");
+
+    // the lengths are read from data + 1
+    const unsigned size = 2201;
+    uint8_t data[size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+
+    // partial stripes, whole stripes and more than one block of 16 stripes
+    const unsigned lengths[] = { 0, 1, 3, 63, 64, 65, 100, 1024, 1031, 2200 };
+    const uint64_t seeds[] = { 0, 0x123456789abcdef };
+
+    for (uint64_t s : seeds) {
+        SIMDPP_ALIGN(16) uint32_t r32[12];
+        SIMDPP_ALIGN(16) uint64_t r64[12];
+        unsigned k = 0;
+        for (unsigned len : lengths) {
+            r32[k] = hash32(data + 1, len, uint32_t(s));
+            r64[k] = hash64(data + 1, len, s);
+            TEST_CHECK(tc, r32[k] == sd::hash32_scalar(data + 1, len, uint32_t(s)));
+            TEST_CHECK(tc, r64[k] == sd::hash64_scalar(data + 1, len, s));
+            k++;
+        }
+        r32[10] = r32[11] = 0;
+        r64[10] = r64[11] = 0;
+        for (unsigned i = 0; i < 12; i += 4) {
+            uint32x4 v = load(r32 + i);
+            TEST_PUSH(tc, uint32x4, v);
+        }
+        for (unsigned i = 0; i < 12; i += 2) {
+            uint64x2 v = load(r64 + i);
+            TEST_PUSH(tc, uint64x2, v);
+        }
+    }
+
+    // a single changed byte changes the hash
+    uint32_t h32 = hash32(data, 1000);
+    uint64_t h64 = hash64(data, 1000);
+    data[777] ^= 1;
+    TEST_CHECK(tc, h32 != hash32(data, 1000));
+    TEST_CHECK(tc, h64 != hash64(data, 1000));
+
+    // batches, the last keys are processed by the scalar code
+    const unsigned n = 37;
+    SIMDPP_ALIGN(16) uint32_t k32[40] = {};
+    SIMDPP_ALIGN(16) uint64_t k64[40] = {};
+    std::memcpy(k32, data, n * 4);
+    std::memcpy(k64, data, n * 8);
+    SIMDPP_ALIGN(16) uint32_t o32[40] = {};
+    SIMDPP_ALIGN(16) uint64_t o64[40] = {};
+    hash32_batch(k32, n, 5, o32);
+    hash64_batch(k64, n, 5, o64);
+
+    unsigned same = 0;
+    for (unsigned i = 0; i < n; ++i) {
+        same += o32[i] == sd::hash_fmix32(k32[i] ^ sd::hash_fmix32(5 + 0x9e3779b1));
+        same += o64[i] == sd::hash_fmix64(k64[i] ^ sd::hash_fmix64(5 + 0x9e3779b185ebca87));
+    }
+    TEST_PUSH(tc, uint16_t, same);
+    TEST_CHECK(tc, same == 2*n);
+    for (unsigned i = 0; i < 40; i += 4) {
+        uint32x4 v = load(o32 + i);
+        TEST_PUSH(tc, uint32x4, v);
+    }
+    for (unsigned i = 0; i < 40; i += 2) {
+        uint64x2 v = load(o64 + i);
+        TEST_PUSH(tc, uint64x2, v);
+    }
+
+    // in place
+    hash64_batch(k64, n, 5, k64);
+    TEST_CHECK(tc, std::memcmp(k64, o64, n * 8) == 0);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
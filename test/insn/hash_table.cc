@@ -0,0 +1,132 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <unordered_map>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+void test_hash_table(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "hash_table");
+
+    const unsigned size = 1000;
+    uint32_t keys[2*size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < 2*size; i++) {
+        seed = seed * 1103515245 + 12345;
+        // the second half of the keys is never inserted
+        keys[i] = (seed & ~1u) | (i >= size);
+    }
+
+    hash_map<uint32_t, uint32_t> map;
+    hash_set<uint32_t> set(16);
+
+    // std::unordered_map is the reference for the contents of both tables
+    std::unordered_map<uint32_t, uint32_t> ref;
+    auto matches_ref = [&]() -> bool
+    {
+        bool ok = map.size() == ref.size() && set.size() == ref.size();
+        for (unsigned i = 0; i < 2*size; i++) {
+            auto it = ref.find(keys[i]);
+            const uint32_t* v = map.find(keys[i]);
+            if (it == ref.end()) {
+                ok = ok && v == nullptr && !set.contains(keys[i]);
+            } else {
+                ok = ok && v != nullptr && *v == it->second && set.contains(keys[i]);
+            }
+        }
+        return ok;
+    };
+
+    unsigned inserted = 0;
+    for (unsigned i = 0; i < size; i++) {
+        inserted += map.insert(keys[i], i);
+        set.insert(keys[i]);
+        ref.insert(std::make_pair(keys[i], i));
+    }
+    TEST_PUSH(tc, uint16_t, inserted);
+    TEST_PUSH(tc, uint16_t, map.size());
+    TEST_PUSH(tc, uint16_t, set.size());
+    TEST_PUSH(tc, uint16_t, map.insert(keys[0], 5));
+    TEST_CHECK(tc, inserted == ref.size());
+    TEST_CHECK(tc, matches_ref());
+
+    // single lookups
+    unsigned found = 0;
+    unsigned correct = 0;
+    for (unsigned i = 0; i < 2*size; i++) {
+        const uint32_t* v = map.find(keys[i]);
+        if (v != nullptr) {
+            found++;
+            correct += keys[*v] == keys[i];
+        }
+    }
+    TEST_PUSH(tc, uint16_t, found);
+    TEST_PUSH(tc, uint16_t, correct);
+
+    // batch lookups
+    const uint32_t* values[2*size];
+    bool present[2*size];
+    TEST_PUSH(tc, uint16_t, map.find_batch(keys, 2*size, values));
+    TEST_PUSH(tc, uint16_t, set.contains_batch(keys, 2*size, present));
+    bool batch_ok = true;
+    for (unsigned i = 0; i < 2*size; i++) {
+        batch_ok = batch_ok && values[i] == map.find(keys[i]) &&
+                   present[i] == (ref.count(keys[i]) != 0);
+    }
+    TEST_CHECK(tc, batch_ok);
+    for (unsigned i = 0; i < 2*size; i += 4) {
+        uint32_t r[4];
+        for (unsigned j = 0; j < 4; ++j) {
+            r[j] = (values[i+j] != nullptr ? *values[i+j] : 0xffffffff);
+            r[j] ^= present[i+j] ? 0 : 0x80000000;
+        }
+        uint32x4 v = load_u(r);
+        TEST_PUSH(tc, uint32x4, v);
+    }
+
+    // erase every third key, then reinsert some of them
+    unsigned erased = 0;
+    unsigned erased_ref = 0;
+    for (unsigned i = 0; i < size; i += 3) {
+        erased += map.erase(keys[i]);
+        set.erase(keys[i]);
+        erased_ref += unsigned(ref.erase(keys[i]));
+    }
+    TEST_PUSH(tc, uint16_t, erased);
+    TEST_PUSH(tc, uint16_t, map.erase(keys[0]));
+    TEST_CHECK(tc, erased == erased_ref);
+    for (unsigned i = 0; i < size; i += 6) {
+        map[keys[i]] = 7;
+        set.insert(keys[i]);
+        ref[keys[i]] = 7;
+    }
+    TEST_CHECK(tc, matches_ref());
+    TEST_PUSH(tc, uint16_t, map.size());
+    TEST_PUSH(tc, uint16_t, set.size());
+    found = 0;
+    for (unsigned i = 0; i < size; i++) {
+        found += set.contains(keys[i]);
+        const uint32_t* v = map.find(keys[i]);
+        if (v != nullptr && i % 3 == 0) {
+            correct += *v;
+        }
+    }
+    TEST_PUSH(tc, uint16_t, found);
+    TEST_PUSH(tc, uint16_t, correct);
+
+    map.clear();
+    TEST_PUSH(tc, uint16_t, map.size());
+    TEST_CHECK(tc, map.size() == 0);
+    TEST_CHECK(tc, map.find(keys[1]) == nullptr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -8,6 +8,8 @@
 #include "../utils/test_helpers.h"
 #include "../utils/test_results.h"
 #include <simdpp/simd.h>
+#include <cmath>
+#include <cstring>
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
@@ -52,7 +54,7 @@ void test_math_fp_n(TestSuite& tc, TestSuite& ts_fma)
         TEST_ARRAY_HELPER1(tc, float32_n, sign, s);
         TEST_ARRAY_HELPER1(tc, float32_n, neg, s);
 
-#if (SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4 || SIMDPP_USE_NULL) && !SIMDPP_USE_AVX512
+#if SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4 || SIMDPP_USE_NULL
         TEST_ALL_COMB_HELPER3(ts_fma, float32_n, fmadd, s, 4);
         TEST_ALL_COMB_HELPER3(ts_fma, float32_n, fmsub, s, 4);
 #endif
@@ -67,7 +69,21 @@ void test_math_fp_n(TestSuite& tc, TestSuite& ts_fma)
         TEST_ALL_COMB_HELPER2(tc, float32_n, min, snan, 4);
         TEST_ALL_COMB_HELPER2(tc, float32_n, max, snan, 4);
 
-
+        // one Newton-Raphson step must bring the estimate close to 1/sqrt(a)
+        float sa[float32_n::length];
+        for (unsigned i = 0; i < float32_n::length; i++) {
+            sa[i] = 0.01f + 37.5f * i;
+        }
+        float32_n a = load_u(sa);
+        float32_n x = rsqrt_e(a);
+        x = rsqrt_rh(x, a);
+        float sx[float32_n::length];
+        std::memcpy(sx, &x, sizeof(sx));
+        bool rsqrt_ok = true;
+        for (unsigned i = 0; i < float32_n::length; i++) {
+            rsqrt_ok = rsqrt_ok && std::abs(sx[i] * std::sqrt(sa[i]) - 1.0f) < 1e-5f;
+        }
+        TEST_CHECK(tc, rsqrt_ok);
     }
 
     // Vectors with 64-bit floating-point elements
@@ -96,7 +112,7 @@ void test_math_fp_n(TestSuite& tc, TestSuite& ts_fma)
         TEST_ARRAY_HELPER1(tc, float64_n, sign, s);
         TEST_ARRAY_HELPER1(tc, float64_n, neg, s);
 
-#if (SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4 || SIMDPP_USE_NULL) && !SIMDPP_USE_AVX512
+#if SIMDPP_USE_FMA3 || SIMDPP_USE_FMA4 || SIMDPP_USE_NULL
         TEST_ALL_COMB_HELPER3(ts_fma, float64_n, fmadd, s, 8);
         TEST_ALL_COMB_HELPER3(ts_fma, float64_n, fmsub, s, 8);
 #endif
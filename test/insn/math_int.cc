@@ -8,9 +8,37 @@
 #include "../utils/test_helpers.h"
 #include "../utils/test_results.h"
 #include <simdpp/simd.h>
+#include <cstring>
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
+// Checks that mull returns the products in the order of the source elements.
+// The element values differ, unlike in the repeating patterns used above.
+template<class RV, class V>
+void test_mull_order(TestSuite& tc)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+    using RE = typename RV::element_type;
+
+    E ea[V::length], eb[V::length];
+    for (unsigned i = 0; i < V::length; i++) {
+        ea[i] = E(i * 40503u + 12345u);
+        eb[i] = E(i * 2654435761u + 1u);
+    }
+    V a = load_u(ea);
+    V b = load_u(eb);
+    RV r = mull(a, b);
+
+    RE er[RV::length];
+    std::memcpy(er, &r, sizeof(er));
+    bool ok = true;
+    for (unsigned i = 0; i < V::length; i++) {
+        ok = ok && er[i] == RE(RE(ea[i]) * RE(eb[i]));
+    }
+    TEST_CHECK(tc, ok);
+}
+
 template<unsigned B>
 void test_math_int_n(TestSuite& tc)
 {
@@ -103,6 +131,8 @@ void test_math_int_n(TestSuite& tc)
 
         TEST_ALL_COMB_HELPER2_T(tc, int32<B/2>, int16_n, mull, s, 2);
         TEST_ALL_COMB_HELPER2_T(tc, uint32<B/2>, uint16_n, mull, s, 2);
+        test_mull_order<int32<B/2>, int16_n>(tc);
+        test_mull_order<uint32<B/2>, uint16_n>(tc);
 
         TEST_ARRAY_HELPER1(tc, int16_n, neg, s);
         TEST_ARRAY_HELPER1(tc, int16_n, abs, s);
@@ -140,8 +170,12 @@ void test_math_int_n(TestSuite& tc)
 
 #if !(SIMDPP_USE_ALTIVEC)
         TEST_ALL_COMB_HELPER2_T(tc, uint64<B/4>, uint32_n, mull, s, 4);
+        test_mull_order<uint64<B/4>, uint32_n>(tc);
         TEST_ALL_COMB_HELPER2_T(tc, uint32_n, uint32_n, mul_lo, s, 4);
 #endif
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSE4_1 || SIMDPP_USE_NEON
+        test_mull_order<int64<B/4>, int32_n>(tc);
+#endif
 
         TEST_ARRAY_HELPER1(tc, int32_n, neg, s);
         TEST_ARRAY_HELPER1(tc, int32_n, abs, s);
@@ -9,6 +9,7 @@
 #include "../utils/test_results.h"
 #include "../common/vectors.h"
 #include <simdpp/simd.h>
+#include <cstring>
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
@@ -27,6 +28,21 @@ void test_load_helper(TestSuite& tc, void* sv_p)
         }
     };
 
+    // checks that rv[0..n-1] hold the elements of the interleaved data
+    auto check_packed = [&](const E* data, unsigned n)
+    {
+        bool ok = true;
+        for (unsigned k = 0; k < n; k++) {
+            E r[V::length];
+            std::memcpy(r, &rv[k], sizeof(r));
+            for (unsigned i = 0; i < V::length; i++) {
+                // compare bits: the data may contain NaN patterns
+                ok = ok && std::memcmp(&r[i], &data[i*n + k], sizeof(E)) == 0;
+            }
+        }
+        TEST_CHECK(tc, ok);
+    };
+
     // calls constructor that accepts expr_construct
     for (unsigned i = 0; i < vnum; i++) {
         V r = simdpp::load(sdata + i*V::length);
@@ -65,14 +81,37 @@ void test_load_helper(TestSuite& tc, void* sv_p)
     rzero();
     load_packed2(rv[0], rv[1], sdata);
     TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(sdata, 2);
 
     rzero();
     load_packed3(rv[0], rv[1], rv[2], sdata);
     TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(sdata, 3);
 
     rzero();
     load_packed4(rv[0], rv[1], rv[2], rv[3], sdata);
     TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(sdata, 4);
+
+    // the unaligned variants must produce the same result
+    E udata[V::length*vnum + 1];
+    udata[0] = 0;
+    std::memcpy(udata + 1, sdata, sizeof(E)*V::length*vnum);
+
+    rzero();
+    load_packed2_u(rv[0], rv[1], udata + 1);
+    TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(udata + 1, 2);
+
+    rzero();
+    load_packed3_u(rv[0], rv[1], rv[2], udata + 1);
+    TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(udata + 1, 3);
+
+    rzero();
+    load_packed4_u(rv[0], rv[1], rv[2], rv[3], udata + 1);
+    TEST_ARRAY_PUSH(tc, V, rv);
+    check_packed(udata + 1, 4);
 }
 
 template<unsigned B>
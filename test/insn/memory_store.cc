@@ -42,6 +42,12 @@ void test_store_helper(TestSuite& tc, const V* sv)
         TEST_ARRAY_PUSH(tc, V, rv);
     }
 
+    for (unsigned i = 0; i < V::length; i++) {
+        rzero(rv);
+        store_u(rdata+i, sv[0]);
+        TEST_ARRAY_PUSH(tc, V, rv);
+    }
+
     tc.reset_seq();
     for (unsigned i = 0; i < V::length; i++) {
         rzero(rv);
@@ -67,6 +73,36 @@ void test_store_helper(TestSuite& tc, const V* sv)
     rzero(rv);
     store_packed4(rdata, sv[0], sv[1], sv[2], sv[3]);
     TEST_ARRAY_PUSH(tc, V, rv);
+
+    rzero(rv);
+    stream_packed2(rdata, sv[0], sv[1]);
+    TEST_ARRAY_PUSH(tc, V, rv);
+
+    rzero(rv);
+    stream_packed3(rdata, sv[0], sv[1], sv[2]);
+    TEST_ARRAY_PUSH(tc, V, rv);
+
+    rzero(rv);
+    stream_packed4(rdata, sv[0], sv[1], sv[2], sv[3]);
+    TEST_ARRAY_PUSH(tc, V, rv);
+
+    // the unaligned variants must produce the same result
+    E udata[V::length*vnum + 1];
+
+    std::memset(udata, 0, sizeof(udata));
+    store_packed2_u(udata + 1, sv[0], sv[1]);
+    std::memcpy(rdata, udata + 1, sizeof(rdata));
+    TEST_ARRAY_PUSH(tc, V, rv);
+
+    std::memset(udata, 0, sizeof(udata));
+    store_packed3_u(udata + 1, sv[0], sv[1], sv[2]);
+    std::memcpy(rdata, udata + 1, sizeof(rdata));
+    TEST_ARRAY_PUSH(tc, V, rv);
+
+    std::memset(udata, 0, sizeof(udata));
+    store_packed4_u(udata + 1, sv[0], sv[1], sv[2], sv[3]);
+    std::memcpy(rdata, udata + 1, sizeof(rdata));
+    TEST_ARRAY_PUSH(tc, V, rv);
 }
 
 template<unsigned B>
@@ -0,0 +1,195 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+unsigned motion_ref_sad(const uint8_t* a, std::size_t a_stride,
+                        const uint8_t* b, std::size_t b_stride, unsigned size)
+{
+    unsigned s = 0;
+    for (unsigned y = 0; y < size; ++y) {
+        for (unsigned x = 0; x < size; ++x) {
+            int d = int(a[y*a_stride + x]) - int(b[y*b_stride + x]);
+            s += d < 0 ? -d : d;
+        }
+    }
+    return s;
+}
+
+template<unsigned N>
+bool test_motion_sad_vec(unsigned seed)
+{
+    std::srand(seed);
+    uint8_t a[N], b[N];
+    for (unsigned i = 0; i < N; ++i) {
+        // Include the extreme differences
+        a[i] = i % 5 == 0 ? 0 : uint8_t(std::rand());
+        b[i] = i % 5 == 0 ? 255 : uint8_t(std::rand());
+    }
+    uint64_t r[N/8];
+    simdpp::store_u(r, simdpp::sad((simdpp::uint8<N>) simdpp::load_u(a),
+                                   (simdpp::uint8<N>) simdpp::load_u(b)));
+    for (unsigned i = 0; i < N/8; ++i) {
+        unsigned s = 0;
+        for (unsigned j = 8*i; j < 8*i + 8; ++j) {
+            s += a[j] > b[j] ? a[j] - b[j] : b[j] - a[j];
+        }
+        if (r[i] != s) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> motion_random(std::size_t n, unsigned seed)
+{
+    std::srand(seed);
+    std::vector<uint8_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = uint8_t(std::rand());
+    }
+    return v;
+}
+
+bool test_motion_block_sad(unsigned size, std::size_t a_stride, std::size_t b_stride)
+{
+    std::vector<uint8_t> a = motion_random(a_stride * size, unsigned(a_stride));
+    std::vector<uint8_t> b = motion_random(b_stride * size, unsigned(b_stride + 1));
+    // The blocks end at the end of the arrays to catch reads past the block
+    const uint8_t* pa = a.data() + a_stride - size;
+    const uint8_t* pb = b.data() + b_stride - size;
+    unsigned r = size == 8 ? simdpp::block_sad_8x8(pa, a_stride, pb, b_stride)
+                           : simdpp::block_sad_16x16(pa, a_stride, pb, b_stride);
+    return r == motion_ref_sad(pa, a_stride, pb, b_stride, size);
+}
+
+/*  The current image is the reference image moved by (-dx, -dy) with random
+    pixels at the uncovered edges. On the smooth image the SAD mostly
+    decreases towards the motion within the search range, thus the diamond
+    search finds it for most blocks.
+*/
+bool test_motion_estimate(unsigned size, simdpp::motion_search method,
+                          int dx, int dy, bool smooth)
+{
+    const std::size_t width = 133, height = 75, stride = 144;
+    const int range = 7;
+    std::vector<uint8_t> ref = motion_random(stride * height, 5);
+    std::vector<uint8_t> cur = motion_random(stride * height, 6);
+    if (smooth) {
+        for (std::size_t y = 0; y < height; ++y) {
+            for (std::size_t x = 0; x < width; ++x) {
+                double v = 128 + 60 * std::sin(x / 6.0) + 60 * std::cos(y / 5.0);
+                ref[y*stride + x] = uint8_t(v);
+            }
+        }
+    }
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            long sx = long(x) + dx, sy = long(y) + dy;
+            if (sx >= 0 && sy >= 0 && sx < long(width) && sy < long(height)) {
+                cur[y*stride + x] = ref[sy*stride + sx];
+            }
+        }
+    }
+
+    std::size_t bw = width / size, bh = height / size;
+    std::vector<simdpp::motion_vector> mv(bw * bh);
+    simdpp::motion_estimate(cur.data(), ref.data(), stride, width, height,
+                            size, range, method, mv.data());
+
+    unsigned exact = 0;
+    for (std::size_t by = 0; by < bh; ++by) {
+        for (std::size_t bx = 0; bx < bw; ++bx) {
+            int px = int(bx * size), py = int(by * size);
+            int x0 = std::max(-range, -px), y0 = std::max(-range, -py);
+            int x1 = std::min(range, int(width - size) - px);
+            int y1 = std::min(range, int(height - size) - py);
+            const uint8_t* c = cur.data() + py*stride + px;
+            const uint8_t* r = ref.data() + py*stride + px;
+
+            // Reference full search with the documented tie breaking
+            simdpp::motion_vector best = { 0, 0, motion_ref_sad(c, stride, r, stride, size) };
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    unsigned s = motion_ref_sad(c, stride, r + y*long(stride) + x,
+                                                stride, size);
+                    if (s < best.sad) {
+                        best.x = x; best.y = y; best.sad = s;
+                    }
+                }
+            }
+
+            const simdpp::motion_vector& m = mv[by*bw + bx];
+            if (m.x < x0 || m.x > x1 || m.y < y0 || m.y > y1) {
+                return false;
+            }
+            if (m.sad != motion_ref_sad(c, stride, r + m.y*long(stride) + m.x,
+                                        stride, size)) {
+                return false;
+            }
+            if (method == simdpp::motion_search::full) {
+                if (m.x != best.x || m.y != best.y || m.sad != best.sad) {
+                    return false;
+                }
+            } else if (m.sad < best.sad) {
+                return false;
+            }
+            if (m.x == dx && m.y == dy && m.sad == 0) {
+                exact++;
+            }
+        }
+    }
+    /*  The blocks away from the edges move by exactly (dx, dy). The diamond
+        search may stop at a local minimum on the flat parts of the image.
+    */
+    std::size_t inner = (bw - 2) * (bh - 2);
+    if (method == simdpp::motion_search::full) {
+        return exact >= inner;
+    }
+    return !smooth || exact >= inner * 3 / 4;
+}
+
+void test_motion(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "motion");
+
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        TEST_CHECK(tc, test_motion_sad_vec<16>(seed));
+        TEST_CHECK(tc, test_motion_sad_vec<32>(seed));
+        TEST_CHECK(tc, test_motion_sad_vec<64>(seed));
+    }
+
+    const std::size_t strides[4] = { 16, 17, 31, 64 };
+    for (std::size_t sa : strides) {
+        for (std::size_t sb : strides) {
+            TEST_CHECK(tc, test_motion_block_sad(8, sa, sb));
+            TEST_CHECK(tc, test_motion_block_sad(16, sa, sb));
+        }
+    }
+
+    const int moves[4][2] = { { 0, 0 }, { 3, -2 }, { -7, 5 }, { 1, 1 } };
+    for (unsigned size = 8; size <= 16; size += 8) {
+        for (const auto& d : moves) {
+            for (unsigned smooth = 0; smooth < 2; ++smooth) {
+                TEST_CHECK(tc, test_motion_estimate(size, simdpp::motion_search::full,
+                                                    d[0], d[1], smooth == 1));
+                TEST_CHECK(tc, test_motion_estimate(size, simdpp::motion_search::diamond,
+                                                    d[0], d[1], smooth == 1));
+            }
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
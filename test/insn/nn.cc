@@ -0,0 +1,206 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Random values in [offset - scale, offset + scale]
+std::vector<float> nn_random(std::size_t n, unsigned seed, float offset, float scale)
+{
+    std::srand(seed);
+    std::vector<float> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = offset + (float(std::rand()) / RAND_MAX * 2 - 1) * scale;
+    }
+    return v;
+}
+
+bool nn_close(double ref, float x, double tol)
+{
+    return std::abs(ref - x) <= tol * std::max(1.0, std::abs(ref));
+}
+
+// Runs the kernel out of place and in place, the results must be equal
+template<class F>
+bool nn_run(F f, const std::vector<float>& x, std::vector<float>& y)
+{
+    y.assign(x.size(), 0);
+    f(x.data(), x.size(), y.data());
+    std::vector<float> z = x;
+    f(z.data(), z.size(), z.data());
+    return z == y;
+}
+
+bool test_nn_relu(std::size_t n)
+{
+    std::vector<float> x = nn_random(n, unsigned(n), 0, 10), y;
+    if (!nn_run(simdpp::relu, x, y)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (y[i] != std::max(x[i], 0.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*  Random values, including the range where the exponent overflows, and the
+    extreme values
+*/
+std::vector<float> nn_gelu_args(std::size_t n)
+{
+    std::vector<float> x = nn_random(n, unsigned(n + 1), 0, n % 2 ? 8 : 200);
+    const float big = std::numeric_limits<float>::max();
+    const float extreme[8] = { -big, -1e30f, -1e10f, -20, -10.5f, -9.5f, 1e30f, big };
+    for (std::size_t i = 0; i < n && i < 8; ++i) {
+        x[n - 1 - i] = extreme[i];
+    }
+    return x;
+}
+
+bool test_nn_gelu(std::size_t n)
+{
+    std::vector<float> x = nn_gelu_args(n), y;
+    if (!nn_run(simdpp::gelu, x, y)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        // 0.5*v*(1 + tanh(u/2)) == v*sigmoid(u), the latter is accurate for v < 0
+        double v = x[i];
+        double u = 2 * 0.7978845608028654 * (v + 0.044715 * v*v*v);
+        double ref = v / (1 + std::exp(-u));
+        // The rounding error of u is amplified by the exponent
+        double tol = 1e-6 * (2 + std::abs(u)) * std::abs(ref);
+        // Results below 5e-38 in magnitude may be flushed to zero
+        if (std::abs(ref) < 5e-38) {
+            tol = std::abs(ref);
+        }
+        if (std::abs(ref - y[i]) > tol) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*  The rows of the given kind: random logits, logits with a large offset,
+    increasing values that raise the maximum in every block, decreasing
+    values and masked logits whose exponents underflow.
+*/
+std::vector<float> nn_logits(std::size_t n, unsigned kind)
+{
+    std::vector<float> x = nn_random(n, unsigned(n + kind), kind == 1 ? 1000 : 0, 10);
+    if (kind == 2) {
+        std::sort(x.begin(), x.end());
+    } else if (kind == 3) {
+        std::sort(x.rbegin(), x.rend());
+    } else if (kind == 4) {
+        const float masked[6] = { 0, 100, -100, 3, -1e9f,
+                                  -std::numeric_limits<float>::infinity() };
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = masked[i % 6];
+        }
+    }
+    return x;
+}
+
+bool test_nn_softmax(std::size_t n, unsigned kind)
+{
+    std::vector<float> x = nn_logits(n, kind), y;
+    if (!nn_run(simdpp::softmax, x, y)) {
+        return false;
+    }
+    double m = -1e300, s = 0, sum = 0;
+    for (float v : x) {
+        m = std::max(m, double(v));
+    }
+    for (float v : x) {
+        s += std::exp(v - m);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        double ref = std::exp(x[i] - m) / s;
+        // Results below the smallest normal number may be flushed to zero
+        double tol = ref < std::numeric_limits<float>::min() ? ref : 1e-5 * ref;
+        if (std::abs(ref - y[i]) > tol) {
+            return false;
+        }
+        sum += y[i];
+    }
+    return std::abs(sum - 1) < 1e-4;
+}
+
+bool test_nn_layer_norm(std::size_t n, bool affine, float offset)
+{
+    std::vector<float> x = nn_random(n, unsigned(n + 2), offset, 3);
+    std::vector<float> gamma = nn_random(n, unsigned(n + 3), 1, 0.5);
+    std::vector<float> beta = nn_random(n, unsigned(n + 4), 0, 1);
+    const float* pg = affine ? gamma.data() : nullptr;
+    const float* pb = affine ? beta.data() : nullptr;
+    const float eps = 1e-5f;
+
+    std::vector<float> y(n), z = x;
+    simdpp::layer_norm(x.data(), n, pg, pb, eps, y.data());
+    simdpp::layer_norm(z.data(), n, pg, pb, eps, z.data());
+    if (z != y) {
+        return false;
+    }
+
+    double mean = 0, var = 0;
+    for (float v : x) {
+        mean += v;
+    }
+    mean /= n;
+    for (float v : x) {
+        var += (v - mean) * (v - mean);
+    }
+    var /= n;
+    for (std::size_t i = 0; i < n; ++i) {
+        double ref = (x[i] - mean) / std::sqrt(var + eps);
+        if (affine) {
+            ref = ref * gamma[i] + beta[i];
+        }
+        // The offset adds the rounding error of the input to the deviations
+        if (!nn_close(ref, y[i], 1e-5 + std::abs(offset) * 1e-6)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_nn(TestResults& res)
+{
+    TestSuite& tc = NEW_TEST_SUITE(res, "nn");
+
+    const std::size_t sizes[9] = { 1, 3, 17, 64, 100, 512, 1000, 4096, 8192 };
+    for (std::size_t n : sizes) {
+        TEST_CHECK(tc, test_nn_relu(n));
+        TEST_CHECK(tc, test_nn_gelu(n));
+        TEST_CHECK(tc, test_nn_gelu(n + 1));
+        for (unsigned kind = 0; kind < 5; ++kind) {
+            TEST_CHECK(tc, test_nn_softmax(n, kind));
+        }
+        if (n > 1) {
+            TEST_CHECK(tc, test_nn_layer_norm(n, false, 0));
+            TEST_CHECK(tc, test_nn_layer_norm(n, true, 0));
+            TEST_CHECK(tc, test_nn_layer_norm(n, true, 100));
+        }
+    }
+    // Rows of more than 64 blocks of the minimum size
+    for (unsigned kind = 0; kind < 4; ++kind) {
+        TEST_CHECK(tc, test_nn_softmax(100003, kind));
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,121 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Parses the whole string as an unsigned 64-bit integer
+bool test_parse_u64(const char* s, uint64_t expected)
+{
+    uint64_t v = 0;
+    const char* end = s + std::strlen(s);
+    return simdpp::parse_uint64(s, end, v) == end && v == expected;
+}
+
+// Parses the whole string as a double
+bool test_parse_double(const char* s, double expected)
+{
+    double v = 0;
+    const char* end = s + std::strlen(s);
+    return simdpp::parse_double(s, end, v) == end &&
+           std::memcmp(&v, &expected, sizeof(v)) == 0;
+}
+
+void test_parse(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "parse");
+
+    TEST_CHECK(tc, test_parse_u64("0", 0));
+    TEST_CHECK(tc, test_parse_u64("7", 7));
+    TEST_CHECK(tc, test_parse_u64("12345678", 12345678));
+    TEST_CHECK(tc, test_parse_u64("1234567890123456", 1234567890123456));
+    TEST_CHECK(tc, test_parse_u64("12345678901234567", 12345678901234567));
+    TEST_CHECK(tc, test_parse_u64("18446744073709551615", 18446744073709551615ull));
+    TEST_CHECK(tc, test_parse_u64("000000000000000000000042", 42));
+
+    uint64_t v64;
+    uint32_t v32;
+    const char* s = "18446744073709551616";
+    TEST_CHECK(tc, parse_uint64(s, s + 20, v64) == nullptr);
+    s = "123456789012345678901";
+    TEST_CHECK(tc, parse_uint64(s, s + 21, v64) == nullptr);
+    s = "x1";
+    TEST_CHECK(tc, parse_uint64(s, s + 2, v64) == nullptr);
+    s = "4294967295,";
+    TEST_CHECK(tc, parse_uint32(s, s + 11, v32) == s + 10 && v32 == 4294967295u);
+    s = "4294967296";
+    TEST_CHECK(tc, parse_uint32(s, s + 10, v32) == nullptr);
+    // the end of the buffer stops the parsing
+    s = "123456";
+    TEST_CHECK(tc, parse_uint32(s, s + 3, v32) == s + 3 && v32 == 123);
+
+    // fast path
+    TEST_CHECK(tc, test_parse_double("1.5", 1.5));
+    TEST_CHECK(tc, test_parse_double("-0.125", -0.125));
+    TEST_CHECK(tc, test_parse_double("+.5", 0.5));
+    TEST_CHECK(tc, test_parse_double("5.", 5.0));
+    TEST_CHECK(tc, test_parse_double("-0", -0.0));
+    TEST_CHECK(tc, test_parse_double("1e22", 1e22));
+    TEST_CHECK(tc, test_parse_double("1.7976931348623157", 1.7976931348623157));
+    TEST_CHECK(tc, test_parse_double("123456.789e-3", 123.456789));
+    // hard cases
+    TEST_CHECK(tc, test_parse_double("1e23", 1e23));
+    TEST_CHECK(tc, test_parse_double("1.7976931348623157e308", 1.7976931348623157e308));
+    TEST_CHECK(tc, test_parse_double("4.9406564584124654e-324", 4.9406564584124654e-324));
+    TEST_CHECK(tc, test_parse_double("0.30000000000000000000000001", 0.3));
+    TEST_CHECK(tc, test_parse_double("9007199254740993", 9007199254740993.0));
+
+    double d;
+    s = "1e+";
+    TEST_CHECK(tc, parse_double(s, s + 3, d) == s + 1 && d == 1.0);
+    s = ".e1";
+    TEST_CHECK(tc, parse_double(s, s + 3, d) == nullptr);
+
+    const char* col = "12\n345\n0\n4294967295\n7\n";
+    uint32_t out32[8];
+    TEST_CHECK(tc, parse_uint32_column(col, std::strlen(col), '\n', out32) == 5 &&
+                   out32[1] == 345 && out32[3] == 4294967295u);
+    col = "1,22,x,4";
+    uint64_t out64[8];
+    TEST_CHECK(tc, parse_uint64_column(col, std::strlen(col), ',', out64) == 2);
+    col = "1.5;-2e3;.25;1e400";
+    double outd[8];
+    TEST_CHECK(tc, parse_double_column(col, std::strlen(col), ';', outd) == 4 &&
+                   outd[1] == -2000 && outd[2] == 0.25);
+
+    // a long column with all digit counts
+    static char text[200 * 21];
+    static uint64_t values[200];
+    std::size_t len = 0;
+    uint64_t x = 1;
+    for (unsigned i = 0; i < 200; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t v = x >> (i % 64);
+        values[i] = v;
+        char digits[20];
+        unsigned n = 0;
+        do {
+            digits[n++] = char('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        while (n > 0) {
+            text[len++] = digits[--n];
+        }
+        text[len++] = ',';
+    }
+    static uint64_t parsed[200];
+    std::size_t count = parse_uint64_column(text, len, ',', parsed);
+    TEST_CHECK(tc, count == 200 &&
+                   std::memcmp(parsed, values, sizeof(values)) == 0);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
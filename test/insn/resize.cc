@@ -0,0 +1,186 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// The source pixels and weights of destination pixel i when resizing n to m
+void resize_ref_weights(std::size_t i, std::size_t n, std::size_t m,
+                        simdpp::resize_mode mode,
+                        std::vector<std::size_t>& idx, std::vector<double>& w)
+{
+    idx.clear();
+    w.clear();
+    double r = double(n) / double(m);
+    if (mode == simdpp::resize_mode::bilinear) {
+        double s = (i + 0.5) * r - 0.5;
+        s = s < 0 ? 0 : s > double(n - 1) ? double(n - 1) : s;
+        std::size_t s0 = std::size_t(std::floor(s));
+        idx.push_back(s0);
+        w.push_back(1 - (s - s0));
+        idx.push_back(s0 + 1 < n ? s0 + 1 : s0);
+        w.push_back(s - s0);
+    } else {
+        double b = i * r;
+        double e = (i + 1) * r < double(n) ? (i + 1) * r : double(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            double o = std::fmin(j + 1.0, e) - std::fmax(double(j), b);
+            if (o > 0) {
+                idx.push_back(j);
+                w.push_back(o / (e - b));
+            }
+        }
+    }
+}
+
+// Resizes a single channel of an image with interleaved channels
+std::vector<double> resize_ref(const std::vector<double>& src, unsigned channels,
+                               std::size_t sw, std::size_t sh,
+                               std::size_t dw, std::size_t dh,
+                               simdpp::resize_mode mode)
+{
+    std::vector<double> dst(dw * dh * channels);
+    std::vector<std::size_t> ix, iy;
+    std::vector<double> wx, wy;
+    for (std::size_t y = 0; y < dh; ++y) {
+        resize_ref_weights(y, sh, dh, mode, iy, wy);
+        for (std::size_t x = 0; x < dw; ++x) {
+            resize_ref_weights(x, sw, dw, mode, ix, wx);
+            for (unsigned c = 0; c < channels; ++c) {
+                double s = 0;
+                for (std::size_t j = 0; j < iy.size(); ++j) {
+                    for (std::size_t i = 0; i < ix.size(); ++i) {
+                        s += wy[j] * wx[i] * src[(iy[j]*sw + ix[i])*channels + c];
+                    }
+                }
+                dst[(y*dw + x)*channels + c] = s;
+            }
+        }
+    }
+    return dst;
+}
+
+bool test_resize_rgba(std::size_t sw, std::size_t sh, std::size_t dw, std::size_t dh,
+                      simdpp::resize_mode mode, bool constant)
+{
+    std::srand(unsigned(sw * 7 + sh * 3 + dw + dh));
+    std::size_t sstride = 4 * sw + 3;
+    std::size_t dstride = 4 * dw + 5;
+    std::vector<uint8_t> src(sstride * sh), dst(dstride * dh);
+    std::vector<double> ref_src(4 * sw * sh);
+    for (std::size_t y = 0; y < sh; ++y) {
+        for (std::size_t i = 0; i < 4 * sw; ++i) {
+            uint8_t v = constant ? uint8_t(i % 4 * 60 + 13) : uint8_t(std::rand());
+            src[y*sstride + i] = v;
+            ref_src[y*4*sw + i] = v;
+        }
+    }
+
+    // Computed in three bands to test resize_rgba_rows
+    std::size_t b0 = dh / 3, b1 = 2 * dh / 3;
+    simdpp::resize_rgba_rows(src.data(), sstride, sw, sh, dst.data(), dstride,
+                             dw, dh, mode, 0, b0);
+    simdpp::resize_rgba_rows(src.data(), sstride, sw, sh, dst.data(), dstride,
+                             dw, dh, mode, b0, b1);
+    simdpp::resize_rgba_rows(src.data(), sstride, sw, sh, dst.data(), dstride,
+                             dw, dh, mode, b1, dh);
+
+    std::vector<double> ref = resize_ref(ref_src, 4, sw, sh, dw, dh, mode);
+    bool exact = constant || (sw == dw && sh == dh) || (sw == 2*dw && sh == 2*dh);
+    for (std::size_t y = 0; y < dh; ++y) {
+        for (std::size_t i = 0; i < 4 * dw; ++i) {
+            double r = ref[y*4*dw + i];
+            double d = dst[y*dstride + i];
+            if (exact ? d != std::floor(r + 0.5) : std::fabs(d - r) > 0.501) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*  Channel c of each source pixel is within [64*c, 64*c + 8). The vector
+    code and the scalar tails must keep the channels in memory order, thus
+    the channel c of each resized pixel must stay within the same range.
+    Wide images are used so that the interpolated pixels mix the pixels of
+    both code paths.
+*/
+bool test_resize_rgba_channels(std::size_t sw, std::size_t dw,
+                               simdpp::resize_mode mode)
+{
+    const std::size_t h = 3;
+    std::vector<uint8_t> src(4 * sw * h), dst(4 * dw * h);
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        src[i] = uint8_t(i % 4 * 64 + (i / 4 * 5) % 8);
+    }
+    simdpp::resize_rgba(src.data(), 4 * sw, sw, h, dst.data(), 4 * dw, dw, h, mode);
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        if (dst[i] / 64 != i % 4 || dst[i] % 64 >= 8) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_resize_plane(std::size_t sw, std::size_t sh, std::size_t dw, std::size_t dh,
+                       simdpp::resize_mode mode)
+{
+    std::srand(unsigned(sw * 5 + sh * 11 + dw + dh));
+    std::size_t sstride = sw + 1;
+    std::vector<float> src(sstride * sh), dst(dw * dh);
+    std::vector<double> ref_src(sw * sh);
+    for (std::size_t y = 0; y < sh; ++y) {
+        for (std::size_t x = 0; x < sw; ++x) {
+            float v = float(std::rand() % 4096) / 16;
+            src[y*sstride + x] = v;
+            ref_src[y*sw + x] = v;
+        }
+    }
+
+    simdpp::resize_plane(src.data(), sstride, sw, sh, dst.data(), dw, dw, dh, mode);
+
+    std::vector<double> ref = resize_ref(ref_src, 1, sw, sh, dw, dh, mode);
+    for (std::size_t i = 0; i < dw * dh; ++i) {
+        if (std::fabs(dst[i] - ref[i]) > 1e-3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_resize(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "resize");
+
+    const resize_mode modes[2] = { resize_mode::bilinear, resize_mode::area };
+    const std::size_t sizes[][4] = {
+        { 1, 1, 1, 1 }, { 1, 1, 5, 3 }, { 7, 5, 1, 1 }, { 37, 9, 37, 9 },
+        { 74, 18, 37, 9 }, { 75, 19, 37, 9 }, { 100, 40, 33, 13 },
+        { 33, 13, 100, 40 }, { 64, 8, 48, 6 }, { 50, 30, 97, 7 },
+        { 301, 17, 20, 4 }, { 20, 4, 301, 17 }
+    };
+
+    for (unsigned m = 0; m < 2; ++m) {
+        for (const std::size_t* s : sizes) {
+            TEST_CHECK(tc, test_resize_rgba(s[0], s[1], s[2], s[3], modes[m], false));
+            TEST_CHECK(tc, test_resize_rgba(s[0], s[1], s[2], s[3], modes[m], true));
+            TEST_CHECK(tc, test_resize_plane(s[0], s[1], s[2], s[3], modes[m]));
+        }
+        TEST_CHECK(tc, test_resize_rgba_channels(37, 74, modes[m]));
+        TEST_CHECK(tc, test_resize_rgba_channels(75, 37, modes[m]));
+        TEST_CHECK(tc, test_resize_rgba_channels(301, 97, modes[m]));
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,236 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include "../common/vectors.h"
+#include <simdpp/simd.h>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Checks prefix_sum against a sequential sum of the elements
+template<class V>
+bool test_prefix_sum_ok(const V& a)
+{
+    using T = typename V::element_type;
+    simdpp::detail::mem_block<V> in(a);
+    simdpp::detail::mem_block<V> out(simdpp::prefix_sum(a));
+    T s = 0;
+    for (unsigned i = 0; i < V::length; i++) {
+        s = T(s + in[i]);
+        if (out[i] != s) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<unsigned B>
+void test_prefix_sum_n(TestSuite& tc)
+{
+    using namespace simdpp;
+    const unsigned vnum = 4;
+    Vectors<B,vnum> v;
+
+    // floating-point data is restricted to small integers so that the sums
+    // are exact regardless of the summation order
+    SIMDPP_ALIGN(64) float pf32[B/4];
+    SIMDPP_ALIGN(64) double pf64[B/8];
+    for (unsigned i = 0; i < B/4; i++) {
+        pf32[i] = float(i % 7);
+    }
+    for (unsigned i = 0; i < B/8; i++) {
+        pf64[i] = double(i % 5);
+    }
+
+    for (unsigned i = 0; i < vnum; i++) {
+        TEST_PUSH(tc, uint8<B>, prefix_sum(v.u8[i]));
+        TEST_PUSH(tc, int8<B>, prefix_sum(v.i8[i]));
+        TEST_PUSH(tc, uint16<B/2>, prefix_sum(v.u16[i]));
+        TEST_PUSH(tc, int16<B/2>, prefix_sum(v.i16[i]));
+        TEST_PUSH(tc, uint32<B/4>, prefix_sum(v.u32[i]));
+        TEST_PUSH(tc, int32<B/4>, prefix_sum(v.i32[i]));
+        TEST_PUSH(tc, uint64<B/8>, prefix_sum(v.u64[i]));
+        TEST_PUSH(tc, int64<B/8>, prefix_sum(v.i64[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.u8[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.i8[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.u16[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.i16[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.u32[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.i32[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.u64[i]));
+        TEST_CHECK(tc, test_prefix_sum_ok(v.i64[i]));
+    }
+
+    float32<B/4> f32 = load(pf32);
+    float64<B/8> f64 = load(pf64);
+    TEST_PUSH(tc, float32<B/4>, prefix_sum(f32));
+    TEST_PUSH(tc, float64<B/8>, prefix_sum(f64));
+    TEST_CHECK(tc, test_prefix_sum_ok(f32));
+    TEST_CHECK(tc, test_prefix_sum_ok(f64));
+}
+
+template<class T>
+bool test_scan_equal(const T* a, const T* b, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Pushes the contents of a buffer as a sequence of vectors
+template<class V>
+void test_push_buffer(TestSuite& tc, const typename V::element_type* p,
+                      unsigned size)
+{
+    for (unsigned i = 0; i < size; i += V::length) {
+        V r = simdpp::load_u(p + i);
+        TEST_PUSH(tc, V, r);
+    }
+}
+
+template<class V>
+void test_scan_type(TestSuite& tc)
+{
+    using namespace simdpp;
+    using T = typename V::element_type;
+
+    // the returned totals are stored to the last element of the buffer
+    const unsigned size = 64;
+    T src[size];
+    T dst[size];
+    for (unsigned i = 0; i < size; i++) {
+        src[i] = T((i*7) % 23 + 1);
+    }
+
+    const unsigned lengths[] = { 60, 57, 5 };
+    for (unsigned n : lengths) {
+        // the sequential sums are the reference. The data are small integers,
+        // thus the floating-point sums are exact too
+        T incl[size], excl[size], delta[size];
+        T total = T(3);
+        for (unsigned i = 0; i < n; i++) {
+            excl[i] = total;
+            total = T(total + src[i]);
+            incl[i] = total;
+            delta[i] = T(src[i] - (i == 0 ? T(1) : src[i-1]));
+        }
+
+        for (unsigned i = 0; i < size; i++) dst[i] = 0;
+        dst[size-1] = inclusive_scan(src, dst, n, T(3));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, incl, n) && dst[size-1] == total);
+
+        for (unsigned i = 0; i < size; i++) dst[i] = 0;
+        dst[size-1] = exclusive_scan(src, dst, n, T(3));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, excl, n) && dst[size-1] == total);
+
+        // in place
+        for (unsigned i = 0; i < size; i++) dst[i] = src[i];
+        dst[size-1] = inclusive_scan(dst, dst, n, T(3));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, incl, n) && dst[size-1] == total);
+
+        for (unsigned i = 0; i < size; i++) dst[i] = src[i];
+        dst[size-1] = exclusive_scan(dst, dst, n, T(3));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, excl, n) && dst[size-1] == total);
+
+        // delta coding, decoding must restore the original data
+        for (unsigned i = 0; i < size; i++) dst[i] = 0;
+        dst[size-1] = delta_encode(src, dst, n, T(1));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, delta, n) && dst[size-1] == src[n-1]);
+
+        dst[size-1] = delta_decode(dst, dst, n, T(1));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, src, n) && dst[size-1] == src[n-1]);
+
+        for (unsigned i = 0; i < size; i++) dst[i] = src[i];
+        delta_encode(dst, dst, n, T(1));
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, delta, n));
+    }
+}
+
+template<class V>
+void test_delta4_type(TestSuite& tc)
+{
+    using namespace simdpp;
+    using T = typename V::element_type;
+
+    const unsigned size = 64;
+    T src[size];
+    T dst[size];
+    for (unsigned i = 0; i < size; i++) {
+        src[i] = T((i*5) % 19 + 2);
+    }
+
+    const unsigned lengths[] = { 60, 57, 3 };
+    for (unsigned n : lengths) {
+        // the reference deltas and the final state
+        T delta[size];
+        T last[4] = { 1, 2, 3, 4 };
+        for (unsigned i = 0; i < n; i++) {
+            delta[i] = T(src[i] - last[i % 4]);
+            last[i % 4] = src[i];
+        }
+
+        T state[4] = { 1, 2, 3, 4 };
+        for (unsigned i = 0; i < size; i++) dst[i] = 0;
+        delta_encode4(src, dst, n, state);
+        TEST_CHECK(tc, test_scan_equal(dst, delta, n) &&
+                       test_scan_equal(state, last, 4));
+        for (unsigned i = 0; i < 4; i++) dst[size-4+i] = state[i];
+        test_push_buffer<V>(tc, dst, size);
+
+        T dstate[4] = { 1, 2, 3, 4 };
+        delta_decode4(dst, dst, n, dstate);
+        TEST_CHECK(tc, test_scan_equal(dst, src, n) &&
+                       test_scan_equal(dstate, last, 4));
+        for (unsigned i = 0; i < 4; i++) dst[size-4+i] = dstate[i];
+        test_push_buffer<V>(tc, dst, size);
+
+        // in place, processed in two blocks
+        T istate[4] = { 1, 2, 3, 4 };
+        for (unsigned i = 0; i < size; i++) dst[i] = src[i];
+        unsigned first = n >= 20 ? 20 : 0;
+        delta_encode4(dst, dst, first, istate);
+        delta_encode4(dst + first, dst + first, n - first, istate);
+        test_push_buffer<V>(tc, dst, size);
+        TEST_CHECK(tc, test_scan_equal(dst, delta, n) &&
+                       test_scan_equal(istate, last, 4));
+    }
+}
+
+void test_scan(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "scan");
+
+    test_prefix_sum_n<16>(tc);
+    test_prefix_sum_n<32>(tc);
+    test_prefix_sum_n<64>(tc);
+
+    test_scan_type<uint8x16>(tc);
+    test_scan_type<int16x8>(tc);
+    test_scan_type<uint32x4>(tc);
+    test_scan_type<int64x2>(tc);
+    test_scan_type<float32x4>(tc);
+    test_scan_type<float64x2>(tc);
+
+    test_delta4_type<int32x4>(tc);
+    test_delta4_type<uint64x2>(tc);
+    test_delta4_type<float32x4>(tc);
+    test_delta4_type<float64x2>(tc);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,123 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class V, class T>
+void test_set_ops_push(TestSuite& tc, const T* p, std::size_t size)
+{
+    using namespace simdpp;
+    const unsigned L = V::length;
+    T buf[L];
+    TEST_PUSH(tc, uint16_t, uint16_t(size));
+    for (std::size_t i = 0; i < size; i += L) {
+        for (unsigned j = 0; j < L; ++j) {
+            buf[j] = i + j < size ? p[i+j] : T(0);
+        }
+        V r = load_u(buf);
+        TEST_PUSH(tc, V, r);
+    }
+}
+
+// Returns whether [p, p+size) holds the elements of ref
+template<class T>
+bool test_set_ops_equal(const T* p, std::size_t size, const std::vector<T>& ref)
+{
+    return size == ref.size() && std::equal(ref.begin(), ref.end(), p);
+}
+
+// Fills p with an increasing sequence whose steps are 1 to step
+template<class T>
+void test_set_ops_fill(T* p, unsigned size, unsigned step, uint32_t seed)
+{
+    T x = 0;
+    for (unsigned i = 0; i < size; ++i) {
+        seed = seed * 1103515245 + 12345;
+        x += 1 + (seed >> 16) % step;
+        p[i] = x;
+    }
+}
+
+template<class V, class T>
+void test_set_ops_type(TestSuite& tc)
+{
+    using namespace simdpp;
+    const unsigned size = 400;
+    T a[size], b[size], out[2*size];
+
+    // similar density, sparser first set and a much smaller first set that
+    // is looked up with the galloping search
+    const unsigned cases[][4] = {
+        { 400, 3, 400, 4 },
+        { 101, 17, 400, 3 },
+        { 6, 200, 400, 2 },
+    };
+
+    for (const unsigned* c : cases) {
+        unsigned na = c[0];
+        unsigned nb = c[2];
+        test_set_ops_fill(a, na, c[1], 1);
+        test_set_ops_fill(b, nb, c[3], 7);
+
+        // the standard algorithms are the reference
+        std::vector<T> inter, diff_ab, diff_ba, uni;
+        std::set_intersection(a, a + na, b, b + nb, std::back_inserter(inter));
+        std::set_difference(a, a + na, b, b + nb, std::back_inserter(diff_ab));
+        std::set_difference(b, b + nb, a, a + na, std::back_inserter(diff_ba));
+        std::set_union(a, a + na, b, b + nb, std::back_inserter(uni));
+
+        std::size_t r = set_intersect(a, na, b, nb, out);
+        test_set_ops_push<V>(tc, out, r);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, inter));
+        r = set_intersect(b, nb, a, na, out);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, inter));
+        TEST_PUSH(tc, uint16_t, uint16_t(set_intersect_count(a, na, b, nb)));
+        TEST_PUSH(tc, uint16_t, uint16_t(set_intersect_count(b, nb, a, na)));
+        TEST_CHECK(tc, set_intersect_count(a, na, b, nb) == inter.size());
+        TEST_CHECK(tc, set_intersect_count(b, nb, a, na) == inter.size());
+
+        r = set_difference(a, na, b, nb, out);
+        test_set_ops_push<V>(tc, out, r);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, diff_ab));
+        r = set_difference(b, nb, a, na, out);
+        test_set_ops_push<V>(tc, out, r);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, diff_ba));
+
+        r = set_union(a, na, b, nb, out);
+        test_set_ops_push<V>(tc, out, r);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, uni));
+        r = set_union(b, nb, a, na, out);
+        TEST_CHECK(tc, test_set_ops_equal(out, r, uni));
+    }
+
+    // empty sets
+    TEST_PUSH(tc, uint16_t, uint16_t(set_intersect(a, 0, b, size, out)));
+    TEST_PUSH(tc, uint16_t, uint16_t(set_difference(a, 5, b, 0, out)));
+    TEST_PUSH(tc, uint16_t, uint16_t(set_union(a, 0, b, 0, out)));
+    TEST_CHECK(tc, set_intersect(a, 0, b, size, out) == 0);
+    TEST_CHECK(tc, set_difference(a, 5, b, 0, out) == 5 &&
+                   std::equal(a, a + 5, out));
+    TEST_CHECK(tc, set_union(a, 0, b, 0, out) == 0);
+}
+
+void test_set_ops(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "set_ops");
+
+    test_set_ops_type<uint32x4, uint32_t>(tc);
+    test_set_ops_type<uint64x2, uint64_t>(tc);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
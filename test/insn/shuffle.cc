@@ -215,6 +215,14 @@ void test_shuffle(TestResults& res)
         TEST_PUSH(tc, uint16_t, extract_bits<7>(uint8x16(mu)));
     }
 
+    for (unsigned el = 0; el < 32; el++) {
+        simdpp::SIMDPP_ARCH_NAMESPACE::detail::mem_block<uint8x32> mu;
+        mu = uint8x32::zero();
+        mu[el] = 0xff;
+        TEST_PUSH(tc, uint32_t, extract_bits_any(uint8x32(mu)));
+        TEST_CHECK(tc, extract_bits_any(uint8x32(mu)) == uint32_t(1) << el);
+    }
+
 }
 
 } // namespace SIMDPP_ARCH_NAMESPACE
@@ -9,6 +9,7 @@
 #include "../utils/test_results.h"
 #include "../common/vectors.h"
 #include <simdpp/simd.h>
+#include <cstring>
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
@@ -48,8 +49,22 @@ struct Test_shuffle21 {
         const unsigned s0 = i / 2 % 2;
         const unsigned s1 = i % 2;
 
+        using E = typename V::element_type;
+        E ea[V::length], eb[V::length], er[V::length];
+        std::memcpy(ea, &a, sizeof(ea));
+        std::memcpy(eb, &b, sizeof(eb));
+
         a = simdpp::shuffle1<s0,s1>(a, b);
         TEST_PUSH(tc, V, a);
+
+        // each 128-bit lane takes element s0 of a and element s1 of b
+        std::memcpy(er, &a, sizeof(er));
+        bool ok = true;
+        for (unsigned j = 0; j < V::length; j += 2) {
+            ok = ok && std::memcmp(&er[j], &ea[j+s0], sizeof(E)) == 0;
+            ok = ok && std::memcmp(&er[j+1], &eb[j+s1], sizeof(E)) == 0;
+        }
+        TEST_CHECK(tc, ok);
     }
 };
 
@@ -0,0 +1,193 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <limits>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class V, class T>
+void test_sort_push(TestSuite& tc, const T* p, unsigned size)
+{
+    using namespace simdpp;
+    T buf[4];
+    for (unsigned i = 0; i < size; i += 4) {
+        for (unsigned j = 0; j < 4; ++j) {
+            buf[j] = i + j < size ? p[i+j] : T(0);
+        }
+        V r = load_u(buf);
+        TEST_PUSH(tc, V, r);
+    }
+}
+
+template<class T>
+bool test_is_sorted(const T* p, unsigned size)
+{
+    for (unsigned i = 1; i < size; ++i) {
+        if (p[i] < p[i-1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class V, class T>
+void test_sort_type(TestSuite& tc, const T* src)
+{
+    using namespace simdpp;
+    const unsigned size = 300;
+    T buf[size];
+
+    // sizes around the leaf size and larger buffers
+    const unsigned lengths[] = { 0, 1, 7, 16, 17, 61, 200, size };
+    for (unsigned n : lengths) {
+        for (unsigned i = 0; i < n; ++i) {
+            buf[i] = src[i];
+        }
+        simdpp::sort(buf, n);
+        TEST_CHECK(tc, test_is_sorted(buf, n));
+        test_sort_push<V>(tc, buf, n);
+    }
+
+    // few distinct values
+    for (unsigned i = 0; i < size; ++i) {
+        buf[i] = src[i % 3];
+    }
+    simdpp::sort(buf, size);
+    TEST_CHECK(tc, test_is_sorted(buf, size));
+    test_sort_push<V>(tc, buf, size);
+
+    // reversed input
+    for (unsigned i = 0; i < size; ++i) {
+        buf[i] = T(size - i);
+    }
+    simdpp::sort(buf, size);
+    TEST_CHECK(tc, test_is_sorted(buf, size));
+    test_sort_push<V>(tc, buf, size);
+
+    // sort16
+    V a0 = load_u(src);
+    V a1 = load_u(src + 4);
+    V a2 = load_u(src + 8);
+    V a3 = load_u(src + 12);
+    sort16(a0, a1, a2, a3);
+    TEST_PUSH(tc, V, a0);
+    TEST_PUSH(tc, V, a1);
+    TEST_PUSH(tc, V, a2);
+    TEST_PUSH(tc, V, a3);
+
+    // merge of two sorted runs of different lengths
+    T ra[100], rb[37], out[137];
+    for (unsigned i = 0; i < 100; ++i) {
+        ra[i] = src[i];
+    }
+    for (unsigned i = 0; i < 37; ++i) {
+        rb[i] = src[100 + i];
+    }
+    simdpp::sort(ra, 100);
+    simdpp::sort(rb, 37);
+    T* end = merge(ra, 100, rb, 37, out);
+    TEST_CHECK(tc, end == out + 137);
+    TEST_CHECK(tc, test_is_sorted(out, 137));
+    test_sort_push<V>(tc, out, 137);
+
+    end = merge(ra, 3, rb, 37, out);
+    TEST_CHECK(tc, end == out + 40);
+    TEST_CHECK(tc, test_is_sorted(out, 40));
+    test_sort_push<V>(tc, out, 40);
+}
+
+/*  Checks that the keys are sorted and that each key still has its payload.
+    The payload of the element i is i, the keys are restored from it.
+*/
+template<class T, class P>
+bool test_sort_pairs_ok(const T* src, const T* keys, const P* values,
+                        unsigned size)
+{
+    std::vector<bool> seen(size, false);
+    for (unsigned i = 0; i < size; ++i) {
+        unsigned idx = unsigned(values[i]);
+        if (idx >= size || seen[idx] || !(keys[i] == src[idx])) {
+            return false;
+        }
+        seen[idx] = true;
+    }
+    return test_is_sorted(keys, size);
+}
+
+template<class V, class T, class P>
+void test_sort_pairs(TestSuite& tc, const T* src, T max_value)
+{
+    using namespace simdpp;
+    const unsigned size = 300;
+    T in[size], keys[size];
+    P values[size];
+
+    // duplicates and keys equal to the padding value of the small sorts
+    for (unsigned i = 0; i < size; ++i) {
+        in[i] = i % 5 == 0 ? max_value : src[i];
+    }
+
+    const unsigned lengths[] = { 0, 1, 7, 16, 17, 33, 61, 200, size };
+    for (unsigned n : lengths) {
+        for (unsigned i = 0; i < n; ++i) {
+            keys[i] = in[i];
+            values[i] = P(i);
+        }
+        simdpp::sort(keys, values, n);
+        TEST_CHECK(tc, test_sort_pairs_ok(in, keys, values, n));
+        test_sort_push<V>(tc, keys, n);
+    }
+
+    // few distinct values
+    for (unsigned i = 0; i < size; ++i) {
+        in[i] = src[i % 3];
+        keys[i] = in[i];
+        values[i] = P(i);
+    }
+    simdpp::sort(keys, values, size);
+    TEST_CHECK(tc, test_sort_pairs_ok(in, keys, values, size));
+    test_sort_push<V>(tc, keys, size);
+}
+
+void test_sort(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "sort");
+
+    const unsigned size = 300;
+    uint32_t su[size];
+    int32_t si[size];
+    float sf[size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        su[i] = seed;
+        si[i] = int32_t(seed) >> (i % 20);
+        sf[i] = float(int32_t(seed) >> 8) / 256.0f;
+    }
+    // duplicates
+    for (unsigned i = 0; i < size; i += 7) {
+        su[i] = su[0];
+        si[i] = si[0];
+        sf[i] = sf[0];
+    }
+
+    test_sort_type<uint32x4>(tc, su);
+    test_sort_type<int32x4>(tc, si);
+    test_sort_type<float32x4>(tc, sf);
+
+    test_sort_pairs<uint32x4, uint32_t, uint32_t>(tc, su, 0xffffffff);
+    test_sort_pairs<int32x4, int32_t, float>(tc, si, 0x7fffffff);
+    test_sort_pairs<float32x4, float, int32_t>(
+            tc, sf, std::numeric_limits<float>::infinity());
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
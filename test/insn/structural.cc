@@ -0,0 +1,83 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Scans the text in chunks of the given size and returns the number of found
+// positions
+std::size_t test_structural_scan(simdpp::structural_scanner& sc,
+                                 const char* p, std::size_t len,
+                                 std::size_t chunk, uint64_t* out)
+{
+    sc.reset();
+    uint64_t* o = out;
+    for (std::size_t i = 0; i < len; i += chunk) {
+        o = sc.scan(p + i, len - i < chunk ? len - i : chunk, o);
+    }
+    o = sc.finish(o);
+    return o - out;
+}
+
+void test_structural(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "structural");
+
+    static uint64_t out[2200];
+    structural_scanner json;
+
+    const char* doc = "{\"a\": [1, -2.5e3, true], \"b\\\"{\": \"x\\\\\", \"c\":null}";
+    const uint64_t expected[] = { 0, 1, 4, 6, 7, 8, 10, 16, 18, 22, 23, 25, 31, 33,
+                                  38, 40, 43, 44, 48 };
+    std::size_t n = test_structural_scan(json, doc, std::strlen(doc), 1000, out);
+    TEST_CHECK(tc, n == 19 && std::memcmp(out, expected, sizeof(expected)) == 0);
+    TEST_CHECK(tc, !json.in_string());
+
+    // an unterminated string
+    test_structural_scan(json, "[\"ab", 4, 1000, out);
+    TEST_CHECK(tc, json.in_string());
+
+    structural_scanner csv(structural_format::csv, ';');
+    const char* table = "a;\"b;\"\"c\"\"\n\";d\r\ne;f";
+    n = test_structural_scan(csv, table, std::strlen(table), 1000, out);
+    TEST_CHECK(tc, n == 4 && out[0] == 1 && out[1] == 12 && out[2] == 15 &&
+                   out[3] == 17);
+
+    // long documents scanned in chunks crossing the block boundaries
+    const char* pieces[] = { "{\"key\": ", "\"v\\\\\"", "\"\\\"q\\\"\"", "[1, 2]",
+                             "true", "}, ", "\n", "-12.5", "\"{[,]}\"" };
+    static char text[2000];
+    std::size_t len = 0;
+    uint32_t seed = 1;
+    for (;;) {
+        seed = seed * 1103515245 + 12345;
+        const char* p = pieces[(seed >> 16) % 9];
+        std::size_t m = std::strlen(p);
+        if (len + m > sizeof(text)) {
+            break;
+        }
+        std::memcpy(text + len, p, m);
+        len += m;
+    }
+
+    const std::size_t chunks[] = { 1, 7, 64, 100, 2000 };
+    for (std::size_t chunk : chunks) {
+        n = test_structural_scan(json, text, len, chunk, out);
+        TEST_PUSH(tc, uint32_t, n);
+        TEST_PUSH(tc, uint32_t, crc32c(out, n * sizeof(uint64_t)));
+        n = test_structural_scan(csv, text, len, chunk, out);
+        TEST_PUSH(tc, uint32_t, n);
+        TEST_PUSH(tc, uint32_t, crc32c(out, n * sizeof(uint64_t)));
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -32,6 +32,30 @@ void main_test_function(TestResults& res)
     test_memory_load(res);
     test_memory_store(res);
     test_transpose(res);
+    test_scan(res);
+    test_varint(res);
+    test_filter(res);
+    test_find(res);
+    test_sort(res);
+    test_set_ops(res);
+    test_hash_table(res);
+    test_hash(res);
+    test_checksum(res);
+    test_base64(res);
+    test_utf8(res);
+    test_structural(res);
+    test_ascii(res);
+    test_parse(res);
+    test_aos_soa(res);
+    test_color(res);
+    test_convolve(res);
+    test_resize(res);
+    test_alpha(res);
+    test_motion(res);
+    test_audio(res);
+    test_fft(res);
+    test_complex(res);
+    test_nn(res);
 }
 
 static ArchRegistration tester(main_test_function,
@@ -17,24 +17,48 @@
 namespace SIMDPP_ARCH_NAMESPACE {
 
 void main_test_function(TestResults& res);
+void test_alpha(TestResults& res);
+void test_aos_soa(TestResults& res);
+void test_ascii(TestResults& res);
+void test_audio(TestResults& res);
+void test_base64(TestResults& res);
 void test_bitwise(TestResults& res);
 void test_blend(TestResults& res);
+void test_checksum(TestResults& res);
+void test_color(TestResults& res);
 void test_compare(TestResults& res);
+void test_complex(TestResults& res);
 void test_convert(TestResults& res);
 void test_construct(TestResults& res);
+void test_convolve(TestResults& res);
+void test_fft(TestResults& res);
+void test_filter(TestResults& res);
+void test_find(TestResults& res);
+void test_hash(TestResults& res);
+void test_hash_table(TestResults& res);
 void test_math_fp(TestResults& res);
 void test_math_int(TestResults& res);
 void test_math_shift(TestResults& res);
 void test_memory_load(TestResults& res);
 void test_memory_store(TestResults& res);
+void test_motion(TestResults& res);
+void test_nn(TestResults& res);
+void test_parse(TestResults& res);
+void test_resize(TestResults& res);
+void test_scan(TestResults& res);
 void test_set(TestResults& res);
+void test_set_ops(TestResults& res);
 void test_shuffle(TestResults& res);
 void test_shuffle_bytes(TestResults& res);
 void test_shuffle_generic(TestResults& res);
 void test_permute_generic(TestResults& res);
 void test_shuffle_transpose(TestResults& res);
+void test_sort(TestResults& res);
+void test_structural(TestResults& res);
 void test_test_utils(TestResults& res);
 void test_transpose(TestResults& res);
+void test_utf8(TestResults& res);
+void test_varint(TestResults& res);
 
 } // namespace SIMDPP_ARCH_NAMESPACE
 
@@ -0,0 +1,98 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+void test_utf8(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "utf8");
+
+    const char* valid[] = {
+        "", "a", "\x7f", "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf",
+        "\xee\x80\x80", "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf",
+    };
+    const char* invalid[] = {
+        "\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xc2", "\xc2\x41", "\xe0\x80\x80",
+        "\xe0\x9f\xbf", "\xed\xa0\x80", "\xed\xbf\xbf", "\xe1\x80", "\xf0\x8f\xbf\xbf",
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff", "\xc2\x80\x80",
+        "\xf0\x90\x80", "\xe1\x80\x80\x80",
+    };
+
+    // each sequence at the start, in the middle and at the end of the input,
+    // so that it crosses vector and chunk boundaries
+    char buf[200];
+    char32_t u32[200];
+    char16_t u16[200];
+    const unsigned offsets[] = { 0, 14, 15, 30, 31, 62, 63, 100 };
+    for (const char* s : valid) {
+        std::size_t len = std::strlen(s);
+        for (unsigned off : offsets) {
+            std::memset(buf, 'a', sizeof(buf));
+            std::memcpy(buf + off, s, len);
+            TEST_CHECK(tc, validate_utf8(buf, off + len));
+            TEST_CHECK(tc, validate_utf8(buf, sizeof(buf)));
+            TEST_CHECK(tc, utf8_to_utf32(buf, sizeof(buf), u32) != nullptr);
+        }
+    }
+    for (const char* s : invalid) {
+        std::size_t len = std::strlen(s);
+        for (unsigned off : offsets) {
+            std::memset(buf, 'a', sizeof(buf));
+            std::memcpy(buf + off, s, len);
+            TEST_CHECK(tc, !validate_utf8(buf, off + len));
+            TEST_CHECK(tc, utf8_to_utf16(buf, off + len, u16) == nullptr);
+        }
+    }
+
+    // transcoding round trips over long mixed text
+    const char* pieces[] = { "text ", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80",
+                             "0123456789abcdefghijklmnopqrstuvwxyz" };
+    static char text[1000];
+    static char back[3000];
+    static char32_t long32[1000];
+    static char16_t long16[1000];
+    std::size_t len = 0;
+    uint32_t seed = 1;
+    for (;;) {
+        seed = seed * 1103515245 + 12345;
+        const char* p = pieces[(seed >> 16) % 5];
+        std::size_t n = std::strlen(p);
+        if (len + n > sizeof(text)) {
+            break;
+        }
+        std::memcpy(text + len, p, n);
+        len += n;
+    }
+    TEST_CHECK(tc, validate_utf8(text, len));
+
+    char32_t* e32 = utf8_to_utf32(text, len, long32);
+    TEST_PUSH(tc, uint32_t, e32 ? crc32c(long32, (e32 - long32) * 4) : 0);
+    char* e = e32 ? utf32_to_utf8(long32, e32 - long32, back) : nullptr;
+    TEST_CHECK(tc, e == back + len && std::memcmp(back, text, len) == 0);
+
+    char16_t* e16 = utf8_to_utf16(text, len, long16);
+    TEST_PUSH(tc, uint32_t, e16 ? crc32c(long16, (e16 - long16) * 2) : 0);
+    e = e16 ? utf16_to_utf8(long16, e16 - long16, back) : nullptr;
+    TEST_CHECK(tc, e == back + len && std::memcmp(back, text, len) == 0);
+
+    // unpaired surrogates and out of range values
+    const char16_t bad16[] = { 0xdc00, 0xd800, 'a' };
+    TEST_CHECK(tc, utf16_to_utf8(bad16, 1, back) == nullptr);
+    TEST_CHECK(tc, utf16_to_utf8(bad16 + 1, 1, back) == nullptr);
+    TEST_CHECK(tc, utf16_to_utf8(bad16 + 1, 2, back) == nullptr);
+    const char32_t bad32[] = { 0xd800, 0x110000 };
+    TEST_CHECK(tc, utf32_to_utf8(bad32, 1, back) == nullptr);
+    TEST_CHECK(tc, utf32_to_utf8(bad32 + 1, 1, back) == nullptr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,91 @@
+/*  Copyright (C) 2014  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstring>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Pushes the contents of a byte buffer as a sequence of vectors
+void test_push_bytes(TestSuite& tc, const uint8_t* p, unsigned size)
+{
+    using namespace simdpp;
+    SIMDPP_ALIGN(16) uint8_t buf[16];
+    for (unsigned i = 0; i < size; i += 16) {
+        std::memset(buf, 0, 16);
+        std::memcpy(buf, p + i, size - i < 16 ? size - i : 16);
+        uint8x16 r = load(buf);
+        TEST_PUSH(tc, uint8x16, r);
+    }
+}
+
+void test_varint(TestResults& res)
+{
+    using namespace simdpp;
+    TestSuite& tc = NEW_TEST_SUITE(res, "varint");
+
+    // a mix of 1 to 5 byte values, with runs of short values so that the
+    // vector paths are exercised
+    const unsigned size = 96;
+    uint32_t src[size];
+    uint32_t dst[size];
+    uint32_t seed = 1;
+    for (unsigned i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned bits = (i / 16) % 2 == 0 ? 14 : (seed >> 8) % 33;
+        src[i] = bits == 32 ? seed : (seed & ((1u << bits) - 1));
+    }
+
+    uint8_t enc[size*5];
+    const unsigned lengths[] = { 96, 93, 3 };
+
+    for (unsigned n : lengths) {
+        std::memset(enc, 0, sizeof(enc));
+        std::memset(dst, 0, sizeof(dst));
+        uint8_t* end = streamvbyte_encode(src, n, enc);
+        unsigned enc_size = end - enc;
+        test_push_bytes(tc, enc, enc_size);
+
+        const uint8_t* dend = streamvbyte_decode(enc, end, dst, n);
+        TEST_CHECK(tc, dend == end);
+        for (unsigned i = 0; i < size; i += 4) {
+            uint32x4 r = load_u(dst + i);
+            TEST_PUSH(tc, uint32x4, r);
+        }
+
+        // truncated input
+        dend = streamvbyte_decode(enc, end - 1, dst, n);
+        TEST_CHECK(tc, dend == nullptr);
+    }
+
+    for (unsigned n : lengths) {
+        std::memset(enc, 0, sizeof(enc));
+        std::memset(dst, 0, sizeof(dst));
+        uint8_t* end = varint_encode(src, n, enc);
+        unsigned enc_size = end - enc;
+        test_push_bytes(tc, enc, enc_size);
+
+        const uint8_t* dend = varint_decode(enc, end, dst, n);
+        TEST_CHECK(tc, dend == end);
+        for (unsigned i = 0; i < size; i += 4) {
+            uint32x4 r = load_u(dst + i);
+            TEST_PUSH(tc, uint32x4, r);
+        }
+
+        dend = varint_decode(enc, end - 1, dst, n);
+        TEST_CHECK(tc, dend == nullptr);
+    }
+
+    // varints longer than 5 bytes are rejected
+    uint8_t bad[16];
+    std::memset(bad, 0x80, sizeof(bad));
+    TEST_CHECK(tc, varint_decode(bad, bad + 16, dst, 1) == nullptr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -42,16 +42,20 @@ int main(int argc, char** argv)
     } else if (arch_name == "X86_SSE4_1") {
         g_supported_arch = Arch::X86_SSE2 | Arch::X86_SSE3 | Arch::X86_SSSE3 |
                            Arch::X86_SSE4_1;
+    } else if (arch_name == "X86_SSE4_2") {
+        g_supported_arch = Arch::X86_SSE2 | Arch::X86_SSE3 | Arch::X86_SSSE3 |
+                           Arch::X86_SSE4_1 | Arch::X86_SSE4_2;
     } else if (arch_name == "X86_AVX") {
         g_supported_arch = Arch::X86_SSE2 | Arch::X86_SSE3 | Arch::X86_SSSE3 |
-                Arch::X86_SSE4_1 | Arch::X86_AVX;
+                Arch::X86_SSE4_1 | Arch::X86_SSE4_2 | Arch::X86_AVX;
     } else if (arch_name == "X86_AVX2") {
         g_supported_arch = Arch::X86_SSE2 | Arch::X86_SSE3 | Arch::X86_SSSE3 |
-                Arch::X86_SSE4_1 | Arch::X86_AVX | Arch::X86_AVX2;
+                Arch::X86_SSE4_1 | Arch::X86_SSE4_2 | Arch::X86_AVX |
+                Arch::X86_AVX2;
     } else if (arch_name == "X86_AVX512F") {
         g_supported_arch = Arch::X86_SSE2 | Arch::X86_SSE3 | Arch::X86_SSSE3 |
-                Arch::X86_SSE4_1 | Arch::X86_AVX | Arch::X86_AVX2 |
-                Arch::X86_AVX512F;
+                Arch::X86_SSE4_1 | Arch::X86_SSE4_2 | Arch::X86_AVX |
+                Arch::X86_AVX2 | Arch::X86_FMA3 | Arch::X86_AVX512F;
     } else if (arch_name == "ARM_NEON") {
         g_supported_arch = Arch::ARM_NEON;
     } else if (arch_name == "ARM_NEON_FLT_SP") {
@@ -84,6 +88,10 @@ int main(int argc, char** argv)
     if (test_dispatcher4(1, 2, 3, 4) != 1+2+3+4) {
         err |= 8;
     }
+    if (!test_dispatcher_utf8("\xe2\x82\xac", 3) ||
+        test_dispatcher_utf8("\xe2\x82", 2)) {
+        err |= 16;
+    }
     if (err != 0) {
         std::cout << "ERR: " << err << "\n";
         return EXIT_FAILURE;
@@ -52,7 +52,7 @@ int main()
 
     std::cout << "Num results: " << null_results.num_results() << '\n';
 
-    bool ok = true;
+    bool ok = test_checks_passed(null_results, err);
 
     for (auto it = arch_list.begin(); it != arch_list.end(); it++) {
         if (it == null_arch) {
@@ -68,6 +68,9 @@ int main()
         TestResults results(it->arch);
         it->run(results);
 
+        if (!test_checks_passed(results, err)) {
+            ok = false;
+        }
         if (!test_equal(null_results, results, err)) {
             ok = false;
         }
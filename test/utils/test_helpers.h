@@ -109,6 +109,9 @@ void test_push_internal(TestSuite& t, const simdpp::float64<N>& data, unsigned l
 */
 #define TEST_PUSH(TC,T,D)   { test_push_internal((TC), (T)(D), __LINE__); }
 
+// C - a condition that must hold on every architecture
+#define TEST_CHECK(TC,C)    { (TC).check((C), __LINE__); }
+
 #define NEW_TEST_SUITE(R, NAME) ((R).new_test_suite((NAME), __FILE__))
 
 #define TEST_ARRAY_PUSH(TC, T, A)                                       \
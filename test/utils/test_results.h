@@ -47,6 +47,7 @@ private:
 
     friend bool test_equal(const TestResults& a, const TestResults& b,
                            std::ostream& err);
+    friend bool test_checks_passed(const TestResults& a, std::ostream& err);
 
     const char* arch_;
     // use deque because we must never invalidate references to test cases
@@ -111,4 +112,15 @@ inline bool test_equal(const TestResults& a, const TestResults& b, std::ostream&
     return ok;
 }
 
+inline bool test_checks_passed(const TestResults& a, std::ostream& err)
+{
+    bool ok = true;
+    for (const auto& i: a.test_suites_) {
+        if (!test_checks_passed(i.test_suite, a.arch_, err)) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
 #endif
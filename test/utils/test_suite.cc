@@ -255,7 +255,7 @@ bool test_equal(const TestSuite& a, const char* a_arch,
     auto cmpeq_result = [](const TestSuite::Result& ia, const TestSuite::Result& ib,
                            unsigned prec) -> bool
     {
-        if (std::memcmp(ia.d(), ib.d(), TestSuite::size_for_type(ia.type)) == 0) {
+        if (std::memcmp(ia.d(), ib.d(), ia.el_size * ia.length) == 0) {
             return true;
         }
 
@@ -339,3 +339,16 @@ bool test_equal(const TestSuite& a, const char* a_arch,
     }
     return ok;
 }
+
+bool test_checks_passed(const TestSuite& a, const char* a_arch, std::ostream& err)
+{
+    for (unsigned line : a.failed_checks_) {
+        err << "--------------------------------------------------------------\n";
+        err << "  For architecture: " << a_arch << " :\n";
+        err << "  In file \"" << a.file_ << "\" at line " << line << " : \n";
+        err << "  In test case \"" << a.name_ << "\" :\n";
+        err << "ERROR: Check failed\n";
+        err << "--------------------------------------------------------------\n";
+    }
+    return a.failed_checks_.empty();
+}
@@ -19,6 +19,8 @@ bool test_equal(const TestSuite& a, const char* a_arch,
                 const TestSuite& b, const char* b_arch,
                 std::ostream& err);
 
+bool test_checks_passed(const TestSuite& a, const char* a_arch, std::ostream& err);
+
 class TestSuite {
 public:
 
@@ -76,6 +78,16 @@ public:
     /// Stores the results into the results set.
     Result& push(Type type, unsigned length, unsigned line);
 
+    /// Records the outcome of a check that must hold on every architecture,
+    /// including the null one. Unlike the pushed results, checks are not
+    /// compared between architectures.
+    void check(bool success, unsigned line)
+    {
+        if (!success) {
+            failed_checks_.push_back(line);
+        }
+    }
+
     /// Sets the allowed error in ULPs. Only meaningful for floating-point data.
     /// Affects all pushed data until the next call to @a unset_precision
     void set_precision(unsigned num_ulp)    { curr_precision_ulp_ = num_ulp; }
@@ -95,6 +107,8 @@ private:
     friend bool test_equal(const TestSuite& a, const char* a_arch,
                            const TestSuite& b, const char* b_arch,
                            std::ostream& err);
+    friend bool test_checks_passed(const TestSuite& a, const char* a_arch,
+                                   std::ostream& err);
 
     TestSuite(const char* name, const char* file);
 
@@ -106,6 +120,7 @@ private:
     unsigned seq_;
     unsigned curr_precision_ulp_;
     std::vector<Result> results_;
+    std::vector<unsigned> failed_checks_;
 };
 
 class SeqTestSuite {